@@ -0,0 +1,203 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__MOTION_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
+#define AUTOWARE__MOTION_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
+
+#include "autoware/universe_utils/geometry/geometry.hpp"
+
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace autoware::motion_utils
+{
+/**
+ * @brief immutable spatial index of trajectory points.
+ * The cumulative arc lengths and a bounding volume hierarchy over contiguous point ranges are
+ * computed once at construction so that the nearest point/segment, arc length and lateral offset
+ * queries do not scan all the points. The query results are the same as the free functions in
+ * trajectory.hpp (findNearestIndex, findNearestSegmentIndex, calcSignedArcLength,
+ * calcLateralOffset) for trajectories without overlapping points.
+ * The index keeps a copy of the poses, so it stays valid after the source points are modified.
+ */
+class TrajectoryIndex
+{
+public:
+  /**
+   * @brief build the index from points of trajectory, path, ...
+   * @param points points of trajectory, path, ...
+   */
+  template <class T>
+  explicit TrajectoryIndex(const T & points)
+  : TrajectoryIndex(extractPoses(points))
+  {
+  }
+
+  explicit TrajectoryIndex(std::vector<geometry_msgs::msg::Pose> poses);
+
+  size_t size() const { return poses_.size(); }
+  bool empty() const { return poses_.empty(); }
+  const geometry_msgs::msg::Pose & pose(const size_t idx) const { return poses_.at(idx); }
+
+  /**
+   * @brief get the arc length from the front point to the given point index
+   */
+  double arcLength(const size_t idx) const { return arc_lengths_.at(idx); }
+
+  /**
+   * @brief get the total arc length of the trajectory
+   */
+  double length() const { return arc_lengths_.empty() ? 0.0 : arc_lengths_.back(); }
+
+  /**
+   * @brief find nearest point index for a given point.
+   * @param point given point
+   * @param hint_idx index expected to be close to the answer (e.g. the previous result). It only
+   * speeds up the search and does not change the result.
+   * @return index of nearest point
+   */
+  size_t findNearestIndex(
+    const geometry_msgs::msg::Point & point,
+    const std::optional<size_t> hint_idx = std::nullopt) const;
+
+  /**
+   * @brief find nearest point index for a given pose with distance and yaw thresholds.
+   * @param pose given pose
+   * @param max_dist max distance to the nearest point
+   * @param max_yaw max yaw deviation to the nearest point
+   * @param hint_idx index expected to be close to the answer (e.g. the previous result)
+   * @return index of nearest point (index or none if not found)
+   */
+  std::optional<size_t> findNearestIndex(
+    const geometry_msgs::msg::Pose & pose,
+    const double max_dist = std::numeric_limits<double>::max(),
+    const double max_yaw = std::numeric_limits<double>::max(),
+    const std::optional<size_t> hint_idx = std::nullopt) const;
+
+  /**
+   * @brief find nearest segment index for a given point.
+   * Segment is straight path between two continuous points of trajectory.
+   * @param point given point
+   * @param hint_idx segment index expected to be close to the answer
+   * @return nearest segment index
+   */
+  size_t findNearestSegmentIndex(
+    const geometry_msgs::msg::Point & point,
+    const std::optional<size_t> hint_idx = std::nullopt) const;
+
+  /**
+   * @brief find nearest segment index for a given pose with distance and yaw thresholds.
+   * @param pose given pose
+   * @param max_dist max distance to the nearest point
+   * @param max_yaw max yaw deviation to the nearest point
+   * @param hint_idx segment index expected to be close to the answer
+   * @return nearest segment index (index or none if not found)
+   */
+  std::optional<size_t> findNearestSegmentIndex(
+    const geometry_msgs::msg::Pose & pose,
+    const double max_dist = std::numeric_limits<double>::max(),
+    const double max_yaw = std::numeric_limits<double>::max(),
+    const std::optional<size_t> hint_idx = std::nullopt) const;
+
+  /**
+   * @brief find the segment index containing the given arc length in O(log N).
+   * The arc length is clamped to the trajectory.
+   */
+  size_t findSegmentIndexFromArcLength(const double arc_length) const;
+
+  /**
+   * @brief calculate longitudinal offset from the front point of the segment to the projection of
+   * the given point on the segment
+   */
+  double calcLongitudinalOffsetToSegment(
+    const size_t seg_idx, const geometry_msgs::msg::Point & point) const;
+
+  /**
+   * @brief calculate arc length from the front point to the projection of the given point
+   */
+  double calcArcLength(
+    const geometry_msgs::msg::Point & point,
+    const std::optional<size_t> hint_idx = std::nullopt) const;
+
+  /**
+   * @brief calculate signed arc length between two point indices in O(1)
+   */
+  double calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const;
+
+  /**
+   * @brief calculate signed arc length between the projections of two points
+   */
+  double calcSignedArcLength(
+    const geometry_msgs::msg::Point & src_point, const geometry_msgs::msg::Point & dst_point) const;
+
+  /**
+   * @brief calculate lateral offset of the given point from the given segment.
+   * The offset is positive on the left side of the trajectory.
+   */
+  double calcLateralOffset(const geometry_msgs::msg::Point & point, const size_t seg_idx) const;
+
+  /**
+   * @brief calculate lateral offset of the given point from the nearest segment.
+   */
+  double calcLateralOffset(
+    const geometry_msgs::msg::Point & point,
+    const std::optional<size_t> hint_idx = std::nullopt) const;
+
+private:
+  // axis aligned bounding box of the points in [begin, end)
+  struct Node
+  {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+    size_t begin;
+    size_t end;
+    size_t left;   // index of the left child node. leaf if left == 0
+    size_t right;  // index of the right child node
+  };
+
+  template <class T>
+  static std::vector<geometry_msgs::msg::Pose> extractPoses(const T & points)
+  {
+    std::vector<geometry_msgs::msg::Pose> poses;
+    poses.reserve(points.size());
+    for (const auto & p : points) {
+      poses.push_back(autoware::universe_utils::getPose(p));
+    }
+    return poses;
+  }
+
+  size_t buildTree(const size_t begin, const size_t end);
+  void searchNearest(
+    const double x, const double y, const size_t node_idx, const double max_squared_dist,
+    const geometry_msgs::msg::Pose * pose, const double max_yaw, double & min_squared_dist,
+    std::optional<size_t> & min_idx) const;
+  size_t toSegmentIndex(const size_t nearest_idx, const geometry_msgs::msg::Point & point) const;
+  size_t segmentEndIndex(const size_t seg_idx) const;
+
+  std::vector<geometry_msgs::msg::Pose> poses_;
+  std::vector<double> arc_lengths_;
+  // index of the next point which does not overlap with the point
+  std::vector<size_t> next_distinct_indices_;
+  std::vector<Node> nodes_;
+};
+}  // namespace autoware::motion_utils
+
+#endif  // AUTOWARE__MOTION_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
@@ -0,0 +1,372 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/trajectory/trajectory_index.hpp"
+
+#include "autoware/universe_utils/geometry/pose_deviation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace autoware::motion_utils
+{
+namespace
+{
+// max number of points in a leaf of the bounding volume hierarchy
+constexpr size_t max_leaf_size = 16;
+// number of points scanned around the hint index to get an initial search bound
+constexpr size_t hint_window = 8;
+// same threshold as removeOverlapPoints()
+constexpr double overlap_eps = 1.0E-08;
+
+double calcSquaredDistanceToBox(
+  const double x, const double y, const double min_x, const double min_y, const double max_x,
+  const double max_y)
+{
+  const double dx = std::max({min_x - x, 0.0, x - max_x});
+  const double dy = std::max({min_y - y, 0.0, y - max_y});
+  return dx * dx + dy * dy;
+}
+
+double calcSquaredDistance2d(const geometry_msgs::msg::Pose & pose, const double x, const double y)
+{
+  const double dx = pose.position.x - x;
+  const double dy = pose.position.y - y;
+  return dx * dx + dy * dy;
+}
+
+void validateNonEmpty(const std::vector<geometry_msgs::msg::Pose> & poses)
+{
+  if (poses.empty()) {
+    throw std::invalid_argument("[autoware_motion_utils] TrajectoryIndex: Points is empty.");
+  }
+}
+}  // namespace
+
+TrajectoryIndex::TrajectoryIndex(std::vector<geometry_msgs::msg::Pose> poses)
+: poses_(std::move(poses))
+{
+  const size_t n = poses_.size();
+
+  arc_lengths_.resize(n, 0.0);
+  for (size_t i = 1; i < n; ++i) {
+    arc_lengths_.at(i) = arc_lengths_.at(i - 1) +
+                         autoware::universe_utils::calcDistance2d(poses_.at(i - 1), poses_.at(i));
+  }
+
+  next_distinct_indices_.resize(n, n);
+  for (size_t i = n; i-- > 1;) {
+    const auto & curr = poses_.at(i - 1).position;
+    const auto & next = poses_.at(i).position;
+    const bool is_overlapped =
+      std::abs(curr.x - next.x) < overlap_eps && std::abs(curr.y - next.y) < overlap_eps;
+    next_distinct_indices_.at(i - 1) = is_overlapped ? next_distinct_indices_.at(i) : i;
+  }
+
+  if (n != 0) {
+    nodes_.reserve(2 * (n / max_leaf_size + 1));
+    buildTree(0, n);
+  }
+}
+
+size_t TrajectoryIndex::buildTree(const size_t begin, const size_t end)
+{
+  const size_t node_idx = nodes_.size();
+  nodes_.push_back(Node{
+    std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), begin, end, 0,
+    0});
+
+  // NOTE: trajectory points are spatially coherent along the index, so splitting the index range
+  // at its middle gives tight boxes without sorting the points.
+  if (end - begin > max_leaf_size) {
+    const size_t mid = begin + (end - begin) / 2;
+    const size_t left = buildTree(begin, mid);
+    const size_t right = buildTree(mid, end);
+    auto & node = nodes_.at(node_idx);
+    node.left = left;
+    node.right = right;
+    node.min_x = std::min(nodes_.at(left).min_x, nodes_.at(right).min_x);
+    node.min_y = std::min(nodes_.at(left).min_y, nodes_.at(right).min_y);
+    node.max_x = std::max(nodes_.at(left).max_x, nodes_.at(right).max_x);
+    node.max_y = std::max(nodes_.at(left).max_y, nodes_.at(right).max_y);
+    return node_idx;
+  }
+
+  auto & node = nodes_.at(node_idx);
+  for (size_t i = begin; i < end; ++i) {
+    const auto & p = poses_.at(i).position;
+    node.min_x = std::min(node.min_x, p.x);
+    node.min_y = std::min(node.min_y, p.y);
+    node.max_x = std::max(node.max_x, p.x);
+    node.max_y = std::max(node.max_y, p.y);
+  }
+  return node_idx;
+}
+
+void TrajectoryIndex::searchNearest(
+  const double x, const double y, const size_t node_idx, const double max_squared_dist,
+  const geometry_msgs::msg::Pose * pose, const double max_yaw, double & min_squared_dist,
+  std::optional<size_t> & min_idx) const
+{
+  const auto & node = nodes_.at(node_idx);
+  const double box_squared_dist =
+    calcSquaredDistanceToBox(x, y, node.min_x, node.min_y, node.max_x, node.max_y);
+  // NOTE: a box at the same distance may contain a smaller index which has priority.
+  if (box_squared_dist > max_squared_dist || box_squared_dist > min_squared_dist) {
+    return;
+  }
+  if (node.left != 0) {
+    // visit the closer child first to shrink the bound early
+    const auto & left = nodes_.at(node.left);
+    const auto & right = nodes_.at(node.right);
+    const double left_dist =
+      calcSquaredDistanceToBox(x, y, left.min_x, left.min_y, left.max_x, left.max_y);
+    const double right_dist =
+      calcSquaredDistanceToBox(x, y, right.min_x, right.min_y, right.max_x, right.max_y);
+    const auto [first, second] = left_dist <= right_dist ? std::make_pair(node.left, node.right)
+                                                         : std::make_pair(node.right, node.left);
+    searchNearest(x, y, first, max_squared_dist, pose, max_yaw, min_squared_dist, min_idx);
+    searchNearest(x, y, second, max_squared_dist, pose, max_yaw, min_squared_dist, min_idx);
+    return;
+  }
+
+  for (size_t i = node.begin; i < node.end; ++i) {
+    const double squared_dist = calcSquaredDistance2d(poses_.at(i), x, y);
+    if (squared_dist > max_squared_dist || squared_dist > min_squared_dist) {
+      continue;
+    }
+    if (squared_dist == min_squared_dist && min_idx && *min_idx < i) {
+      continue;
+    }
+    if (pose) {
+      const double yaw = autoware::universe_utils::calcYawDeviation(poses_.at(i), *pose);
+      if (std::fabs(yaw) > max_yaw) {
+        continue;
+      }
+    }
+    min_squared_dist = squared_dist;
+    min_idx = i;
+  }
+}
+
+size_t TrajectoryIndex::findNearestIndex(
+  const geometry_msgs::msg::Point & point, const std::optional<size_t> hint_idx) const
+{
+  validateNonEmpty(poses_);
+
+  double min_squared_dist = std::numeric_limits<double>::max();
+  std::optional<size_t> min_idx = std::nullopt;
+
+  // the points around the hint give a tight initial bound for the tree search
+  if (hint_idx) {
+    const size_t center = std::min(*hint_idx, poses_.size() - 1);
+    const size_t begin = center > hint_window ? center - hint_window : 0;
+    const size_t end = std::min(center + hint_window + 1, poses_.size());
+    for (size_t i = begin; i < end; ++i) {
+      const double squared_dist = calcSquaredDistance2d(poses_.at(i), point.x, point.y);
+      if (squared_dist < min_squared_dist) {
+        min_squared_dist = squared_dist;
+        min_idx = i;
+      }
+    }
+  }
+
+  searchNearest(
+    point.x, point.y, 0, std::numeric_limits<double>::infinity(), nullptr, 0.0, min_squared_dist,
+    min_idx);
+
+  return min_idx ? *min_idx : 0;
+}
+
+std::optional<size_t> TrajectoryIndex::findNearestIndex(
+  const geometry_msgs::msg::Pose & pose, const double max_dist, const double max_yaw,
+  const std::optional<size_t> hint_idx) const
+{
+  if (poses_.empty()) {
+    return std::nullopt;
+  }
+
+  const double max_squared_dist = max_dist * max_dist;
+
+  double min_squared_dist = std::numeric_limits<double>::max();
+  std::optional<size_t> min_idx = std::nullopt;
+
+  if (hint_idx) {
+    const size_t center = std::min(*hint_idx, poses_.size() - 1);
+    const size_t begin = center > hint_window ? center - hint_window : 0;
+    const size_t end = std::min(center + hint_window + 1, poses_.size());
+    for (size_t i = begin; i < end; ++i) {
+      const double squared_dist =
+        calcSquaredDistance2d(poses_.at(i), pose.position.x, pose.position.y);
+      if (squared_dist > max_squared_dist || squared_dist >= min_squared_dist) {
+        continue;
+      }
+      const double yaw = autoware::universe_utils::calcYawDeviation(poses_.at(i), pose);
+      if (std::fabs(yaw) > max_yaw) {
+        continue;
+      }
+      min_squared_dist = squared_dist;
+      min_idx = i;
+    }
+  }
+
+  searchNearest(
+    pose.position.x, pose.position.y, 0, max_squared_dist, &pose, max_yaw, min_squared_dist,
+    min_idx);
+
+  return min_idx;
+}
+
+size_t TrajectoryIndex::toSegmentIndex(
+  const size_t nearest_idx, const geometry_msgs::msg::Point & point) const
+{
+  if (nearest_idx == 0) {
+    return 0;
+  }
+  if (nearest_idx == poses_.size() - 1) {
+    return poses_.size() - 2;
+  }
+
+  const double signed_length = calcLongitudinalOffsetToSegment(nearest_idx, point);
+  if (signed_length <= 0) {
+    return nearest_idx - 1;
+  }
+  return nearest_idx;
+}
+
+size_t TrajectoryIndex::findNearestSegmentIndex(
+  const geometry_msgs::msg::Point & point, const std::optional<size_t> hint_idx) const
+{
+  const size_t nearest_idx = findNearestIndex(point, hint_idx);
+  return toSegmentIndex(nearest_idx, point);
+}
+
+std::optional<size_t> TrajectoryIndex::findNearestSegmentIndex(
+  const geometry_msgs::msg::Pose & pose, const double max_dist, const double max_yaw,
+  const std::optional<size_t> hint_idx) const
+{
+  const auto nearest_idx = findNearestIndex(pose, max_dist, max_yaw, hint_idx);
+  if (!nearest_idx) {
+    return std::nullopt;
+  }
+  return toSegmentIndex(*nearest_idx, pose.position);
+}
+
+size_t TrajectoryIndex::findSegmentIndexFromArcLength(const double arc_length) const
+{
+  validateNonEmpty(poses_);
+  if (poses_.size() < 2) {
+    return 0;
+  }
+
+  const auto itr = std::upper_bound(arc_lengths_.begin(), arc_lengths_.end(), arc_length);
+  const size_t idx = static_cast<size_t>(std::distance(arc_lengths_.begin(), itr));
+  return std::clamp(idx, static_cast<size_t>(1), poses_.size() - 1) - 1;
+}
+
+size_t TrajectoryIndex::segmentEndIndex(const size_t seg_idx) const
+{
+  return next_distinct_indices_.at(seg_idx);
+}
+
+double TrajectoryIndex::calcLongitudinalOffsetToSegment(
+  const size_t seg_idx, const geometry_msgs::msg::Point & point) const
+{
+  if (poses_.empty() || seg_idx >= poses_.size() - 1) {
+    return std::nan("");
+  }
+
+  const size_t end_idx = segmentEndIndex(seg_idx);
+  if (end_idx >= poses_.size()) {
+    return std::nan("");
+  }
+
+  const auto & p_front = poses_.at(seg_idx).position;
+  const auto & p_back = poses_.at(end_idx).position;
+
+  const double segment_x = p_back.x - p_front.x;
+  const double segment_y = p_back.y - p_front.y;
+  const double target_x = point.x - p_front.x;
+  const double target_y = point.y - p_front.y;
+
+  return (segment_x * target_x + segment_y * target_y) / std::hypot(segment_x, segment_y);
+}
+
+double TrajectoryIndex::calcArcLength(
+  const geometry_msgs::msg::Point & point, const std::optional<size_t> hint_idx) const
+{
+  if (poses_.empty()) {
+    return 0.0;
+  }
+
+  const size_t seg_idx = findNearestSegmentIndex(point, hint_idx);
+  return arc_lengths_.at(seg_idx) + calcLongitudinalOffsetToSegment(seg_idx, point);
+}
+
+double TrajectoryIndex::calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const
+{
+  if (poses_.empty()) {
+    return 0.0;
+  }
+  return arc_lengths_.at(dst_idx) - arc_lengths_.at(src_idx);
+}
+
+double TrajectoryIndex::calcSignedArcLength(
+  const geometry_msgs::msg::Point & src_point, const geometry_msgs::msg::Point & dst_point) const
+{
+  if (poses_.empty()) {
+    return 0.0;
+  }
+  return calcArcLength(dst_point) - calcArcLength(src_point);
+}
+
+double TrajectoryIndex::calcLateralOffset(
+  const geometry_msgs::msg::Point & point, const size_t seg_idx) const
+{
+  if (poses_.empty()) {
+    return std::nan("");
+  }
+
+  // use the last non-degenerated segment if the given one has no length
+  size_t front_idx = std::min(seg_idx, poses_.size() - 1);
+  while (front_idx < poses_.size() && segmentEndIndex(front_idx) >= poses_.size()) {
+    if (front_idx == 0) {
+      return std::nan("");
+    }
+    --front_idx;
+  }
+
+  const auto & p_front = poses_.at(front_idx).position;
+  const auto & p_back = poses_.at(segmentEndIndex(front_idx)).position;
+
+  const double segment_x = p_back.x - p_front.x;
+  const double segment_y = p_back.y - p_front.y;
+  const double target_x = point.x - p_front.x;
+  const double target_y = point.y - p_front.y;
+
+  return (segment_x * target_y - segment_y * target_x) / std::hypot(segment_x, segment_y);
+}
+
+double TrajectoryIndex::calcLateralOffset(
+  const geometry_msgs::msg::Point & point, const std::optional<size_t> hint_idx) const
+{
+  if (poses_.empty()) {
+    return std::nan("");
+  }
+  return calcLateralOffset(point, findNearestSegmentIndex(point, hint_idx));
+}
+}  // namespace autoware::motion_utils
@@ -0,0 +1,132 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+#include "autoware/motion_utils/trajectory/trajectory_index.hpp"
+#include "autoware/universe_utils/system/stop_watch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+using autoware::universe_utils::createPoint;
+using autoware::universe_utils::createQuaternionFromRPY;
+using autoware_planning_msgs::msg::Trajectory;
+
+geometry_msgs::msg::Pose createPose(
+  double x, double y, double z, double roll, double pitch, double yaw)
+{
+  geometry_msgs::msg::Pose p;
+  p.position = createPoint(x, y, z);
+  p.orientation = createQuaternionFromRPY(roll, pitch, yaw);
+  return p;
+}
+
+template <class T>
+T generateTestTrajectory(
+  const size_t num_points, const double point_interval, const double vel = 0.0,
+  const double init_theta = 0.0, const double delta_theta = 0.0)
+{
+  using Point = typename T::_points_type::value_type;
+
+  T traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = init_theta + i * delta_theta;
+    const double x = i * point_interval * std::cos(theta);
+    const double y = i * point_interval * std::sin(theta);
+
+    Point p;
+    p.pose = createPose(x, y, 0.0, 0.0, 0.0, theta);
+    p.longitudinal_velocity_mps = vel;
+    traj.points.push_back(p);
+  }
+
+  return traj;
+}
+}  // namespace
+
+TEST(trajectory_benchmark, DISABLED_TrajectoryIndex)
+{
+  using autoware::motion_utils::calcLateralOffset;
+  using autoware::motion_utils::findNearestIndex;
+  using autoware::motion_utils::findNearestSegmentIndex;
+  using autoware::motion_utils::TrajectoryIndex;
+
+  std::default_random_engine engine(0);
+  std::normal_distribution<double> offset_dist(0.0, 2.0);
+
+  autoware::universe_utils::StopWatch<std::chrono::nanoseconds, std::chrono::nanoseconds> sw;
+  constexpr auto nb_queries = 10000;
+  for (const size_t nb_points : {100UL, 1000UL, 5000UL}) {
+    const auto traj = generateTestTrajectory<Trajectory>(nb_points, 0.5, 0.0, 0.0, 0.002);
+
+    // query points close to the trajectory as the planning modules do
+    std::vector<geometry_msgs::msg::Point> points;
+    std::uniform_int_distribution<size_t> idx_dist(0, nb_points - 1);
+    for (auto i = 0; i < nb_queries; ++i) {
+      const auto & p = traj.points.at(idx_dist(engine)).pose.position;
+      points.push_back(createPoint(p.x + offset_dist(engine), p.y + offset_dist(engine), 0.0));
+    }
+
+    sw.tic();
+    const TrajectoryIndex index(traj.points);
+    const double build_ns = sw.toc();
+
+    double free_nearest_ns = 0.0;
+    double index_nearest_ns = 0.0;
+    double free_segment_ns = 0.0;
+    double index_segment_ns = 0.0;
+    double free_lateral_ns = 0.0;
+    double index_lateral_ns = 0.0;
+    for (const auto & point : points) {
+      sw.tic();
+      const auto free_idx = findNearestIndex(traj.points, point);
+      free_nearest_ns += sw.toc();
+      sw.tic();
+      const auto index_idx = index.findNearestIndex(point);
+      index_nearest_ns += sw.toc();
+      EXPECT_EQ(free_idx, index_idx);
+
+      sw.tic();
+      findNearestSegmentIndex(traj.points, point);
+      free_segment_ns += sw.toc();
+      sw.tic();
+      index.findNearestSegmentIndex(point);
+      index_segment_ns += sw.toc();
+
+      sw.tic();
+      calcLateralOffset(traj.points, point);
+      free_lateral_ns += sw.toc();
+      sw.tic();
+      index.calcLateralOffset(point);
+      index_lateral_ns += sw.toc();
+    }
+
+    std::printf(
+      "points = %ld, queries = %d, build = %2.3f ms\n", nb_points, nb_queries, build_ns / 1e6);
+    std::printf(
+      "\tfindNearestIndex:\n\t\tfree function = %2.2f ms\n\t\tTrajectoryIndex = %2.2f ms\n",
+      free_nearest_ns / 1e6, index_nearest_ns / 1e6);
+    std::printf(
+      "\tfindNearestSegmentIndex:\n\t\tfree function = %2.2f ms\n\t\tTrajectoryIndex = %2.2f ms\n",
+      free_segment_ns / 1e6, index_segment_ns / 1e6);
+    std::printf(
+      "\tcalcLateralOffset:\n\t\tfree function = %2.2f ms\n\t\tTrajectoryIndex = %2.2f ms\n",
+      free_lateral_ns / 1e6, index_lateral_ns / 1e6);
+  }
+}
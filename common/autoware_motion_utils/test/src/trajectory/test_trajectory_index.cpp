@@ -0,0 +1,142 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+#include "autoware/motion_utils/trajectory/trajectory_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+using autoware::motion_utils::TrajectoryIndex;
+using autoware::universe_utils::createPoint;
+using autoware::universe_utils::createQuaternionFromRPY;
+using autoware_planning_msgs::msg::Trajectory;
+
+constexpr double epsilon = 1e-6;
+
+geometry_msgs::msg::Pose createPose(
+  double x, double y, double z, double roll, double pitch, double yaw)
+{
+  geometry_msgs::msg::Pose p;
+  p.position = createPoint(x, y, z);
+  p.orientation = createQuaternionFromRPY(roll, pitch, yaw);
+  return p;
+}
+
+template <class T>
+T generateTestTrajectory(
+  const size_t num_points, const double point_interval, const double vel = 0.0,
+  const double init_theta = 0.0, const double delta_theta = 0.0)
+{
+  using Point = typename T::_points_type::value_type;
+
+  T traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = init_theta + i * delta_theta;
+    const double x = i * point_interval * std::cos(theta);
+    const double y = i * point_interval * std::sin(theta);
+
+    Point p;
+    p.pose = createPose(x, y, 0.0, 0.0, 0.0, theta);
+    p.longitudinal_velocity_mps = vel;
+    traj.points.push_back(p);
+  }
+
+  return traj;
+}
+}  // namespace
+
+TEST(trajectory_index, EmptyTrajectory)
+{
+  const TrajectoryIndex index(std::vector<autoware_planning_msgs::msg::TrajectoryPoint>{});
+
+  EXPECT_TRUE(index.empty());
+  EXPECT_DOUBLE_EQ(index.length(), 0.0);
+  EXPECT_THROW(index.findNearestIndex(createPoint(0.0, 0.0, 0.0)), std::invalid_argument);
+  EXPECT_FALSE(index.findNearestIndex(createPose(0.0, 0.0, 0.0, 0.0, 0.0, 0.0)));
+}
+
+TEST(trajectory_index, ArcLength)
+{
+  const auto traj = generateTestTrajectory<Trajectory>(10, 1.0);
+  const TrajectoryIndex index(traj.points);
+
+  EXPECT_EQ(index.size(), 10U);
+  EXPECT_NEAR(index.length(), 9.0, epsilon);
+  EXPECT_NEAR(index.arcLength(3), 3.0, epsilon);
+  EXPECT_NEAR(index.calcSignedArcLength(7, 2), -5.0, epsilon);
+  EXPECT_NEAR(index.calcArcLength(createPoint(3.5, 1.0, 0.0)), 3.5, epsilon);
+  EXPECT_NEAR(
+    index.calcSignedArcLength(createPoint(5.5, 1.0, 0.0), createPoint(1.2, -1.0, 0.0)), -4.3,
+    epsilon);
+
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(-1.0), 0U);
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(0.0), 0U);
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(3.5), 3U);
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(9.0), 8U);
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(100.0), 8U);
+}
+
+TEST(trajectory_index, LateralOffset)
+{
+  const auto traj = generateTestTrajectory<Trajectory>(10, 1.0);
+  const TrajectoryIndex index(traj.points);
+
+  EXPECT_NEAR(index.calcLateralOffset(createPoint(3.5, 1.0, 0.0)), 1.0, epsilon);
+  EXPECT_NEAR(index.calcLateralOffset(createPoint(3.5, -2.0, 0.0)), -2.0, epsilon);
+  EXPECT_NEAR(index.calcLateralOffset(createPoint(20.0, 0.5, 0.0)), 0.5, epsilon);
+}
+
+TEST(trajectory_index, CompareWithFreeFunctions)
+{
+  using autoware::motion_utils::calcLateralOffset;
+  using autoware::motion_utils::calcSignedArcLength;
+  using autoware::motion_utils::findNearestIndex;
+  using autoware::motion_utils::findNearestSegmentIndex;
+
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> position_dist(-50.0, 150.0);
+  std::uniform_real_distribution<double> yaw_dist(-M_PI, M_PI);
+
+  const auto traj = generateTestTrajectory<Trajectory>(1000, 0.2, 0.0, 0.0, 0.005);
+  const TrajectoryIndex index(traj.points);
+
+  size_t prev_idx = 0;
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto point = createPoint(position_dist(engine), position_dist(engine), 0.0);
+    const auto pose = createPose(point.x, point.y, 0.0, 0.0, 0.0, yaw_dist(engine));
+
+    const auto nearest_idx = findNearestIndex(traj.points, point);
+    EXPECT_EQ(index.findNearestIndex(point), nearest_idx);
+    EXPECT_EQ(index.findNearestIndex(point, prev_idx), nearest_idx);
+    prev_idx = nearest_idx;
+
+    EXPECT_EQ(index.findNearestSegmentIndex(point), findNearestSegmentIndex(traj.points, point));
+    EXPECT_EQ(
+      index.findNearestIndex(pose, 30.0, M_PI_4),
+      findNearestIndex(traj.points, pose, 30.0, M_PI_4));
+    EXPECT_EQ(
+      index.findNearestSegmentIndex(pose, 30.0, M_PI_4),
+      findNearestSegmentIndex(traj.points, pose, 30.0, M_PI_4));
+
+    EXPECT_NEAR(
+      index.calcSignedArcLength(createPoint(0.0, 0.0, 0.0), point),
+      calcSignedArcLength(traj.points, createPoint(0.0, 0.0, 0.0), point), epsilon);
+    EXPECT_NEAR(index.calcLateralOffset(point), calcLateralOffset(traj.points, point), epsilon);
+  }
+}
@@ -0,0 +1,168 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__UNIVERSE_UTILS__GEOMETRY__BATCH_COLLISION_CHECKER_HPP_
+#define AUTOWARE__UNIVERSE_UTILS__GEOMETRY__BATCH_COLLISION_CHECKER_HPP_
+
+#include "autoware/universe_utils/geometry/boost_geometry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace autoware::universe_utils
+{
+/**
+ * @brief Polygon with its envelope and the projections onto its edge normals computed once
+ * @details the coordinates are stored in contiguous arrays so that the projection loops can be
+ * vectorized by the compiler
+ */
+struct PreparedPolygon
+{
+  explicit PreparedPolygon(const Polygon2d & input_polygon);
+  explicit PreparedPolygon(const LinearRing2d & ring);
+
+  Polygon2d polygon;
+  Box2d envelope;
+  // vertices without the repeated ones and the closing point
+  std::vector<double> xs;
+  std::vector<double> ys;
+  // unit edge normals pointing to the outside and the projection of the polygon onto them
+  std::vector<double> normal_xs;
+  std::vector<double> normal_ys;
+  std::vector<double> projection_mins;
+  std::vector<double> projection_maxs;
+  // true if the polygon is convex with a positive area and without holes
+  bool is_convex{false};
+};
+
+/**
+ * @brief Check if 2 polygons are separated by their envelopes or by one of their edge normals
+ * @details the polygons do not need to be convex. The separation has to be larger than a small
+ * margin so that the result never contradicts boost::geometry::intersects(), which treats touching
+ * polygons as intersecting, despite the rounding errors.
+ */
+bool isSeparated(const PreparedPolygon & polygon1, const PreparedPolygon & polygon2);
+
+/**
+ * @brief Points binned into a 2D grid to look up the points around a box
+ */
+class PointGrid2d
+{
+public:
+  PointGrid2d(const std::vector<Point2d> & points, const double cell_size);
+
+  bool empty() const { return points_.empty(); }
+  const Point2d & getPoint(const size_t idx) const { return points_.at(idx); }
+
+  /**
+   * @brief Visit the points in the cells overlapping the box until the visitor returns true
+   * @param box box to look up
+   * @param visitor function called with the index of the point in the input points
+   * @return true if the visitor returned true for a point
+   */
+  template <class Visitor>
+  bool visitPointsInBox(const Box2d & box, Visitor && visitor) const
+  {
+    if (empty()) {
+      return false;
+    }
+    const int64_t min_ix = std::max(toCellIndex(box.min_corner().x()), min_ix_);
+    const int64_t max_ix = std::min(toCellIndex(box.max_corner().x()), max_ix_);
+    const int64_t min_iy = toCellIndex(box.min_corner().y());
+    const int64_t max_iy = toCellIndex(box.max_corner().y());
+    for (int64_t ix = min_ix; ix <= max_ix; ++ix) {
+      auto itr = std::lower_bound(
+        cells_.begin(), cells_.end(), std::make_pair(std::make_pair(ix, min_iy), size_t{0}));
+      for (; itr != cells_.end() && itr->first.first == ix && itr->first.second <= max_iy;
+           ++itr) {
+        if (visitor(itr->second)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  int64_t toCellIndex(const double value) const
+  {
+    return static_cast<int64_t>(std::floor(value / cell_size_));
+  }
+
+  double cell_size_;
+  std::vector<Point2d> points_;
+  // (cell index, point index) sorted by the cell index
+  std::vector<std::pair<std::pair<int64_t, int64_t>, size_t>> cells_;
+  int64_t min_ix_{0};
+  int64_t max_ix_{0};
+};
+
+/**
+ * @brief Collision checker between a sequence of polygons, e.g. the footprints swept by the ego
+ * along its trajectory, and obstacles given as polygons or points
+ * @details the polygons are prepared once and each obstacle is rejected by the envelopes and the
+ * separating axes before falling back to boost::geometry, so the results are the same as the
+ * ones of boost::geometry::intersects() and boost::geometry::within().
+ */
+class BatchCollisionChecker
+{
+public:
+  explicit BatchCollisionChecker(const std::vector<Polygon2d> & polygons);
+  explicit BatchCollisionChecker(const std::vector<LinearRing2d> & rings);
+
+  size_t size() const { return polygons_.size(); }
+  const PreparedPolygon & getPolygon(const size_t idx) const { return polygons_.at(idx); }
+
+  /**
+   * @brief Check if the polygon intersects the polygon at the index
+   * @details same result as boost::geometry::intersects()
+   */
+  bool intersects(const size_t idx, const PreparedPolygon & polygon) const;
+
+  /**
+   * @brief Check if the point is inside the polygon at the index, excluding its boundary
+   * @details same result as boost::geometry::within()
+   */
+  bool isWithin(const size_t idx, const Point2d & point) const;
+
+  /**
+   * @brief Find the first polygon intersecting the given polygon
+   * @param polygon obstacle polygon
+   * @param start_idx index of the polygon to start the search from
+   * @return index of the first intersecting polygon, std::nullopt if none intersects
+   */
+  std::optional<size_t> findFirstIntersection(
+    const PreparedPolygon & polygon, const size_t start_idx = 0) const;
+
+  /**
+   * @brief Find the first polygon containing one of the points
+   * @param point_grid obstacle points
+   * @param start_idx index of the polygon to start the search from
+   * @return index of the first polygon containing points and the smallest index of the points
+   * contained in it, std::nullopt if no polygon contains the points
+   */
+  std::optional<std::pair<size_t, size_t>> findFirstPointWithin(
+    const PointGrid2d & point_grid, const size_t start_idx = 0) const;
+
+private:
+  std::vector<PreparedPolygon> polygons_;
+};
+
+}  // namespace autoware::universe_utils
+
+#endif  // AUTOWARE__UNIVERSE_UTILS__GEOMETRY__BATCH_COLLISION_CHECKER_HPP_
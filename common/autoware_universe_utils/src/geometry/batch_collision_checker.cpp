@@ -0,0 +1,245 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/universe_utils/geometry/batch_collision_checker.hpp"
+
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <limits>
+
+namespace autoware::universe_utils
+{
+namespace
+{
+// distance under which the fast checks are not trusted and boost::geometry decides
+constexpr double margin = 1e-6;
+
+/// @brief project the vertices onto the axis and return the minimum and maximum values
+std::pair<double, double> projectVertices(
+  const PreparedPolygon & polygon, const double axis_x, const double axis_y)
+{
+  double min = std::numeric_limits<double>::max();
+  double max = std::numeric_limits<double>::lowest();
+  for (size_t i = 0; i < polygon.xs.size(); ++i) {
+    const double projection = axis_x * polygon.xs[i] + axis_y * polygon.ys[i];
+    min = std::min(min, projection);
+    max = std::max(max, projection);
+  }
+  return {min, max};
+}
+
+/// @brief check if the other polygon is separated from the polygon along one of its edge normals
+bool hasSeparatingAxis(const PreparedPolygon & polygon, const PreparedPolygon & other)
+{
+  for (size_t i = 0; i < polygon.normal_xs.size(); ++i) {
+    const auto [min, max] = projectVertices(other, polygon.normal_xs[i], polygon.normal_ys[i]);
+    if (max < polygon.projection_mins[i] - margin || polygon.projection_maxs[i] + margin < min) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+PreparedPolygon::PreparedPolygon(const LinearRing2d & ring) : PreparedPolygon(Polygon2d{ring})
+{
+}
+
+PreparedPolygon::PreparedPolygon(const Polygon2d & input_polygon) : polygon(input_polygon)
+{
+  // vertices without the repeated ones and the closing point
+  for (const auto & point : polygon.outer()) {
+    if (!xs.empty() && xs.back() == point.x() && ys.back() == point.y()) {
+      continue;
+    }
+    xs.push_back(point.x());
+    ys.push_back(point.y());
+  }
+  if (xs.size() > 1 && xs.front() == xs.back() && ys.front() == ys.back()) {
+    xs.pop_back();
+    ys.pop_back();
+  }
+  if (xs.empty()) {
+    return;
+  }
+  const size_t vertex_num = xs.size();
+
+  const auto [min_x, max_x] = std::minmax_element(xs.begin(), xs.end());
+  const auto [min_y, max_y] = std::minmax_element(ys.begin(), ys.end());
+  envelope = Box2d{Point2d{*min_x, *min_y}, Point2d{*max_x, *max_y}};
+
+  // the orientation of the ring decides which side of the edges is outside
+  double signed_area = 0.0;
+  for (size_t i = 1; i + 1 < vertex_num; ++i) {
+    signed_area += (xs[i] - xs[0]) * (ys[i + 1] - ys[0]) - (xs[i + 1] - xs[0]) * (ys[i] - ys[0]);
+  }
+  const double sign = signed_area > 0.0 ? 1.0 : -1.0;
+
+  bool has_same_turns = true;
+  double total_turn = 0.0;
+  for (size_t i = 0; i < vertex_num; ++i) {
+    const size_t next_i = (i + 1) % vertex_num;
+    const size_t next_next_i = (i + 2) % vertex_num;
+    const double dx = xs[next_i] - xs[i];
+    const double dy = ys[next_i] - ys[i];
+    const double length = std::hypot(dx, dy);
+    if (length == 0.0) {
+      continue;
+    }
+    // outside is on the right of the edges in a counter-clockwise ring
+    normal_xs.push_back(sign * dy / length);
+    normal_ys.push_back(-sign * dx / length);
+    const auto [min, max] = projectVertices(*this, normal_xs.back(), normal_ys.back());
+    projection_mins.push_back(min);
+    projection_maxs.push_back(max);
+
+    // a convex ring turns to the same side and only once around
+    const double next_dx = xs[next_next_i] - xs[next_i];
+    const double next_dy = ys[next_next_i] - ys[next_i];
+    const double cross = dx * next_dy - dy * next_dx;
+    const double dot = dx * next_dx + dy * next_dy;
+    has_same_turns &= sign * cross > 0.0 || (cross == 0.0 && dot > 0.0);
+    total_turn += std::atan2(sign * cross, dot);
+  }
+  is_convex = has_same_turns && std::abs(total_turn - 2.0 * M_PI) < 1e-6 &&
+              std::abs(signed_area) > margin && polygon.inners().empty();
+}
+
+bool isSeparated(const PreparedPolygon & polygon1, const PreparedPolygon & polygon2)
+{
+  if (polygon1.xs.empty() || polygon2.xs.empty()) {
+    return false;
+  }
+  const auto & box1 = polygon1.envelope;
+  const auto & box2 = polygon2.envelope;
+  if (
+    box1.max_corner().x() + margin < box2.min_corner().x() ||
+    box2.max_corner().x() + margin < box1.min_corner().x() ||
+    box1.max_corner().y() + margin < box2.min_corner().y() ||
+    box2.max_corner().y() + margin < box1.min_corner().y()) {
+    return true;
+  }
+  return hasSeparatingAxis(polygon1, polygon2) || hasSeparatingAxis(polygon2, polygon1);
+}
+
+PointGrid2d::PointGrid2d(const std::vector<Point2d> & points, const double cell_size)
+: cell_size_(cell_size), points_(points)
+{
+  cells_.reserve(points_.size());
+  for (size_t i = 0; i < points_.size(); ++i) {
+    const auto & p = points_[i];
+    if (!std::isfinite(p.x()) || !std::isfinite(p.y())) {
+      continue;
+    }
+    cells_.emplace_back(std::make_pair(toCellIndex(p.x()), toCellIndex(p.y())), i);
+  }
+  std::sort(cells_.begin(), cells_.end());
+  if (!cells_.empty()) {
+    min_ix_ = cells_.front().first.first;
+    max_ix_ = cells_.back().first.first;
+  }
+}
+
+BatchCollisionChecker::BatchCollisionChecker(const std::vector<Polygon2d> & polygons)
+{
+  polygons_.reserve(polygons.size());
+  for (const auto & polygon : polygons) {
+    polygons_.emplace_back(polygon);
+  }
+}
+
+BatchCollisionChecker::BatchCollisionChecker(const std::vector<LinearRing2d> & rings)
+{
+  polygons_.reserve(rings.size());
+  for (const auto & ring : rings) {
+    polygons_.emplace_back(ring);
+  }
+}
+
+bool BatchCollisionChecker::intersects(const size_t idx, const PreparedPolygon & polygon) const
+{
+  const auto & prepared_polygon = polygons_.at(idx);
+  if (isSeparated(prepared_polygon, polygon)) {
+    return false;
+  }
+  return boost::geometry::intersects(prepared_polygon.polygon, polygon.polygon);
+}
+
+bool BatchCollisionChecker::isWithin(const size_t idx, const Point2d & point) const
+{
+  const auto & polygon = polygons_.at(idx);
+  if (polygon.xs.empty()) {
+    return boost::geometry::within(point, polygon.polygon);
+  }
+  const auto & box = polygon.envelope;
+  if (
+    point.x() < box.min_corner().x() || box.max_corner().x() < point.x() ||
+    point.y() < box.min_corner().y() || box.max_corner().y() < point.y()) {
+    return false;
+  }
+  if (polygon.is_convex) {
+    // signed distance from the edges, which is positive inside
+    double min_distance = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < polygon.normal_xs.size(); ++i) {
+      const double distance = polygon.projection_maxs[i] -
+                              (polygon.normal_xs[i] * point.x() + polygon.normal_ys[i] * point.y());
+      min_distance = std::min(min_distance, distance);
+    }
+    if (min_distance < -margin) {
+      return false;
+    }
+    if (margin < min_distance) {
+      return true;
+    }
+  }
+  return boost::geometry::within(point, polygon.polygon);
+}
+
+std::optional<size_t> BatchCollisionChecker::findFirstIntersection(
+  const PreparedPolygon & polygon, const size_t start_idx) const
+{
+  for (size_t i = start_idx; i < polygons_.size(); ++i) {
+    if (intersects(i, polygon)) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<std::pair<size_t, size_t>> BatchCollisionChecker::findFirstPointWithin(
+  const PointGrid2d & point_grid, const size_t start_idx) const
+{
+  for (size_t i = start_idx; i < polygons_.size(); ++i) {
+    const auto & envelope = polygons_.at(i).envelope;
+    const auto is_within = [&](const size_t point_idx) {
+      return isWithin(i, point_grid.getPoint(point_idx));
+    };
+    if (polygons_.at(i).xs.empty() || !point_grid.visitPointsInBox(envelope, is_within)) {
+      continue;
+    }
+    // the points are visited in the order of the cells, so look for the first one in the input
+    size_t first_point_idx = std::numeric_limits<size_t>::max();
+    point_grid.visitPointsInBox(envelope, [&](const size_t point_idx) {
+      if (point_idx < first_point_idx && is_within(point_idx)) {
+        first_point_idx = point_idx;
+      }
+      return false;
+    });
+    return std::make_pair(i, first_point_idx);
+  }
+  return std::nullopt;
+}
+
+}  // namespace autoware::universe_utils
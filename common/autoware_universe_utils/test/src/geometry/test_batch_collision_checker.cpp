@@ -0,0 +1,283 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/universe_utils/geometry/batch_collision_checker.hpp"
+#include "autoware/universe_utils/geometry/boost_geometry.hpp"
+#include "autoware/universe_utils/geometry/random_convex_polygon.hpp"
+#include "autoware/universe_utils/system/stop_watch.hpp"
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using autoware::universe_utils::BatchCollisionChecker;
+using autoware::universe_utils::Point2d;
+using autoware::universe_utils::PointGrid2d;
+using autoware::universe_utils::Polygon2d;
+using autoware::universe_utils::PreparedPolygon;
+
+Polygon2d createRectangle(
+  const double x, const double y, const double yaw, const double length, const double width)
+{
+  Polygon2d polygon;
+  const double c = std::cos(yaw);
+  const double s = std::sin(yaw);
+  for (const auto & [lon, lat] : std::vector<std::pair<double, double>>{
+         {length / 2.0, width / 2.0},
+         {length / 2.0, -width / 2.0},
+         {-length / 2.0, -width / 2.0},
+         {-length / 2.0, width / 2.0}}) {
+    polygon.outer().emplace_back(x + c * lon - s * lat, y + s * lon + c * lat);
+  }
+  boost::geometry::correct(polygon);
+  return polygon;
+}
+
+// footprints along an arc, which are similar to the ones swept by the ego along a trajectory
+std::vector<Polygon2d> createSweptFootprints(const size_t num, const double offset)
+{
+  std::vector<Polygon2d> footprints;
+  constexpr double radius = 50.0;
+  for (size_t i = 0; i < num; ++i) {
+    const double yaw = 0.02 * static_cast<double>(i);
+    footprints.push_back(createRectangle(
+      offset + radius * std::sin(yaw), offset + radius * (1.0 - std::cos(yaw)), yaw, 5.0, 2.0));
+  }
+  return footprints;
+}
+}  // namespace
+
+TEST(batch_collision_checker, preparedPolygon)
+{
+  const auto rectangle = createRectangle(1.0, 2.0, 0.0, 4.0, 2.0);
+  const PreparedPolygon prepared_polygon(rectangle);
+  EXPECT_EQ(prepared_polygon.xs.size(), 4ul);
+  EXPECT_EQ(prepared_polygon.normal_xs.size(), 4ul);
+  EXPECT_TRUE(prepared_polygon.is_convex);
+  EXPECT_DOUBLE_EQ(prepared_polygon.envelope.min_corner().x(), -1.0);
+  EXPECT_DOUBLE_EQ(prepared_polygon.envelope.min_corner().y(), 1.0);
+  EXPECT_DOUBLE_EQ(prepared_polygon.envelope.max_corner().x(), 3.0);
+  EXPECT_DOUBLE_EQ(prepared_polygon.envelope.max_corner().y(), 3.0);
+
+  // open and counter-clockwise ring
+  Polygon2d open_polygon;
+  open_polygon.outer() = {{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}};
+  EXPECT_TRUE(PreparedPolygon(open_polygon).is_convex);
+
+  Polygon2d concave_polygon;
+  concave_polygon.outer() = {
+    {0.0, 0.0}, {0.0, 2.0}, {1.0, 1.0}, {2.0, 2.0}, {2.0, 0.0}, {0.0, 0.0}};
+  EXPECT_FALSE(PreparedPolygon(concave_polygon).is_convex);
+
+  Polygon2d degenerate_polygon;
+  degenerate_polygon.outer() = {{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}, {0.0, 0.0}};
+  EXPECT_FALSE(PreparedPolygon(degenerate_polygon).is_convex);
+
+  EXPECT_TRUE(PreparedPolygon(Polygon2d{}).xs.empty());
+}
+
+TEST(batch_collision_checker, isSeparated)
+{
+  using autoware::universe_utils::isSeparated;
+  const PreparedPolygon rectangle(createRectangle(0.0, 0.0, 0.0, 2.0, 2.0));
+  // separated by the envelopes
+  EXPECT_TRUE(isSeparated(rectangle, PreparedPolygon(createRectangle(3.0, 0.0, 0.0, 2.0, 2.0))));
+  // separated by an edge normal of the rotated rectangle only
+  EXPECT_TRUE(
+    isSeparated(rectangle, PreparedPolygon(createRectangle(2.3, 2.3, M_PI_4, 2.0, 2.0))));
+  // touching polygons are not separated
+  EXPECT_FALSE(isSeparated(rectangle, PreparedPolygon(createRectangle(2.0, 0.0, 0.0, 2.0, 2.0))));
+  EXPECT_FALSE(isSeparated(rectangle, PreparedPolygon(createRectangle(0.5, 0.5, 0.3, 2.0, 2.0))));
+}
+
+TEST(batch_collision_checker, findFirstIntersection)
+{
+  const BatchCollisionChecker checker(createSweptFootprints(100, 0.0));
+  EXPECT_EQ(checker.size(), 100ul);
+
+  // object away from the footprints
+  EXPECT_FALSE(
+    checker.findFirstIntersection(PreparedPolygon(createRectangle(0.0, 20.0, 0.0, 2.0, 2.0))));
+
+  // object on the arc
+  const double yaw = 0.02 * 50.0;
+  const PreparedPolygon object(
+    createRectangle(50.0 * std::sin(yaw), 50.0 * (1.0 - std::cos(yaw)), 0.0, 1.0, 1.0));
+  const auto first_idx = checker.findFirstIntersection(object);
+  ASSERT_TRUE(first_idx);
+  EXPECT_GT(*first_idx, 40ul);
+  EXPECT_LE(*first_idx, 50ul);
+  EXPECT_FALSE(checker.intersects(*first_idx - 1, object));
+  EXPECT_EQ(checker.findFirstIntersection(object, *first_idx + 1), *first_idx + 1);
+  EXPECT_FALSE(checker.findFirstIntersection(object, 60));
+}
+
+TEST(batch_collision_checker, findFirstPointWithin)
+{
+  std::vector<Polygon2d> polygons;
+  polygons.push_back(createRectangle(0.0, 0.0, 0.0, 2.0, 2.0));
+  polygons.push_back(createRectangle(2.0, 0.0, 0.0, 2.0, 2.0));
+  polygons.push_back(createRectangle(4.0, 0.0, 0.0, 2.0, 2.0));
+  const BatchCollisionChecker checker(polygons);
+
+  // points on the boundary are not within the polygons
+  EXPECT_FALSE(checker.isWithin(0, Point2d{1.0, 0.0}));
+  EXPECT_FALSE(checker.isWithin(0, Point2d{1.0, 1.0}));
+  EXPECT_TRUE(checker.isWithin(0, Point2d{0.999, 0.0}));
+
+  const std::vector<Point2d> points{{10.0, 0.0}, {4.5, 0.5}, {3.0, 0.5}, {2.5, -0.5}};
+  const PointGrid2d point_grid(points, 1.0);
+  const auto first_collision = checker.findFirstPointWithin(point_grid);
+  ASSERT_TRUE(first_collision);
+  // point on the boundary between the 2nd and 3rd polygons is skipped
+  EXPECT_EQ(first_collision->first, 1ul);
+  EXPECT_EQ(first_collision->second, 3ul);
+  EXPECT_EQ(checker.findFirstPointWithin(point_grid, 2)->second, 1ul);
+  EXPECT_FALSE(checker.findFirstPointWithin(PointGrid2d({}, 1.0)));
+}
+
+TEST(batch_collision_checker, compareWithBoost)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist(-100.0, 100.0);
+  constexpr size_t polygons_nb = 200;
+
+  std::vector<Polygon2d> polygons;
+  for (size_t i = 0; i < polygons_nb; ++i) {
+    auto polygon = autoware::universe_utils::random_convex_polygon(3 + i % 8, 20.0);
+    const double offset_x = dist(engine);
+    const double offset_y = dist(engine);
+    for (auto & p : polygon.outer()) {
+      p.x() += offset_x;
+      p.y() += offset_y;
+    }
+    polygons.push_back(polygon);
+  }
+  // points on the vertices are on the boundary
+  std::vector<Point2d> points;
+  for (size_t i = 0; i < 1000; ++i) {
+    points.emplace_back(dist(engine), dist(engine));
+  }
+  for (const auto & polygon : polygons) {
+    points.push_back(polygon.outer().front());
+  }
+
+  const BatchCollisionChecker checker(polygons);
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    for (size_t j = 0; j < polygons.size(); ++j) {
+      EXPECT_EQ(
+        checker.intersects(i, PreparedPolygon(polygons[j])),
+        boost::geometry::intersects(polygons[i], polygons[j]));
+    }
+    for (const auto & point : points) {
+      EXPECT_EQ(checker.isWithin(i, point), boost::geometry::within(point, polygons[i]));
+    }
+  }
+}
+
+TEST(batch_collision_checker, benchmark)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist(-10.0, 60.0);
+  autoware::universe_utils::StopWatch<std::chrono::nanoseconds, std::chrono::nanoseconds> sw;
+
+  // footprints at the map coordinates far from the origin
+  constexpr double offset = 10000.0;
+  const auto footprints = createSweptFootprints(100, offset);
+  std::vector<Polygon2d> objects;
+  for (size_t i = 0; i < 50; ++i) {
+    objects.push_back(
+      createRectangle(offset + dist(engine), offset + dist(engine), dist(engine), 4.0, 2.0));
+  }
+  // points beside the footprints and one point on the 90th footprint
+  std::vector<Point2d> points;
+  for (size_t i = 0; i < 10000; ++i) {
+    points.emplace_back(offset + dist(engine), offset - 20.0 - dist(engine));
+  }
+  const auto & footprint = footprints.at(90).outer();
+  points.emplace_back(
+    (footprint.at(0).x() + footprint.at(2).x()) / 2.0,
+    (footprint.at(0).y() + footprint.at(2).y()) / 2.0);
+
+  // objects
+  sw.tic();
+  std::vector<size_t> boost_first_idxs;
+  for (const auto & object : objects) {
+    size_t first_idx = footprints.size();
+    for (size_t i = 0; i < footprints.size(); ++i) {
+      if (boost::geometry::intersects(footprints[i], object)) {
+        first_idx = i;
+        break;
+      }
+    }
+    boost_first_idxs.push_back(first_idx);
+  }
+  const double boost_objects_ns = sw.toc();
+
+  sw.tic();
+  const BatchCollisionChecker checker(footprints);
+  std::vector<size_t> first_idxs;
+  for (const auto & object : objects) {
+    first_idxs.push_back(
+      checker.findFirstIntersection(PreparedPolygon(object)).value_or(footprints.size()));
+  }
+  const double objects_ns = sw.toc();
+  EXPECT_EQ(boost_first_idxs, first_idxs);
+
+  // points
+  sw.tic();
+  std::optional<size_t> boost_first_idx;
+  for (size_t i = 0; i < footprints.size() && !boost_first_idx; ++i) {
+    for (const auto & point : points) {
+      if (boost::geometry::within(point, footprints[i])) {
+        boost_first_idx = i;
+        break;
+      }
+    }
+  }
+  const double boost_points_ns = sw.toc();
+
+  sw.tic();
+  const BatchCollisionChecker point_checker(footprints);
+  const PointGrid2d point_grid(points, 1.0);
+  const auto first_collision = point_checker.findFirstPointWithin(point_grid);
+  const double points_ns = sw.toc();
+  ASSERT_EQ(boost_first_idx.has_value(), first_collision.has_value());
+  if (first_collision) {
+    EXPECT_EQ(*boost_first_idx, first_collision->first);
+    EXPECT_EQ(first_collision->second, points.size() - 1);
+  }
+
+  std::printf(
+    "footprints = %ld, objects = %ld, points = %ld\n", footprints.size(), objects.size(),
+    points.size());
+  std::printf(
+    "\tObjects:\n\t\tBoost::geometry = %2.2f ms\n\t\tBatchCollisionChecker = %2.2f ms\n",
+    boost_objects_ns / 1e6, objects_ns / 1e6);
+  std::printf(
+    "\tPoints:\n\t\tBoost::geometry = %2.2f ms\n\t\tBatchCollisionChecker = %2.2f ms\n",
+    boost_points_ns / 1e6, points_ns / 1e6);
+}
@@ -22,6 +22,7 @@
 
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -42,9 +43,13 @@ public:
   void updateEpsRel(const double eps_rel) override;
   void updateVerbose(const bool verbose) override;
 
+  // Set the primal initial guess used by the next optimization. It is consumed by one solve.
+  void setPrimalInitialGuess(const std::vector<double> & x);
+
 private:
   proxsuite::proxqp::Settings<double> settings_{};
   std::shared_ptr<proxsuite::proxqp::sparse::QP<double, int>> qp_ptr_{nullptr};
+  std::optional<Eigen::VectorXd> primal_initial_guess_{std::nullopt};
 
   void initializeProblemImpl(
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
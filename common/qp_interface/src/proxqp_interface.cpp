@@ -84,6 +84,11 @@ void ProxQPInterface::initializeProblemImpl(
   }
 }
 
+void ProxQPInterface::setPrimalInitialGuess(const std::vector<double> & x)
+{
+  primal_initial_guess_ = Eigen::Map<const Eigen::VectorXd>(x.data(), x.size());
+}
+
 void ProxQPInterface::updateEpsAbs(const double eps_abs)
 {
   settings_.eps_abs = eps_abs;
@@ -142,7 +147,16 @@ std::string ProxQPInterface::getStatus() const
 
 std::vector<double> ProxQPInterface::optimizeImpl()
 {
-  qp_ptr_->solve();
+  // NOTE: the initial guess is used only when its size matches the current problem.
+  if (
+    primal_initial_guess_ &&
+    primal_initial_guess_->size() == static_cast<Eigen::Index>(*variables_num_)) {
+    const Eigen::Ref<const Eigen::VectorXd> x_initial_guess(*primal_initial_guess_);
+    qp_ptr_->solve(x_initial_guess, proxsuite::nullopt, proxsuite::nullopt);
+  } else {
+    qp_ptr_->solve();
+  }
+  primal_initial_guess_ = std::nullopt;
 
   std::vector<double> result;
   for (Eigen::Index i = 0; i < qp_ptr_->results.x.size(); ++i) {
@@ -79,5 +79,14 @@ TEST(TestProxqpInterface, BasicQp)
       EXPECT_EQ(proxqp.getIterationNumber(), 0);
     }
   }
+
+  {
+    // Define problem during optimization with a primal initial guess
+    autoware::common::ProxQPInterface proxqp(true, 4000, 1e-9, 1e-9, false);
+    proxqp.setPrimalInitialGuess({0.3, 0.7});
+    const auto solution = proxqp.QPInterface::optimize(P, A, q, l, u);
+    const auto status = proxqp.getStatus();
+    check_result(solution, status);
+  }
 }
 }  // namespace
@@ -0,0 +1,139 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__AUTONOMOUS_EMERGENCY_BRAKING__FAST_POINTCLOUD_PIPELINE_HPP_
+#define AUTOWARE__AUTONOMOUS_EMERGENCY_BRAKING__FAST_POINTCLOUD_PIPELINE_HPP_
+
+#include <autoware/universe_utils/geometry/boost_geometry.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <Eigen/Core>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace autoware::motion::control::autonomous_emergency_braking::fast_pointcloud
+{
+using autoware::universe_utils::Polygon2d;
+using sensor_msgs::msg::PointCloud2;
+
+struct Point
+{
+  float x{0.0f};
+  float y{0.0f};
+  float z{0.0f};
+};
+using Points = std::vector<Point>;
+
+/**
+ * @brief Union of convex footprint polygons with precomputed bounds for fast inside tests
+ */
+class Corridor
+{
+public:
+  /**
+   * @brief Constructor for Corridor
+   * @param polygons Convex polygons of the ego footprint along the path
+   */
+  explicit Corridor(const std::vector<Polygon2d> & polygons);
+
+  /**
+   * @brief Check if a point is covered by any of the polygons
+   * @param x X coordinate of the point
+   * @param y Y coordinate of the point
+   * @return True if the point is covered by the corridor, false otherwise
+   */
+  [[nodiscard]] bool isCovered(const double x, const double y) const;
+
+private:
+  struct ConvexPolygon
+  {
+    double min_x;
+    double max_x;
+    double min_y;
+    double max_y;
+    // a * x + b * y + c >= 0 inside the polygon
+    std::vector<std::array<double, 3>> half_planes;
+  };
+  std::vector<ConvexPolygon> polygons_;
+  double min_x_{0.0};
+  double max_x_{0.0};
+  double min_y_{0.0};
+  double max_y_{0.0};
+};
+
+/**
+ * @brief Read the points of a PointCloud2 message within a height range
+ * @param msg Point cloud message with float32 x, y and z fields
+ * @param transform Optional transform applied to the points before the height filter
+ * @param min_z Minimum height of the points
+ * @param max_z Maximum height of the points
+ * @param points Output points (the buffer is reused)
+ * @return True if the message has the x, y and z fields, false otherwise
+ */
+bool extractPoints(
+  const PointCloud2 & msg, const std::optional<Eigen::Matrix4f> & transform, const double min_z,
+  const double max_z, Points & points);
+
+/**
+ * @brief Keep only the points inside the corridor
+ * @param points Input points
+ * @param corridor Corridor of the ego footprint
+ * @param cropped_points Output points (the buffer is reused)
+ */
+void cropPoints(const Points & points, const Corridor & corridor, Points & cropped_points);
+
+/**
+ * @brief Grid-based helpers which keep their buffers over the calls to avoid reallocation
+ */
+class GridProcessor
+{
+public:
+  /**
+   * @brief Replace the points in each voxel with their centroid
+   * @param leaf_x Voxel size along x
+   * @param leaf_y Voxel size along y
+   * @param leaf_z Voxel size along z
+   * @param points Points to be downsampled in place
+   */
+  void downsample(const double leaf_x, const double leaf_y, const double leaf_z, Points & points);
+
+  /**
+   * @brief Cluster the points connected with each other within the tolerance
+   * @details The points are binned into cells as large as the tolerance, so that only the points
+   * in the neighboring cells are compared and connected with union-find. The clusters are the same
+   * as the ones of the euclidean cluster extraction.
+   * @param points Points to be clustered
+   * @param tolerance Maximum distance between the connected points
+   * @param cluster_ids Output cluster id of each point in [0, number of clusters)
+   * @return Number of clusters
+   */
+  size_t cluster(
+    const Points & points, const double tolerance, std::vector<size_t> & cluster_ids);
+
+private:
+  size_t findRoot(size_t idx);
+
+  std::vector<std::pair<int64_t, size_t>> keys_;
+  std::vector<size_t> parents_;
+  std::vector<size_t> root_to_cluster_id_;
+  Points voxel_points_;
+};
+}  // namespace autoware::motion::control::autonomous_emergency_braking::fast_pointcloud
+
+#endif  // AUTOWARE__AUTONOMOUS_EMERGENCY_BRAKING__FAST_POINTCLOUD_PIPELINE_HPP_
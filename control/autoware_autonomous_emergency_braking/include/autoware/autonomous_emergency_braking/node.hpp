@@ -15,6 +15,7 @@
 #ifndef AUTOWARE__AUTONOMOUS_EMERGENCY_BRAKING__NODE_HPP_
 #define AUTOWARE__AUTONOMOUS_EMERGENCY_BRAKING__NODE_HPP_
 
+#include "autoware/autonomous_emergency_braking/fast_pointcloud_pipeline.hpp"
 #include "autoware/universe_utils/system/time_keeper.hpp"
 
 #include <autoware/motion_utils/trajectory/trajectory.hpp>
@@ -45,6 +46,8 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <algorithm>
+#include <array>
 #include <deque>
 #include <limits>
 #include <memory>
@@ -308,6 +311,45 @@ private:
   rclcpp::Clock::SharedPtr clock_;
 };
 
+/**
+ * @brief Class to count the latencies of the collision check in bins
+ */
+class LatencyHistogram
+{
+public:
+  /**
+   * @brief Add a latency to the histogram
+   * @param latency_ms Latency [ms]
+   */
+  void add(const double latency_ms)
+  {
+    latest_latency_ms_ = latency_ms;
+    const auto itr = std::upper_bound(
+      bin_upper_bounds_ms_.begin(), bin_upper_bounds_ms_.end(), static_cast<int>(latency_ms));
+    ++counts_.at(std::distance(bin_upper_bounds_ms_.begin(), itr));
+  }
+
+  /**
+   * @brief Add the latest latency and the counts of the bins to the diagnostic status
+   * @param stat Diagnostic status wrapper
+   */
+  void appendTo(DiagnosticStatusWrapper & stat) const
+  {
+    stat.addf("Latency [ms]", "%.2f", latest_latency_ms_);
+    for (size_t i = 0; i < counts_.size(); ++i) {
+      const auto range = (i < bin_upper_bounds_ms_.size())
+                           ? "< " + std::to_string(bin_upper_bounds_ms_.at(i))
+                           : ">= " + std::to_string(bin_upper_bounds_ms_.back());
+      stat.add("Latency " + range + " [ms]", counts_.at(i));
+    }
+  }
+
+private:
+  static constexpr std::array<int, 6> bin_upper_bounds_ms_{5, 10, 20, 50, 100, 200};
+  std::array<size_t, bin_upper_bounds_ms_.size() + 1> counts_{};
+  double latest_latency_ms_{0.0};
+};
+
 /**
  * @brief Autonomous Emergency Braking (AEB) node
  */
@@ -349,6 +391,12 @@ public:
    */
   void onPointCloud(const PointCloud2::ConstSharedPtr input_msg);
 
+  /**
+   * @brief Read the obstacle points of the point cloud message for the fast point cloud pipeline
+   * @param input_msg Shared pointer to the point cloud message
+   */
+  void extractObstaclePoints(const PointCloud2::ConstSharedPtr input_msg);
+
   /**
    * @brief Callback for IMU messages
    * @param input_msg Shared pointer to the IMU message
@@ -431,6 +479,22 @@ public:
     std::vector<ObjectData> & objects,
     const pcl::PointCloud<pcl::PointXYZ>::Ptr obstacle_points_ptr);
 
+  /**
+   * @brief Create object data of the closest point of each cluster with the fast point cloud
+   * pipeline, which crops the obstacle points with the footprint corridor and clusters them on a
+   * grid
+   * @param ego_path Ego vehicle path
+   * @param ego_polys Polygons representing the ego vehicle footprint
+   * @param expanded_ego_polys Polygons of the ego vehicle footprint with the extra margin
+   * @param stamp Timestamp of the data
+   * @param objects Vector to store the created object data
+   * @param filtered_objects Pointer to the point cloud to store the cropped points for debugging
+   */
+  void createObjectDataUsingFastPointCloudPipeline(
+    const Path & ego_path, const std::vector<Polygon2d> & ego_polys,
+    const std::vector<Polygon2d> & expanded_ego_polys, const rclcpp::Time & stamp,
+    std::vector<ObjectData> & objects, pcl::PointCloud<pcl::PointXYZ>::Ptr filtered_objects);
+
   /**
    * @brief Create object data using predicted objects
    * @param ego_path Ego vehicle path
@@ -518,6 +582,7 @@ public:
   bool use_pointcloud_data_;
   bool use_predicted_object_data_;
   bool use_object_velocity_calculation_;
+  bool use_fast_pointcloud_pipeline_;
   bool check_autoware_state_;
   double path_footprint_extra_margin_;
   double detection_range_min_height_;
@@ -540,6 +605,13 @@ public:
   double mpc_prediction_time_horizon_;
   double mpc_prediction_time_interval_;
   CollisionDataKeeper collision_data_keeper_;
+  LatencyHistogram latency_histogram_;
+
+  // buffers of the fast point cloud pipeline reused every cycle
+  fast_pointcloud::Points obstacle_points_;
+  fast_pointcloud::Points cropped_points_;
+  fast_pointcloud::GridProcessor grid_processor_;
+  std::vector<size_t> cluster_ids_;
   // Parameter callback
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 };
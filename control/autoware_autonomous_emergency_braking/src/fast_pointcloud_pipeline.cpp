@@ -0,0 +1,285 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/autonomous_emergency_braking/fast_pointcloud_pipeline.hpp>
+
+#include <sensor_msgs/msg/point_field.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace autoware::motion::control::autonomous_emergency_braking::fast_pointcloud
+{
+namespace
+{
+int64_t toCellKey(const int64_t ix, const int64_t iy)
+{
+  return static_cast<int64_t>(
+    (static_cast<uint64_t>(ix) << 32) | (static_cast<uint64_t>(iy) & 0xFFFFFFFFULL));
+}
+
+int64_t toVoxelKey(const int64_t ix, const int64_t iy, const int64_t iz)
+{
+  constexpr uint64_t mask = (1ULL << 21) - 1;
+  return static_cast<int64_t>(
+    ((static_cast<uint64_t>(ix) & mask) << 42) | ((static_cast<uint64_t>(iy) & mask) << 21) |
+    (static_cast<uint64_t>(iz) & mask));
+}
+
+std::optional<uint32_t> findFloat32FieldOffset(const PointCloud2 & msg, const std::string & name)
+{
+  for (const auto & field : msg.fields) {
+    if (field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32) {
+      return field.offset;
+    }
+  }
+  return std::nullopt;
+}
+}  // namespace
+
+Corridor::Corridor(const std::vector<Polygon2d> & polygons)
+{
+  min_x_ = min_y_ = std::numeric_limits<double>::max();
+  max_x_ = max_y_ = std::numeric_limits<double>::lowest();
+  for (const auto & polygon : polygons) {
+    const auto & ring = polygon.outer();
+    if (ring.size() < 3) continue;
+
+    // the orientation of the ring decides which side of the edges is inside
+    double signed_area = 0.0;
+    for (size_t i = 0; i < ring.size(); ++i) {
+      const auto & p1 = ring.at(i);
+      const auto & p2 = ring.at((i + 1) % ring.size());
+      signed_area += p1.x() * p2.y() - p2.x() * p1.y();
+    }
+    const double sign = signed_area > 0.0 ? 1.0 : -1.0;
+
+    ConvexPolygon convex_polygon;
+    convex_polygon.min_x = convex_polygon.min_y = std::numeric_limits<double>::max();
+    convex_polygon.max_x = convex_polygon.max_y = std::numeric_limits<double>::lowest();
+    for (size_t i = 0; i < ring.size(); ++i) {
+      const auto & p1 = ring.at(i);
+      const auto & p2 = ring.at((i + 1) % ring.size());
+      convex_polygon.min_x = std::min(convex_polygon.min_x, p1.x());
+      convex_polygon.max_x = std::max(convex_polygon.max_x, p1.x());
+      convex_polygon.min_y = std::min(convex_polygon.min_y, p1.y());
+      convex_polygon.max_y = std::max(convex_polygon.max_y, p1.y());
+      const double dx = p2.x() - p1.x();
+      const double dy = p2.y() - p1.y();
+      if (std::abs(dx) < 1e-9 && std::abs(dy) < 1e-9) continue;
+      // inside is on the left of the edges in a counter-clockwise ring
+      convex_polygon.half_planes.push_back(
+        {-dy * sign, dx * sign, (dy * p1.x() - dx * p1.y()) * sign});
+    }
+    min_x_ = std::min(min_x_, convex_polygon.min_x);
+    max_x_ = std::max(max_x_, convex_polygon.max_x);
+    min_y_ = std::min(min_y_, convex_polygon.min_y);
+    max_y_ = std::max(max_y_, convex_polygon.max_y);
+    polygons_.push_back(convex_polygon);
+  }
+}
+
+bool Corridor::isCovered(const double x, const double y) const
+{
+  if (x < min_x_ || max_x_ < x || y < min_y_ || max_y_ < y) {
+    return false;
+  }
+  for (const auto & polygon : polygons_) {
+    if (x < polygon.min_x || polygon.max_x < x || y < polygon.min_y || polygon.max_y < y) {
+      continue;
+    }
+    const bool is_inside = std::all_of(
+      polygon.half_planes.begin(), polygon.half_planes.end(),
+      [&](const auto & h) { return h[0] * x + h[1] * y + h[2] >= 0.0; });
+    if (is_inside) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool extractPoints(
+  const PointCloud2 & msg, const std::optional<Eigen::Matrix4f> & transform, const double min_z,
+  const double max_z, Points & points)
+{
+  points.clear();
+  const auto offset_x = findFloat32FieldOffset(msg, "x");
+  const auto offset_y = findFloat32FieldOffset(msg, "y");
+  const auto offset_z = findFloat32FieldOffset(msg, "z");
+  if (!offset_x || !offset_y || !offset_z) {
+    return false;
+  }
+
+  points.reserve(static_cast<size_t>(msg.width) * msg.height);
+  for (uint32_t row = 0; row < msg.height; ++row) {
+    const uint8_t * row_ptr = msg.data.data() + static_cast<size_t>(row) * msg.row_step;
+    for (uint32_t col = 0; col < msg.width; ++col) {
+      const uint8_t * point_ptr = row_ptr + static_cast<size_t>(col) * msg.point_step;
+      Point p;
+      std::memcpy(&p.x, point_ptr + *offset_x, sizeof(float));
+      std::memcpy(&p.y, point_ptr + *offset_y, sizeof(float));
+      std::memcpy(&p.z, point_ptr + *offset_z, sizeof(float));
+      if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) continue;
+      if (transform) {
+        const auto & m = *transform;
+        const Point original = p;
+        p.x = m(0, 0) * original.x + m(0, 1) * original.y + m(0, 2) * original.z + m(0, 3);
+        p.y = m(1, 0) * original.x + m(1, 1) * original.y + m(1, 2) * original.z + m(1, 3);
+        p.z = m(2, 0) * original.x + m(2, 1) * original.y + m(2, 2) * original.z + m(2, 3);
+      }
+      if (p.z < min_z || max_z < p.z) continue;
+      points.push_back(p);
+    }
+  }
+  return true;
+}
+
+void cropPoints(const Points & points, const Corridor & corridor, Points & cropped_points)
+{
+  cropped_points.clear();
+  for (const auto & p : points) {
+    if (corridor.isCovered(p.x, p.y)) {
+      cropped_points.push_back(p);
+    }
+  }
+}
+
+void GridProcessor::downsample(
+  const double leaf_x, const double leaf_y, const double leaf_z, Points & points)
+{
+  if (points.empty() || leaf_x <= 0.0 || leaf_y <= 0.0 || leaf_z <= 0.0) {
+    return;
+  }
+
+  keys_.clear();
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto & p = points.at(i);
+    keys_.emplace_back(
+      toVoxelKey(
+        static_cast<int64_t>(std::floor(p.x / leaf_x)),
+        static_cast<int64_t>(std::floor(p.y / leaf_y)),
+        static_cast<int64_t>(std::floor(p.z / leaf_z))),
+      i);
+  }
+  std::sort(keys_.begin(), keys_.end());
+
+  // centroid of the points in each voxel
+  voxel_points_.clear();
+  for (size_t begin = 0; begin < keys_.size();) {
+    size_t end = begin;
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    double sum_z = 0.0;
+    for (; end < keys_.size() && keys_.at(end).first == keys_.at(begin).first; ++end) {
+      const auto & p = points.at(keys_.at(end).second);
+      sum_x += p.x;
+      sum_y += p.y;
+      sum_z += p.z;
+    }
+    const double num = static_cast<double>(end - begin);
+    voxel_points_.push_back(
+      {static_cast<float>(sum_x / num), static_cast<float>(sum_y / num),
+       static_cast<float>(sum_z / num)});
+    begin = end;
+  }
+  points.swap(voxel_points_);
+}
+
+size_t GridProcessor::findRoot(size_t idx)
+{
+  while (parents_.at(idx) != idx) {
+    parents_.at(idx) = parents_.at(parents_.at(idx));
+    idx = parents_.at(idx);
+  }
+  return idx;
+}
+
+size_t GridProcessor::cluster(
+  const Points & points, const double tolerance, std::vector<size_t> & cluster_ids)
+{
+  cluster_ids.assign(points.size(), 0);
+  if (points.empty() || tolerance <= 0.0) {
+    // each point is a cluster by itself
+    for (size_t i = 0; i < points.size(); ++i) cluster_ids.at(i) = i;
+    return points.size();
+  }
+
+  const auto to_cell_index = [&](const float value) {
+    return static_cast<int64_t>(std::floor(value / tolerance));
+  };
+  keys_.clear();
+  for (size_t i = 0; i < points.size(); ++i) {
+    keys_.emplace_back(toCellKey(to_cell_index(points.at(i).x), to_cell_index(points.at(i).y)), i);
+  }
+  std::sort(keys_.begin(), keys_.end());
+
+  parents_.resize(points.size());
+  for (size_t i = 0; i < parents_.size(); ++i) parents_.at(i) = i;
+
+  // connect the points within the tolerance in the same cell or the neighboring cells
+  const double squared_tolerance = tolerance * tolerance;
+  for (size_t begin = 0; begin < keys_.size();) {
+    const int64_t key = keys_.at(begin).first;
+    const auto end = static_cast<size_t>(
+      std::upper_bound(
+        keys_.begin() + begin, keys_.end(), std::make_pair(key, std::numeric_limits<size_t>::max())) -
+      keys_.begin());
+    const auto & first_point = points.at(keys_.at(begin).second);
+    const int64_t ix = to_cell_index(first_point.x);
+    const int64_t iy = to_cell_index(first_point.y);
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        const int64_t neighbor_key = toCellKey(ix + dx, iy + dy);
+        // each pair of the cells is checked once
+        if (neighbor_key < key) continue;
+        auto neighbor_itr = std::lower_bound(
+          keys_.begin(), keys_.end(), std::make_pair(neighbor_key, size_t{0}));
+        const auto neighbor_begin = static_cast<size_t>(neighbor_itr - keys_.begin());
+        for (size_t i = begin; i < end; ++i) {
+          const auto & p1 = points.at(keys_.at(i).second);
+          for (size_t j = (neighbor_key == key) ? i + 1 : neighbor_begin;
+               j < keys_.size() && keys_.at(j).first == neighbor_key; ++j) {
+            const auto & p2 = points.at(keys_.at(j).second);
+            const double squared_dist = (p1.x - p2.x) * (p1.x - p2.x) +
+                                        (p1.y - p2.y) * (p1.y - p2.y) +
+                                        (p1.z - p2.z) * (p1.z - p2.z);
+            if (squared_dist > squared_tolerance) continue;
+            const size_t root1 = findRoot(keys_.at(i).second);
+            const size_t root2 = findRoot(keys_.at(j).second);
+            if (root1 != root2) {
+              parents_.at(std::max(root1, root2)) = std::min(root1, root2);
+            }
+          }
+        }
+      }
+    }
+    begin = end;
+  }
+
+  // number the clusters in the order of the points
+  root_to_cluster_id_.assign(points.size(), std::numeric_limits<size_t>::max());
+  size_t cluster_num = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    auto & cluster_id = root_to_cluster_id_.at(findRoot(i));
+    if (cluster_id == std::numeric_limits<size_t>::max()) {
+      cluster_id = cluster_num++;
+    }
+    cluster_ids.at(i) = cluster_id;
+  }
+  return cluster_num;
+}
+}  // namespace autoware::motion::control::autonomous_emergency_braking::fast_pointcloud
@@ -41,6 +41,7 @@
 #include <pcl/surface/convex_hull.h>
 #include <tf2/utils.h>
 
+#include <chrono>
 #include <cmath>
 #include <functional>
 #include <limits>
@@ -141,6 +142,7 @@ AEB::AEB(const rclcpp::NodeOptions & node_options)
   use_pointcloud_data_ = declare_parameter<bool>("use_pointcloud_data");
   use_predicted_object_data_ = declare_parameter<bool>("use_predicted_object_data");
   use_object_velocity_calculation_ = declare_parameter<bool>("use_object_velocity_calculation");
+  use_fast_pointcloud_pipeline_ = declare_parameter<bool>("use_fast_pointcloud_pipeline");
   check_autoware_state_ = declare_parameter<bool>("check_autoware_state");
   path_footprint_extra_margin_ = declare_parameter<double>("path_footprint_extra_margin");
   detection_range_min_height_ = declare_parameter<double>("detection_range_min_height");
@@ -201,6 +203,7 @@ rcl_interfaces::msg::SetParametersResult AEB::onParameter(
   updateParam<bool>(parameters, "use_predicted_object_data", use_predicted_object_data_);
   updateParam<bool>(
     parameters, "use_object_velocity_calculation", use_object_velocity_calculation_);
+  updateParam<bool>(parameters, "use_fast_pointcloud_pipeline", use_fast_pointcloud_pipeline_);
   updateParam<bool>(parameters, "check_autoware_state", check_autoware_state_);
   updateParam<double>(parameters, "path_footprint_extra_margin", path_footprint_extra_margin_);
   updateParam<double>(parameters, "detection_range_min_height", detection_range_min_height_);
@@ -266,6 +269,11 @@ void AEB::onImu(const Imu::ConstSharedPtr input_msg)
 void AEB::onPointCloud(const PointCloud2::ConstSharedPtr input_msg)
 {
   autoware::universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
+  if (use_fast_pointcloud_pipeline_) {
+    extractObstaclePoints(input_msg);
+    return;
+  }
+
   PointCloud::Ptr pointcloud_ptr(new PointCloud);
   pcl::fromROSMsg(*input_msg, *pointcloud_ptr);
 
@@ -316,6 +324,44 @@ void AEB::onPointCloud(const PointCloud2::ConstSharedPtr input_msg)
   obstacle_ros_pointcloud_ptr_->header = input_msg->header;
 }
 
+void AEB::extractObstaclePoints(const PointCloud2::ConstSharedPtr input_msg)
+{
+  autoware::universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
+  std::optional<Eigen::Matrix4f> affine_matrix{std::nullopt};
+  if (input_msg->header.frame_id != "base_link") {
+    RCLCPP_ERROR_STREAM(
+      get_logger(),
+      "[AEB]: Input point cloud frame is not base_link and it is " << input_msg->header.frame_id);
+    // transform pointcloud
+    geometry_msgs::msg::TransformStamped transform_stamped{};
+    try {
+      transform_stamped = tf_buffer_.lookupTransform(
+        "base_link", input_msg->header.frame_id, input_msg->header.stamp,
+        rclcpp::Duration::from_seconds(0.5));
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_ERROR_STREAM(
+        get_logger(),
+        "[AEB] Failed to look up transform from base_link to" << input_msg->header.frame_id);
+      return;
+    }
+    affine_matrix = tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
+  }
+
+  // read the points directly from the message with the z-axis filter. The voxel grid filter is
+  // applied after the points are cropped with the ego path.
+  const bool has_xyz_fields = fast_pointcloud::extractPoints(
+    *input_msg, affine_matrix, detection_range_min_height_,
+    vehicle_info_.vehicle_height_m + detection_range_max_height_margin_, obstacle_points_);
+  if (!has_xyz_fields) {
+    RCLCPP_ERROR_STREAM(get_logger(), "[AEB] Input point cloud does not have float32 x, y and z");
+    return;
+  }
+
+  // the points are kept in obstacle_points_, so only the header is set to the message
+  obstacle_ros_pointcloud_ptr_ = std::make_shared<PointCloud2>();
+  obstacle_ros_pointcloud_ptr_->header = input_msg->header;
+}
+
 bool AEB::fetchLatestData()
 {
   const auto missing = [this](const auto & name) {
@@ -393,7 +439,11 @@ void AEB::onCheckCollision(DiagnosticStatusWrapper & stat)
 {
   MarkerArray debug_markers;
   MarkerArray info_markers;
+  const auto start_time = std::chrono::steady_clock::now();
   checkCollision(debug_markers);
+  latency_histogram_.add(
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time)
+      .count());
 
   if (!collision_data_keeper_.checkCollisionExpired()) {
     const std::string error_msg = "[AEB]: Emergency Brake";
@@ -414,6 +464,7 @@ void AEB::onCheckCollision(DiagnosticStatusWrapper & stat)
     const auto diag_level = DiagnosticStatus::OK;
     stat.summary(diag_level, error_msg);
   }
+  latency_histogram_.appendTo(stat);
 
   // publish debug markers
   debug_marker_publisher_->publish(debug_markers);
@@ -454,10 +505,15 @@ bool AEB::checkCollision(MarkerArray & debug_markers)
       if (use_pointcloud_data_) {
         const auto expanded_ego_polys =
           generatePathFootprint(path, expand_width_ + path_footprint_extra_margin_);
-        cropPointCloudWithEgoFootprintPath(expanded_ego_polys, filtered_objects);
         const auto current_time = obstacle_ros_pointcloud_ptr_->header.stamp;
-        createObjectDataUsingPointCloudClusters(
-          path, ego_polys, current_time, objects, filtered_objects);
+        if (use_fast_pointcloud_pipeline_) {
+          createObjectDataUsingFastPointCloudPipeline(
+            path, ego_polys, expanded_ego_polys, current_time, objects, filtered_objects);
+        } else {
+          cropPointCloudWithEgoFootprintPath(expanded_ego_polys, filtered_objects);
+          createObjectDataUsingPointCloudClusters(
+            path, ego_polys, current_time, objects, filtered_objects);
+        }
       }
       if (use_predicted_object_data_) {
         createObjectDataUsingPredictedObjects(path, ego_polys, objects);
@@ -844,6 +900,96 @@ void AEB::createObjectDataUsingPointCloudClusters(
   }
 }
 
+void AEB::createObjectDataUsingFastPointCloudPipeline(
+  const Path & ego_path, const std::vector<Polygon2d> & ego_polys,
+  const std::vector<Polygon2d> & expanded_ego_polys, const rclcpp::Time & stamp,
+  std::vector<ObjectData> & objects, pcl::PointCloud<pcl::PointXYZ>::Ptr filtered_objects)
+{
+  autoware::universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
+  // check if the predicted path has valid number of points
+  if (ego_path.size() < 2 || ego_polys.empty()) {
+    return;
+  }
+
+  // crop the points with the corridor of the expanded ego path, then downsample them
+  fast_pointcloud::cropPoints(
+    obstacle_points_, fast_pointcloud::Corridor(expanded_ego_polys), cropped_points_);
+  grid_processor_.downsample(voxel_grid_x_, voxel_grid_y_, voxel_grid_z_, cropped_points_);
+  if (publish_debug_pointcloud_) {
+    filtered_objects->clear();
+    for (const auto & p : cropped_points_) {
+      filtered_objects->push_back(pcl::PointXYZ(p.x, p.y, p.z));
+    }
+  }
+  if (cropped_points_.empty()) {
+    return;
+  }
+
+  // eliminate noisy points by only considering points belonging to clusters of at least a certain
+  // size
+  const size_t cluster_num =
+    grid_processor_.cluster(cropped_points_, cluster_tolerance_, cluster_ids_);
+  std::vector<int> cluster_sizes(cluster_num, 0);
+  std::vector<bool> cluster_surpasses_threshold_height(cluster_num, false);
+  for (size_t i = 0; i < cropped_points_.size(); ++i) {
+    const auto cluster_id = cluster_ids_.at(i);
+    ++cluster_sizes.at(cluster_id);
+    if (cropped_points_.at(i).z > cluster_minimum_height_) {
+      cluster_surpasses_threshold_height.at(cluster_id) = true;
+    }
+  }
+
+  // select the closest point of each cluster inside the ego footprint path
+  const auto current_p = [&]() {
+    const auto & first_point_of_path = ego_path.front();
+    const auto & p = first_point_of_path.position;
+    return autoware::universe_utils::createPoint(p.x, p.y, p.z);
+  }();
+  const fast_pointcloud::Corridor ego_corridor(ego_polys);
+
+  std::vector<std::optional<ObjectData>> closest_objects(cluster_num, std::nullopt);
+  for (size_t i = 0; i < cropped_points_.size(); ++i) {
+    const auto cluster_id = cluster_ids_.at(i);
+    const int cluster_size = cluster_sizes.at(cluster_id);
+    if (
+      cluster_size < minimum_cluster_size_ || cluster_size > maximum_cluster_size_ ||
+      !cluster_surpasses_threshold_height.at(cluster_id)) {
+      continue;
+    }
+    const auto & p = cropped_points_.at(i);
+    if (!ego_corridor.isCovered(p.x, p.y)) continue;
+
+    const auto obj_position = autoware::universe_utils::createPoint(p.x, p.y, p.z);
+    const double obj_arc_length =
+      autoware::motion_utils::calcSignedArcLength(ego_path, current_p, obj_position);
+    if (std::isnan(obj_arc_length)) continue;
+
+    // If the object is behind the ego, we need to use the backward long offset. The distance should
+    // be a positive number in any case
+    const bool is_object_in_front_of_ego = obj_arc_length > 0.0;
+    const double dist_ego_to_object = (is_object_in_front_of_ego)
+                                        ? obj_arc_length - vehicle_info_.max_longitudinal_offset_m
+                                        : obj_arc_length + vehicle_info_.min_longitudinal_offset_m;
+
+    auto & closest_object = closest_objects.at(cluster_id);
+    if (closest_object && closest_object->distance_to_object <= std::abs(dist_ego_to_object)) {
+      continue;
+    }
+    ObjectData obj;
+    obj.stamp = stamp;
+    obj.position = obj_position;
+    obj.velocity = 0.0;
+    obj.distance_to_object = std::abs(dist_ego_to_object);
+    closest_object = obj;
+  }
+
+  for (const auto & closest_object : closest_objects) {
+    if (closest_object) {
+      objects.push_back(closest_object.value());
+    }
+  }
+}
+
 void AEB::cropPointCloudWithEgoFootprintPath(
   const std::vector<Polygon2d> & ego_polys, pcl::PointCloud<pcl::PointXYZ>::Ptr filtered_objects)
 {
@@ -27,8 +27,10 @@
 #include <pcl/memory.h>
 #include <tf2/LinearMath/Transform.h>
 
+#include <algorithm>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace autoware::motion::control::autonomous_emergency_braking::test
 {
@@ -323,4 +325,57 @@ TEST_F(TestAEB, TestCropPointCloud)
   ASSERT_TRUE(filtered_objects->points.size() == 2 * n_points);
 }
 
+TEST_F(TestAEB, TestFastPointCloudPipeline)
+{
+  constexpr double longitudinal_velocity = 3.0;
+  constexpr double yaw_rate = 0.05;
+  const auto imu_path = aeb_node_->generateEgoPath(longitudinal_velocity, yaw_rate);
+  ASSERT_FALSE(imu_path.empty());
+
+  // Create a cluster on the path, an isolated noise point and a point outside the path. Each
+  // point is at the center of a voxel so that the voxel grid filter does not move them.
+  pcl::PointCloud<pcl::PointXYZ>::Ptr obstacle_points_ptr =
+    pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+  for (size_t i = 0; i < 6; ++i) {
+    for (size_t j = 0; j < 8; ++j) {
+      obstacle_points_ptr->push_back(pcl::PointXYZ(3.025 + 0.05 * i, -0.175 + 0.05 * j, 0.5));
+    }
+  }
+  obstacle_points_ptr->push_back(pcl::PointXYZ(2.025, 0.025, 0.5));
+  obstacle_points_ptr->push_back(pcl::PointXYZ(100.0, 100.0, 0.5));
+  const auto input_msg = std::make_shared<PointCloud2>();
+  pcl::toROSMsg(*obstacle_points_ptr, *input_msg);
+  input_msg->header = get_header("base_link", pub_sub_node_->now());
+
+  const auto ego_polys = aeb_node_->generatePathFootprint(imu_path, aeb_node_->expand_width_);
+  const auto expanded_ego_polys = aeb_node_->generatePathFootprint(
+    imu_path, aeb_node_->expand_width_ + aeb_node_->path_footprint_extra_margin_);
+  const rclcpp::Time stamp = input_msg->header.stamp;
+
+  // the closest point of the cluster is almost the same as the one of the PCL pipeline
+  std::vector<ObjectData> pcl_objects;
+  pcl::PointCloud<pcl::PointXYZ>::Ptr filtered_objects =
+    pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+  aeb_node_->obstacle_ros_pointcloud_ptr_ = input_msg;
+  aeb_node_->cropPointCloudWithEgoFootprintPath(expanded_ego_polys, filtered_objects);
+  aeb_node_->createObjectDataUsingPointCloudClusters(
+    imu_path, ego_polys, stamp, pcl_objects, filtered_objects);
+  ASSERT_FALSE(pcl_objects.empty());
+  const auto pcl_closest_object = std::min_element(
+    pcl_objects.begin(), pcl_objects.end(),
+    [](const auto & o1, const auto & o2) { return o1.distance_to_object < o2.distance_to_object; });
+
+  std::vector<ObjectData> objects;
+  aeb_node_->extractObstaclePoints(input_msg);
+  EXPECT_EQ(aeb_node_->obstacle_points_.size(), obstacle_points_ptr->size());
+  aeb_node_->createObjectDataUsingFastPointCloudPipeline(
+    imu_path, ego_polys, expanded_ego_polys, stamp, objects, filtered_objects);
+  ASSERT_EQ(objects.size(), size_t{1});
+  // all the points of the cluster are checked instead of the hull vertices, so the closest point
+  // can be slightly closer than the one of the PCL pipeline
+  EXPECT_LE(objects.front().distance_to_object, pcl_closest_object->distance_to_object + 1e-6);
+  EXPECT_NEAR(objects.front().distance_to_object, pcl_closest_object->distance_to_object, 0.02);
+  EXPECT_NEAR(objects.front().position.x, 3.025, 1e-3);
+}
+
 }  // namespace autoware::motion::control::autonomous_emergency_braking::test
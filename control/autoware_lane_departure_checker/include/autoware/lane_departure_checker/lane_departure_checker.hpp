@@ -43,11 +43,13 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace autoware::lane_departure_checker
 {
+using autoware::universe_utils::Box2d;
 using autoware::universe_utils::LinearRing2d;
 using autoware::universe_utils::PoseDeviation;
 using autoware::universe_utils::Segment2d;
@@ -114,6 +116,7 @@ public:
   {
     param_ = param;
     vehicle_info_ptr_ = std::make_shared<autoware::vehicle_info_utils::VehicleInfo>(vehicle_info);
+    footprint_cache_ = FootprintCache{};
   }
 
   void setParam(const Param & param) { param_ = param; }
@@ -121,6 +124,7 @@ public:
   void setVehicleInfo(const autoware::vehicle_info_utils::VehicleInfo vehicle_info)
   {
     vehicle_info_ptr_ = std::make_shared<autoware::vehicle_info_utils::VehicleInfo>(vehicle_info);
+    footprint_cache_ = FootprintCache{};
   }
 
   bool checkPathWillLeaveLane(
@@ -153,9 +157,32 @@ public:
     const lanelet::ConstLanelets & candidate_lanelets, const LinearRing2d & vehicle_footprint);
 
 private:
+  struct LaneletPolygon
+  {
+    lanelet::BasicPolygon2d polygon;
+    Box2d envelope;
+  };
+
+  // footprints on the previous trajectory, which are reused for the unchanged points
+  struct FootprintCache
+  {
+    double margin_lon{0.0};
+    double margin_lat{0.0};
+    std::vector<geometry_msgs::msg::Pose> poses{};
+    std::vector<LinearRing2d> footprints{};
+  };
+
   Param param_;
   std::shared_ptr<autoware::vehicle_info_utils::VehicleInfo> vehicle_info_ptr_;
 
+  // caches which are kept while the lanelet map is the same
+  lanelet::LaneletMapPtr cached_lanelet_map_{};
+  std::vector<std::string> cached_boundary_types_{};
+  SegmentRtree map_uncrossable_boundaries_{};
+  std::unordered_map<lanelet::Id, LaneletPolygon> lanelet_polygons_{};
+
+  FootprintCache footprint_cache_{};
+
   static PoseDeviation calcTrajectoryDeviation(
     const Trajectory & trajectory, const geometry_msgs::msg::Pose & pose,
     const double dist_threshold, const double yaw_threshold);
@@ -173,6 +200,20 @@ private:
   static std::vector<LinearRing2d> createVehiclePassingAreas(
     const std::vector<LinearRing2d> & vehicle_footprints);
 
+  void updateMapCache(
+    const lanelet::LaneletMapPtr & lanelet_map,
+    const std::vector<std::string> & boundary_types_to_detect);
+
+  const LaneletPolygon & getLaneletPolygon(const lanelet::ConstLanelet & lanelet);
+
+  lanelet::ConstLanelets findCandidateLanelets(
+    const lanelet::ConstLanelets & lanelets, const LinearRing2d & footprint_hull,
+    std::vector<const LaneletPolygon *> & candidate_polygons);
+
+  static bool isOutOfLane(
+    const std::vector<const LaneletPolygon *> & candidate_polygons,
+    const LinearRing2d & vehicle_footprint);
+
   bool willLeaveLane(
     const lanelet::ConstLanelets & candidate_lanelets,
     const std::vector<LinearRing2d> & vehicle_footprints) const;
@@ -180,8 +221,12 @@ private:
   double calcMaxSearchLengthForBoundaries(const Trajectory & trajectory) const;
 
   static SegmentRtree extractUncrossableBoundaries(
-    const lanelet::LaneletMap & lanelet_map, const geometry_msgs::msg::Point & ego_point,
-    const double max_search_length, const std::vector<std::string> & boundary_types_to_detect);
+    const lanelet::LaneletMap & lanelet_map,
+    const std::vector<std::string> & boundary_types_to_detect);
+
+  static SegmentRtree extractUncrossableBoundaries(
+    const SegmentRtree & map_uncrossable_boundaries, const geometry_msgs::msg::Point & ego_point,
+    const double max_search_length, const std::vector<LinearRing2d> & vehicle_footprints);
 
   bool willCrossBoundary(
     const std::vector<LinearRing2d> & vehicle_footprints,
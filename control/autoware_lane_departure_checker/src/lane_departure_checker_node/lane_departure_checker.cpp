@@ -32,7 +32,6 @@
 
 using autoware::motion_utils::calcArcLength;
 using autoware::universe_utils::LinearRing2d;
-using autoware::universe_utils::LineString2d;
 using autoware::universe_utils::MultiPoint2d;
 using autoware::universe_utils::MultiPolygon2d;
 using autoware::universe_utils::Point2d;
@@ -129,28 +128,36 @@ Output LaneDepartureChecker::update(const Input & input)
   output.vehicle_passing_areas = createVehiclePassingAreas(output.vehicle_footprints);
   output.processing_time_map["createVehiclePassingAreas"] = stop_watch.toc(true);
 
-  const auto candidate_road_lanelets =
-    getCandidateLanelets(input.route_lanelets, output.vehicle_footprints);
-  const auto candidate_shoulder_lanelets =
-    getCandidateLanelets(input.shoulder_lanelets, output.vehicle_footprints);
-  output.candidate_lanelets = candidate_road_lanelets;
-  output.candidate_lanelets.insert(
-    output.candidate_lanelets.end(), candidate_shoulder_lanelets.begin(),
-    candidate_shoulder_lanelets.end());
+  updateMapCache(input.lanelet_map, input.boundary_types_to_detect);
+
+  std::vector<const LaneletPolygon *> candidate_polygons;
+  {
+    const auto footprint_hull = createHullFromFootprints(output.vehicle_footprints);
+    const auto candidate_road_lanelets =
+      findCandidateLanelets(input.route_lanelets, footprint_hull, candidate_polygons);
+    const auto candidate_shoulder_lanelets =
+      findCandidateLanelets(input.shoulder_lanelets, footprint_hull, candidate_polygons);
+    output.candidate_lanelets = candidate_road_lanelets;
+    output.candidate_lanelets.insert(
+      output.candidate_lanelets.end(), candidate_shoulder_lanelets.begin(),
+      candidate_shoulder_lanelets.end());
+  }
 
   output.processing_time_map["getCandidateLanelets"] = stop_watch.toc(true);
 
-  output.will_leave_lane = willLeaveLane(output.candidate_lanelets, output.vehicle_footprints);
+  output.will_leave_lane = std::any_of(
+    output.vehicle_footprints.begin(), output.vehicle_footprints.end(),
+    [&](const auto & footprint) { return isOutOfLane(candidate_polygons, footprint); });
   output.processing_time_map["willLeaveLane"] = stop_watch.toc(true);
 
-  output.is_out_of_lane = isOutOfLane(output.candidate_lanelets, output.vehicle_footprints.front());
+  output.is_out_of_lane = isOutOfLane(candidate_polygons, output.vehicle_footprints.front());
   output.processing_time_map["isOutOfLane"] = stop_watch.toc(true);
 
   const double max_search_length_for_boundaries =
     calcMaxSearchLengthForBoundaries(*input.predicted_trajectory);
   const auto uncrossable_boundaries = extractUncrossableBoundaries(
-    *input.lanelet_map, input.predicted_trajectory->points.front().pose.position,
-    max_search_length_for_boundaries, input.boundary_types_to_detect);
+    map_uncrossable_boundaries_, input.predicted_trajectory->points.front().pose.position,
+    max_search_length_for_boundaries, output.vehicle_footprints);
   output.will_cross_boundary = willCrossBoundary(output.vehicle_footprints, uncrossable_boundaries);
   output.processing_time_map["willCrossBoundary"] = stop_watch.toc(true);
 
@@ -249,13 +256,41 @@ std::vector<LinearRing2d> LaneDepartureChecker::createVehicleFootprints(
   // Create vehicle footprint in base_link coordinate
   const auto local_vehicle_footprint = vehicle_info_ptr_->createFootprint(margin.lat, margin.lon);
 
+  // The footprints on the previous trajectory can be reused only with the same margin
+  auto & cache = footprint_cache_;
+  if (cache.margin_lon != margin.lon || cache.margin_lat != margin.lat) {
+    cache.poses.clear();
+    cache.footprints.clear();
+  }
+
+  // Find the first point in the previous trajectory, from which the points are compared one by one
+  size_t cache_idx = 0;
+  if (!trajectory.empty()) {
+    const auto itr = std::find(cache.poses.begin(), cache.poses.end(), trajectory.front().pose);
+    cache_idx = static_cast<size_t>(std::distance(cache.poses.begin(), itr));
+  }
+
   // Create vehicle footprint on each TrajectoryPoint
   std::vector<LinearRing2d> vehicle_footprints;
+  vehicle_footprints.reserve(trajectory.size());
   for (const auto & p : trajectory) {
+    if (cache_idx < cache.poses.size() && cache.poses.at(cache_idx) == p.pose) {
+      vehicle_footprints.push_back(cache.footprints.at(cache_idx++));
+      continue;
+    }
+    cache_idx = cache.poses.size();
     vehicle_footprints.push_back(
       transformVector(local_vehicle_footprint, autoware::universe_utils::pose2transform(p.pose)));
   }
 
+  cache.margin_lon = margin.lon;
+  cache.margin_lat = margin.lat;
+  cache.poses.resize(trajectory.size());
+  std::transform(trajectory.begin(), trajectory.end(), cache.poses.begin(), [](const auto & p) {
+    return p.pose;
+  });
+  cache.footprints = vehicle_footprints;
+
   return vehicle_footprints;
 }
 
@@ -474,6 +509,70 @@ bool LaneDepartureChecker::isOutOfLane(
   return false;
 }
 
+bool LaneDepartureChecker::isOutOfLane(
+  const std::vector<const LaneletPolygon *> & candidate_polygons,
+  const LinearRing2d & vehicle_footprint)
+{
+  const auto is_in_any_lane = [&](const Point2d & point) {
+    return std::any_of(
+      candidate_polygons.begin(), candidate_polygons.end(), [&](const auto * lanelet_polygon) {
+        return boost::geometry::covered_by(point, lanelet_polygon->envelope) &&
+               boost::geometry::within(point, lanelet_polygon->polygon);
+      });
+  };
+  return !std::all_of(vehicle_footprint.begin(), vehicle_footprint.end(), is_in_any_lane);
+}
+
+void LaneDepartureChecker::updateMapCache(
+  const lanelet::LaneletMapPtr & lanelet_map,
+  const std::vector<std::string> & boundary_types_to_detect)
+{
+  if (lanelet_map != cached_lanelet_map_) {
+    lanelet_polygons_.clear();
+  }
+  if (lanelet_map != cached_lanelet_map_ || boundary_types_to_detect != cached_boundary_types_) {
+    map_uncrossable_boundaries_ =
+      extractUncrossableBoundaries(*lanelet_map, boundary_types_to_detect);
+  }
+  cached_lanelet_map_ = lanelet_map;
+  cached_boundary_types_ = boundary_types_to_detect;
+}
+
+const LaneDepartureChecker::LaneletPolygon & LaneDepartureChecker::getLaneletPolygon(
+  const lanelet::ConstLanelet & lanelet)
+{
+  const auto itr = lanelet_polygons_.find(lanelet.id());
+  if (itr != lanelet_polygons_.end()) {
+    return itr->second;
+  }
+
+  LaneletPolygon lanelet_polygon;
+  lanelet_polygon.polygon = lanelet.polygon2d().basicPolygon();
+  boost::geometry::envelope(lanelet_polygon.polygon, lanelet_polygon.envelope);
+  return lanelet_polygons_.emplace(lanelet.id(), std::move(lanelet_polygon)).first->second;
+}
+
+lanelet::ConstLanelets LaneDepartureChecker::findCandidateLanelets(
+  const lanelet::ConstLanelets & lanelets, const LinearRing2d & footprint_hull,
+  std::vector<const LaneletPolygon *> & candidate_polygons)
+{
+  lanelet::ConstLanelets candidate_lanelets;
+
+  // Find lanes within the convex hull of footprints
+  const auto footprint_hull_envelope = boost::geometry::return_envelope<Box2d>(footprint_hull);
+  for (const auto & lanelet : lanelets) {
+    const auto & lanelet_polygon = getLaneletPolygon(lanelet);
+    if (
+      !boost::geometry::disjoint(lanelet_polygon.envelope, footprint_hull_envelope) &&
+      !boost::geometry::disjoint(lanelet_polygon.polygon, footprint_hull)) {
+      candidate_lanelets.push_back(lanelet);
+      candidate_polygons.push_back(&lanelet_polygon);
+    }
+  }
+
+  return candidate_lanelets;
+}
+
 double LaneDepartureChecker::calcMaxSearchLengthForBoundaries(const Trajectory & trajectory) const
 {
   const double max_ego_lon_length = std::max(
@@ -487,8 +586,8 @@ double LaneDepartureChecker::calcMaxSearchLengthForBoundaries(const Trajectory &
 }
 
 SegmentRtree LaneDepartureChecker::extractUncrossableBoundaries(
-  const lanelet::LaneletMap & lanelet_map, const geometry_msgs::msg::Point & ego_point,
-  const double max_search_length, const std::vector<std::string> & boundary_types_to_detect)
+  const lanelet::LaneletMap & lanelet_map,
+  const std::vector<std::string> & boundary_types_to_detect)
 {
   const auto has_types =
     [](const lanelet::ConstLineString3d & ls, const std::vector<std::string> & types) {
@@ -497,22 +596,41 @@ SegmentRtree LaneDepartureChecker::extractUncrossableBoundaries(
       return (type != no_type && std::find(types.begin(), types.end(), type) != types.end());
     };
 
-  SegmentRtree uncrossable_segments_in_range;
-  LineString2d line;
-  const auto ego_p = Point2d{ego_point.x, ego_point.y};
+  std::vector<Segment2d> uncrossable_segments;
   for (const auto & ls : lanelet_map.lineStringLayer) {
     if (has_types(ls, boundary_types_to_detect)) {
-      line.clear();
-      for (const auto & p : ls) line.push_back(Point2d{p.x(), p.y()});
-      for (auto segment_idx = 0LU; segment_idx + 1 < line.size(); ++segment_idx) {
-        const Segment2d segment = {line[segment_idx], line[segment_idx + 1]};
-        if (boost::geometry::distance(segment, ego_p) < max_search_length) {
-          uncrossable_segments_in_range.insert(segment);
-        }
+      for (auto segment_idx = 0LU; segment_idx + 1 < ls.size(); ++segment_idx) {
+        uncrossable_segments.push_back(
+          {Point2d{ls[segment_idx].x(), ls[segment_idx].y()},
+           Point2d{ls[segment_idx + 1].x(), ls[segment_idx + 1].y()}});
       }
     }
   }
-  return uncrossable_segments_in_range;
+  // the packing algorithm builds the tree of the whole map at once
+  return SegmentRtree(uncrossable_segments.begin(), uncrossable_segments.end());
+}
+
+SegmentRtree LaneDepartureChecker::extractUncrossableBoundaries(
+  const SegmentRtree & map_uncrossable_boundaries, const geometry_msgs::msg::Point & ego_point,
+  const double max_search_length, const std::vector<LinearRing2d> & vehicle_footprints)
+{
+  // only the segments overlapping with the footprints can intersect them
+  Box2d footprints_envelope;
+  boost::geometry::assign_inverse(footprints_envelope);
+  for (const auto & footprint : vehicle_footprints) {
+    boost::geometry::expand(
+      footprints_envelope, boost::geometry::return_envelope<Box2d>(footprint));
+  }
+
+  const auto ego_p = Point2d{ego_point.x, ego_point.y};
+  std::vector<Segment2d> uncrossable_segments_in_range;
+  map_uncrossable_boundaries.query(
+    boost::geometry::index::intersects(footprints_envelope) &&
+      boost::geometry::index::satisfies([&](const Segment2d & segment) {
+        return boost::geometry::distance(segment, ego_p) < max_search_length;
+      }),
+    std::back_inserter(uncrossable_segments_in_range));
+  return SegmentRtree(uncrossable_segments_in_range.begin(), uncrossable_segments_in_range.end());
 }
 
 bool LaneDepartureChecker::willCrossBoundary(
@@ -0,0 +1,244 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/lane_departure_checker/lane_departure_checker.hpp"
+
+#include <autoware/universe_utils/geometry/geometry.hpp>
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using autoware::lane_departure_checker::Input;
+using autoware::lane_departure_checker::LaneDepartureChecker;
+using autoware::lane_departure_checker::LinearRing2d;
+using autoware::lane_departure_checker::Output;
+using autoware::lane_departure_checker::Param;
+using autoware::lane_departure_checker::Trajectory;
+using autoware::lane_departure_checker::TrajectoryPoint;
+
+namespace
+{
+constexpr lanelet::Id first_lanelet_id = 1000;
+constexpr lanelet::Id second_lanelet_id = 1001;
+
+Param createParam(const double footprint_margin_scale)
+{
+  Param param;
+  param.footprint_margin_scale = footprint_margin_scale;
+  param.resample_interval = 0.3;
+  param.max_deceleration = 2.8;
+  param.delay_time = 1.3;
+  param.min_braking_distance = 0.0;
+  param.ego_nearest_dist_threshold = 3.0;
+  param.ego_nearest_yaw_threshold = 1.046;
+  return param;
+}
+
+autoware::vehicle_info_utils::VehicleInfo createVehicleInfo()
+{
+  return autoware::vehicle_info_utils::createVehicleInfo(
+    0.39, 0.42, 2.74, 1.63, 1.0, 1.03, 0.1, 0.1, 2.5, 0.7);
+}
+
+// straight road from x = -20 to x = 80 with two lanelets bounded by the road borders. The lanelet
+// ids do not depend on the width, so that a map swap keeps the ids while changing the polygons.
+lanelet::LaneletMapPtr createStraightRoadMap(const double lane_width)
+{
+  lanelet::Id id = 1;
+  const auto create_bound = [&](const double start_x, const double y) {
+    lanelet::Points3d points;
+    for (double x = start_x; x <= start_x + 50.0; x += 10.0) {
+      points.emplace_back(id++, x, y, 0.0);
+    }
+    lanelet::LineString3d bound(id++, points);
+    bound.attributes()[lanelet::AttributeName::Type] = "road_border";
+    return bound;
+  };
+  const double half_width = 0.5 * lane_width;
+  lanelet::Lanelet first_lanelet(
+    first_lanelet_id, create_bound(-20.0, half_width), create_bound(-20.0, -half_width));
+  lanelet::Lanelet second_lanelet(
+    second_lanelet_id, create_bound(30.0, half_width), create_bound(30.0, -half_width));
+  return lanelet::utils::createMap({first_lanelet, second_lanelet});
+}
+
+// trajectory along the x axis with 1 m interval, which is shifted laterally after x = 20
+Trajectory::ConstSharedPtr createTrajectory(
+  const double start_x, const size_t size, const double tail_lat_offset = 0.0)
+{
+  auto trajectory = std::make_shared<Trajectory>();
+  for (size_t i = 0; i < size; ++i) {
+    TrajectoryPoint p;
+    p.pose.position.x = start_x + static_cast<double>(i);
+    p.pose.position.y = p.pose.position.x > 20.0 ? tail_lat_offset : 0.0;
+    p.pose.orientation = autoware::universe_utils::createQuaternionFromYaw(0.0);
+    p.longitudinal_velocity_mps = 10.0;
+    trajectory->points.push_back(p);
+  }
+  return trajectory;
+}
+
+Input createInput(
+  const lanelet::LaneletMapPtr & lanelet_map, const Trajectory::ConstSharedPtr & trajectory,
+  const double position_covariance = 0.0)
+{
+  auto odom = std::make_shared<nav_msgs::msg::Odometry>();
+  odom->pose.pose = trajectory->points.front().pose;
+  odom->pose.covariance[0 * 6 + 0] = position_covariance;
+  odom->pose.covariance[1 * 6 + 1] = position_covariance;
+  odom->twist.twist.linear.x = 10.0;
+
+  Input input;
+  input.current_odom = odom;
+  input.lanelet_map = lanelet_map;
+  input.route_lanelets = {
+    lanelet_map->laneletLayer.get(first_lanelet_id),
+    lanelet_map->laneletLayer.get(second_lanelet_id)};
+  input.reference_trajectory = trajectory;
+  input.predicted_trajectory = trajectory;
+  input.boundary_types_to_detect = {"road_border"};
+  return input;
+}
+
+// output of a checker without any cache
+Output updateWithoutCache(const Input & input, const Param & param)
+{
+  LaneDepartureChecker checker;
+  checker.setParam(param, createVehicleInfo());
+  return checker.update(input);
+}
+
+void expectSameRings(const std::vector<LinearRing2d> & a, const std::vector<LinearRing2d> & b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(a.at(i).size(), b.at(i).size());
+    for (size_t j = 0; j < a.at(i).size(); ++j) {
+      EXPECT_DOUBLE_EQ(a.at(i).at(j).x(), b.at(i).at(j).x());
+      EXPECT_DOUBLE_EQ(a.at(i).at(j).y(), b.at(i).at(j).y());
+    }
+  }
+}
+
+void expectSameOutput(const Output & output, const Output & expected)
+{
+  EXPECT_EQ(output.will_leave_lane, expected.will_leave_lane);
+  EXPECT_EQ(output.is_out_of_lane, expected.is_out_of_lane);
+  EXPECT_EQ(output.will_cross_boundary, expected.will_cross_boundary);
+  ASSERT_EQ(output.candidate_lanelets.size(), expected.candidate_lanelets.size());
+  for (size_t i = 0; i < output.candidate_lanelets.size(); ++i) {
+    EXPECT_EQ(output.candidate_lanelets.at(i).id(), expected.candidate_lanelets.at(i).id());
+  }
+  ASSERT_EQ(output.resampled_trajectory.size(), expected.resampled_trajectory.size());
+  for (size_t i = 0; i < output.resampled_trajectory.size(); ++i) {
+    EXPECT_EQ(output.resampled_trajectory.at(i).pose, expected.resampled_trajectory.at(i).pose);
+  }
+  expectSameRings(output.vehicle_footprints, expected.vehicle_footprints);
+  expectSameRings(output.vehicle_passing_areas, expected.vehicle_passing_areas);
+}
+}  // namespace
+
+TEST(LaneDepartureChecker, SameOutputAfterMapSwap)
+{
+  const auto param = createParam(1.0);
+  LaneDepartureChecker checker;
+  checker.setParam(param, createVehicleInfo());
+
+  const auto trajectory = createTrajectory(0.0, 80);
+  const auto wide_map = createStraightRoadMap(4.0);
+  const auto narrow_map = createStraightRoadMap(1.6);
+
+  const auto wide_input = createInput(wide_map, trajectory);
+  const auto wide_output = checker.update(wide_input);
+  expectSameOutput(wide_output, updateWithoutCache(wide_input, param));
+  EXPECT_FALSE(wide_output.will_leave_lane);
+  EXPECT_FALSE(wide_output.will_cross_boundary);
+
+  // the lanelets have the same ids but the other polygons, and the borders are in the footprints
+  const auto narrow_input = createInput(narrow_map, trajectory);
+  const auto narrow_output = checker.update(narrow_input);
+  expectSameOutput(narrow_output, updateWithoutCache(narrow_input, param));
+  EXPECT_TRUE(narrow_output.will_leave_lane);
+  EXPECT_TRUE(narrow_output.will_cross_boundary);
+
+  // the same map without the boundary types to detect
+  auto narrow_input_without_boundary = narrow_input;
+  narrow_input_without_boundary.boundary_types_to_detect.clear();
+  const auto narrow_output_without_boundary = checker.update(narrow_input_without_boundary);
+  expectSameOutput(
+    narrow_output_without_boundary, updateWithoutCache(narrow_input_without_boundary, param));
+  EXPECT_FALSE(narrow_output_without_boundary.will_cross_boundary);
+
+  // back and forth between the maps
+  expectSameOutput(checker.update(wide_input), updateWithoutCache(wide_input, param));
+  expectSameOutput(checker.update(narrow_input), updateWithoutCache(narrow_input, param));
+}
+
+TEST(LaneDepartureChecker, SameOutputWithPartialTrajectoryReuse)
+{
+  const auto param = createParam(1.0);
+  LaneDepartureChecker checker;
+  checker.setParam(param, createVehicleInfo());
+  const auto lanelet_map = createStraightRoadMap(4.0);
+
+  // the trajectory moves ahead with ego, so the points after the new front are reused
+  for (const double start_x : {0.0, 2.0, 5.0}) {
+    const auto input = createInput(lanelet_map, createTrajectory(start_x, 80));
+    const auto output = checker.update(input);
+    expectSameOutput(output, updateWithoutCache(input, param));
+    EXPECT_FALSE(output.will_leave_lane);
+  }
+
+  // the points are reused only until the first changed point
+  const auto shifted_input = createInput(lanelet_map, createTrajectory(5.0, 80, 1.5));
+  const auto shifted_output = checker.update(shifted_input);
+  expectSameOutput(shifted_output, updateWithoutCache(shifted_input, param));
+  EXPECT_TRUE(shifted_output.will_leave_lane);
+
+  // the trajectory which does not contain the previous front
+  const auto backward_input = createInput(lanelet_map, createTrajectory(-3.5, 80));
+  expectSameOutput(checker.update(backward_input), updateWithoutCache(backward_input, param));
+}
+
+TEST(LaneDepartureChecker, SameOutputAfterFootprintMarginChange)
+{
+  const auto param = createParam(1.0);
+  LaneDepartureChecker checker;
+  checker.setParam(param, createVehicleInfo());
+  const auto lanelet_map = createStraightRoadMap(4.0);
+  const auto trajectory = createTrajectory(0.0, 80, 1.0);
+
+  const auto input = createInput(lanelet_map, trajectory);
+  const auto output = checker.update(input);
+  expectSameOutput(output, updateWithoutCache(input, param));
+  EXPECT_FALSE(output.will_leave_lane);
+
+  // the margin from the covariance makes the footprints on the same trajectory leave the lane
+  const auto uncertain_input = createInput(lanelet_map, trajectory, 0.2);
+  const auto uncertain_output = checker.update(uncertain_input);
+  expectSameOutput(uncertain_output, updateWithoutCache(uncertain_input, param));
+  EXPECT_TRUE(uncertain_output.will_leave_lane);
+
+  // the margin also changes with the scale
+  const auto unscaled_param = createParam(0.0);
+  checker.setParam(unscaled_param);
+  const auto unscaled_output = checker.update(uncertain_input);
+  expectSameOutput(unscaled_output, updateWithoutCache(uncertain_input, unscaled_param));
+  EXPECT_FALSE(unscaled_output.will_leave_lane);
+}
@@ -221,7 +221,16 @@ private:
 
   double m_min_prediction_length = 5.0;  // Minimum prediction distance.
 
+  double m_qp_solve_time_ms = 0.0;  // Time to update and solve the latest QP problem [ms].
+
   rclcpp::Publisher<Trajectory>::SharedPtr m_debug_frenet_predicted_trajectory_pub;
+
+  // Buffers reused every control cycle. Their sizes only change with the horizon or the model.
+  MPCMatrix m_mpc_matrix;  // Prediction and cost matrices of the MPC problem.
+  MatrixXd m_Ad, m_Bd, m_Wd, m_Cd, m_Uref;  // Discrete model matrices at each step.
+  MatrixXd m_CB_row, m_QCB_row;  // Block row of Cex * Bex and Qex * Cex * Bex at each step.
+  MatrixXd m_H, m_f, m_f_vec, m_A;  // Cost and constraint matrices of the QP.
+  VectorXd m_lb, m_ub, m_lbA, m_ubA;  // Bounds of the QP.
   /**
    * @brief Get variables for MPC calculation.
    * @param trajectory The reference trajectory.
@@ -254,11 +263,32 @@ private:
    * @brief Generate the MPC matrix using the reference trajectory and vehicle model.
    * @param reference_trajectory The reference trajectory used for linearization.
    * @param prediction_dt The prediction time step.
-   * @return The generated MPC matrix.
+   * @return The generated MPC matrix, which is valid until the next call.
+   */
+  const MPCMatrix & generateMPCMatrix(
+    const MPCTrajectory & reference_trajectory, const double prediction_dt);
+
+  /**
+   * @brief Fill the prediction and weight matrices of the MPC matrix for each step.
+   * @details DIM_X, DIM_U and DIM_Y are the dimensions of the vehicle model, or Eigen::Dynamic
+   * for the models whose dimensions are not known at compile time.
+   * @param reference_trajectory The reference trajectory used for linearization.
+   * @param prediction_dt The prediction time step.
    */
-  MPCMatrix generateMPCMatrix(
+  template <int DIM_X, int DIM_U, int DIM_Y>
+  void generateMPCMatrixImpl(
     const MPCTrajectory & reference_trajectory, const double prediction_dt);
 
+  /**
+   * @brief Calculate the Hessian H and the gradient f of the condensed QP into m_H and m_f.
+   * @details Cex and Qex are block diagonal and Bex is block lower triangular, so only the
+   * non-zero blocks of Cex * Bex are used instead of the dense products.
+   * @param m The MPC matrix.
+   * @param x0 The initial state vector.
+   */
+  template <int DIM_X, int DIM_U, int DIM_Y>
+  void calcCondensedCost(const MPCMatrix & m, const VectorXd & x0);
+
   /**
    * @brief Execute the optimization using the provided MPC matrix, initial state, and prediction
    * time step.
@@ -33,6 +33,7 @@
 #include "tier4_debug_msgs/msg/float32_multi_array_stamped.hpp"
 #include "tier4_debug_msgs/msg/float32_stamped.hpp"
 
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <string>
@@ -93,8 +94,9 @@ private:
   // Flag indicating whether to keep the steering control until it converges.
   bool m_keep_steer_control_until_converged;
 
-  // MPC solver checker.
-  bool m_is_mpc_solved{true};
+  // MPC solver checker, which is read by the diagnostic updater from another thread when the
+  // controller runs on a worker thread.
+  std::atomic<bool> m_is_mpc_solved{true};
 
   // trajectory buffer for detecting new trajectory
   std::deque<Trajectory> m_trajectory_buffer;
@@ -16,13 +16,18 @@
 #define AUTOWARE__MPC_LATERAL_CONTROLLER__QP_SOLVER__QP_SOLVER_OSQP_HPP_
 
 #include "autoware/mpc_lateral_controller/qp_solver/qp_solver_interface.hpp"
+#include "osqp_interface/csc_matrix_conv.hpp"
 #include "osqp_interface/osqp_interface.hpp"
 #include "rclcpp/rclcpp.hpp"
 
+#include <vector>
+
 namespace autoware::motion::control::mpc_lateral_controller
 {
 
 /// Solver for QP problems using the OSQP library
+/// The OSQP workspace is kept while the structure of the problem is unchanged, and only the values
+/// are updated with a warm start from the previous solution shifted by one step.
 class QPSolverOSQP : public QPSolverInterface
 {
 public:
@@ -56,10 +61,39 @@ public:
   int64_t getTakenIter() const override { return osqpsolver_.getTakenIter(); }
   double getRunTime() const override { return osqpsolver_.getRunTime(); }
   double getObjVal() const override { return osqpsolver_.getObjVal(); }
+  bool isWarmStarted() const override { return is_warm_started_; }
 
 private:
   autoware::common::osqp::OSQPInterface osqpsolver_;
   rclcpp::Logger logger_;
+
+  /**
+   * @brief set the upper triangle of h_mat to p_csc_ with all the entries in the structure
+   * @param [in] h_mat parameter matrix in object function
+   */
+  void setHessianCSC(const Eigen::MatrixXd & h_mat);
+
+  /**
+   * @brief set [I; a] to a_csc_ with the non-zero entries in the structure
+   * @param [in] a parameter matrix for constraint lb_a < a*u < ub_a
+   */
+  void setConstraintCSC(const Eigen::MatrixXd & a);
+
+  // problem in the osqp format (reused to avoid reallocation)
+  autoware::common::osqp::CSC_Matrix p_csc_;
+  autoware::common::osqp::CSC_Matrix a_csc_;
+  std::vector<double> f_;
+  std::vector<double> lower_bound_;
+  std::vector<double> upper_bound_;
+
+  // constraint matrix of the problem in the workspace
+  autoware::common::osqp::CSC_Matrix prev_a_csc_;
+  bool is_workspace_initialized_ = false;
+  bool is_warm_started_ = false;
+
+  // previous solution for the warm start
+  std::vector<double> prev_primal_;
+  std::vector<double> prev_dual_;
 };
 }  // namespace autoware::motion::control::mpc_lateral_controller
 #endif  // AUTOWARE__MPC_LATERAL_CONTROLLER__QP_SOLVER__QP_SOLVER_OSQP_HPP_
@@ -73,7 +73,7 @@ bool MPC::calculateMPC(
   }
 
   // generate mpc matrix : predict equation Xec = Aex * x0 + Bex * Uex + Wex
-  const auto mpc_matrix = generateMPCMatrix(mpc_resampled_ref_trajectory, prediction_dt);
+  const auto & mpc_matrix = generateMPCMatrix(mpc_resampled_ref_trajectory, prediction_dt);
 
   // solve Optimization problem
   const auto [success_opt, Uex] = executeOptimization(
@@ -158,6 +158,8 @@ Float32MultiArrayStamped MPC::generateDiagData(
   append_diag(iteration_num);             // [18] iteration number
   append_diag(runtime);                   // [19] runtime of the latest problem solved
   append_diag(objective_value);           // [20] objective value of the latest problem solved
+  append_diag(m_qpsolver_ptr->isWarmStarted());  // [21] warm start of the latest problem solved
+  append_diag(m_qp_solve_time_ms);  // [22] time to update and solve the latest problem [ms]
 
   return diagnostic;
 }
@@ -412,7 +414,7 @@ MPCTrajectory MPC::applyVelocityDynamicsFilter(
  * cost function: J = Xex' * Qex * Xex + (Uex - Uref)' * R1ex * (Uex - Uref_ex) + Uex' * R2ex * Uex
  * Qex = diag([Q,Q,...]), R1ex = diag([R,R,...])
  */
-MPCMatrix MPC::generateMPCMatrix(
+const MPCMatrix & MPC::generateMPCMatrix(
   const MPCTrajectory & reference_trajectory, const double prediction_dt)
 {
   const int N = m_param.prediction_horizon;
@@ -421,27 +423,60 @@ MPCMatrix MPC::generateMPCMatrix(
   const int DIM_U = m_vehicle_model_ptr->getDimU();
   const int DIM_Y = m_vehicle_model_ptr->getDimY();
 
-  MPCMatrix m;
-  m.Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
-  m.Bex = MatrixXd::Zero(DIM_X * N, DIM_U * N);
-  m.Wex = MatrixXd::Zero(DIM_X * N, 1);
-  m.Cex = MatrixXd::Zero(DIM_Y * N, DIM_X * N);
-  m.Qex = MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
-  m.R1ex = MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  m.R2ex = MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  m.Uref_ex = MatrixXd::Zero(DIM_U * N, 1);
-
-  // weight matrix depends on the vehicle model
-  MatrixXd Q = MatrixXd::Zero(DIM_Y, DIM_Y);
-  MatrixXd R = MatrixXd::Zero(DIM_U, DIM_U);
-  MatrixXd Q_adaptive = MatrixXd::Zero(DIM_Y, DIM_Y);
-  MatrixXd R_adaptive = MatrixXd::Zero(DIM_U, DIM_U);
+  // NOTE: The buffers are not reallocated as long as the sizes are not changed.
+  auto & m = m_mpc_matrix;
+  m.Aex.setZero(DIM_X * N, DIM_X);
+  m.Bex.setZero(DIM_X * N, DIM_U * N);
+  m.Wex.setZero(DIM_X * N, 1);
+  m.Cex.setZero(DIM_Y * N, DIM_X * N);
+  m.Qex.setZero(DIM_Y * N, DIM_Y * N);
+  m.R1ex.setZero(DIM_U * N, DIM_U * N);
+  m.R2ex.setZero(DIM_U * N, DIM_U * N);
+  m.Uref_ex.setZero(DIM_U * N, 1);
+
+  // use the fixed-size matrices for the dimensions of the bicycle models
+  if (DIM_U == 1 && DIM_Y == 2 && DIM_X == 2) {
+    generateMPCMatrixImpl<2, 1, 2>(reference_trajectory, DT);  // kinematics_no_delay
+  } else if (DIM_U == 1 && DIM_Y == 2 && DIM_X == 3) {
+    generateMPCMatrixImpl<3, 1, 2>(reference_trajectory, DT);  // kinematics
+  } else if (DIM_U == 1 && DIM_Y == 2 && DIM_X == 4) {
+    generateMPCMatrixImpl<4, 1, 2>(reference_trajectory, DT);  // dynamics
+  } else {
+    generateMPCMatrixImpl<Eigen::Dynamic, Eigen::Dynamic, Eigen::Dynamic>(reference_trajectory, DT);
+  }
 
-  MatrixXd Ad(DIM_X, DIM_X);
-  MatrixXd Bd(DIM_X, DIM_U);
-  MatrixXd Wd(DIM_X, 1);
-  MatrixXd Cd(DIM_Y, DIM_X);
-  MatrixXd Uref(DIM_U, 1);
+  const double sign_vx = m_is_forward_shift ? 1 : -1;
+
+  // add lateral jerk : weight for (v * {u(i) - u(i-1)} )^2
+  for (int i = 0; i < N - 1; ++i) {
+    const double ref_vx = reference_trajectory.vx.at(i);
+    const double ref_k = reference_trajectory.k.at(i) * sign_vx;
+    const double j = ref_vx * ref_vx * getWeight(ref_k).lat_jerk / (DT * DT);
+    const Eigen::Matrix2d J = (Eigen::Matrix2d() << j, -j, -j, j).finished();
+    m.R2ex.block(i, i, 2, 2) += J;
+  }
+
+  addSteerWeightR(prediction_dt, m.R1ex);
+
+  return m;
+}
+
+template <int DIM_X, int DIM_U, int DIM_Y>
+void MPC::generateMPCMatrixImpl(
+  const MPCTrajectory & reference_trajectory, const double prediction_dt)
+{
+  const int N = m_param.prediction_horizon;
+  const double DT = prediction_dt;
+  const int dim_x = m_vehicle_model_ptr->getDimX();
+  const int dim_u = m_vehicle_model_ptr->getDimU();
+  const int dim_y = m_vehicle_model_ptr->getDimY();
+
+  auto & m = m_mpc_matrix;
+  m_Ad.resize(dim_x, dim_x);
+  m_Bd.resize(dim_x, dim_u);
+  m_Wd.resize(dim_x, 1);
+  m_Cd.resize(dim_y, dim_x);
+  m_Uref.resize(dim_u, 1);
 
   const double sign_vx = m_is_forward_shift ? 1 : -1;
 
@@ -457,17 +492,40 @@ MPCMatrix MPC::generateMPCMatrix(
     // get discrete state matrix A, B, C, W
     m_vehicle_model_ptr->setVelocity(ref_vx);
     m_vehicle_model_ptr->setCurvature(ref_k);
-    m_vehicle_model_ptr->calculateDiscreteMatrix(Ad, Bd, Cd, Wd, DT);
+    m_vehicle_model_ptr->calculateDiscreteMatrix(m_Ad, m_Bd, m_Cd, m_Wd, DT);
+    const Eigen::Matrix<double, DIM_X, DIM_X> Ad = m_Ad;
+    const Eigen::Matrix<double, DIM_X, DIM_U> Bd = m_Bd;
+    const Eigen::Matrix<double, DIM_X, 1> Wd = m_Wd;
 
-    Q = MatrixXd::Zero(DIM_Y, DIM_Y);
-    R = MatrixXd::Zero(DIM_U, DIM_U);
-    const auto mpc_weight = getWeight(ref_k);
-    Q(0, 0) = mpc_weight.lat_error;
-    Q(1, 1) = mpc_weight.heading_error;
-    R(0, 0) = mpc_weight.steering_input;
+    // update mpc matrix
+    const int idx_x_i = i * dim_x;
+    const int idx_x_i_prev = (i - 1) * dim_x;
+    const int idx_u_i = i * dim_u;
+    const int idx_y_i = i * dim_y;
+    auto Aex_i = m.Aex.template block<DIM_X, DIM_X>(idx_x_i, 0, dim_x, dim_x);
+    auto Wex_i = m.Wex.template block<DIM_X, 1>(idx_x_i, 0, dim_x, 1);
+    if (i == 0) {
+      Aex_i = Ad;
+      Wex_i = Wd;
+    } else {
+      Aex_i = Ad * m.Aex.template block<DIM_X, DIM_X>(idx_x_i_prev, 0, dim_x, dim_x);
+      for (int j = 0; j < i; ++j) {
+        const int idx_u_j = j * dim_u;
+        m.Bex.template block<DIM_X, DIM_U>(idx_x_i, idx_u_j, dim_x, dim_u) =
+          Ad * m.Bex.template block<DIM_X, DIM_U>(idx_x_i_prev, idx_u_j, dim_x, dim_u);
+      }
+      Wex_i = Ad * m.Wex.template block<DIM_X, 1>(idx_x_i_prev, 0, dim_x, 1) + Wd;
+    }
+    m.Bex.template block<DIM_X, DIM_U>(idx_x_i, idx_u_i, dim_x, dim_u) = Bd;
+    m.Cex.template block<DIM_Y, DIM_X>(idx_y_i, idx_x_i, dim_y, dim_x) = m_Cd;
 
-    Q_adaptive = Q;
-    R_adaptive = R;
+    // weight matrix depends on the vehicle model
+    const auto mpc_weight = getWeight(ref_k);
+    auto Q_adaptive = m.Qex.template block<DIM_Y, DIM_Y>(idx_y_i, idx_y_i, dim_y, dim_y);
+    auto R_adaptive = m.R1ex.template block<DIM_U, DIM_U>(idx_u_i, idx_u_i, dim_u, dim_u);
+    Q_adaptive(0, 0) = mpc_weight.lat_error;
+    Q_adaptive(1, 1) = mpc_weight.heading_error;
+    R_adaptive(0, 0) = mpc_weight.steering_input;
     if (i == N - 1) {
       Q_adaptive(0, 0) = m_param.nominal_weight.terminal_lat_error;
       Q_adaptive(1, 1) = m_param.nominal_weight.terminal_heading_error;
@@ -475,50 +533,14 @@ MPCMatrix MPC::generateMPCMatrix(
     Q_adaptive(1, 1) += ref_vx_squared * mpc_weight.heading_error_squared_vel;
     R_adaptive(0, 0) += ref_vx_squared * mpc_weight.steering_input_squared_vel;
 
-    // update mpc matrix
-    int idx_x_i = i * DIM_X;
-    int idx_x_i_prev = (i - 1) * DIM_X;
-    int idx_u_i = i * DIM_U;
-    int idx_y_i = i * DIM_Y;
-    if (i == 0) {
-      m.Aex.block(0, 0, DIM_X, DIM_X) = Ad;
-      m.Bex.block(0, 0, DIM_X, DIM_U) = Bd;
-      m.Wex.block(0, 0, DIM_X, 1) = Wd;
-    } else {
-      m.Aex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad * m.Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
-      for (int j = 0; j < i; ++j) {
-        int idx_u_j = j * DIM_U;
-        m.Bex.block(idx_x_i, idx_u_j, DIM_X, DIM_U) =
-          Ad * m.Bex.block(idx_x_i_prev, idx_u_j, DIM_X, DIM_U);
-      }
-      m.Wex.block(idx_x_i, 0, DIM_X, 1) = Ad * m.Wex.block(idx_x_i_prev, 0, DIM_X, 1) + Wd;
-    }
-    m.Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
-    m.Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
-    m.Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y) = Q_adaptive;
-    m.R1ex.block(idx_u_i, idx_u_i, DIM_U, DIM_U) = R_adaptive;
-
     // get reference input (feed-forward)
     m_vehicle_model_ptr->setCurvature(ref_smooth_k);
-    m_vehicle_model_ptr->calculateReferenceInput(Uref);
-    if (std::fabs(Uref(0, 0)) < autoware::universe_utils::deg2rad(m_param.zero_ff_steer_deg)) {
-      Uref(0, 0) = 0.0;  // ignore curvature noise
+    m_vehicle_model_ptr->calculateReferenceInput(m_Uref);
+    if (std::fabs(m_Uref(0, 0)) < autoware::universe_utils::deg2rad(m_param.zero_ff_steer_deg)) {
+      m_Uref(0, 0) = 0.0;  // ignore curvature noise
     }
-    m.Uref_ex.block(i * DIM_U, 0, DIM_U, 1) = Uref;
+    m.Uref_ex.template block<DIM_U, 1>(idx_u_i, 0, dim_u, 1) = m_Uref;
   }
-
-  // add lateral jerk : weight for (v * {u(i) - u(i-1)} )^2
-  for (int i = 0; i < N - 1; ++i) {
-    const double ref_vx = reference_trajectory.vx.at(i);
-    const double ref_k = reference_trajectory.k.at(i) * sign_vx;
-    const double j = ref_vx * ref_vx * getWeight(ref_k).lat_jerk / (DT * DT);
-    const Eigen::Matrix2d J = (Eigen::Matrix2d() << j, -j, -j, j).finished();
-    m.R2ex.block(i, i, 2, 2) += J;
-  }
-
-  addSteerWeightR(prediction_dt, m.R1ex);
-
-  return m;
 }
 
 /*
@@ -554,48 +576,53 @@ std::pair<bool, VectorXd> MPC::executeOptimization(
     return {false, {}};
   }
 
-  const int DIM_U_N = m_param.prediction_horizon * m_vehicle_model_ptr->getDimU();
+  const int DIM_X = m_vehicle_model_ptr->getDimX();
+  const int DIM_U = m_vehicle_model_ptr->getDimU();
+  const int DIM_Y = m_vehicle_model_ptr->getDimY();
+  const int DIM_U_N = m_param.prediction_horizon * DIM_U;
 
   // cost function: 1/2 * Uex' * H * Uex + f' * Uex,  H = B' * C' * Q * C * B + R
-  const MatrixXd CB = m.Cex * m.Bex;
-  const MatrixXd QCB = m.Qex * CB;
-  // MatrixXd H = CB.transpose() * QCB + m.R1ex + m.R2ex; // This calculation is heavy. looking for
-  // a good way.  //NOLINT
-  MatrixXd H = MatrixXd::Zero(DIM_U_N, DIM_U_N);
-  H.triangularView<Eigen::Upper>() = CB.transpose() * QCB;
-  H.triangularView<Eigen::Upper>() += m.R1ex + m.R2ex;
-  H.triangularView<Eigen::Lower>() = H.transpose();
-  MatrixXd f = (m.Cex * (m.Aex * x0 + m.Wex)).transpose() * QCB - m.Uref_ex.transpose() * m.R1ex;
-  addSteerWeightF(prediction_dt, f);
-
-  MatrixXd A = MatrixXd::Identity(DIM_U_N, DIM_U_N);
-  for (int i = 1; i < DIM_U_N; i++) {
-    A(i, i - 1) = -1.0;
+  if (DIM_U == 1 && DIM_Y == 2 && DIM_X == 2) {
+    calcCondensedCost<2, 1, 2>(m, x0);
+  } else if (DIM_U == 1 && DIM_Y == 2 && DIM_X == 3) {
+    calcCondensedCost<3, 1, 2>(m, x0);
+  } else if (DIM_U == 1 && DIM_Y == 2 && DIM_X == 4) {
+    calcCondensedCost<4, 1, 2>(m, x0);
+  } else {
+    calcCondensedCost<Eigen::Dynamic, Eigen::Dynamic, Eigen::Dynamic>(m, x0);
+  }
+  addSteerWeightF(prediction_dt, m_f);
+  m_f_vec = m_f.transpose();
+
+  // the constraint matrix only depends on the horizon
+  if (m_A.rows() != DIM_U_N) {
+    m_A = MatrixXd::Identity(DIM_U_N, DIM_U_N);
+    for (int i = 1; i < DIM_U_N; i++) {
+      m_A(i, i - 1) = -1.0;
+    }
   }
 
   // steering angle limit
-  VectorXd lb = VectorXd::Constant(DIM_U_N, -m_steer_lim);  // min steering angle
-  VectorXd ub = VectorXd::Constant(DIM_U_N, m_steer_lim);   // max steering angle
+  m_lb.setConstant(DIM_U_N, -m_steer_lim);  // min steering angle
+  m_ub.setConstant(DIM_U_N, m_steer_lim);   // max steering angle
 
   // steering angle rate limit
-  VectorXd steer_rate_limits = calcSteerRateLimitOnTrajectory(traj, current_velocity);
-  VectorXd ubA = steer_rate_limits * prediction_dt;
-  VectorXd lbA = -steer_rate_limits * prediction_dt;
-  ubA(0) = m_raw_steer_cmd_prev + steer_rate_limits(0) * m_ctrl_period;
-  lbA(0) = m_raw_steer_cmd_prev - steer_rate_limits(0) * m_ctrl_period;
+  const VectorXd steer_rate_limits = calcSteerRateLimitOnTrajectory(traj, current_velocity);
+  m_ubA = steer_rate_limits * prediction_dt;
+  m_lbA = -steer_rate_limits * prediction_dt;
+  m_ubA(0) = m_raw_steer_cmd_prev + steer_rate_limits(0) * m_ctrl_period;
+  m_lbA(0) = m_raw_steer_cmd_prev - steer_rate_limits(0) * m_ctrl_period;
 
   auto t_start = std::chrono::system_clock::now();
-  bool solve_result = m_qpsolver_ptr->solve(H, f.transpose(), A, lb, ub, lbA, ubA, Uex);
+  bool solve_result = m_qpsolver_ptr->solve(m_H, m_f_vec, m_A, m_lb, m_ub, m_lbA, m_ubA, Uex);
   auto t_end = std::chrono::system_clock::now();
+  m_qp_solve_time_ms = std::chrono::duration<double, std::milli>(t_end - t_start).count();
   if (!solve_result) {
     warn_throttle("qp solver error");
     return {false, {}};
   }
 
-  {
-    auto t = std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_start).count();
-    RCLCPP_DEBUG(m_logger, "qp solver calculation time = %ld [ms]", t);
-  }
+  RCLCPP_DEBUG(m_logger, "qp solver calculation time = %f [ms]", m_qp_solve_time_ms);
 
   if (Uex.array().isNaN().any()) {
     warn_throttle("model Uex includes NaN, stop MPC.");
@@ -604,6 +631,65 @@ std::pair<bool, VectorXd> MPC::executeOptimization(
   return {true, Uex};
 }
 
+template <int DIM_X, int DIM_U, int DIM_Y>
+void MPC::calcCondensedCost(const MPCMatrix & m, const VectorXd & x0)
+{
+  const int N = m_param.prediction_horizon;
+  const int dim_x = m_vehicle_model_ptr->getDimX();
+  const int dim_u = m_vehicle_model_ptr->getDimU();
+  const int dim_y = m_vehicle_model_ptr->getDimY();
+
+  m_CB_row.resize(dim_y, dim_u * N);
+  m_QCB_row.resize(dim_y, dim_u * N);
+  m_H.setZero(dim_u * N, dim_u * N);
+  m_f.resize(1, dim_u * N);
+  m_f.noalias() = -m.Uref_ex.transpose() * m.R1ex;
+
+  for (int i = 0; i < N; ++i) {
+    const auto C = m.Cex.template block<DIM_Y, DIM_X>(i * dim_y, i * dim_x, dim_y, dim_x);
+    const auto Q = m.Qex.template block<DIM_Y, DIM_Y>(i * dim_y, i * dim_y, dim_y, dim_y);
+    const auto CB = [&](const int j) {
+      return m_CB_row.template block<DIM_Y, DIM_U>(0, j * dim_u, dim_y, dim_u);
+    };
+    const auto QCB = [&](const int j) {
+      return m_QCB_row.template block<DIM_Y, DIM_U>(0, j * dim_u, dim_y, dim_u);
+    };
+
+    // output without the inputs: C * (Aex * x0 + Wex)
+    const Eigen::Matrix<double, DIM_Y, 1> y =
+      C * (m.Aex.template block<DIM_X, DIM_X>(i * dim_x, 0, dim_x, dim_x) * x0 +
+           m.Wex.template block<DIM_X, 1>(i * dim_x, 0, dim_x, 1));
+
+    // the blocks of the i-th output depending on the j-th input (j <= i)
+    for (int j = 0; j <= i; ++j) {
+      CB(j).noalias() = C * m.Bex.template block<DIM_X, DIM_U>(i * dim_x, j * dim_u, dim_x, dim_u);
+      QCB(j).noalias() = Q * CB(j);
+      m_f.template block<1, DIM_U>(0, j * dim_u, 1, dim_u).noalias() += y.transpose() * QCB(j);
+    }
+
+    // upper blocks of H += CB_i' * QCB_i
+    for (int k = 0; k <= i; ++k) {
+      for (int j = 0; j <= k; ++j) {
+        m_H.template block<DIM_U, DIM_U>(j * dim_u, k * dim_u, dim_u, dim_u).noalias() +=
+          CB(j).transpose() * QCB(k);
+      }
+    }
+  }
+
+  // H = CB' * QCB + R1ex + R2ex, which is symmetric
+  const int DIM_U_N = dim_u * N;
+  for (int c = 0; c < DIM_U_N; ++c) {
+    for (int r = 0; r <= c; ++r) {
+      m_H(r, c) += m.R1ex(r, c) + m.R2ex(r, c);
+    }
+  }
+  for (int c = 0; c < DIM_U_N; ++c) {
+    for (int r = c + 1; r < DIM_U_N; ++r) {
+      m_H(r, c) = m_H(c, r);
+    }
+  }
+}
+
 void MPC::addSteerWeightR(const double prediction_dt, MatrixXd & R) const
 {
   const int N = m_param.prediction_horizon;
@@ -716,14 +802,13 @@ double MPC::calcDesiredSteeringRate(
     return (u_filtered - current_steer) / predict_dt;
   }
 
-  // calculate predicted states to get the steering motion
+  // calculate predicted state of the first step to get the steering motion
   const auto & m = mpc_matrix;
-  const MatrixXd Xex = m.Aex * x0 + m.Bex * Uex + m.Wex;
-
   const size_t STEER_IDX = 2;  // for kinematics model
 
   const auto steer_0 = x0(STEER_IDX, 0);
-  const auto steer_1 = Xex(STEER_IDX, 0);
+  const auto steer_1 = m.Aex.row(STEER_IDX).dot(x0.col(0)) +
+                       m.Bex.row(STEER_IDX).dot(Uex.col(0)) + m.Wex(STEER_IDX, 0);
 
   const auto steer_rate = (steer_1 - steer_0) / predict_dt;
 
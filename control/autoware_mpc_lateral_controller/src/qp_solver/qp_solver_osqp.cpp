@@ -14,57 +14,148 @@
 
 #include "autoware/mpc_lateral_controller/qp_solver/qp_solver_osqp.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 
 namespace autoware::motion::control::mpc_lateral_controller
 {
+namespace
+{
+// shift the values in [begin, end) forward by one step and keep the last value
+void shiftByOneStep(std::vector<double> & values, const size_t begin, const size_t end)
+{
+  if (end <= begin + 1 || values.size() < end) {
+    return;
+  }
+  std::copy(values.begin() + begin + 1, values.begin() + end, values.begin() + begin);
+}
+}  // namespace
+
 QPSolverOSQP::QPSolverOSQP(const rclcpp::Logger & logger) : logger_{logger}
 {
 }
+
+void QPSolverOSQP::setHessianCSC(const Eigen::MatrixXd & h_mat)
+{
+  // NOTE: The entries which are zero now are also kept in the structure so that the structure
+  //       depends only on the size and the workspace can be reused in the next solves.
+  const Eigen::Index dim_u = h_mat.rows();
+  p_csc_.m_vals.clear();
+  p_csc_.m_row_idxs.clear();
+  p_csc_.m_col_idxs.assign(1, 0);
+  for (Eigen::Index j = 0; j < dim_u; ++j) {
+    for (Eigen::Index i = 0; i <= j; ++i) {
+      // same threshold as calCSCMatrixTrapezoidal
+      const double val = h_mat(i, j);
+      p_csc_.m_vals.push_back(std::fabs(val) < 1e-9 ? 0.0 : val);
+      p_csc_.m_row_idxs.push_back(static_cast<c_int>(i));
+    }
+    p_csc_.m_col_idxs.push_back(static_cast<c_int>(p_csc_.m_vals.size()));
+  }
+}
+
+void QPSolverOSQP::setConstraintCSC(const Eigen::MatrixXd & a)
+{
+  const Eigen::Index dim_u = a.cols();
+  a_csc_.m_vals.clear();
+  a_csc_.m_row_idxs.clear();
+  a_csc_.m_col_idxs.assign(1, 0);
+  for (Eigen::Index j = 0; j < dim_u; ++j) {
+    // identity for the constraint lb < u < ub
+    a_csc_.m_vals.push_back(1.0);
+    a_csc_.m_row_idxs.push_back(static_cast<c_int>(j));
+    for (Eigen::Index i = 0; i < a.rows(); ++i) {
+      // same threshold as calCSCMatrix
+      const double val = a(i, j);
+      if (std::fabs(val) < 1e-9) {
+        continue;
+      }
+      a_csc_.m_vals.push_back(val);
+      a_csc_.m_row_idxs.push_back(static_cast<c_int>(dim_u + i));
+    }
+    a_csc_.m_col_idxs.push_back(static_cast<c_int>(a_csc_.m_vals.size()));
+  }
+}
+
 bool QPSolverOSQP::solve(
   const Eigen::MatrixXd & h_mat, const Eigen::MatrixXd & f_vec, const Eigen::MatrixXd & a,
   const Eigen::VectorXd & lb, const Eigen::VectorXd & ub, const Eigen::VectorXd & lb_a,
   const Eigen::VectorXd & ub_a, Eigen::VectorXd & u)
 {
-  const Eigen::Index raw_a = a.rows();
-  const Eigen::Index col_a = a.cols();
   const Eigen::Index dim_u = ub.size();
-  Eigen::MatrixXd Identity = Eigen::MatrixXd::Identity(dim_u, dim_u);
+  const Eigen::Index dim_a = a.rows();
 
   // convert matrix to vector for osqpsolver
-  std::vector<double> f(&f_vec(0), f_vec.data() + f_vec.cols() * f_vec.rows());
-
-  std::vector<double> lower_bound;
-  std::vector<double> upper_bound;
+  f_.assign(f_vec.data(), f_vec.data() + f_vec.size());
 
-  for (int i = 0; i < dim_u; ++i) {
-    lower_bound.push_back(lb(i));
-    upper_bound.push_back(ub(i));
-  }
+  lower_bound_.resize(dim_u + dim_a);
+  upper_bound_.resize(dim_u + dim_a);
+  Eigen::Map<Eigen::VectorXd>(lower_bound_.data(), dim_u) = lb;
+  Eigen::Map<Eigen::VectorXd>(upper_bound_.data(), dim_u) = ub;
+  Eigen::Map<Eigen::VectorXd>(lower_bound_.data() + dim_u, dim_a) = lb_a;
+  Eigen::Map<Eigen::VectorXd>(upper_bound_.data() + dim_u, dim_a) = ub_a;
 
-  for (int i = 0; i < col_a; ++i) {
-    lower_bound.push_back(lb_a(i));
-    upper_bound.push_back(ub_a(i));
-  }
+  setHessianCSC(h_mat);
+  setConstraintCSC(a);
 
-  Eigen::MatrixXd osqpA = Eigen::MatrixXd(dim_u + col_a, raw_a);
-  osqpA << Identity, a;
+  const bool is_same_structure = is_workspace_initialized_ &&
+                                 prev_primal_.size() == static_cast<size_t>(dim_u) &&
+                                 prev_dual_.size() == lower_bound_.size() &&
+                                 a_csc_.m_row_idxs == prev_a_csc_.m_row_idxs &&
+                                 a_csc_.m_col_idxs == prev_a_csc_.m_col_idxs;
 
   /* execute optimization */
-  auto result = osqpsolver_.optimize(h_mat, osqpA, f, lower_bound, upper_bound);
+  if (is_same_structure) {
+    // update the values only, so that the factorization structure is reused
+    osqpsolver_.updateCscP(p_csc_);
+    if (a_csc_.m_vals != prev_a_csc_.m_vals) {
+      osqpsolver_.updateCscA(a_csc_);
+      prev_a_csc_.m_vals = a_csc_.m_vals;
+    }
+    osqpsolver_.updateQ(f_);
+    osqpsolver_.updateBounds(lower_bound_, upper_bound_);
 
-  std::vector<double> U_osqp = std::get<0>(result);
+    // warm start with the previous solution shifted by one step
+    // NOTE: the lateral MPC has one input (steering) per step
+    shiftByOneStep(prev_primal_, 0, dim_u);
+    shiftByOneStep(prev_dual_, 0, dim_u);
+    shiftByOneStep(prev_dual_, dim_u, dim_u + dim_a);
+    is_warm_started_ = osqpsolver_.setWarmStart(prev_primal_, prev_dual_);
+  } else {
+    const auto exit_flag =
+      osqpsolver_.initializeProblem(p_csc_, a_csc_, f_, lower_bound_, upper_bound_);
+    is_warm_started_ = false;
+    is_workspace_initialized_ = exit_flag == 0;
+    if (!is_workspace_initialized_) {
+      RCLCPP_WARN(
+        logger_, "optimization failed : osqp setup error (%d)", static_cast<int>(exit_flag));
+      return false;
+    }
+    prev_a_csc_ = a_csc_;
+  }
+  auto result = osqpsolver_.optimize();
+
+  std::vector<double> & U_osqp = std::get<0>(result);
   u = Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, 1>>(
     &U_osqp[0], static_cast<Eigen::Index>(U_osqp.size()), 1);
 
   const int status_val = std::get<3>(result);
+  const auto has_nan =
+    std::any_of(U_osqp.begin(), U_osqp.end(), [](const auto v) { return std::isnan(v); });
+
+  // set up the workspace again in the next solve unless the solution is usable for the warm start
+  is_workspace_initialized_ = status_val == 1 && !has_nan;
+  if (is_workspace_initialized_) {
+    prev_primal_.swap(U_osqp);
+    prev_dual_.swap(std::get<1>(result));
+  }
+
   if (status_val != 1) {
     RCLCPP_WARN(logger_, "optimization failed : %s", osqpsolver_.getStatusMessage().c_str());
     return false;
   }
-  const auto has_nan =
-    std::any_of(U_osqp.begin(), U_osqp.end(), [](const auto v) { return std::isnan(v); });
   if (has_nan) {
     RCLCPP_WARN(logger_, "optimization failed: result contains NaN values");
     return false;
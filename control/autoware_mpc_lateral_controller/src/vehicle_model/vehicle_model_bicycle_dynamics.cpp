@@ -44,37 +44,38 @@ void DynamicsBicycleModel::calculateDiscreteMatrix(
 
   const double vel = std::max(m_velocity, 0.01);
 
-  a_d = Eigen::MatrixXd::Zero(m_dim_x, m_dim_x);
-  a_d(0, 1) = 1.0;
-  a_d(1, 1) = -(m_cf + m_cr) / (m_mass * vel);
-  a_d(1, 2) = (m_cf + m_cr) / m_mass;
-  a_d(1, 3) = (m_lr * m_cr - m_lf * m_cf) / (m_mass * vel);
-  a_d(2, 3) = 1.0;
-  a_d(3, 1) = (m_lr * m_cr - m_lf * m_cf) / (m_iz * vel);
-  a_d(3, 2) = (m_lf * m_cf - m_lr * m_cr) / m_iz;
-  a_d(3, 3) = -(m_lf * m_lf * m_cf + m_lr * m_lr * m_cr) / (m_iz * vel);
-
-  Eigen::MatrixXd I = Eigen::MatrixXd::Identity(m_dim_x, m_dim_x);
-  Eigen::MatrixXd a_d_inverse = (I - dt * 0.5 * a_d).inverse();
-
-  a_d = a_d_inverse * (I + dt * 0.5 * a_d);  // bilinear discretization
-
-  b_d = Eigen::MatrixXd::Zero(m_dim_x, m_dim_u);
-  b_d(0, 0) = 0.0;
-  b_d(1, 0) = m_cf / m_mass;
-  b_d(2, 0) = 0.0;
-  b_d(3, 0) = m_lf * m_cf / m_iz;
-
-  w_d = Eigen::MatrixXd::Zero(m_dim_x, 1);
-  w_d(0, 0) = 0.0;
-  w_d(1, 0) = (m_lr * m_cr - m_lf * m_cf) / (m_mass * vel) - vel;
-  w_d(2, 0) = 0.0;
-  w_d(3, 0) = -(m_lf * m_lf * m_cf + m_lr * m_lr * m_cr) / (m_iz * vel);
-
-  b_d = (a_d_inverse * dt) * b_d;
-  w_d = (a_d_inverse * dt * m_curvature * vel) * w_d;
-
-  c_d = Eigen::MatrixXd::Zero(m_dim_y, m_dim_x);
+  // NOTE: fixed-size matrices are used for the calculation so that no heap allocation is needed
+  Eigen::Matrix4d a = Eigen::Matrix4d::Zero();
+  a(0, 1) = 1.0;
+  a(1, 1) = -(m_cf + m_cr) / (m_mass * vel);
+  a(1, 2) = (m_cf + m_cr) / m_mass;
+  a(1, 3) = (m_lr * m_cr - m_lf * m_cf) / (m_mass * vel);
+  a(2, 3) = 1.0;
+  a(3, 1) = (m_lr * m_cr - m_lf * m_cf) / (m_iz * vel);
+  a(3, 2) = (m_lf * m_cf - m_lr * m_cr) / m_iz;
+  a(3, 3) = -(m_lf * m_lf * m_cf + m_lr * m_lr * m_cr) / (m_iz * vel);
+
+  const Eigen::Matrix4d I = Eigen::Matrix4d::Identity();
+  const Eigen::Matrix4d a_d_inverse = (I - dt * 0.5 * a).inverse();
+
+  a_d = a_d_inverse * (I + dt * 0.5 * a);  // bilinear discretization
+
+  Eigen::Vector4d b = Eigen::Vector4d::Zero();
+  b(0, 0) = 0.0;
+  b(1, 0) = m_cf / m_mass;
+  b(2, 0) = 0.0;
+  b(3, 0) = m_lf * m_cf / m_iz;
+
+  Eigen::Vector4d w = Eigen::Vector4d::Zero();
+  w(0, 0) = 0.0;
+  w(1, 0) = (m_lr * m_cr - m_lf * m_cf) / (m_mass * vel) - vel;
+  w(2, 0) = 0.0;
+  w(3, 0) = -(m_lf * m_lf * m_cf + m_lr * m_lr * m_cr) / (m_iz * vel);
+
+  b_d = (a_d_inverse * dt) * b;
+  w_d = (a_d_inverse * dt * m_curvature * vel) * w;
+
+  c_d.setZero(m_dim_y, m_dim_x);
   c_d(0, 0) = 1.0;
   c_d(1, 2) = 1.0;
 }
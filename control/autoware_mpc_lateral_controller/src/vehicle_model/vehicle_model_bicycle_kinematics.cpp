@@ -43,25 +43,30 @@ void KinematicsBicycleModel::calculateDiscreteMatrix(
     velocity = 1e-04 * (m_velocity >= 0 ? 1 : -1);
   }
 
-  a_d << 0.0, velocity, 0.0, 0.0, 0.0, velocity / m_wheelbase * cos_delta_r_squared_inv, 0.0, 0.0,
+  // NOTE: fixed-size matrices are used for the calculation so that no heap allocation is needed
+  Eigen::Matrix3d a;
+  a << 0.0, velocity, 0.0, 0.0, 0.0, velocity / m_wheelbase * cos_delta_r_squared_inv, 0.0, 0.0,
     -1.0 / m_steer_tau;
 
-  b_d << 0.0, 0.0, 1.0 / m_steer_tau;
+  Eigen::Vector3d b;
+  b << 0.0, 0.0, 1.0 / m_steer_tau;
 
+  c_d.resize(m_dim_y, m_dim_x);
   c_d << 1.0, 0.0, 0.0, 0.0, 1.0, 0.0;
 
-  w_d << 0.0,
+  Eigen::Vector3d w;
+  w << 0.0,
     -velocity * m_curvature +
       velocity / m_wheelbase * (tan(delta_r) - delta_r * cos_delta_r_squared_inv),
     0.0;
 
   // bilinear discretization for ZOH system
   // no discretization is needed for Cd
-  Eigen::MatrixXd I = Eigen::MatrixXd::Identity(m_dim_x, m_dim_x);
-  const Eigen::MatrixXd i_dt2a_inv = (I - dt * 0.5 * a_d).inverse();
-  a_d = i_dt2a_inv * (I + dt * 0.5 * a_d);
-  b_d = i_dt2a_inv * b_d * dt;
-  w_d = i_dt2a_inv * w_d * dt;
+  const Eigen::Matrix3d I = Eigen::Matrix3d::Identity();
+  const Eigen::Matrix3d i_dt2a_inv = (I - dt * 0.5 * a).inverse();
+  a_d = i_dt2a_inv * (I + dt * 0.5 * a);
+  b_d = i_dt2a_inv * b * dt;
+  w_d = i_dt2a_inv * w * dt;
 }
 
 void KinematicsBicycleModel::calculateReferenceInput(Eigen::MatrixXd & u_ref)
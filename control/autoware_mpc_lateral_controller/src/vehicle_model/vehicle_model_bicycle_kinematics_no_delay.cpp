@@ -38,21 +38,26 @@ void KinematicsBicycleModelNoDelay::calculateDiscreteMatrix(
   }
   double cos_delta_r_squared_inv = 1 / (cos(delta_r) * cos(delta_r));
 
-  a_d << 0.0, m_velocity, 0.0, 0.0;
+  // NOTE: fixed-size matrices are used for the calculation so that no heap allocation is needed
+  Eigen::Matrix2d a;
+  a << 0.0, m_velocity, 0.0, 0.0;
 
-  b_d << 0.0, m_velocity / m_wheelbase * cos_delta_r_squared_inv;
+  Eigen::Vector2d b;
+  b << 0.0, m_velocity / m_wheelbase * cos_delta_r_squared_inv;
 
+  c_d.resize(m_dim_y, m_dim_x);
   c_d << 1.0, 0.0, 0.0, 1.0;
 
-  w_d << 0.0, -m_velocity / m_wheelbase * delta_r * cos_delta_r_squared_inv;
+  Eigen::Vector2d w;
+  w << 0.0, -m_velocity / m_wheelbase * delta_r * cos_delta_r_squared_inv;
 
   // bilinear discretization for ZOH system
   // no discretization is needed for Cd
-  Eigen::MatrixXd I = Eigen::MatrixXd::Identity(m_dim_x, m_dim_x);
-  const Eigen::MatrixXd i_dt2a_inv = (I - dt * 0.5 * a_d).inverse();
-  a_d = i_dt2a_inv * (I + dt * 0.5 * a_d);
-  b_d = i_dt2a_inv * b_d * dt;
-  w_d = i_dt2a_inv * w_d * dt;
+  const Eigen::Matrix2d I = Eigen::Matrix2d::Identity();
+  const Eigen::Matrix2d i_dt2a_inv = (I - dt * 0.5 * a).inverse();
+  a_d = i_dt2a_inv * (I + dt * 0.5 * a);
+  b_d = i_dt2a_inv * b * dt;
+  w_d = i_dt2a_inv * w * dt;
 }
 
 void KinematicsBicycleModelNoDelay::calculateReferenceInput(Eigen::MatrixXd & u_ref)
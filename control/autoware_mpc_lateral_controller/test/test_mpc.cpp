@@ -34,6 +34,9 @@
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -302,6 +305,143 @@ TEST_F(MPCTest, OsqpCalculateRightTurn)
   EXPECT_LT(ctrl_cmd.steering_tire_rotation_rate, 0.0f);
 }
 
+TEST_F(MPCTest, OsqpWarmStart)
+{
+  auto node = rclcpp::Node("mpc_test_node", rclcpp::NodeOptions{});
+  const auto calculate = [&](MPC & mpc, const Pose & pose, Lateral & ctrl_cmd) {
+    const auto current_kinematics = makeOdometry(pose, default_velocity);
+    mpc.setReferenceTrajectory(dummy_right_turn_trajectory, trajectory_param, current_kinematics);
+    Trajectory pred_traj;
+    Float32MultiArrayStamped diag;
+    const bool result =
+      mpc.calculateMPC(neutral_steer, current_kinematics, ctrl_cmd, pred_traj, diag);
+    return std::make_pair(result, diag);
+  };
+  const auto create_mpc = [&]() {
+    auto mpc = std::make_unique<MPC>(node);
+    initializeMPC(*mpc);
+    mpc->setVehicleModel(
+      std::make_shared<KinematicsBicycleModel>(wheelbase, steer_limit, steer_tau));
+    mpc->setQPSolver(std::make_shared<QPSolverOSQP>(logger));
+    return mpc;
+  };
+
+  // solve the problems of the consecutive cycles with the same solver
+  auto mpc = create_mpc();
+  Lateral ctrl_cmd;
+  const auto [first_result, first_diag] = calculate(*mpc, pose_zero, ctrl_cmd);
+  ASSERT_TRUE(first_result);
+  EXPECT_EQ(first_diag.data.at(21), 0.0f);
+
+  Pose pose = pose_zero;
+  pose.position.x = 0.05;
+  pose.position.y = -0.02;
+  const auto [second_result, second_diag] = calculate(*mpc, pose, ctrl_cmd);
+  ASSERT_TRUE(second_result);
+  EXPECT_EQ(second_diag.data.at(21), 1.0f);
+
+  // the result is close to the one of a new solver within the tolerance of the solver
+  auto new_mpc = create_mpc();
+  Lateral new_ctrl_cmd;
+  calculate(*new_mpc, pose_zero, new_ctrl_cmd);
+  new_mpc->setQPSolver(std::make_shared<QPSolverOSQP>(logger));
+  ASSERT_TRUE(calculate(*new_mpc, pose, new_ctrl_cmd).first);
+  EXPECT_NEAR(ctrl_cmd.steering_tire_angle, new_ctrl_cmd.steering_tire_angle, 1e-3);
+  EXPECT_LT(ctrl_cmd.steering_tire_angle, 0.0f);
+}
+
+TEST_F(MPCTest, DISABLED_benchmarkOsqpWarmStart)
+{
+  // drive along a sinusoidal path with a lateral offset
+  Trajectory trajectory;
+  for (int i = 0; i < 300; ++i) {
+    const double x = static_cast<double>(i);
+    trajectory.points.push_back(makePoint(x, 3.0 * std::sin(x / 15.0), 5.0f));
+  }
+  std::vector<Pose> poses;
+  for (double x = 10.0; x < 250.0; x += 0.15) {
+    Pose pose;
+    pose.position.x = x;
+    pose.position.y = 3.0 * std::sin(x / 15.0) + 0.2 * std::sin(x / 4.0);
+    tf2::Quaternion q;
+    q.setRPY(0.0, 0.0, std::atan(0.2 * std::cos(x / 15.0)));
+    pose.orientation = tf2::toMsg(q);
+    poses.push_back(pose);
+  }
+
+  auto node = rclcpp::Node("mpc_test_node", rclcpp::NodeOptions{});
+  std::cout << "solver, mean iteration, mean qp time [ms], max qp time [ms]" << std::endl;
+  for (const bool reuse_solver : {false, true}) {
+    auto mpc = std::make_unique<MPC>(node);
+    initializeMPC(*mpc);
+    mpc->setVehicleModel(
+      std::make_shared<KinematicsBicycleModel>(wheelbase, steer_limit, steer_tau));
+    mpc->setQPSolver(std::make_shared<QPSolverOSQP>(logger));
+
+    double sum_iteration = 0.0;
+    double sum_time = 0.0;
+    double max_time = 0.0;
+    for (const auto & pose : poses) {
+      if (!reuse_solver) {
+        mpc->setQPSolver(std::make_shared<QPSolverOSQP>(logger));
+      }
+      const auto current_kinematics = makeOdometry(pose, 5.0);
+      mpc->setReferenceTrajectory(trajectory, trajectory_param, current_kinematics);
+      Lateral ctrl_cmd;
+      Trajectory pred_traj;
+      Float32MultiArrayStamped diag;
+      ASSERT_TRUE(mpc->calculateMPC(neutral_steer, current_kinematics, ctrl_cmd, pred_traj, diag));
+      sum_iteration += diag.data.at(18);
+      sum_time += diag.data.at(22);
+      max_time = std::max(max_time, static_cast<double>(diag.data.at(22)));
+    }
+    const double num = static_cast<double>(poses.size());
+    std::cout << (reuse_solver ? "warm start" : "cold start") << ", " << sum_iteration / num
+              << ", " << sum_time / num << ", " << max_time << std::endl;
+  }
+}
+
+TEST_F(MPCTest, ReuseBuffersAfterModelAndHorizonChange)
+{
+  const auto calculate = [&](MPC & mpc, Lateral & ctrl_cmd) {
+    const auto current_kinematics =
+      makeOdometry(dummy_right_turn_trajectory.points.front().pose, 0.0);
+    mpc.setReferenceTrajectory(dummy_right_turn_trajectory, trajectory_param, current_kinematics);
+    mpc.resetPrevResult(neutral_steer);
+    Trajectory pred_traj;
+    Float32MultiArrayStamped diag;
+    return mpc.calculateMPC(
+      neutral_steer, makeOdometry(pose_zero, default_velocity), ctrl_cmd, pred_traj, diag);
+  };
+  auto node = rclcpp::Node("mpc_test_node", rclcpp::NodeOptions{});
+  std::shared_ptr<QPSolverInterface> qpsolver_ptr = std::make_shared<QPSolverEigenLeastSquareLLT>();
+
+  // calculate with the kinematics model, then with the dynamics model and a shorter horizon
+  auto mpc = std::make_unique<MPC>(node);
+  mpc->setVehicleModel(std::make_shared<KinematicsBicycleModel>(wheelbase, steer_limit, steer_tau));
+  mpc->setQPSolver(qpsolver_ptr);
+  initializeMPC(*mpc);
+  Lateral ctrl_cmd;
+  ASSERT_TRUE(calculate(*mpc, ctrl_cmd));
+
+  param.prediction_horizon = 30;
+  mpc->setVehicleModel(std::make_shared<DynamicsBicycleModel>(
+    wheelbase, mass_fl, mass_fr, mass_rl, mass_rr, cf, cr));
+  initializeMPC(*mpc);
+  ASSERT_TRUE(calculate(*mpc, ctrl_cmd));
+
+  // the result is the same as the one of a new MPC
+  auto new_mpc = std::make_unique<MPC>(node);
+  new_mpc->setVehicleModel(std::make_shared<DynamicsBicycleModel>(
+    wheelbase, mass_fl, mass_fr, mass_rl, mass_rr, cf, cr));
+  new_mpc->setQPSolver(qpsolver_ptr);
+  initializeMPC(*new_mpc);
+  Lateral new_ctrl_cmd;
+  ASSERT_TRUE(calculate(*new_mpc, new_ctrl_cmd));
+  EXPECT_FLOAT_EQ(ctrl_cmd.steering_tire_angle, new_ctrl_cmd.steering_tire_angle);
+  EXPECT_FLOAT_EQ(ctrl_cmd.steering_tire_rotation_rate, new_ctrl_cmd.steering_tire_rotation_rate);
+}
+
 TEST_F(MPCTest, KinematicsNoDelayCalculate)
 {
   auto node = rclcpp::Node("mpc_test_node", rclcpp::NodeOptions{});
@@ -78,6 +78,9 @@ private:
   std::shared_ptr<std::vector<geometry_msgs::msg::Pose>> curr_wps_ptr_;
   std::shared_ptr<geometry_msgs::msg::Pose> curr_pose_ptr_;
 
+  // cumulative 2D arc length of the waypoints, which is computed when the waypoints are set
+  std::vector<double> curr_wps_arc_lengths_;
+
   // functions
   int32_t findNextPointIdx(int32_t search_start_idx);
   std::pair<bool, geometry_msgs::msg::Point> lerpNextTarget(int32_t next_wp_idx);
@@ -113,6 +113,10 @@ private:
   autoware_vehicle_msgs::msg::SteeringReport current_steering_;
   boost::optional<Lateral> prev_cmd_;
 
+  // tables of the resampled trajectory, which are computed once per received trajectory
+  std::vector<double> trajectory_resampled_arc_lengths_;
+  std::vector<double> trajectory_resampled_curvatures_;
+
   // Debug Publisher
   rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr pub_debug_marker_;
   rclcpp::Publisher<tier4_debug_msgs::msg::Float32MultiArrayStamped>::SharedPtr pub_debug_values_;
@@ -125,6 +129,11 @@ private:
 
   void setResampledTrajectory();
 
+  /**
+   * @brief resample and filter the trajectory and compute its tables only when it is updated
+   */
+  void updateTrajectory(const Trajectory & trajectory);
+
   // TF
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_;
@@ -171,6 +171,32 @@ void PurePursuitLateralController::setResampledTrajectory()
   output_tp_array_ = autoware::motion_utils::convertToTrajectoryPointArray(*trajectory_resampled_);
 }
 
+void PurePursuitLateralController::updateTrajectory(const Trajectory & trajectory)
+{
+  if (trajectory_resampled_ && trajectory == trajectory_) {
+    return;
+  }
+
+  trajectory_ = trajectory;
+  setResampledTrajectory();
+  if (param_.enable_path_smoothing) {
+    averageFilterTrajectory(*trajectory_resampled_);
+  }
+
+  const auto & points = trajectory_resampled_->points;
+  trajectory_resampled_arc_lengths_.resize(points.size());
+  trajectory_resampled_curvatures_.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    trajectory_resampled_arc_lengths_.at(i) =
+      (i == 0) ? 0.0
+               : trajectory_resampled_arc_lengths_.at(i - 1) +
+                   planning_utils::calcArcLengthFromWayPoint(*trajectory_resampled_, i - 1, i);
+    trajectory_resampled_curvatures_.at(i) = calcCurvature(i);
+  }
+
+  pure_pursuit_->setWaypoints(planning_utils::extractPoses(*trajectory_resampled_));
+}
+
 double PurePursuitLateralController::calcCurvature(const size_t closest_idx)
 {
   // Calculate current curvature
@@ -275,8 +301,8 @@ boost::optional<Trajectory> PurePursuitLateralController::generatePredictedTraje
     return boost::none;
   }
 
-  const double remaining_distance = planning_utils::calcArcLengthFromWayPoint(
-    *trajectory_resampled_, *closest_idx_result, trajectory_resampled_->points.size() - 1);
+  const double remaining_distance = trajectory_resampled_arc_lengths_.back() -
+                                    trajectory_resampled_arc_lengths_.at(*closest_idx_result);
 
   const auto num_of_iteration = std::max(
     static_cast<int>(std::ceil(
@@ -340,14 +366,10 @@ bool PurePursuitLateralController::isReady([[maybe_unused]] const InputData & in
 LateralOutput PurePursuitLateralController::run(const InputData & input_data)
 {
   current_pose_ = input_data.current_odometry.pose.pose;
-  trajectory_ = input_data.current_trajectory;
   current_odometry_ = input_data.current_odometry;
   current_steering_ = input_data.current_steering;
 
-  setResampledTrajectory();
-  if (param_.enable_path_smoothing) {
-    averageFilterTrajectory(*trajectory_resampled_);
-  }
+  updateTrajectory(input_data.current_trajectory);
   const auto cmd_msg = generateOutputControlCmd();
 
   LateralOutput output;
@@ -443,7 +465,7 @@ boost::optional<PpOutput> PurePursuitLateralController::calcTargetCurvature(
 
   // calculate the current curvature
 
-  const double current_curvature = calcCurvature(*closest_idx_result);
+  const double current_curvature = trajectory_resampled_curvatures_.at(*closest_idx_result);
 
   // Calculate lookahead distance
 
@@ -460,7 +482,6 @@ boost::optional<PpOutput> PurePursuitLateralController::calcTargetCurvature(
 
   // Set PurePursuit data
   pure_pursuit_->setCurrentPose(pose);
-  pure_pursuit_->setWaypoints(planning_utils::extractPoses(*trajectory_resampled_));
   pure_pursuit_->setLookaheadDistance(lookahead_distance);
 
   // Run PurePursuit
@@ -31,6 +31,8 @@
 
 #include "autoware/pure_pursuit/util/planning_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -155,15 +157,40 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
     return -1;
   }
 
+  // if search waypoint is the last
+  const auto last_idx = static_cast<int32_t>(curr_wps_ptr_->size()) - 1;
+  if (search_start_idx == last_idx) {
+    return last_idx;
+  }
+
+  // the lane direction does not depend on the waypoint, and the waypoint is lost if the direction
+  // cannot be determined, even when the search below would reach the last waypoint
+  const auto gld = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
+  if (gld != 0 && gld != 1) {
+    return -1;
+  }
+
+  // The waypoints whose arc length from the search start is shorter than the lookahead distance
+  // minus the distance to the search start are closer to the ego than the lookahead distance, so
+  // the search skips them with a binary search on the cumulative arc length.
+  constexpr double arc_length_margin = 1e-6;
+  const double dist_to_search_start = std::sqrt(planning_utils::calcDistSquared2D(
+    curr_wps_ptr_->at(search_start_idx).position, curr_pose_ptr_->position));
+  const double min_arc_length = curr_wps_arc_lengths_.at(search_start_idx) + lookahead_distance_ -
+                                dist_to_search_start - arc_length_margin;
+  const auto first_candidate_itr = std::lower_bound(
+    curr_wps_arc_lengths_.begin() + search_start_idx, curr_wps_arc_lengths_.end(), min_arc_length);
+  const auto first_candidate_idx = std::min(
+    static_cast<int32_t>(first_candidate_itr - curr_wps_arc_lengths_.begin()), last_idx);
+
   // look for the next waypoint.
-  for (int32_t i = search_start_idx; i < (int32_t)curr_wps_ptr_->size(); i++) {
+  for (int32_t i = first_candidate_idx; i < (int32_t)curr_wps_ptr_->size(); i++) {
     // if search waypoint is the last
-    if (i == ((int32_t)curr_wps_ptr_->size() - 1)) {
+    if (i == last_idx) {
       return i;
     }
 
     // if waypoint direction is forward
-    const auto gld = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
     if (gld == 0) {
       // if waypoint is not in front of ego, skip
       auto ret = planning_utils::transformToRelativeCoordinate2D(
@@ -171,7 +198,7 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
       if (ret.x < 0) {
         continue;
       }
-    } else if (gld == 1) {
+    } else {
       // waypoint direction is backward
 
       // if waypoint is in front of ego, skip
@@ -180,8 +207,6 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
       if (ret.x > 0) {
         continue;
       }
-    } else {
-      return -1;
     }
 
     const geometry_msgs::msg::Point & curr_motion_point = curr_wps_ptr_->at(i).position;
@@ -207,6 +232,15 @@ void PurePursuit::setWaypoints(const std::vector<geometry_msgs::msg::Pose> & msg
 {
   curr_wps_ptr_ = std::make_shared<std::vector<geometry_msgs::msg::Pose>>();
   *curr_wps_ptr_ = msg;
+
+  curr_wps_arc_lengths_.resize(msg.size());
+  for (size_t i = 0; i < msg.size(); ++i) {
+    curr_wps_arc_lengths_.at(i) =
+      (i == 0) ? 0.0
+               : curr_wps_arc_lengths_.at(i - 1) +
+                   std::sqrt(planning_utils::calcDistSquared2D(
+                     msg.at(i - 1).position, msg.at(i).position));
+  }
 }
 
 }  // namespace autoware::pure_pursuit
@@ -0,0 +1,163 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pure_pursuit/autoware_pure_pursuit.hpp"
+#include "autoware/pure_pursuit/util/planning_utils.hpp"
+
+#include <autoware/universe_utils/geometry/geometry.hpp>
+
+#include <gtest/gtest.h>
+#include <tf2/utils.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using autoware::pure_pursuit::PurePursuit;
+namespace planning_utils = autoware::pure_pursuit::planning_utils;
+using geometry_msgs::msg::Pose;
+
+namespace
+{
+constexpr double closest_thr_dist = 3.0;
+constexpr double closest_thr_ang = M_PI / 4;
+
+// the linear scan of the next waypoint from the closest waypoint, without skipping the waypoints
+// by the arc length
+int32_t findNextPointIdxReference(
+  const std::vector<Pose> & waypoints, const Pose & pose, const double lookahead_distance)
+{
+  const auto closest_pair = planning_utils::findClosestIdxWithDistAngThr(
+    waypoints, pose, closest_thr_dist, closest_thr_ang);
+  if (!closest_pair.first) {
+    return -1;
+  }
+  for (int32_t i = closest_pair.second; i < static_cast<int32_t>(waypoints.size()); i++) {
+    if (i == static_cast<int32_t>(waypoints.size()) - 1) {
+      return i;
+    }
+    const auto gld = planning_utils::getLaneDirection(waypoints, 0.05);
+    if (gld != 0 && gld != 1) {
+      return -1;
+    }
+    const auto ret =
+      planning_utils::transformToRelativeCoordinate2D(waypoints.at(i).position, pose);
+    if ((gld == 0 && ret.x < 0) || (gld == 1 && ret.x > 0)) {
+      continue;
+    }
+    if (
+      planning_utils::calcDistSquared2D(waypoints.at(i).position, pose.position) >
+      std::pow(lookahead_distance, 2)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// winding waypoints with random intervals, which are away from the origin so that none of them is
+// the default location of the next waypoint. The orientation is reversed for the backward driving.
+std::vector<Pose> createRandomWaypoints(std::mt19937 & engine, const bool is_backward)
+{
+  std::uniform_real_distribution<double> interval_dist(0.1, 2.0);
+  std::uniform_real_distribution<double> curvature_dist(-0.1, 0.1);
+  std::vector<Pose> waypoints;
+  double x = 100.0;
+  double y = 50.0;
+  double yaw = 0.0;
+  for (int i = 0; i < 100; i++) {
+    Pose p;
+    p.position.x = x;
+    p.position.y = y;
+    p.orientation =
+      autoware::universe_utils::createQuaternionFromYaw(is_backward ? yaw + M_PI : yaw);
+    waypoints.push_back(p);
+    const double interval = interval_dist(engine);
+    x += interval * std::cos(yaw);
+    y += interval * std::sin(yaw);
+    yaw += interval * curvature_dist(engine);
+  }
+  return waypoints;
+}
+
+// pose around a waypoint, which is not always close enough to the waypoints to find the closest
+Pose createRandomPose(std::mt19937 & engine, const std::vector<Pose> & waypoints)
+{
+  std::uniform_int_distribution<size_t> idx_dist(0, waypoints.size() - 1);
+  std::uniform_real_distribution<double> offset_dist(-2.0, 2.0);
+  std::uniform_real_distribution<double> yaw_offset_dist(-0.5, 0.5);
+  const auto & base_pose = waypoints.at(idx_dist(engine));
+  Pose pose;
+  pose.position.x = base_pose.position.x + offset_dist(engine);
+  pose.position.y = base_pose.position.y + offset_dist(engine);
+  pose.orientation = autoware::universe_utils::createQuaternionFromYaw(
+    tf2::getYaw(base_pose.orientation) + yaw_offset_dist(engine));
+  return pose;
+}
+
+void expectSameNextWaypoint(
+  const std::vector<Pose> & waypoints, const Pose & pose, const double lookahead_distance)
+{
+  PurePursuit pure_pursuit;
+  pure_pursuit.setClosestThreshold(closest_thr_dist, closest_thr_ang);
+  pure_pursuit.setLookaheadDistance(lookahead_distance);
+  pure_pursuit.setWaypoints(waypoints);
+  pure_pursuit.setCurrentPose(pose);
+  const auto is_success = pure_pursuit.run().first;
+
+  // the location of the next waypoint is set before the target is interpolated
+  const auto expected_idx = findNextPointIdxReference(waypoints, pose, lookahead_distance);
+  if (expected_idx == -1) {
+    EXPECT_FALSE(is_success);
+    EXPECT_EQ(pure_pursuit.getLocationOfNextWaypoint(), geometry_msgs::msg::Point());
+    return;
+  }
+  EXPECT_EQ(pure_pursuit.getLocationOfNextWaypoint(), waypoints.at(expected_idx).position)
+    << "expected index: " << expected_idx;
+}
+}  // namespace
+
+TEST(PurePursuit, SameNextWaypointAsLinearScan)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> lookahead_dist(0.5, 20.0);
+  for (const bool is_backward : {false, true}) {
+    for (int i = 0; i < 20; i++) {
+      const auto waypoints = createRandomWaypoints(engine, is_backward);
+      for (int j = 0; j < 50; j++) {
+        const auto pose = createRandomPose(engine, waypoints);
+        expectSameNextWaypoint(waypoints, pose, lookahead_dist(engine));
+      }
+    }
+  }
+}
+
+TEST(PurePursuit, NextWaypointIsLostWithUndeterminedLaneDirection)
+{
+  // the waypoints are too close to each other to determine the lane direction, and all of them are
+  // within the lookahead distance
+  std::vector<Pose> waypoints;
+  for (int i = 0; i < 5; i++) {
+    Pose p;
+    p.position.x = 100.0 + 0.01 * i;
+    p.position.y = 50.0;
+    p.orientation = autoware::universe_utils::createQuaternionFromYaw(0.0);
+    waypoints.push_back(p);
+  }
+  ASSERT_EQ(planning_utils::getLaneDirection(waypoints, 0.05), 2);
+  ASSERT_EQ(findNextPointIdxReference(waypoints, waypoints.front(), 3.0), -1);
+  expectSameNextWaypoint(waypoints, waypoints.front(), 3.0);
+
+  // the last waypoint is returned without the lane direction
+  expectSameNextWaypoint(waypoints, waypoints.back(), 3.0);
+}
@@ -0,0 +1,267 @@
+// Copyright 2024 Proxima Technology Inc, TIER IV
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// cSpell:ignore lstm
+
+#include "proxima_calc.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int acc_ctrl_queue_size = 15;
+constexpr int steer_ctrl_queue_size = 15;
+constexpr int steer_ctrl_queue_size_core = 8;
+constexpr int acc_delay_step = 3;
+constexpr int steer_delay_step = 8;
+constexpr int deg = 2;
+// number of the monomials of degree 1 and 2 in the 9 features of the polynomial regression
+constexpr int polynomial_features_dim = 9 + 45;
+constexpr int x_dim = 6 + acc_ctrl_queue_size + steer_ctrl_queue_size;
+
+constexpr int acc_layer_1_dim = 8;
+constexpr int steer_layer_1_head_dim = 8;
+constexpr int steer_layer_1_tail_dim = 8;
+constexpr int acc_layer_2_dim = 6;
+constexpr int steer_layer_2_dim = 6;
+constexpr int h1_dim = 1 + acc_layer_2_dim + steer_layer_2_dim;
+constexpr int lstm_dim = 8;
+constexpr int linear_relu_1_dim = 16;
+constexpr int linear_relu_2_dim = 16;
+
+// weights of the trained model, which are drawn at random
+struct ModelParams
+{
+  explicit ModelParams(const bool with_memory)
+  {
+    std::mt19937 engine(0);
+    std::normal_distribution<double> dist(0.0, 0.5);
+    const auto random_matrix = [&](const int rows, const int cols) {
+      return Eigen::MatrixXd(
+        Eigen::MatrixXd::NullaryExpr(rows, cols, [&]() { return dist(engine); }));
+    };
+    const auto random_vector = [&](const int size) {
+      return Eigen::VectorXd(Eigen::VectorXd::NullaryExpr(size, [&]() { return dist(engine); }));
+    };
+    const int h2_dim = with_memory ? lstm_dim + linear_relu_1_dim : linear_relu_1_dim;
+    weight_acc_layer_1 = random_matrix(acc_layer_1_dim, acc_ctrl_queue_size + 1);
+    weight_steer_layer_1_head =
+      random_matrix(steer_layer_1_head_dim, steer_ctrl_queue_size_core + 1);
+    weight_steer_layer_1_tail = random_matrix(steer_layer_1_tail_dim, steer_ctrl_queue_size);
+    weight_acc_layer_2 = random_matrix(acc_layer_2_dim, acc_layer_1_dim);
+    weight_steer_layer_2 =
+      random_matrix(steer_layer_2_dim, steer_layer_1_head_dim + steer_layer_1_tail_dim);
+    weight_lstm_ih = random_matrix(4 * lstm_dim, h1_dim);
+    weight_lstm_hh = random_matrix(4 * lstm_dim, lstm_dim);
+    weight_linear_relu_1 = random_matrix(linear_relu_1_dim, h1_dim);
+    weight_linear_relu_2 = random_matrix(linear_relu_2_dim, h2_dim);
+    weight_finalize = random_matrix(6, linear_relu_2_dim + acc_layer_2_dim + steer_layer_2_dim);
+    bias_acc_layer_1 = random_vector(acc_layer_1_dim);
+    bias_steer_layer_1_head = random_vector(steer_layer_1_head_dim);
+    bias_steer_layer_1_tail = random_vector(steer_layer_1_tail_dim);
+    bias_acc_layer_2 = random_vector(acc_layer_2_dim);
+    bias_steer_layer_2 = random_vector(steer_layer_2_dim);
+    bias_lstm_ih = random_vector(4 * lstm_dim);
+    bias_lstm_hh = random_vector(4 * lstm_dim);
+    bias_linear_relu_1 = random_vector(linear_relu_1_dim);
+    bias_linear_relu_2 = random_vector(linear_relu_2_dim);
+    bias_linear_finalize = random_vector(6);
+    A_linear_reg = 0.1 * random_matrix(6, polynomial_features_dim);
+    b_linear_reg = random_vector(6);
+  }
+
+  Eigen::MatrixXd weight_acc_layer_1, weight_steer_layer_1_head, weight_steer_layer_1_tail;
+  Eigen::MatrixXd weight_acc_layer_2, weight_steer_layer_2, weight_lstm_ih, weight_lstm_hh;
+  Eigen::MatrixXd weight_linear_relu_1, weight_linear_relu_2, weight_finalize, A_linear_reg;
+  Eigen::VectorXd bias_acc_layer_1, bias_steer_layer_1_head, bias_steer_layer_1_tail;
+  Eigen::VectorXd bias_acc_layer_2, bias_steer_layer_2, bias_lstm_ih, bias_lstm_hh;
+  Eigen::VectorXd bias_linear_relu_1, bias_linear_relu_2, bias_linear_finalize, b_linear_reg;
+  double vel_normalize{1.0 / 10.0};
+  double acc_normalize{1.0 / 2.0};
+  double steer_normalize{1.0 / 0.5};
+};
+
+void setParams(transform_model_to_eigen & model, const ModelParams & p)
+{
+  model.set_params(
+    p.weight_acc_layer_1, p.weight_steer_layer_1_head, p.weight_steer_layer_1_tail,
+    p.weight_acc_layer_2, p.weight_steer_layer_2, p.weight_linear_relu_1, p.weight_linear_relu_2,
+    p.weight_finalize, p.bias_acc_layer_1, p.bias_steer_layer_1_head, p.bias_steer_layer_1_tail,
+    p.bias_acc_layer_2, p.bias_steer_layer_2, p.bias_linear_relu_1, p.bias_linear_relu_2,
+    p.bias_linear_finalize, p.A_linear_reg, p.b_linear_reg, deg, acc_delay_step, steer_delay_step,
+    acc_ctrl_queue_size, steer_ctrl_queue_size, steer_ctrl_queue_size_core, p.vel_normalize,
+    p.acc_normalize, p.steer_normalize);
+}
+
+void setParams(transform_model_with_memory_to_eigen & model, const ModelParams & p)
+{
+  model.set_params(
+    p.weight_acc_layer_1, p.weight_steer_layer_1_head, p.weight_steer_layer_1_tail,
+    p.weight_acc_layer_2, p.weight_steer_layer_2, p.weight_lstm_ih, p.weight_lstm_hh,
+    p.weight_linear_relu_1, p.weight_linear_relu_2, p.weight_finalize, p.bias_acc_layer_1,
+    p.bias_steer_layer_1_head, p.bias_steer_layer_1_tail, p.bias_acc_layer_2,
+    p.bias_steer_layer_2, p.bias_lstm_ih, p.bias_lstm_hh, p.bias_linear_relu_1,
+    p.bias_linear_relu_2, p.bias_linear_finalize);
+  model.set_params_res(
+    p.A_linear_reg, p.b_linear_reg, deg, acc_delay_step, steer_delay_step, acc_ctrl_queue_size,
+    steer_ctrl_queue_size, steer_ctrl_queue_size_core, p.vel_normalize, p.acc_normalize,
+    p.steer_normalize);
+}
+
+// states of the columns, where some of the velocities are low enough to scale down the prediction
+Eigen::MatrixXd createRandomStates(const int size, const unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  Eigen::MatrixXd X = Eigen::MatrixXd::NullaryExpr(x_dim, size, [&]() { return dist(engine); });
+  X.row(2) = 10.0 * X.row(2);
+  X.row(3) = M_PI * X.row(3);
+  for (int i = 0; i < size; i += 5) {
+    X(2, i) = 0.1 * X(2, i);
+  }
+  return X;
+}
+
+// rot_and_d_rot_error_prediction_with_diff composed from error_prediction_with_diff, which does not
+// use the batched evaluation
+Eigen::MatrixXd rotErrorPredictionWithDiffReference(
+  const transform_model_to_eigen & model, const Eigen::VectorXd & x)
+{
+  const double theta = x[3];
+  const double coef = std::min(std::pow(2.0 * std::abs(x[2]), 7), 1.0);
+  Eigen::Matrix2d Rot;
+  Rot << std::cos(theta), -std::sin(theta), std::sin(theta), std::cos(theta);
+  Eigen::Matrix2d dRot;
+  dRot << -std::sin(theta), -std::cos(theta), std::cos(theta), -std::sin(theta);
+
+  Eigen::VectorXd vars(x_dim - 3);
+  vars << x[2], x[4], x[5], x.tail(x_dim - 6);
+  const Eigen::MatrixXd pred_d_pred = model.error_prediction_with_diff(vars);
+
+  // the derivatives by vars are placed at the columns of the corresponding states
+  Eigen::MatrixXd result = Eigen::MatrixXd::Zero(6, x_dim + 2);
+  result.block(0, 0, 2, 1) = Rot * pred_d_pred.block(0, 0, 2, 1);
+  result.block(2, 0, 4, 1) = pred_d_pred.block(2, 0, 4, 1);
+  result.block(0, 1, 2, 1) = dRot * pred_d_pred.block(0, 0, 2, 1);
+  Eigen::MatrixXd rot_d_pred = pred_d_pred.rightCols(x_dim - 3);
+  rot_d_pred.topRows(2) = Rot * rot_d_pred.topRows(2);
+  result.col(2 + 2) = rot_d_pred.col(0);
+  result.col(2 + 4) = rot_d_pred.col(1);
+  result.col(2 + 5) = rot_d_pred.col(2);
+  result.rightCols(x_dim - 6) = rot_d_pred.rightCols(x_dim - 6);
+  return coef * result;
+}
+
+double maxAbsDiff(const Eigen::MatrixXd & a, const Eigen::MatrixXd & b)
+{
+  EXPECT_EQ(a.rows(), b.rows());
+  EXPECT_EQ(a.cols(), b.cols());
+  return (a - b).cwiseAbs().maxCoeff();
+}
+}  // namespace
+
+TEST(ProximaCalc, RotatedErrorPredictionSameAsPerState)
+{
+  transform_model_to_eigen model;
+  setParams(model, ModelParams(false));
+
+  // the buffers of the batch are reused with the different numbers of the columns
+  for (const int size : {50, 1, 50, 7}) {
+    const Eigen::MatrixXd X = createRandomStates(size, size);
+    const Eigen::MatrixXd Pred = model.Rotated_error_prediction(X);
+    ASSERT_EQ(Pred.cols(), size);
+    for (int i = 0; i < size; i++) {
+      const Eigen::VectorXd pred = model.rotated_error_prediction(X.col(i));
+      EXPECT_LT(maxAbsDiff(Pred.col(i), pred), 1e-12 * (1.0 + pred.cwiseAbs().maxCoeff()))
+        << "size: " << size << ", column: " << i;
+    }
+  }
+}
+
+TEST(ProximaCalc, RotatedErrorPredictionWithDiffSameAsPerState)
+{
+  transform_model_to_eigen model;
+  setParams(model, ModelParams(false));
+
+  for (const int size : {50, 1, 7}) {
+    const Eigen::MatrixXd X = createRandomStates(size, size + 100);
+    const Eigen::MatrixXd Pred_with_diff = model.Rotated_error_prediction_with_diff(X);
+    ASSERT_EQ(Pred_with_diff.rows(), 6);
+    ASSERT_EQ(Pred_with_diff.cols(), size * (x_dim + 2));
+    for (int i = 0; i < size; i++) {
+      const Eigen::MatrixXd expected = rotErrorPredictionWithDiffReference(model, X.col(i));
+      const double tolerance = 1e-12 * (1.0 + expected.cwiseAbs().maxCoeff());
+      EXPECT_LT(
+        maxAbsDiff(Pred_with_diff.middleCols(i * (x_dim + 2), x_dim + 2), expected), tolerance)
+        << "size: " << size << ", column: " << i;
+      EXPECT_LT(
+        maxAbsDiff(model.rot_and_d_rot_error_prediction_with_diff(X.col(i)), expected), tolerance)
+        << "size: " << size << ", column: " << i;
+    }
+  }
+}
+
+TEST(ProximaCalc, Float32RotatedErrorPredictionCloseToDouble)
+{
+  transform_model_to_eigen model;
+  setParams(model, ModelParams(false));
+  const Eigen::MatrixXd X = createRandomStates(50, 200);
+  const Eigen::MatrixXd Pred = model.Rotated_error_prediction(X);
+
+  model.set_use_float32(true);
+  const Eigen::MatrixXd Pred_float = model.Rotated_error_prediction(X);
+  EXPECT_LT(maxAbsDiff(Pred_float, Pred), 1e-5 * (1.0 + Pred.cwiseAbs().maxCoeff()));
+
+  model.set_use_float32(false);
+  EXPECT_EQ(maxAbsDiff(model.Rotated_error_prediction(X), Pred), 0.0);
+}
+
+TEST(ProximaCalc, MemoryRotatedErrorPredictionSameAsPerState)
+{
+  const ModelParams params(true);
+  transform_model_with_memory_to_eigen model;
+  setParams(model, params);
+  transform_model_with_memory_to_eigen reference_model;
+  setParams(reference_model, params);
+
+  constexpr int size = 20;
+  std::mt19937 engine(300);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  const Eigen::VectorXd h = Eigen::VectorXd::NullaryExpr(lstm_dim, [&]() { return dist(engine); });
+  const Eigen::VectorXd c = Eigen::VectorXd::NullaryExpr(lstm_dim, [&]() { return dist(engine); });
+  model.set_lstm_for_candidate(h, c, size);
+
+  // the second step uses the lstm states of the candidates updated in the first step
+  const std::vector<Eigen::MatrixXd> X_steps{
+    createRandomStates(size, 301), createRandomStates(size, 302)};
+  std::vector<Eigen::MatrixXd> Pred_steps;
+  for (const auto & X : X_steps) {
+    Pred_steps.push_back(model.Rotated_error_prediction(X));
+  }
+
+  for (int i = 0; i < size; i++) {
+    reference_model.set_lstm(h, c);
+    for (size_t step = 0; step < X_steps.size(); step++) {
+      const Eigen::VectorXd pred = reference_model.rotated_error_prediction(X_steps[step].col(i));
+      EXPECT_LT(
+        maxAbsDiff(Pred_steps[step].col(i), pred), 1e-12 * (1.0 + pred.cwiseAbs().maxCoeff()))
+        << "step: " << step << ", column: " << i;
+    }
+  }
+}
@@ -43,8 +43,12 @@
 #include "visualization_msgs/msg/marker_array.hpp"
 #include <tier4_debug_msgs/msg/float64_stamped.hpp>
 
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -67,20 +71,43 @@ class TRAJECTORY_FOLLOWER_PUBLIC Controller : public rclcpp::Node
 {
 public:
   explicit Controller(const rclcpp::NodeOptions & node_options);
-  virtual ~Controller() {}
+  virtual ~Controller();
 
 private:
   rclcpp::TimerBase::SharedPtr timer_control_;
   double timeout_thr_sec_;
+  bool enable_parallel_control_;
+  bool enable_one_cycle_lagged_sync_;
   boost::optional<LongitudinalOutput> longitudinal_output_{boost::none};
 
   std::shared_ptr<diagnostic_updater::Updater> diag_updater_ =
     std::make_shared<diagnostic_updater::Updater>(
       this);  // Diagnostic updater for publishing diagnostic data.
 
+  // Diagnostic updater of the lateral controller when it runs concurrently, so that the diagnostic
+  // tasks of one controller are not called from the thread of the other controller.
+  std::shared_ptr<diagnostic_updater::Updater> lateral_diag_updater_;
+
   std::shared_ptr<trajectory_follower::LongitudinalControllerBase> longitudinal_controller_;
   std::shared_ptr<trajectory_follower::LateralControllerBase> lateral_controller_;
 
+  // Worker thread running the lateral controller concurrently with the longitudinal controller
+  std::thread lateral_worker_;
+  std::mutex lateral_worker_mutex_;
+  std::condition_variable lateral_worker_cv_;
+  boost::optional<trajectory_follower::InputData> lateral_input_{boost::none};
+  boost::optional<LateralOutput> lateral_output_{boost::none};
+  std::exception_ptr lateral_exception_{nullptr};
+  double lateral_processing_time_ms_{0.0};
+  bool stop_lateral_worker_{false};
+  bool is_lateral_pending_{false};
+  OnSetParametersCallbackHandle::SharedPtr set_param_res_;
+
+  // The lateral output collected in the current cycle and the longitudinal sync data given to the
+  // next lateral run in the one-cycle-lagged sync mode
+  boost::optional<LateralOutput> lagged_lateral_output_{boost::none};
+  trajectory_follower::LongitudinalSyncData lagged_longitudinal_sync_data_{};
+
   // Subscribers
   autoware::universe_utils::InterProcessPollingSubscriber<autoware_planning_msgs::msg::Trajectory>
     sub_ref_path_{this, "~/input/reference_trajectory"};
@@ -103,6 +130,7 @@ private:
   rclcpp::Publisher<autoware_control_msgs::msg::Control>::SharedPtr control_cmd_pub_;
   rclcpp::Publisher<Float64Stamped>::SharedPtr pub_processing_time_lat_ms_;
   rclcpp::Publisher<Float64Stamped>::SharedPtr pub_processing_time_lon_ms_;
+  rclcpp::Publisher<Float64Stamped>::SharedPtr pub_processing_time_ms_;
   rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr debug_marker_pub_;
 
   autoware_planning_msgs::msg::Trajectory::ConstSharedPtr current_trajectory_ptr_;
@@ -128,6 +156,10 @@ private:
   void callbackTimerControl();
   bool processData(rclcpp::Clock & clock);
   bool isTimeOut(const LongitudinalOutput & lon_out, const LateralOutput & lat_out);
+  void runLateralWorker();
+  void startLateralController(const trajectory_follower::InputData & input_data);
+  LateralOutput waitLateralController();
+  void waitLateralControllerIdle();
   LateralControllerMode getLateralControllerMode(const std::string & algorithm_name) const;
   LongitudinalControllerMode getLongitudinalControllerMode(
     const std::string & algorithm_name) const;
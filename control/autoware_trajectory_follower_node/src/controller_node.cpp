@@ -34,13 +34,18 @@ Controller::Controller(const rclcpp::NodeOptions & node_options) : Node("control
 
   const double ctrl_period = declare_parameter<double>("ctrl_period");
   timeout_thr_sec_ = declare_parameter<double>("timeout_thr_sec");
+  enable_parallel_control_ = declare_parameter<bool>("enable_parallel_control");
+  enable_one_cycle_lagged_sync_ =
+    declare_parameter<bool>("enable_one_cycle_lagged_sync") && enable_parallel_control_;
+  lateral_diag_updater_ =
+    enable_parallel_control_ ? std::make_shared<diagnostic_updater::Updater>(this) : diag_updater_;
 
   const auto lateral_controller_mode =
     getLateralControllerMode(declare_parameter<std::string>("lateral_controller_mode"));
   switch (lateral_controller_mode) {
     case LateralControllerMode::MPC: {
-      lateral_controller_ =
-        std::make_shared<mpc_lateral_controller::MpcLateralController>(*this, diag_updater_);
+      lateral_controller_ = std::make_shared<mpc_lateral_controller::MpcLateralController>(
+        *this, lateral_diag_updater_);
       break;
     }
     case LateralControllerMode::PURE_PURSUIT: {
@@ -71,9 +76,27 @@ Controller::Controller(const rclcpp::NodeOptions & node_options) : Node("control
     create_publisher<Float64Stamped>("~/lateral/debug/processing_time_ms", 1);
   pub_processing_time_lon_ms_ =
     create_publisher<Float64Stamped>("~/longitudinal/debug/processing_time_ms", 1);
+  pub_processing_time_ms_ = create_publisher<Float64Stamped>("~/debug/processing_time_ms", 1);
   debug_marker_pub_ =
     create_publisher<visualization_msgs::msg::MarkerArray>("~/output/debug_marker", rclcpp::QoS{1});
 
+  if (enable_parallel_control_) {
+    lateral_worker_ = std::thread(&Controller::runLateralWorker, this);
+
+    // In the one-cycle-lagged sync mode, the lateral controller may be running on the worker thread
+    // when the executor calls its parameter callback. This callback is registered after the ones of
+    // the controllers, so it is called first and waits for the run to finish. The timer does not
+    // start another run meanwhile since it shares the default callback group with the parameter
+    // services.
+    set_param_res_ = add_on_set_parameters_callback(
+      [this](const std::vector<rclcpp::Parameter> & /*parameters*/) {
+        waitLateralControllerIdle();
+        rcl_interfaces::msg::SetParametersResult result;
+        result.successful = true;
+        return result;
+      });
+  }
+
   // Timer
   {
     const auto period_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
@@ -88,6 +111,19 @@ Controller::Controller(const rclcpp::NodeOptions & node_options) : Node("control
     std::make_unique<autoware::universe_utils::PublishedTimePublisher>(this);
 }
 
+Controller::~Controller()
+{
+  if (!lateral_worker_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(lateral_worker_mutex_);
+    stop_lateral_worker_ = true;
+  }
+  lateral_worker_cv_.notify_all();
+  lateral_worker_.join();
+}
+
 Controller::LateralControllerMode Controller::getLateralControllerMode(
   const std::string & controller_mode) const
 {
@@ -169,13 +205,83 @@ boost::optional<trajectory_follower::InputData> Controller::createInputData(rclc
   return input_data;
 }
 
+void Controller::runLateralWorker()
+{
+  StopWatch<std::chrono::milliseconds> stop_watch;
+  std::unique_lock<std::mutex> lock(lateral_worker_mutex_);
+  while (true) {
+    lateral_worker_cv_.wait(lock, [this]() { return lateral_input_ || stop_lateral_worker_; });
+    if (stop_lateral_worker_) {
+      return;
+    }
+
+    // the input is not touched by the timer thread until the output is set
+    lock.unlock();
+    boost::optional<LateralOutput> output{boost::none};
+    std::exception_ptr exception{nullptr};
+    stop_watch.tic();
+    try {
+      output = lateral_controller_->run(*lateral_input_);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    const double processing_time_ms = stop_watch.toc();
+    lock.lock();
+
+    lateral_input_ = boost::none;
+    lateral_output_ = output;
+    lateral_exception_ = exception;
+    lateral_processing_time_ms_ = processing_time_ms;
+    lateral_worker_cv_.notify_all();
+  }
+}
+
+void Controller::startLateralController(const trajectory_follower::InputData & input_data)
+{
+  {
+    std::lock_guard<std::mutex> lock(lateral_worker_mutex_);
+    lateral_input_ = input_data;
+    lateral_output_ = boost::none;
+    lateral_exception_ = nullptr;
+  }
+  is_lateral_pending_ = true;
+  lateral_worker_cv_.notify_all();
+}
+
+void Controller::waitLateralControllerIdle()
+{
+  std::unique_lock<std::mutex> lock(lateral_worker_mutex_);
+  lateral_worker_cv_.wait(lock, [this]() { return !lateral_input_; });
+}
+
+LateralOutput Controller::waitLateralController()
+{
+  std::unique_lock<std::mutex> lock(lateral_worker_mutex_);
+  lateral_worker_cv_.wait(lock, [this]() { return !lateral_input_; });
+  is_lateral_pending_ = false;
+  if (lateral_exception_) {
+    std::rethrow_exception(lateral_exception_);
+  }
+  publishProcessingTime(lateral_processing_time_ms_, pub_processing_time_lat_ms_);
+  return *lateral_output_;
+}
+
 void Controller::callbackTimerControl()
 {
+  stop_watch_.tic("total");
+
+  // 0. collect the lateral output started in the previous cycle in the one-cycle-lagged sync mode
+  if (is_lateral_pending_) {
+    lagged_lateral_output_ = waitLateralController();
+  }
+
   // 1. create input data
   const auto input_data = createInputData(*get_clock());
   if (!input_data) {
     RCLCPP_INFO_THROTTLE(
       get_logger(), *get_clock(), 5000, "Control is skipped since input data is not ready.");
+    // the lateral output collected above would be more than one cycle old in the next cycle
+    lagged_lateral_output_ = boost::none;
     return;
   }
 
@@ -186,21 +292,59 @@ void Controller::callbackTimerControl()
     RCLCPP_INFO_THROTTLE(
       get_logger(), *get_clock(), 5000,
       "Control is skipped since lateral and/or longitudinal controllers are not ready to run.");
+    lagged_lateral_output_ = boost::none;
     return;
   }
 
-  // 3. run controllers
-  stop_watch_.tic("lateral");
-  const auto lat_out = lateral_controller_->run(*input_data);
-  publishProcessingTime(stop_watch_.toc("lateral"), pub_processing_time_lat_ms_);
-
-  stop_watch_.tic("longitudinal");
-  const auto lon_out = longitudinal_controller_->run(*input_data);
-  publishProcessingTime(stop_watch_.toc("longitudinal"), pub_processing_time_lon_ms_);
-
-  // 4. sync with each other controllers
-  longitudinal_controller_->sync(lat_out.sync_data);
-  lateral_controller_->sync(lon_out.sync_data);
+  // 3. run controllers and 4. sync with each other controllers
+  LateralOutput lat_out;
+  LongitudinalOutput lon_out;
+  if (!enable_parallel_control_) {
+    stop_watch_.tic("lateral");
+    lat_out = lateral_controller_->run(*input_data);
+    publishProcessingTime(stop_watch_.toc("lateral"), pub_processing_time_lat_ms_);
+
+    stop_watch_.tic("longitudinal");
+    lon_out = longitudinal_controller_->run(*input_data);
+    publishProcessingTime(stop_watch_.toc("longitudinal"), pub_processing_time_lon_ms_);
+
+    longitudinal_controller_->sync(lat_out.sync_data);
+    lateral_controller_->sync(lon_out.sync_data);
+  } else if (!enable_one_cycle_lagged_sync_) {
+    // both controllers use the sync data of the previous cycle as in the sequential execution
+    startLateralController(*input_data);
+
+    stop_watch_.tic("longitudinal");
+    lon_out = longitudinal_controller_->run(*input_data);
+    publishProcessingTime(stop_watch_.toc("longitudinal"), pub_processing_time_lon_ms_);
+
+    lat_out = waitLateralController();
+
+    longitudinal_controller_->sync(lat_out.sync_data);
+    lateral_controller_->sync(lon_out.sync_data);
+  } else {
+    // the lateral output of the previous cycle is published without waiting for the lateral
+    // controller, which is collected at the beginning of the next cycle
+    if (lagged_lateral_output_) {
+      longitudinal_controller_->sync(lagged_lateral_output_->sync_data);
+    }
+    lateral_controller_->sync(lagged_longitudinal_sync_data_);
+    startLateralController(*input_data);
+
+    stop_watch_.tic("longitudinal");
+    lon_out = longitudinal_controller_->run(*input_data);
+    publishProcessingTime(stop_watch_.toc("longitudinal"), pub_processing_time_lon_ms_);
+    lagged_longitudinal_sync_data_ = lon_out.sync_data;
+
+    if (!lagged_lateral_output_) {
+      RCLCPP_INFO_THROTTLE(
+        get_logger(), *get_clock(), 5000,
+        "Control is skipped since the lateral output of the previous cycle is not available.");
+      return;
+    }
+    lat_out = *lagged_lateral_output_;
+    lagged_lateral_output_ = boost::none;
+  }
 
   // TODO(Horibe): Think specification. This comes from the old implementation.
   if (isTimeOut(lon_out, lat_out)) return;
@@ -211,6 +355,7 @@ void Controller::callbackTimerControl()
   out.lateral = lat_out.control_cmd;
   out.longitudinal = lon_out.control_cmd;
   control_cmd_pub_->publish(out);
+  publishProcessingTime(stop_watch_.toc("total"), pub_processing_time_ms_);
 
   // 6. publish debug
   published_time_publisher_->publish_if_subscribed(control_cmd_pub_, out.stamp);
@@ -30,7 +30,9 @@
 #include "geometry_msgs/msg/transform_stamped.hpp"
 #include "nav_msgs/msg/odometry.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <vector>
 
 using Controller = autoware::motion::control::trajectory_follower_node::Controller;
@@ -614,3 +616,102 @@ TEST_F(FakeNodeFixture, longitudinal_check_steer_converged)
     EXPECT_DOUBLE_EQ(tester.cmd_msg->longitudinal.velocity, 0.0f);
   }
 }
+
+// parallel execution of the controllers
+void publishRightTurnInput(ControllerTester & tester)
+{
+  tester.send_default_transform();
+  tester.publish_odom_vx(1.0);
+  tester.publish_autonomous_operation_mode();
+  tester.publish_default_steer();
+  tester.publish_default_acc();
+
+  Trajectory traj_msg;
+  traj_msg.header.stamp = tester.node->now();
+  traj_msg.header.frame_id = "map";
+  traj_msg.points.push_back(make_traj_point(-1.0, -1.0, 1.0f));
+  traj_msg.points.push_back(make_traj_point(0.0, 0.0, 1.0f));
+  traj_msg.points.push_back(make_traj_point(1.0, -1.0, 1.0f));
+  traj_msg.points.push_back(make_traj_point(2.0, -2.0, 1.0f));
+  tester.traj_pub->publish(traj_msg);
+}
+
+Control getRightTurnCommand(FakeNodeFixture * fixture, const bool enable_parallel_control)
+{
+  auto node_options = makeNodeOptions();
+  node_options.append_parameter_override("enable_parallel_control", enable_parallel_control);
+  ControllerTester tester(fixture, node_options);
+
+  publishRightTurnInput(tester);
+
+  test_utils::waitForMessage(tester.node, fixture, tester.received_control_command);
+  EXPECT_TRUE(tester.received_control_command);
+  return tester.cmd_msg ? *tester.cmd_msg : Control{};
+}
+
+TEST_F(FakeNodeFixture, parallel_control)
+{
+  // The controllers running concurrently publish the same command as the sequential execution.
+  const auto sequential_cmd = getRightTurnCommand(this, false);
+  const auto parallel_cmd = getRightTurnCommand(this, true);
+
+  EXPECT_LT(sequential_cmd.lateral.steering_tire_angle, 0.0f);
+  EXPECT_FLOAT_EQ(
+    parallel_cmd.lateral.steering_tire_angle, sequential_cmd.lateral.steering_tire_angle);
+  EXPECT_FLOAT_EQ(
+    parallel_cmd.lateral.steering_tire_rotation_rate,
+    sequential_cmd.lateral.steering_tire_rotation_rate);
+  EXPECT_FLOAT_EQ(parallel_cmd.longitudinal.velocity, sequential_cmd.longitudinal.velocity);
+  EXPECT_FLOAT_EQ(parallel_cmd.longitudinal.acceleration, sequential_cmd.longitudinal.acceleration);
+}
+
+TEST_F(FakeNodeFixture, parallel_control_with_one_cycle_lagged_sync)
+{
+  using tier4_debug_msgs::msg::Float64Stamped;
+
+  const auto sequential_cmd = getRightTurnCommand(this, false);
+
+  auto node_options = makeNodeOptions();
+  node_options.append_parameter_override("enable_parallel_control", true);
+  node_options.append_parameter_override("enable_one_cycle_lagged_sync", true);
+  ControllerTester tester(this, node_options);
+
+  // the longitudinal processing time is published in every cycle which runs the controllers
+  std::vector<rclcpp::Time> lon_cycle_stamps;
+  const auto lon_time_sub = create_subscription<Float64Stamped>(
+    "controller/longitudinal/debug/processing_time_ms", *get_fake_node(),
+    [&lon_cycle_stamps](const Float64Stamped::SharedPtr msg) {
+      lon_cycle_stamps.emplace_back(msg->stamp);
+    });
+  std::optional<Control> first_cmd;
+  bool received_first_cmd = false;
+  const auto first_cmd_sub = create_subscription<Control>(
+    "controller/output/control_cmd", *get_fake_node(), [&](const Control::SharedPtr msg) {
+      if (!first_cmd) {
+        first_cmd = *msg;
+        received_first_cmd = true;
+      }
+    });
+
+  publishRightTurnInput(tester);
+  test_utils::waitForMessage(tester.node, this, received_first_cmd);
+  // receive the processing time of the cycle which published the first command
+  auto fake_node = get_fake_node();
+  test_utils::spinWhile(fake_node);
+  ASSERT_TRUE(first_cmd);
+
+  // the first cycle publishes no command and the second one publishes the lateral command of the
+  // first one
+  const rclcpp::Time first_cmd_stamp(first_cmd->stamp);
+  const auto cycle_num_until_first_cmd = std::count_if(
+    lon_cycle_stamps.begin(), lon_cycle_stamps.end(),
+    [&](const rclcpp::Time & stamp) { return stamp <= first_cmd_stamp; });
+  EXPECT_EQ(cycle_num_until_first_cmd, 2);
+  ASSERT_GE(lon_cycle_stamps.size(), 2u);
+  EXPECT_LT(rclcpp::Time(first_cmd->lateral.stamp), lon_cycle_stamps.at(1));
+  EXPECT_FLOAT_EQ(
+    first_cmd->lateral.steering_tire_angle, sequential_cmd.lateral.steering_tire_angle);
+  EXPECT_FLOAT_EQ(
+    first_cmd->lateral.steering_tire_rotation_rate,
+    sequential_cmd.lateral.steering_tire_rotation_rate);
+}
@@ -0,0 +1,103 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DEADLINE_MONITOR_HPP_
+#define DEADLINE_MONITOR_HPP_
+
+#include <diagnostic_updater/diagnostic_status_wrapper.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+
+namespace autoware::vehicle_cmd_gate
+{
+
+/**
+ * @brief Class to count the jitter of a periodic callback and the periods missed by it
+ */
+class DeadlineMonitor
+{
+public:
+  /**
+   * @brief Constructor
+   * @param period_ms Expected period of the callback [ms]
+   */
+  explicit DeadlineMonitor(const double period_ms) : period_ms_(period_ms) {}
+
+  /**
+   * @brief Add the interval from the previous call of the callback
+   * @details The call is counted as a deadline miss when the interval is twice as long as the
+   * period or longer, i.e. at least one period is skipped.
+   * @param interval_ms Interval between the calls [ms]
+   */
+  void addInterval(const double interval_ms)
+  {
+    latest_jitter_ms_ = interval_ms - period_ms_;
+    const auto itr = std::upper_bound(
+      bin_upper_bounds_ms_.begin(), bin_upper_bounds_ms_.end(), std::abs(latest_jitter_ms_));
+    ++jitter_counts_.at(std::distance(bin_upper_bounds_ms_.begin(), itr));
+
+    is_latest_deadline_missed_ = interval_ms >= 2.0 * period_ms_;
+    if (is_latest_deadline_missed_) {
+      ++deadline_miss_count_;
+    }
+  }
+
+  /**
+   * @brief Add the processing time of the command from its reception to its publication
+   * @param processing_time_ms Processing time [ms]
+   */
+  void addProcessingTime(const double processing_time_ms)
+  {
+    latest_processing_time_ms_ = processing_time_ms;
+    max_processing_time_ms_ = std::max(max_processing_time_ms_, processing_time_ms);
+  }
+
+  bool isLatestDeadlineMissed() const { return is_latest_deadline_missed_; }
+
+  /**
+   * @brief Add the latest values, the deadline misses and the jitter counts to the diagnostics
+   * @param stat Diagnostic status wrapper
+   */
+  void appendTo(diagnostic_updater::DiagnosticStatusWrapper & stat) const
+  {
+    stat.addf("Period [ms]", "%.2f", period_ms_);
+    stat.addf("Jitter [ms]", "%.2f", latest_jitter_ms_);
+    stat.add("Deadline misses", deadline_miss_count_);
+    for (size_t i = 0; i < jitter_counts_.size(); ++i) {
+      const auto range = (i < bin_upper_bounds_ms_.size())
+                           ? "< " + std::to_string(static_cast<int>(bin_upper_bounds_ms_.at(i)))
+                           : ">= " + std::to_string(static_cast<int>(bin_upper_bounds_ms_.back()));
+      stat.add("Jitter " + range + " [ms]", jitter_counts_.at(i));
+    }
+    stat.addf("Command processing time [ms]", "%.3f", latest_processing_time_ms_);
+    stat.addf("Max command processing time [ms]", "%.3f", max_processing_time_ms_);
+  }
+
+private:
+  static constexpr std::array<double, 6> bin_upper_bounds_ms_{1.0, 2.0, 5.0, 10.0, 20.0, 50.0};
+  std::array<size_t, bin_upper_bounds_ms_.size() + 1> jitter_counts_{};
+  double period_ms_;
+  double latest_jitter_ms_{0.0};
+  bool is_latest_deadline_missed_{false};
+  size_t deadline_miss_count_{0};
+  double latest_processing_time_ms_{0.0};
+  double max_processing_time_ms_{0.0};
+};
+
+}  // namespace autoware::vehicle_cmd_gate
+
+#endif  // DEADLINE_MONITOR_HPP_
@@ -38,9 +38,33 @@ bool VehicleCmdFilter::setParameterWithValidation(const VehicleCmdFilterParam &
   }
 
   param_ = p;
+  invalidateLimits();
   return true;
 }
 
+void VehicleCmdFilter::setCurrentSpeed(double v)
+{
+  if (v == current_speed_) {
+    return;
+  }
+  current_speed_ = v;
+  invalidateLimits();
+}
+
+void VehicleCmdFilter::invalidateLimits()
+{
+  limits_ = Limits{};
+}
+
+double VehicleCmdFilter::getCachedLimit(CachedLimit & limit, const LimitArray & limits) const
+{
+  if (!limit.is_valid) {
+    limit.value = param_.reference_speed_points.empty() ? 0.0 : interpolateFromSpeed(limits);
+    limit.is_valid = true;
+  }
+  return limit.value;
+}
+
 void VehicleCmdFilter::setParam(const VehicleCmdFilterParam & p)
 {
   if (!setParameterWithValidation(p)) {
@@ -220,7 +244,7 @@ double VehicleCmdFilter::interpolateFromSpeed(const LimitArray & limits) const
 {
   // Consider only for the positive velocities.
   const auto current = std::abs(current_speed_);
-  const auto reference = param_.reference_speed_points;
+  const auto & reference = param_.reference_speed_points;
 
   // If the speed is out of range of the reference, apply zero-order hold.
   if (current <= reference.front()) {
@@ -249,31 +273,31 @@ double VehicleCmdFilter::interpolateFromSpeed(const LimitArray & limits) const
 
 double VehicleCmdFilter::getLonAccLim() const
 {
-  return interpolateFromSpeed(param_.lon_acc_lim);
+  return getCachedLimit(limits_.lon_acc, param_.lon_acc_lim);
 }
 double VehicleCmdFilter::getLonJerkLim() const
 {
-  return interpolateFromSpeed(param_.lon_jerk_lim);
+  return getCachedLimit(limits_.lon_jerk, param_.lon_jerk_lim);
 }
 double VehicleCmdFilter::getLatAccLim() const
 {
-  return interpolateFromSpeed(param_.lat_acc_lim);
+  return getCachedLimit(limits_.lat_acc, param_.lat_acc_lim);
 }
 double VehicleCmdFilter::getLatJerkLim() const
 {
-  return interpolateFromSpeed(param_.lat_jerk_lim);
+  return getCachedLimit(limits_.lat_jerk, param_.lat_jerk_lim);
 }
 double VehicleCmdFilter::getSteerLim() const
 {
-  return interpolateFromSpeed(param_.steer_lim);
+  return getCachedLimit(limits_.steer, param_.steer_lim);
 }
 double VehicleCmdFilter::getSteerRateLim() const
 {
-  return interpolateFromSpeed(param_.steer_rate_lim);
+  return getCachedLimit(limits_.steer_rate, param_.steer_rate_lim);
 }
 double VehicleCmdFilter::getSteerDiffLim() const
 {
-  return interpolateFromSpeed(param_.actual_steer_diff_lim);
+  return getCachedLimit(limits_.steer_diff, param_.actual_steer_diff_lim);
 }
 
 }  // namespace autoware::vehicle_cmd_gate
@@ -48,7 +48,7 @@ public:
   ~VehicleCmdFilter() = default;
 
   void setWheelBase(double v) { param_.wheel_base = v; }
-  void setCurrentSpeed(double v) { current_speed_ = v; }
+  void setCurrentSpeed(double v);
   void setParam(const VehicleCmdFilterParam & p);
   VehicleCmdFilterParam getParam() const;
   void setPrevCmd(const Control & v) { prev_cmd_ = v; }
@@ -68,11 +68,32 @@ public:
     const Control & c1, const Control & c2, const double tol = 1.0e-3);
 
 private:
+  // limit interpolated at the current speed, which is interpolated when it is used for the first
+  // time after the speed or the parameter is changed
+  struct CachedLimit
+  {
+    double value = 0.0;
+    bool is_valid = false;
+  };
+  struct Limits
+  {
+    CachedLimit lon_acc;
+    CachedLimit lon_jerk;
+    CachedLimit lat_acc;
+    CachedLimit lat_jerk;
+    CachedLimit steer;
+    CachedLimit steer_rate;
+    CachedLimit steer_diff;
+  };
+
   VehicleCmdFilterParam param_;
   Control prev_cmd_;
   double current_speed_ = 0.0;
+  mutable Limits limits_;
 
   bool setParameterWithValidation(const VehicleCmdFilterParam & p);
+  void invalidateLimits();
+  double getCachedLimit(CachedLimit & limit, const LimitArray & limits) const;
 
   double calcLatAcc(const Control & cmd) const;
   double calcLatAcc(const Control & cmd, const double v) const;
@@ -209,6 +209,9 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
   const auto update_period = 1.0 / declare_parameter<double>("update_rate");
   const auto period_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
     std::chrono::duration<double>(update_period));
+  deadline_monitor_ = std::make_unique<DeadlineMonitor>(update_period * 1e3);
+  updater_.add("timer_deadline", this, &VehicleCmdGate::checkTimerDeadline);
+  stop_watch_.tic("timer");
   timer_ =
     rclcpp::create_timer(this, get_clock(), period_ns, std::bind(&VehicleCmdGate::onTimer, this));
   timer_pub_status_ = rclcpp::create_timer(
@@ -329,6 +332,7 @@ bool VehicleCmdGate::isDataReady()
 // for auto
 void VehicleCmdGate::onAutoCtrlCmd(Control::ConstSharedPtr msg)
 {
+  stop_watch_.tic("command");
   auto_commands_.control = *msg;
 
   if (current_gate_mode_.data == GateMode::AUTO) {
@@ -339,6 +343,7 @@ void VehicleCmdGate::onAutoCtrlCmd(Control::ConstSharedPtr msg)
 // for remote
 void VehicleCmdGate::onRemoteCtrlCmd(Control::ConstSharedPtr msg)
 {
+  stop_watch_.tic("command");
   remote_commands_.control = *msg;
 
   if (current_gate_mode_.data == GateMode::EXTERNAL) {
@@ -349,6 +354,7 @@ void VehicleCmdGate::onRemoteCtrlCmd(Control::ConstSharedPtr msg)
 // for emergency
 void VehicleCmdGate::onEmergencyCtrlCmd(Control::ConstSharedPtr msg)
 {
+  stop_watch_.tic("command");
   emergency_commands_.control = *msg;
 
   if (use_emergency_handling_ && is_system_emergency_) {
@@ -375,6 +381,8 @@ T VehicleCmdGate::getContinuousTopic(
 
 void VehicleCmdGate::onTimer()
 {
+  deadline_monitor_->addInterval(stop_watch_.toc("timer", true));
+
   // Subscriber for auto
   const auto msg_auto_command_turn_indicator = auto_turn_indicator_cmd_sub_.takeData();
   if (msg_auto_command_turn_indicator)
@@ -576,6 +584,7 @@ void VehicleCmdGate::publishControlCommands(const Commands & commands)
   // Publish commands
   vehicle_cmd_emergency_pub_->publish(vehicle_cmd_emergency);
   control_cmd_pub_->publish(filtered_control);
+  deadline_monitor_->addProcessingTime(stop_watch_.toc("command"));
   published_time_publisher_->publish_if_subscribed(control_cmd_pub_, filtered_control.stamp);
   adapi_pause_->publish();
   moderate_stop_interface_->publish();
@@ -866,6 +875,16 @@ void VehicleCmdGate::checkExternalEmergencyStop(diagnostic_updater::DiagnosticSt
   stat.summary(status.level, status.message);
 }
 
+void VehicleCmdGate::checkTimerDeadline(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  if (deadline_monitor_->isLatestDeadlineMissed()) {
+    stat.summary(DiagnosticStatus::WARN, "timer callback missed the period.");
+  } else {
+    stat.summary(DiagnosticStatus::OK, "OK");
+  }
+  deadline_monitor_->appendTo(stat);
+}
+
 MarkerArray VehicleCmdGate::createMarkerArray(const IsFilterActivated & filter_activated)
 {
   MarkerArray msg;
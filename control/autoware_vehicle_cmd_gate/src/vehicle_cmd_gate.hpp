@@ -17,6 +17,8 @@
 
 #include "adapi_pause_interface.hpp"
 #include "autoware/universe_utils/ros/logger_level_configure.hpp"
+#include "autoware/universe_utils/system/stop_watch.hpp"
+#include "deadline_monitor.hpp"
 #include "moderate_stop_interface.hpp"
 #include "vehicle_cmd_filter.hpp"
 
@@ -238,6 +240,12 @@ private:
 
   void checkExternalEmergencyStop(diagnostic_updater::DiagnosticStatusWrapper & stat);
 
+  // Timer deadline monitoring
+  std::unique_ptr<DeadlineMonitor> deadline_monitor_;
+  autoware::universe_utils::StopWatch<std::chrono::milliseconds> stop_watch_;
+
+  void checkTimerDeadline(diagnostic_updater::DiagnosticStatusWrapper & stat);
+
   template <typename T>
   T getContinuousTopic(
     const std::shared_ptr<T> & prev_topic, const T & current_topic,
@@ -0,0 +1,70 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/deadline_monitor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace
+{
+std::string findValue(
+  const diagnostic_updater::DiagnosticStatusWrapper & stat, const std::string & key)
+{
+  for (const auto & value : stat.values) {
+    if (value.key == key) {
+      return value.value;
+    }
+  }
+  return "";
+}
+}  // namespace
+
+TEST(DeadlineMonitor, CountJitterAndDeadlineMiss)
+{
+  autoware::vehicle_cmd_gate::DeadlineMonitor monitor(100.0);
+
+  monitor.addInterval(100.5);
+  EXPECT_FALSE(monitor.isLatestDeadlineMissed());
+  monitor.addInterval(103.0);
+  EXPECT_FALSE(monitor.isLatestDeadlineMissed());
+  monitor.addInterval(96.0);
+  EXPECT_FALSE(monitor.isLatestDeadlineMissed());
+  monitor.addInterval(200.0);
+  EXPECT_TRUE(monitor.isLatestDeadlineMissed());
+  monitor.addInterval(100.0);
+  EXPECT_FALSE(monitor.isLatestDeadlineMissed());
+
+  diagnostic_updater::DiagnosticStatusWrapper stat;
+  monitor.appendTo(stat);
+  EXPECT_EQ(findValue(stat, "Deadline misses"), "1");
+  EXPECT_EQ(findValue(stat, "Jitter < 1 [ms]"), "2");
+  EXPECT_EQ(findValue(stat, "Jitter < 5 [ms]"), "2");
+  EXPECT_EQ(findValue(stat, "Jitter >= 50 [ms]"), "1");
+}
+
+TEST(DeadlineMonitor, KeepMaxProcessingTime)
+{
+  autoware::vehicle_cmd_gate::DeadlineMonitor monitor(100.0);
+
+  monitor.addProcessingTime(0.5);
+  monitor.addProcessingTime(2.0);
+  monitor.addProcessingTime(1.0);
+
+  diagnostic_updater::DiagnosticStatusWrapper stat;
+  monitor.appendTo(stat);
+  EXPECT_EQ(findValue(stat, "Command processing time [ms]"), "1.000");
+  EXPECT_EQ(findValue(stat, "Max command processing time [ms]"), "2.000");
+}
@@ -63,7 +63,6 @@ private:
 
   // Node Methods
   bool isDataReady() const;  // check if data arrive
-  static bool isValidTrajectory(const Trajectory & traj);
 
   // Callback Methods
   void onTrajectory(const Trajectory::ConstSharedPtr msg);
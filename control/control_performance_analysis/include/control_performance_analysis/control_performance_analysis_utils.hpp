@@ -19,6 +19,7 @@
 #include <Eigen/Geometry>
 #include <rclcpp/rclcpp.hpp>
 
+#include <autoware_planning_msgs/msg/trajectory.hpp>
 #include <geometry_msgs/msg/point.hpp>
 #include <geometry_msgs/msg/quaternion.hpp>
 
@@ -76,6 +77,9 @@ inline geometry_msgs::msg::Quaternion createOrientationMsgFromYaw(double yaw_ang
   return orientation_msg;
 }
 
+// Check if all the poses, velocities and accelerations of the trajectory are finite.
+bool isValidTrajectory(const autoware_planning_msgs::msg::Trajectory & traj);
+
 // p-points a, b contains [x, y] coordinates.
 double determinant(std::array<double, 2> const & a, std::array<double, 2> const & b);
 
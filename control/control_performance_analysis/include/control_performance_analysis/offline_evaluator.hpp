@@ -0,0 +1,82 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROL_PERFORMANCE_ANALYSIS__OFFLINE_EVALUATOR_HPP_
+#define CONTROL_PERFORMANCE_ANALYSIS__OFFLINE_EVALUATOR_HPP_
+
+#include "control_performance_analysis/control_performance_analysis_core.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace control_performance_analysis
+{
+struct OfflineEvaluatorTopics
+{
+  std::string reference_trajectory;
+  std::string control_raw;
+  std::string measured_steering;
+  std::string odometry;
+};
+
+// Statistics of a metric over the whole bag
+struct MetricSummary
+{
+  std::string name;
+  size_t count{0};
+  double mean{0.0};
+  double rms{0.0};
+  double min{0.0};
+  double max{0.0};
+  double max_abs{0.0};
+};
+
+struct BagEvaluationResult
+{
+  std::string bag_path;
+  bool success{false};
+  std::string error_message;
+  std::vector<MetricSummary> summaries;
+};
+
+/**
+ * @brief Calculate the statistics of the values of a metric at once
+ * @param name name of the metric
+ * @param values values of the metric in the order of time
+ */
+MetricSummary summarizeMetric(const std::string & name, const std::vector<double> & values);
+
+/**
+ * @brief Replay the messages of a bag as fast as possible and summarize the metrics
+ * @details the metrics are calculated by ControlPerformanceAnalysisCore in the same order as the
+ * subscriptions of ControlPerformanceAnalysisNode, so they are the same as the published ones.
+ */
+BagEvaluationResult evaluateBag(
+  const std::string & bag_path, const OfflineEvaluatorTopics & topics, const Params & params);
+
+/**
+ * @brief Evaluate the bags in parallel
+ * @param num_threads number of the bags evaluated at the same time, 0 to use all the cores
+ * @return results in the order of the bag paths
+ */
+std::vector<BagEvaluationResult> evaluateBags(
+  const std::vector<std::string> & bag_paths, const OfflineEvaluatorTopics & topics,
+  const Params & params, const size_t num_threads);
+
+// Write the summaries as csv, one row per bag and metric.
+void writeSummaries(std::ostream & os, const std::vector<BagEvaluationResult> & results);
+}  // namespace control_performance_analysis
+
+#endif  // CONTROL_PERFORMANCE_ANALYSIS__OFFLINE_EVALUATOR_HPP_
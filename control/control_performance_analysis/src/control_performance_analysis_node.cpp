@@ -85,7 +85,7 @@ void ControlPerformanceAnalysisNode::onTrajectory(const Trajectory::ConstSharedP
     return;
   }
 
-  if (!isValidTrajectory(*msg)) {
+  if (!utils::isValidTrajectory(*msg)) {
     RCLCPP_ERROR(get_logger(), "Trajectory is invalid!, stop computing.");
     return;
   }
@@ -176,25 +176,6 @@ bool ControlPerformanceAnalysisNode::isDataReady() const
  *                                                               -> computePerformanceVars
  * */
 
-bool ControlPerformanceAnalysisNode::isValidTrajectory(const Trajectory & traj)
-{
-  bool check_condition = std::all_of(traj.points.cbegin(), traj.points.cend(), [](auto point) {
-    const auto & p = point.pose.position;
-    const auto & o = point.pose.orientation;
-    const auto & t = point.longitudinal_velocity_mps;
-    const auto & a = point.acceleration_mps2;
-
-    if (
-      !isfinite(p.x) || !isfinite(p.y) || !isfinite(p.z) || !isfinite(o.x) || !isfinite(o.y) ||
-      !isfinite(o.z) || !isfinite(o.w) || !isfinite(t) || !isfinite(a)) {
-      return false;
-    } else {
-      return true;
-    }
-  });
-
-  return check_condition;
-}
 }  // namespace control_performance_analysis
 
 #include <rclcpp_components/register_node_macro.hpp>
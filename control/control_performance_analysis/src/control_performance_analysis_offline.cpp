@@ -0,0 +1,87 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "control_performance_analysis/offline_evaluator.hpp"
+
+#include <autoware/universe_utils/system/stop_watch.hpp>
+#include <autoware_vehicle_info_utils/vehicle_info_utils.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+int main(int argc, char ** argv)
+{
+  using control_performance_analysis::OfflineEvaluatorTopics;
+  using control_performance_analysis::Params;
+
+  rclcpp::init(argc, argv);
+  const auto node = std::make_shared<rclcpp::Node>("control_performance_analysis_offline");
+
+  // same parameters as ControlPerformanceAnalysisNode
+  Params param;
+  param.wheelbase_ =
+    autoware::vehicle_info_utils::VehicleInfoUtils(*node).getVehicleInfo().wheel_base_m;
+  param.curvature_interval_length_ = node->declare_parameter<double>("curvature_interval_length");
+  param.prevent_zero_division_value_ =
+    node->declare_parameter<double>("prevent_zero_division_value");
+  param.odom_interval_ = node->declare_parameter<int64_t>("odom_interval");
+  param.acceptable_max_distance_to_waypoint_ =
+    node->declare_parameter<double>("acceptable_max_distance_to_waypoint");
+  param.acceptable_max_yaw_difference_rad_ =
+    node->declare_parameter<double>("acceptable_max_yaw_difference_rad");
+  param.lpf_gain_ = node->declare_parameter<double>("low_pass_filter_gain");
+
+  OfflineEvaluatorTopics topics;
+  topics.reference_trajectory = node->declare_parameter<std::string>("topics.reference_trajectory");
+  topics.control_raw = node->declare_parameter<std::string>("topics.control_raw");
+  topics.measured_steering = node->declare_parameter<std::string>("topics.measured_steering");
+  topics.odometry = node->declare_parameter<std::string>("topics.odometry");
+
+  const auto bag_paths = node->declare_parameter<std::vector<std::string>>("bag_paths");
+  const auto num_threads = node->declare_parameter<int64_t>("num_threads");
+  const auto output_path = node->declare_parameter<std::string>("output_path");
+
+  autoware::universe_utils::StopWatch<std::chrono::milliseconds> stop_watch;
+  const auto results = control_performance_analysis::evaluateBags(
+    bag_paths, topics, param, static_cast<size_t>(std::max<int64_t>(num_threads, 0)));
+
+  bool is_all_succeeded = true;
+  for (const auto & result : results) {
+    if (!result.success) {
+      RCLCPP_ERROR(
+        node->get_logger(), "Failed to evaluate %s: %s", result.bag_path.c_str(),
+        result.error_message.c_str());
+      is_all_succeeded = false;
+    }
+  }
+
+  std::ofstream ofs(output_path);
+  if (!ofs) {
+    RCLCPP_ERROR(node->get_logger(), "Cannot open %s", output_path.c_str());
+    rclcpp::shutdown();
+    return 1;
+  }
+  control_performance_analysis::writeSummaries(ofs, results);
+  RCLCPP_INFO(
+    node->get_logger(), "Evaluated %lu bags in %.1f s and wrote the summary to %s",
+    results.size(), stop_watch.toc() / 1000.0, output_path.c_str());
+
+  rclcpp::shutdown();
+  return is_all_succeeded ? 0 : 1;
+}
@@ -15,11 +15,26 @@
 #include "control_performance_analysis/control_performance_analysis_utils.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 namespace control_performance_analysis
 {
 namespace utils
 {
+bool isValidTrajectory(const autoware_planning_msgs::msg::Trajectory & traj)
+{
+  return std::all_of(traj.points.cbegin(), traj.points.cend(), [](const auto & point) {
+    const auto & p = point.pose.position;
+    const auto & o = point.pose.orientation;
+    const auto & t = point.longitudinal_velocity_mps;
+    const auto & a = point.acceleration_mps2;
+
+    return std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z) &&
+           std::isfinite(o.x) && std::isfinite(o.y) && std::isfinite(o.z) &&
+           std::isfinite(o.w) && std::isfinite(t) && std::isfinite(a);
+  });
+}
+
 double determinant(std::array<double, 2> const & a, std::array<double, 2> const & b)
 {
   return a[0] * b[1] - b[0] * a[1];
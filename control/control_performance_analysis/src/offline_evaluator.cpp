@@ -0,0 +1,231 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "control_performance_analysis/offline_evaluator.hpp"
+
+#include <Eigen/Core>
+#include <rclcpp/serialization.hpp>
+#include <rosbag2_cpp/reader.hpp>
+#include <rosbag2_storage/storage_filter.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace control_performance_analysis
+{
+namespace
+{
+const std::vector<std::pair<std::string, double Error::*>> error_metrics{
+  {"lateral_error", &Error::lateral_error},
+  {"lateral_error_velocity", &Error::lateral_error_velocity},
+  {"lateral_error_acceleration", &Error::lateral_error_acceleration},
+  {"longitudinal_error", &Error::longitudinal_error},
+  {"longitudinal_error_velocity", &Error::longitudinal_error_velocity},
+  {"longitudinal_error_acceleration", &Error::longitudinal_error_acceleration},
+  {"heading_error", &Error::heading_error},
+  {"heading_error_velocity", &Error::heading_error_velocity},
+  {"control_effort_energy", &Error::control_effort_energy},
+  {"error_energy", &Error::error_energy},
+  {"value_approximation", &Error::value_approximation},
+  {"curvature_estimate", &Error::curvature_estimate},
+  {"curvature_estimate_pp", &Error::curvature_estimate_pp},
+  {"vehicle_velocity_error", &Error::vehicle_velocity_error},
+  {"tracking_curvature_discontinuity_ability", &Error::tracking_curvature_discontinuity_ability},
+};
+
+const std::vector<std::pair<std::string, FloatStamped DrivingMonitorStamped::*>> driving_metrics{
+  {"longitudinal_acceleration", &DrivingMonitorStamped::longitudinal_acceleration},
+  {"longitudinal_jerk", &DrivingMonitorStamped::longitudinal_jerk},
+  {"lateral_acceleration", &DrivingMonitorStamped::lateral_acceleration},
+  {"lateral_jerk", &DrivingMonitorStamped::lateral_jerk},
+  {"desired_steering_angle", &DrivingMonitorStamped::desired_steering_angle},
+  {"controller_processing_time", &DrivingMonitorStamped::controller_processing_time},
+};
+
+template <class T>
+T deserialize(const rosbag2_storage::SerializedBagMessage & bag_message)
+{
+  const rclcpp::Serialization<T> serialization;
+  const rclcpp::SerializedMessage serialized_msg(*bag_message.serialized_data);
+  T msg;
+  serialization.deserialize_message(&serialized_msg, &msg);
+  return msg;
+}
+}  // namespace
+
+MetricSummary summarizeMetric(const std::string & name, const std::vector<double> & values)
+{
+  // the values which are not finite, e.g. the jerk right after a stamp is repeated, are skipped
+  std::vector<double> finite_values;
+  finite_values.reserve(values.size());
+  std::copy_if(values.begin(), values.end(), std::back_inserter(finite_values), [](const double v) {
+    return std::isfinite(v);
+  });
+
+  MetricSummary summary;
+  summary.name = name;
+  summary.count = finite_values.size();
+  if (finite_values.empty()) {
+    return summary;
+  }
+
+  const Eigen::Map<const Eigen::ArrayXd> array(
+    finite_values.data(), static_cast<Eigen::Index>(finite_values.size()));
+  summary.mean = array.mean();
+  summary.rms = std::sqrt(array.square().mean());
+  summary.min = array.minCoeff();
+  summary.max = array.maxCoeff();
+  summary.max_abs = array.abs().maxCoeff();
+  return summary;
+}
+
+BagEvaluationResult evaluateBag(
+  const std::string & bag_path, const OfflineEvaluatorTopics & topics, const Params & params)
+{
+  BagEvaluationResult result;
+  result.bag_path = bag_path;
+
+  std::vector<std::vector<double>> error_values(error_metrics.size());
+  std::vector<std::vector<double>> driving_values(driving_metrics.size());
+  try {
+    rosbag2_cpp::Reader bag_reader;
+    bag_reader.open(bag_path);
+
+    rosbag2_storage::StorageFilter storage_filter;
+    storage_filter.topics = {
+      topics.reference_trajectory, topics.control_raw, topics.measured_steering, topics.odometry};
+    bag_reader.set_filter(storage_filter);
+
+    Params core_params = params;
+    ControlPerformanceAnalysisCore core(core_params);
+
+    // same state as the one held by ControlPerformanceAnalysisNode
+    std::optional<Trajectory> current_trajectory;
+    std::optional<Control> current_control;
+    std::optional<Control> last_control;
+    std::optional<SteeringReport> current_steering;
+    double d_control_cmd = 0.0;
+
+    while (bag_reader.has_next()) {
+      const auto bag_message = bag_reader.read_next();
+      const auto & topic_name = bag_message->topic_name;
+
+      if (topic_name == topics.reference_trajectory) {
+        auto trajectory = deserialize<Trajectory>(*bag_message);
+        if (trajectory.points.size() >= 3 && utils::isValidTrajectory(trajectory)) {
+          current_trajectory = std::move(trajectory);
+        }
+      } else if (topic_name == topics.control_raw) {
+        const auto control = deserialize<Control>(*bag_message);
+        if (last_control) {
+          const auto duration = rclcpp::Time(control.stamp) - rclcpp::Time(last_control->stamp);
+          d_control_cmd = duration.seconds() * 1000;  // ms
+        }
+        last_control = current_control;
+        current_control = control;
+      } else if (topic_name == topics.measured_steering) {
+        current_steering = deserialize<SteeringReport>(*bag_message);
+      } else if (topic_name == topics.odometry) {
+        const auto odometry = deserialize<Odometry>(*bag_message);
+        core.setOdomHistory(odometry);
+        if (!current_trajectory || !current_control || !current_steering) {
+          continue;
+        }
+
+        core.setCurrentWaypoints(*current_trajectory);
+        core.setCurrentPose(odometry.pose.pose);
+        core.setCurrentControlValue(*current_control);
+        core.setSteeringStatus(*current_steering);
+        if (!core.isDataReady()) {
+          continue;
+        }
+
+        if (core.calculateErrorVars()) {
+          for (size_t i = 0; i < error_metrics.size(); ++i) {
+            error_values.at(i).push_back(core.error_vars.error.*error_metrics.at(i).second);
+          }
+        }
+        if (core.calculateDrivingVars()) {
+          auto & status_vars = core.driving_status_vars;
+          status_vars.controller_processing_time.header.stamp = current_control->stamp;
+          status_vars.controller_processing_time.data = d_control_cmd;
+          for (size_t i = 0; i < driving_metrics.size(); ++i) {
+            driving_values.at(i).push_back((status_vars.*driving_metrics.at(i).second).data);
+          }
+        }
+      }
+    }
+  } catch (const std::exception & e) {
+    result.error_message = e.what();
+    return result;
+  }
+
+  for (size_t i = 0; i < error_metrics.size(); ++i) {
+    result.summaries.push_back(summarizeMetric(error_metrics.at(i).first, error_values.at(i)));
+  }
+  for (size_t i = 0; i < driving_metrics.size(); ++i) {
+    result.summaries.push_back(summarizeMetric(driving_metrics.at(i).first, driving_values.at(i)));
+  }
+  result.success = true;
+  return result;
+}
+
+std::vector<BagEvaluationResult> evaluateBags(
+  const std::vector<std::string> & bag_paths, const OfflineEvaluatorTopics & topics,
+  const Params & params, const size_t num_threads)
+{
+  std::vector<BagEvaluationResult> results(bag_paths.size());
+  const size_t max_threads =
+    num_threads > 0 ? num_threads : std::max(std::thread::hardware_concurrency(), 1u);
+  const size_t thread_num = std::min(max_threads, bag_paths.size());
+
+  // each thread takes the next bag when it finishes one, since the lengths of the bags vary
+  std::atomic<size_t> next_idx{0};
+  const auto evaluate_remaining_bags = [&]() {
+    for (size_t i = next_idx++; i < bag_paths.size(); i = next_idx++) {
+      results.at(i) = evaluateBag(bag_paths.at(i), topics, params);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back(evaluate_remaining_bags);
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  return results;
+}
+
+void writeSummaries(std::ostream & os, const std::vector<BagEvaluationResult> & results)
+{
+  os << "bag_path,metric,count,mean,rms,min,max,max_abs\n";
+  for (const auto & result : results) {
+    if (!result.success) {
+      continue;
+    }
+    for (const auto & summary : result.summaries) {
+      os << result.bag_path << "," << summary.name << "," << summary.count << "," << summary.mean
+         << "," << summary.rms << "," << summary.min << "," << summary.max << ","
+         << summary.max_abs << "\n";
+    }
+  }
+}
+}  // namespace control_performance_analysis
@@ -0,0 +1,378 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "control_performance_analysis/offline_evaluator.hpp"
+
+#include <rclcpp/time.hpp>
+#include <rosbag2_cpp/writer.hpp>
+#include <rosbag2_storage/storage_options.hpp>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using control_performance_analysis::BagEvaluationResult;
+using control_performance_analysis::ControlPerformanceAnalysisCore;
+using control_performance_analysis::Control;
+using control_performance_analysis::MetricSummary;
+using control_performance_analysis::Odometry;
+using control_performance_analysis::OfflineEvaluatorTopics;
+using control_performance_analysis::Params;
+using control_performance_analysis::SteeringReport;
+using control_performance_analysis::summarizeMetric;
+using control_performance_analysis::Trajectory;
+
+namespace
+{
+constexpr double control_period = 0.03;  // [s]
+constexpr double ego_velocity = 5.0;     // [m/s]
+
+Params createParams()
+{
+  // same as control_performance_analysis.param.yaml
+  Params params;
+  params.wheelbase_ = 2.79;
+  params.curvature_interval_length_ = 5.0;
+  params.odom_interval_ = 0;
+  params.acceptable_max_distance_to_waypoint_ = 2.0;
+  params.acceptable_max_yaw_difference_rad_ = 1.0472;
+  params.prevent_zero_division_value_ = 0.001;
+  params.lpf_gain_ = 0.95;
+  return params;
+}
+
+OfflineEvaluatorTopics createTopics()
+{
+  OfflineEvaluatorTopics topics;
+  topics.reference_trajectory = "/planning/scenario_planning/trajectory";
+  topics.control_raw = "/control/command/control_cmd";
+  topics.measured_steering = "/vehicle/status/steering_status";
+  topics.odometry = "/localization/kinematic_state";
+  return topics;
+}
+
+// straight trajectory along the x axis
+Trajectory createTrajectory(const rclcpp::Time & stamp, const size_t size)
+{
+  Trajectory trajectory;
+  trajectory.header.stamp = stamp;
+  trajectory.header.frame_id = "map";
+  for (size_t i = 0; i < size; ++i) {
+    autoware_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position.x = static_cast<double>(i);
+    p.pose.orientation.w = 1.0;
+    p.longitudinal_velocity_mps = ego_velocity;
+    trajectory.points.push_back(p);
+  }
+  return trajectory;
+}
+
+Control createControl(const rclcpp::Time & stamp, const double steering_angle)
+{
+  Control control;
+  control.stamp = stamp;
+  control.lateral.stamp = stamp;
+  control.lateral.steering_tire_angle = static_cast<float>(steering_angle);
+  control.longitudinal.stamp = stamp;
+  control.longitudinal.velocity = static_cast<float>(ego_velocity);
+  return control;
+}
+
+SteeringReport createSteering(const rclcpp::Time & stamp, const double steering_angle)
+{
+  SteeringReport steering;
+  steering.stamp = stamp;
+  steering.steering_tire_angle = static_cast<float>(steering_angle);
+  return steering;
+}
+
+// the ego drives along the trajectory with a small lateral oscillation
+Odometry createOdometry(const rclcpp::Time & stamp, const double t)
+{
+  Odometry odometry;
+  odometry.header.stamp = stamp;
+  odometry.header.frame_id = "map";
+  odometry.pose.pose.position.x = ego_velocity * t;
+  odometry.pose.pose.position.y = 0.1 * std::sin(t);
+  odometry.pose.pose.orientation.w = 1.0;
+  odometry.twist.twist.linear.x = ego_velocity + 0.1 * std::cos(t);
+  return odometry;
+}
+
+// ControlPerformanceAnalysisNode fed with the messages directly, which keeps the values of the
+// metrics instead of publishing them
+class ReferenceEvaluator
+{
+public:
+  explicit ReferenceEvaluator(Params params) : params_(params), core_(params_) {}
+
+  void onTrajectory(const Trajectory & trajectory)
+  {
+    if (
+      trajectory.points.size() >= 3 &&
+      control_performance_analysis::utils::isValidTrajectory(trajectory)) {
+      current_trajectory_ = trajectory;
+    }
+  }
+
+  void onControlRaw(const Control & control)
+  {
+    if (last_control_) {
+      d_control_cmd_ =
+        (rclcpp::Time(control.stamp) - rclcpp::Time(last_control_->stamp)).seconds() * 1000;
+    }
+    last_control_ = current_control_;
+    current_control_ = control;
+  }
+
+  void onSteering(const SteeringReport & steering) { current_steering_ = steering; }
+
+  void onOdometry(const Odometry & odometry)
+  {
+    core_.setOdomHistory(odometry);
+    if (!current_trajectory_ || !current_control_ || !current_steering_) {
+      return;
+    }
+    core_.setCurrentWaypoints(*current_trajectory_);
+    core_.setCurrentPose(odometry.pose.pose);
+    core_.setCurrentControlValue(*current_control_);
+    core_.setSteeringStatus(*current_steering_);
+    if (!core_.isDataReady()) {
+      return;
+    }
+    if (core_.calculateErrorVars()) {
+      errors.push_back(core_.error_vars.error);
+    }
+    if (core_.calculateDrivingVars()) {
+      lateral_accelerations.push_back(core_.driving_status_vars.lateral_acceleration.data);
+      controller_processing_times.push_back(d_control_cmd_);
+    }
+  }
+
+  std::vector<control_performance_analysis::Error> errors;
+  std::vector<double> lateral_accelerations;
+  std::vector<double> controller_processing_times;
+
+private:
+  Params params_;
+  ControlPerformanceAnalysisCore core_;
+  std::optional<Trajectory> current_trajectory_;
+  std::optional<Control> current_control_;
+  std::optional<Control> last_control_;
+  std::optional<SteeringReport> current_steering_;
+  double d_control_cmd_{0.0};
+};
+
+const MetricSummary & findSummary(const BagEvaluationResult & result, const std::string & name)
+{
+  const auto it = std::find_if(
+    result.summaries.begin(), result.summaries.end(),
+    [&](const auto & summary) { return summary.name == name; });
+  if (it == result.summaries.end()) {
+    throw std::runtime_error("no summary of " + name);
+  }
+  return *it;
+}
+
+void expectSameSummary(const MetricSummary & actual, const MetricSummary & expected)
+{
+  EXPECT_EQ(actual.count, expected.count) << actual.name;
+  EXPECT_DOUBLE_EQ(actual.mean, expected.mean) << actual.name;
+  EXPECT_DOUBLE_EQ(actual.rms, expected.rms) << actual.name;
+  EXPECT_DOUBLE_EQ(actual.min, expected.min) << actual.name;
+  EXPECT_DOUBLE_EQ(actual.max, expected.max) << actual.name;
+  EXPECT_DOUBLE_EQ(actual.max_abs, expected.max_abs) << actual.name;
+}
+}  // namespace
+
+TEST(OfflineEvaluator, SummarizeMetricSkipsNonFiniteValues)
+{
+  constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  const auto summary = summarizeMetric("lateral_error", {1.0, -3.0, nan, 2.0, inf, -inf});
+
+  EXPECT_EQ(summary.name, "lateral_error");
+  EXPECT_EQ(summary.count, 3u);
+  EXPECT_DOUBLE_EQ(summary.mean, 0.0);
+  EXPECT_DOUBLE_EQ(summary.rms, std::sqrt((1.0 + 9.0 + 4.0) / 3.0));
+  EXPECT_DOUBLE_EQ(summary.min, -3.0);
+  EXPECT_DOUBLE_EQ(summary.max, 2.0);
+  EXPECT_DOUBLE_EQ(summary.max_abs, 3.0);
+}
+
+TEST(OfflineEvaluator, SummarizeMetricMaxAbsOfNegativeValues)
+{
+  const auto summary = summarizeMetric("heading_error", {-0.5, -2.5, -1.5});
+
+  EXPECT_EQ(summary.count, 3u);
+  EXPECT_DOUBLE_EQ(summary.mean, -1.5);
+  EXPECT_DOUBLE_EQ(summary.rms, std::sqrt((0.25 + 6.25 + 2.25) / 3.0));
+  EXPECT_DOUBLE_EQ(summary.min, -2.5);
+  EXPECT_DOUBLE_EQ(summary.max, -0.5);
+  EXPECT_DOUBLE_EQ(summary.max_abs, 2.5);
+}
+
+TEST(OfflineEvaluator, SummarizeMetricWithoutFiniteValues)
+{
+  for (const auto & values : std::vector<std::vector<double>>{
+         {}, {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()}}) {
+    const auto summary = summarizeMetric("longitudinal_jerk", values);
+    EXPECT_EQ(summary.name, "longitudinal_jerk");
+    EXPECT_EQ(summary.count, 0u);
+    EXPECT_DOUBLE_EQ(summary.mean, 0.0);
+    EXPECT_DOUBLE_EQ(summary.rms, 0.0);
+    EXPECT_DOUBLE_EQ(summary.min, 0.0);
+    EXPECT_DOUBLE_EQ(summary.max, 0.0);
+    EXPECT_DOUBLE_EQ(summary.max_abs, 0.0);
+  }
+}
+
+TEST(OfflineEvaluator, WriteSummariesOfSucceededBags)
+{
+  BagEvaluationResult succeeded;
+  succeeded.bag_path = "bag1";
+  succeeded.success = true;
+  succeeded.summaries = {summarizeMetric("lateral_error", {1.0, -1.0})};
+  BagEvaluationResult failed;
+  failed.bag_path = "bag2";
+  failed.error_message = "cannot open";
+  failed.summaries = {summarizeMetric("lateral_error", {2.0})};
+
+  std::ostringstream os;
+  control_performance_analysis::writeSummaries(os, {succeeded, failed});
+  EXPECT_EQ(
+    os.str(),
+    "bag_path,metric,count,mean,rms,min,max,max_abs\n"
+    "bag1,lateral_error,2,0,1,-1,1,1\n");
+}
+
+// writes a bag of the input topics and feeds the same messages to ReferenceEvaluator
+class OfflineEvaluatorBagTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    bag_path_ = (std::filesystem::temp_directory_path() /
+                 ("test_offline_evaluator_" + std::to_string(getpid())))
+                  .string();
+    std::filesystem::remove_all(bag_path_);
+
+    rosbag2_storage::StorageOptions storage_options;
+    storage_options.uri = bag_path_;
+    storage_options.storage_id = "sqlite3";
+    rosbag2_cpp::Writer writer;
+    writer.open(storage_options);
+
+    // the messages are received in this order, 1 ms apart in a control period
+    const auto topics = createTopics();
+    for (int k = 0; k < 100; ++k) {
+      const double t = k * control_period;
+      const rclcpp::Time stamp(std::llround(t * 1e9));
+      const auto receive_time = [&](const int i) {
+        return stamp + rclcpp::Duration::from_seconds(i * 1e-3);
+      };
+      const double steering_angle = 0.01 * std::sin(t);
+
+      if (k % 10 == 0) {
+        // the trajectory with less than 3 points is ignored
+        const auto trajectory = createTrajectory(stamp, k == 50 ? 2 : 100);
+        writer.write(trajectory, topics.reference_trajectory, receive_time(0));
+        reference_.onTrajectory(trajectory);
+      }
+      const auto control = createControl(stamp, steering_angle);
+      writer.write(control, topics.control_raw, receive_time(1));
+      reference_.onControlRaw(control);
+      // the metrics are not calculated until the first steering is received
+      if (k >= 5) {
+        const auto steering = createSteering(stamp, steering_angle);
+        writer.write(steering, topics.measured_steering, receive_time(2));
+        reference_.onSteering(steering);
+      }
+      // the topic which is not the input is filtered out
+      writer.write(createControl(stamp, 1.0), "/control/command/other_cmd", receive_time(3));
+      const auto odometry = createOdometry(stamp, t);
+      writer.write(odometry, topics.odometry, receive_time(4));
+      reference_.onOdometry(odometry);
+    }
+  }
+
+  void TearDown() override { std::filesystem::remove_all(bag_path_); }
+
+  std::string bag_path_;
+  ReferenceEvaluator reference_{createParams()};
+};
+
+TEST_F(OfflineEvaluatorBagTest, SameMetricsAsDirectFeed)
+{
+  ASSERT_FALSE(reference_.errors.empty());
+  const auto result =
+    control_performance_analysis::evaluateBag(bag_path_, createTopics(), createParams());
+  ASSERT_TRUE(result.success) << result.error_message;
+  EXPECT_EQ(result.bag_path, bag_path_);
+
+  std::vector<double> lateral_errors;
+  std::vector<double> heading_errors;
+  for (const auto & error : reference_.errors) {
+    lateral_errors.push_back(error.lateral_error);
+    heading_errors.push_back(error.heading_error);
+  }
+  expectSameSummary(
+    findSummary(result, "lateral_error"), summarizeMetric("lateral_error", lateral_errors));
+  expectSameSummary(
+    findSummary(result, "heading_error"), summarizeMetric("heading_error", heading_errors));
+  expectSameSummary(
+    findSummary(result, "lateral_acceleration"),
+    summarizeMetric("lateral_acceleration", reference_.lateral_accelerations));
+
+  // the duration between a control and the one before the previous one, as the node calculates
+  const auto & processing_time = findSummary(result, "controller_processing_time");
+  expectSameSummary(
+    processing_time,
+    summarizeMetric("controller_processing_time", reference_.controller_processing_times));
+  EXPECT_NEAR(processing_time.max, 2 * control_period * 1000, 1e-6);
+}
+
+TEST_F(OfflineEvaluatorBagTest, EvaluateBagsInParallel)
+{
+  const auto expected =
+    control_performance_analysis::evaluateBag(bag_path_, createTopics(), createParams());
+  const auto missing_bag_path = bag_path_ + "_missing";
+  const auto results = control_performance_analysis::evaluateBags(
+    {bag_path_, missing_bag_path, bag_path_}, createTopics(), createParams(), 2);
+
+  ASSERT_EQ(results.size(), 3u);
+  for (const size_t i : {0u, 2u}) {
+    EXPECT_EQ(results.at(i).bag_path, bag_path_);
+    ASSERT_TRUE(results.at(i).success) << results.at(i).error_message;
+    ASSERT_EQ(results.at(i).summaries.size(), expected.summaries.size());
+    for (size_t j = 0; j < expected.summaries.size(); ++j) {
+      expectSameSummary(results.at(i).summaries.at(j), expected.summaries.at(j));
+    }
+  }
+
+  EXPECT_EQ(results.at(1).bag_path, missing_bag_path);
+  EXPECT_FALSE(results.at(1).success);
+  EXPECT_FALSE(results.at(1).error_message.empty());
+  EXPECT_TRUE(results.at(1).summaries.empty());
+}
@@ -97,10 +97,6 @@ private:
   static bool willCollide(
     const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
     const std::vector<LinearRing2d> & vehicle_footprints);
-
-  static bool hasCollision(
-    const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
-    const LinearRing2d & vehicle_footprint);
 };
 }  // namespace obstacle_collision_checker
 
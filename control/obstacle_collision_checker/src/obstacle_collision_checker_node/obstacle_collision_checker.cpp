@@ -14,6 +14,7 @@
 
 #include "obstacle_collision_checker/obstacle_collision_checker.hpp"
 
+#include <autoware/universe_utils/geometry/batch_collision_checker.hpp>
 #include <autoware/universe_utils/geometry/geometry.hpp>
 #include <autoware/universe_utils/math/normalization.hpp>
 #include <autoware/universe_utils/math/unit_conversion.hpp>
@@ -37,6 +38,9 @@
 
 namespace
 {
+// cell size of the grid to look up the obstacle points around the vehicle passing areas [m]
+constexpr double grid_cell_size = 1.0;
+
 pcl::PointCloud<pcl::PointXYZ> getTransformedPointCloud(
   const sensor_msgs::msg::PointCloud2 & pointcloud_msg,
   const geometry_msgs::msg::Transform & transform)
@@ -238,33 +242,26 @@ bool ObstacleCollisionChecker::willCollide(
   const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
   const std::vector<LinearRing2d> & vehicle_footprints)
 {
-  for (size_t i = 1; i < vehicle_footprints.size(); i++) {
-    // skip first footprint because surround obstacle checker handle it
-    const auto & vehicle_footprint = vehicle_footprints.at(i);
-    if (hasCollision(obstacle_pointcloud, vehicle_footprint)) {
-      RCLCPP_WARN(
-        rclcpp::get_logger("obstacle_collision_checker"), "ObstacleCollisionChecker::willCollide");
-      return true;
-    }
+  std::vector<autoware::universe_utils::Point2d> obstacle_points;
+  obstacle_points.reserve(obstacle_pointcloud.size());
+  for (const auto & point : obstacle_pointcloud.points) {
+    obstacle_points.emplace_back(point.x, point.y);
   }
+  const autoware::universe_utils::PointGrid2d obstacle_grid(obstacle_points, grid_cell_size);
+  const autoware::universe_utils::BatchCollisionChecker collision_checker(vehicle_footprints);
 
-  return false;
-}
-
-bool ObstacleCollisionChecker::hasCollision(
-  const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
-  const LinearRing2d & vehicle_footprint)
-{
-  for (const auto & point : obstacle_pointcloud.points) {
-    if (boost::geometry::within(
-          autoware::universe_utils::Point2d{point.x, point.y}, vehicle_footprint)) {
-      RCLCPP_WARN(
-        rclcpp::get_logger("obstacle_collision_checker"),
-        "[ObstacleCollisionChecker] Collide to Point x: %f y: %f", point.x, point.y);
-      return true;
-    }
+  // skip first footprint because surround obstacle checker handle it
+  const auto collision = collision_checker.findFirstPointWithin(obstacle_grid, 1);
+  if (!collision) {
+    return false;
   }
 
-  return false;
+  const auto & point = obstacle_pointcloud.points.at(collision->second);
+  RCLCPP_WARN(
+    rclcpp::get_logger("obstacle_collision_checker"),
+    "[ObstacleCollisionChecker] Collide to Point x: %f y: %f", point.x, point.y);
+  RCLCPP_WARN(
+    rclcpp::get_logger("obstacle_collision_checker"), "ObstacleCollisionChecker::willCollide");
+  return true;
 }
 }  // namespace obstacle_collision_checker
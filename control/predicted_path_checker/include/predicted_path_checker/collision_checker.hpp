@@ -17,6 +17,7 @@
 
 #include <autoware/motion_utils/trajectory/conversion.hpp>
 #include <autoware/motion_utils/trajectory/interpolation.hpp>
+#include <autoware/universe_utils/geometry/batch_collision_checker.hpp>
 #include <autoware/universe_utils/geometry/geometry.hpp>
 #include <autoware/universe_utils/ros/debug_publisher.hpp>
 #include <autoware/universe_utils/ros/transform_listener.hpp>
@@ -37,6 +38,7 @@
 #include <tf2_ros/transform_listener.h>
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -92,6 +94,10 @@ public:
 private:
   // Functions
 
+  std::optional<size_t> findFirstCollisionStep(
+    const TrajectoryPoints & predicted_trajectory_array, const PredictedObjects & dynamic_objects,
+    const autoware::universe_utils::BatchCollisionChecker & one_step_move_vehicle_polygons) const;
+
   boost::optional<std::pair<geometry_msgs::msg::Point, PredictedObject>> checkObstacleHistory(
     const Pose & base_pose, const Polygon2d & one_step_move_vehicle_polygon2d, const double z_min,
     const double z_max);
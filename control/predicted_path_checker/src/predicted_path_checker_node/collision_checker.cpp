@@ -18,6 +18,7 @@
 #include <rclcpp/logging.hpp>
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -50,17 +51,25 @@ CollisionChecker::checkTrajectoryForCollision(
     return boost::none;
   }
 
+  // create one-step polygons for vehicle
+  std::vector<Polygon2d> one_step_move_vehicle_polygons;
+  for (size_t i = 0; i < predicted_trajectory_array.size() - 1; i++) {
+    one_step_move_vehicle_polygons.push_back(utils::createOneStepPolygon(
+      predicted_trajectory_array.at(i).pose, predicted_trajectory_array.at(i + 1).pose,
+      vehicle_info_, param_.width_margin));
+  }
+  const auto collision_step = findFirstCollisionStep(
+    predicted_trajectory_array, *dynamic_objects,
+    autoware::universe_utils::BatchCollisionChecker(one_step_move_vehicle_polygons));
+
   for (size_t i = 0; i < predicted_trajectory_array.size() - 1; i++) {
     // create one step circle center for vehicle
     const auto & p_front = predicted_trajectory_array.at(i).pose;
-    const auto & p_back = predicted_trajectory_array.at(i + 1).pose;
     const auto z_min = p_front.position.z;
     const auto z_max =
       p_front.position.z + vehicle_info_.max_height_offset_m + param_.z_axis_filtering_buffer;
 
-    // create one-step polygon for vehicle
-    Polygon2d one_step_move_vehicle_polygon2d =
-      utils::createOneStepPolygon(p_front, p_back, vehicle_info_, param_.width_margin);
+    const auto & one_step_move_vehicle_polygon2d = one_step_move_vehicle_polygons.at(i);
     if (param_.enable_z_axis_obstacle_filtering) {
       debug_ptr_->pushPolyhedron(
         one_step_move_vehicle_polygon2d, z_min, z_max, PolygonType::Vehicle);
@@ -69,6 +78,11 @@ CollisionChecker::checkTrajectoryForCollision(
         one_step_move_vehicle_polygon2d, p_front.position.z, PolygonType::Vehicle);
     }
 
+    // the collision points are calculated from the first step colliding with obstacles
+    if (!collision_step || i < *collision_step) {
+      continue;
+    }
+
     // check obstacle history
     auto found_collision_at_history =
       checkObstacleHistory(p_front, one_step_move_vehicle_polygon2d, z_min, z_max);
@@ -113,6 +127,57 @@ CollisionChecker::checkTrajectoryForCollision(
   return boost::none;
 }
 
+std::optional<size_t> CollisionChecker::findFirstCollisionStep(
+  const TrajectoryPoints & predicted_trajectory_array, const PredictedObjects & dynamic_objects,
+  const autoware::universe_utils::BatchCollisionChecker & one_step_move_vehicle_polygons) const
+{
+  const auto intersects_in_z_axis = [&](const PredictedObject & object, const size_t step) {
+    if (!param_.enable_z_axis_obstacle_filtering) {
+      return true;
+    }
+    const auto z_min = predicted_trajectory_array.at(step).pose.position.z;
+    const auto z_max = z_min + vehicle_info_.max_height_offset_m + param_.z_axis_filtering_buffer;
+    return utils::intersectsInZAxis(object, z_min, z_max);
+  };
+
+  // the steps after the first collision found so far are not searched
+  size_t first_step = one_step_move_vehicle_polygons.size();
+  for (const auto & obj_history : predicted_object_history_) {
+    const Point2d point2d(obj_history.point.x, obj_history.point.y);
+    for (size_t i = 0; i < first_step; ++i) {
+      if (
+        intersects_in_z_axis(obj_history.object, i) &&
+        one_step_move_vehicle_polygons.isWithin(i, point2d)) {
+        first_step = i;
+        break;
+      }
+    }
+  }
+
+  for (const auto & obj : dynamic_objects.objects) {
+    const auto object_polygon = utils::convertObjToPolygon(obj);
+    if (object_polygon.outer().empty()) {
+      // unsupported type
+      continue;
+    }
+    const autoware::universe_utils::PreparedPolygon prepared_object_polygon(object_polygon);
+    auto step = one_step_move_vehicle_polygons.findFirstIntersection(prepared_object_polygon);
+    while (step && *step < first_step) {
+      if (intersects_in_z_axis(obj, *step)) {
+        first_step = *step;
+        break;
+      }
+      step =
+        one_step_move_vehicle_polygons.findFirstIntersection(prepared_object_polygon, *step + 1);
+    }
+  }
+
+  if (first_step == one_step_move_vehicle_polygons.size()) {
+    return std::nullopt;
+  }
+  return first_step;
+}
+
 boost::optional<std::pair<geometry_msgs::msg::Point, PredictedObject>>
 CollisionChecker::checkObstacleHistory(
   const Pose & base_pose, const Polygon2d & one_step_move_vehicle_polygon2d, const double z_min,
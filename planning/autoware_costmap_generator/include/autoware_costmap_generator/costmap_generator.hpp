@@ -112,6 +112,10 @@ private:
 
   grid_map::GridMap costmap_;
 
+  // map primitives rasterized in the map frame around the costmap, reused until the costmap moves
+  // out of it
+  grid_map::GridMap primitives_costmap_;
+
   rclcpp::Publisher<grid_map_msgs::msg::GridMap>::SharedPtr pub_costmap_;
   rclcpp::Publisher<nav_msgs::msg::OccupancyGrid>::SharedPtr pub_occupancy_grid_;
 
@@ -185,19 +189,22 @@ private:
 
   /// \brief calculate cost from pointcloud data
   /// \param[in] in_points: subscribed pointcloud data
-  grid_map::Matrix generatePointsCostmap(
+  const grid_map::Matrix & generatePointsCostmap(
     const sensor_msgs::msg::PointCloud2::ConstSharedPtr & in_points);
 
   /// \brief calculate cost from DynamicObjectArray
   /// \param[in] in_objects: subscribed DynamicObjectArray
-  grid_map::Matrix generateObjectsCostmap(
+  const grid_map::Matrix & generateObjectsCostmap(
     const autoware_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects);
 
   /// \brief calculate cost from lanelet2 map
   grid_map::Matrix generatePrimitivesCostmap();
 
-  /// \brief calculate cost for final output
-  grid_map::Matrix generateCombinedCostmap();
+  /// \brief rasterize lanelet2 map primitives around the costmap in the map frame
+  void updatePrimitivesCostmap();
+
+  /// \brief calculate cost for final output in the combined layer
+  void generateCombinedCostmap();
 };
 }  // namespace autoware::costmap_generator
 
@@ -56,6 +56,7 @@
 #include <autoware_perception_msgs/msg/predicted_objects.hpp>
 
 #include <string>
+#include <vector>
 
 namespace autoware::costmap_generator
 {
@@ -70,7 +71,7 @@ public:
   /// \param[in] size_of_expansion_kernel: kernel size for blurring cost
   /// \param[in] in_objects: subscribed PredictedObjects
   /// \param[out] calculated cost in grid_map::Matrix format
-  grid_map::Matrix makeCostmapFromObjects(
+  const grid_map::Matrix & makeCostmapFromObjects(
     const grid_map::GridMap & costmap, const double expand_polygon_size,
     const double size_of_expansion_kernel,
     const autoware_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects);
@@ -78,8 +79,12 @@ public:
 private:
   const int NUMBER_OF_POINTS;
   const int NUMBER_OF_DIMENSIONS;
-  const std::string OBJECTS_COSTMAP_LAYER_;
-  const std::string BLURRED_OBJECTS_COSTMAP_LAYER_;
+
+  // costmaps reused between the calls to avoid allocations
+  grid_map::Matrix objects_costmap_;
+  grid_map::Matrix blurred_objects_costmap_;
+  std::vector<double> crossing_ys_;
+  std::vector<double> column_sums_;
 
   /// \brief make 4 rectangle points from centroid position and orientation
   /// \param[in] in_object: subscribed one of PredictedObjects
@@ -117,13 +122,20 @@ private:
     const double expand_polygon_size);
 
   /// \brief set cost in polygon by using DynamicObject's score
+  /// \details the cells whose center is inside the polygon are filled row by row
   /// \param[in] polygon: 4 rectangle points in polygon format
-  /// \param[in] gridmap_layer_name: target gridmap layer name for calculated cost
   /// \param[in] score: set score as a cost for costmap
-  /// \param[in] objects_costmap: update cost in this objects_costmap[gridmap_layer_name]
+  /// \param[in] gridmap: gridmap defining the geometry of the costmap
+  /// \param[in] objects_costmap: update cost in this objects_costmap
   void setCostInPolygon(
-    const grid_map::Polygon & polygon, const std::string & gridmap_layer_name, const float score,
-    grid_map::GridMap & objects_costmap);
+    const grid_map::Polygon & polygon, const float score, const grid_map::GridMap & gridmap,
+    grid_map::Matrix & objects_costmap);
+
+  /// \brief apply mean filter in place in the same order as grid_map::SlidingWindowIterator
+  /// \details the sums of the window are updated incrementally with the sums of each column
+  /// \param[in] size_of_expansion_kernel: kernel size for blurring cost
+  /// \param[in] costmap: costmap to be blurred
+  void applyMeanFilter(const int size_of_expansion_kernel, grid_map::Matrix & costmap);
 };
 }  // namespace autoware::costmap_generator
 #endif  // AUTOWARE_COSTMAP_GENERATOR__OBJECTS_TO_COSTMAP_HPP_
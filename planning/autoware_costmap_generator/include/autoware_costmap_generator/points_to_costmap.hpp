@@ -47,8 +47,11 @@
 
 #include <grid_map_ros/grid_map_ros.hpp>
 
+#include <Eigen/Geometry>
 #include <pcl_conversions/pcl_conversions.h>
 
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
 #include <string>
 #include <vector>
 
@@ -67,12 +70,28 @@ public:
   /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
   /// \param[in] in_sensor_points: subscribed pointcloud
   /// \param[out] calculated cost in grid_map::Matrix format
-  grid_map::Matrix makeCostmapFromPoints(
+  const grid_map::Matrix & makeCostmapFromPoints(
     const double maximum_height_thres, const double minimum_height_thres,
     const double grid_min_value, const double grid_max_value, const grid_map::GridMap & gridmap,
     const std::string & gridmap_layer_name,
     const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points);
 
+  /// \brief calculate cost from sensor points without converting them to pcl::PointCloud
+  /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
+  /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
+  /// \param[in] grid_min_value: Minimum cost for costmap
+  /// \param[in] grid_max_value: Maximum cost fot costmap
+  /// \param[in] gridmap: costmap based on gridmap
+  /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
+  /// \param[in] in_sensor_points: subscribed pointcloud
+  /// \param[in] transform: transform from the pointcloud frame to the gridmap frame
+  /// \param[out] calculated cost in grid_map::Matrix format
+  const grid_map::Matrix & makeCostmapFromPoints(
+    const double maximum_height_thres, const double minimum_height_thres,
+    const double grid_min_value, const double grid_max_value, const grid_map::GridMap & gridmap,
+    const std::string & gridmap_layer_name, const sensor_msgs::msg::PointCloud2 & in_sensor_points,
+    const Eigen::Affine3f & transform);
+
 private:
   double grid_length_x_;
   double grid_length_y_;
@@ -82,9 +101,16 @@ private:
   double y_cell_size_;
   double x_cell_size_;
 
-  /// \brief initialize gridmap parameters
+  // calculated costmap, reused between the calls to avoid allocations
+  grid_map::Matrix costmap_;
+
+  /// \brief initialize gridmap parameters and the costmap filled with grid_min_value
   /// \param[in] gridmap: gridmap object to be initialized
-  void initGridmapParam(const grid_map::GridMap & gridmap);
+  /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
+  /// \param[in] grid_min_value: Minimum cost for costmap
+  void initGridmapParam(
+    const grid_map::GridMap & gridmap, const std::string & gridmap_layer_name,
+    const double grid_min_value);
 
   /// \brief check if index is valid in the gridmap
   /// \param[in] grid_ind: grid index corresponding with one of pointcloud
@@ -92,31 +118,19 @@ private:
   bool isValidInd(const grid_map::Index & grid_ind);
 
   /// \brief Get index from one of pointcloud
-  /// \param[in] point: one of subscribed pointcloud
+  /// \param[in] x: x coordinate of the point
+  /// \param[in] y: y coordinate of the point
   /// \param[out] index in gridmap
-  grid_map::Index fetchGridIndexFromPoint(const pcl::PointXYZ & point);
-
-  /// \brief Assign pointcloud to appropriate cell in gridmap
-  /// \param[in] in_sensor_points: subscribed pointcloud
-  /// \param[out] grid-x-length x grid-y-length size grid stuffed with point's height in
-  /// corresponding grid cell
-  std::vector<std::vector<std::vector<double>>> assignPoints2GridCell(
-    const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points);
+  grid_map::Index fetchGridIndexFromPoint(const double x, const double y);
 
-  /// \brief calculate costmap from subscribed pointcloud
+  /// \brief set grid_max_value to the cell of the point if its height is within the thresholds
+  /// \param[in] point: one of pointcloud in the gridmap frame
   /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
   /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
-  /// \param[in] grid_min_value: Minimum cost for costmap
   /// \param[in] grid_max_value: Maximum cost fot costmap
-  /// \param[in] gridmap: costmap based on gridmap
-  /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
-  /// \param[in] grid_vec: grid-x-length x grid-y-length size grid stuffed with point's height in
-  /// corresponding grid cell \param[out] calculated costmap in grid_map::Matrix format
-  grid_map::Matrix calculateCostmap(
-    const double maximum_height_thres, const double minimum_lidar_height_thres,
-    const double grid_min_value, const double grid_max_value, const grid_map::GridMap & gridmap,
-    const std::string & gridmap_layer_name,
-    const std::vector<std::vector<std::vector<double>>> grid_vec);
+  void setCostFromPoint(
+    const Eigen::Vector3f & point, const double maximum_height_thres,
+    const double minimum_height_thres, const double grid_max_value);
 };
 }  // namespace autoware::costmap_generator
 
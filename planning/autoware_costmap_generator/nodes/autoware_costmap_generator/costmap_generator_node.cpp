@@ -49,7 +49,6 @@
 #include <autoware_lanelet2_extension/utility/query.hpp>
 #include <autoware_lanelet2_extension/utility/utilities.hpp>
 #include <autoware_lanelet2_extension/visualization/visualization.hpp>
-#include <pcl_ros/transforms.hpp>
 
 #include <lanelet2_core/geometry/Polygon.h>
 #include <tf2/utils.h>
@@ -59,6 +58,7 @@
 #include <tf2_eigen/tf2_eigen.hpp>
 #endif
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
@@ -138,21 +138,6 @@ std::vector<geometry_msgs::msg::Point> poly2vector(const geometry_msgs::msg::Pol
   return ps;
 }
 
-pcl::PointCloud<pcl::PointXYZ> getTransformedPointCloud(
-  const sensor_msgs::msg::PointCloud2 & pointcloud_msg,
-  const geometry_msgs::msg::Transform & transform)
-{
-  const Eigen::Matrix4f transform_matrix = tf2::transformToEigen(transform).matrix().cast<float>();
-
-  sensor_msgs::msg::PointCloud2 transformed_msg;
-  pcl_ros::transformPointCloud(transform_matrix, pointcloud_msg, transformed_msg);
-
-  pcl::PointCloud<pcl::PointXYZ> transformed_pointcloud;
-  pcl::fromROSMsg(transformed_msg, transformed_pointcloud);
-
-  return transformed_pointcloud;
-}
-
 }  // namespace
 
 namespace autoware::costmap_generator
@@ -267,6 +252,7 @@ void CostmapGenerator::onLaneletMapBin(
 {
   lanelet_map_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(*msg, lanelet_map_);
+  primitives_costmap_ = grid_map::GridMap();
 
   if (use_wayarea_) {
     loadRoadAreasFromLaneletMap(lanelet_map_, &primitives_points_);
@@ -309,10 +295,11 @@ void CostmapGenerator::onTimer()
     return;
   }
 
-  // Set grid center
+  // Set grid center, aligned with the cells of the cached map primitives
+  const double resolution = costmap_.getResolution();
   grid_map::Position p;
-  p.x() = tf.transform.translation.x;
-  p.y() = tf.transform.translation.y;
+  p.x() = std::round(tf.transform.translation.x / resolution) * resolution;
+  p.y() = std::round(tf.transform.translation.y / resolution) * resolution;
   costmap_.setPosition(p);
 
   if ((use_wayarea_ || use_parkinglot_) && lanelet_map_) {
@@ -327,7 +314,7 @@ void CostmapGenerator::onTimer()
     costmap_[LayerName::points] = generatePointsCostmap(points_);
   }
 
-  costmap_[LayerName::combined] = generateCombinedCostmap();
+  generateCombinedCostmap();
 
   publishCostmap(costmap_);
 }
@@ -368,7 +355,7 @@ void CostmapGenerator::initGridmap()
   costmap_.add(LayerName::combined, grid_min_value_);
 }
 
-grid_map::Matrix CostmapGenerator::generatePointsCostmap(
+const grid_map::Matrix & CostmapGenerator::generatePointsCostmap(
   const sensor_msgs::msg::PointCloud2::ConstSharedPtr & in_points)
 {
   geometry_msgs::msg::TransformStamped points2costmap;
@@ -379,13 +366,12 @@ grid_map::Matrix CostmapGenerator::generatePointsCostmap(
     RCLCPP_ERROR(rclcpp::get_logger("costmap_generator"), "%s", ex.what());
   }
 
-  const auto transformed_points = getTransformedPointCloud(*in_points, points2costmap.transform);
+  const Eigen::Affine3f transform(
+    tf2::transformToEigen(points2costmap.transform).matrix().cast<float>());
 
-  grid_map::Matrix points_costmap = points2costmap_.makeCostmapFromPoints(
+  return points2costmap_.makeCostmapFromPoints(
     maximum_lidar_height_thres_, minimum_lidar_height_thres_, grid_min_value_, grid_max_value_,
-    costmap_, LayerName::points, transformed_points);
-
-  return points_costmap;
+    costmap_, LayerName::points, *in_points, transform);
 }
 
 autoware_perception_msgs::msg::PredictedObjects::ConstSharedPtr transformObjects(
@@ -414,47 +400,77 @@ autoware_perception_msgs::msg::PredictedObjects::ConstSharedPtr transformObjects
   return autoware_perception_msgs::msg::PredictedObjects::ConstSharedPtr(objects);
 }
 
-grid_map::Matrix CostmapGenerator::generateObjectsCostmap(
+const grid_map::Matrix & CostmapGenerator::generateObjectsCostmap(
   const autoware_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects)
 {
   const auto object_frame = in_objects->header.frame_id;
   const auto transformed_objects =
     transformObjects(tf_buffer_, in_objects, costmap_frame_, object_frame);
 
-  grid_map::Matrix objects_costmap = objects2costmap_.makeCostmapFromObjects(
+  return objects2costmap_.makeCostmapFromObjects(
     costmap_, expand_polygon_size_, size_of_expansion_kernel_, transformed_objects);
-
-  return objects_costmap;
 }
 
 grid_map::Matrix CostmapGenerator::generatePrimitivesCostmap()
 {
-  grid_map::GridMap lanelet2_costmap = costmap_;
-  if (!primitives_points_.empty()) {
-    object_map::FillPolygonAreas(
-      lanelet2_costmap, primitives_points_, LayerName::primitives, grid_max_value_, grid_min_value_,
-      grid_min_value_, grid_max_value_, costmap_frame_, map_frame_, tf_buffer_);
+  if (costmap_frame_ != map_frame_) {
+    // the costmap may be rotated from the map frame, so the primitives are rasterized every time
+    grid_map::GridMap lanelet2_costmap = costmap_;
+    if (!primitives_points_.empty()) {
+      object_map::FillPolygonAreas(
+        lanelet2_costmap, primitives_points_, LayerName::primitives, grid_max_value_,
+        grid_min_value_, grid_min_value_, grid_max_value_, costmap_frame_, map_frame_, tf_buffer_);
+    }
+    return lanelet2_costmap[LayerName::primitives];
   }
-  return lanelet2_costmap[LayerName::primitives];
-}
-
-grid_map::Matrix CostmapGenerator::generateCombinedCostmap()
-{
-  // assuming combined_costmap is calculated by element wise max operation
-  grid_map::GridMap combined_costmap = costmap_;
 
-  combined_costmap[LayerName::combined].setConstant(grid_min_value_);
+  // the cells of the costmap and the cached primitives are aligned since the positions of both are
+  // multiples of the resolution
+  const grid_map::Size size = costmap_.getSize();
+  grid_map::Position top_left;
+  grid_map::Position bottom_right;
+  costmap_.getPosition(grid_map::Index(0, 0), top_left);
+  costmap_.getPosition(size - grid_map::Index::Ones(), bottom_right);
+  if (
+    !primitives_costmap_.exists(LayerName::primitives) || !primitives_costmap_.isInside(top_left) ||
+    !primitives_costmap_.isInside(bottom_right)) {
+    updatePrimitivesCostmap();
+  }
 
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::points]);
+  grid_map::Index top_left_index;
+  primitives_costmap_.getIndex(top_left, top_left_index);
+  return primitives_costmap_[LayerName::primitives].block(
+    top_left_index.x(), top_left_index.y(), size.x(), size.y());
+}
 
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::primitives]);
+void CostmapGenerator::updatePrimitivesCostmap()
+{
+  // keep a margin of the half of the costmap on each side so that the primitives are rasterized
+  // again only after the vehicle moves about the half of the costmap. The parity of the size is
+  // kept to align the cells with the costmap
+  const grid_map::Size size = costmap_.getSize() + (costmap_.getSize() / 2) * 2;
+  primitives_costmap_ = grid_map::GridMap();
+  primitives_costmap_.setFrameId(map_frame_);
+  primitives_costmap_.setGeometry(
+    grid_map::Length(size.cast<double>() * costmap_.getResolution()), costmap_.getResolution(),
+    costmap_.getPosition());
+  primitives_costmap_.add(LayerName::primitives, grid_min_value_);
 
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::objects]);
+  if (!primitives_points_.empty()) {
+    object_map::FillPolygonAreas(
+      primitives_costmap_, primitives_points_, LayerName::primitives, grid_max_value_,
+      grid_min_value_, grid_min_value_, grid_max_value_, map_frame_, map_frame_, tf_buffer_);
+  }
+}
 
-  return combined_costmap[LayerName::combined];
+void CostmapGenerator::generateCombinedCostmap()
+{
+  // assuming combined_costmap is calculated by element wise max operation, which is evaluated in a
+  // single pass without temporary layers
+  costmap_[LayerName::combined] = costmap_[LayerName::points]
+                                    .cwiseMax(costmap_[LayerName::primitives])
+                                    .cwiseMax(costmap_[LayerName::objects])
+                                    .cwiseMax(static_cast<float>(grid_min_value_));
 }
 
 void CostmapGenerator::publishCostmap(const grid_map::GridMap & costmap)
@@ -56,7 +56,8 @@ void FillPolygonAreas(
     out_grid_map, in_grid_layer_name, CV_8UC1, in_layer_min_value, in_layer_max_value,
     original_image);
 
-  cv::Mat merged_filled_image = original_image.clone();
+  // all the polygons are filled in a single image instead of merging an image per polygon
+  cv::Mat filled_image = original_image.clone();
 
   geometry_msgs::msg::TransformStamped transform;
   transform = in_tf_buffer.lookupTransform(
@@ -86,14 +87,11 @@ void FillPolygonAreas(
       cv_polygon.emplace_back(cv_x, cv_y);
     }
 
-    cv::Mat filled_image = original_image.clone();
-
     std::vector<std::vector<cv::Point>> cv_polygons;
     cv_polygons.push_back(cv_polygon);
     cv::fillPoly(filled_image, cv_polygons, cv::Scalar(in_fill_color));
-
-    merged_filled_image &= filled_image;
   }
+  const cv::Mat merged_filled_image = original_image & filled_image;
 
   // convert to ROS msg
   grid_map::GridMapCvConverter::addLayerFromImage<unsigned char, 1>(
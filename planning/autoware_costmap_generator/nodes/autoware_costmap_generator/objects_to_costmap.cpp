@@ -46,17 +46,16 @@
 
 #include <tf2/utils.h>
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace autoware::costmap_generator
 {
 // Constructor
-ObjectsToCostmap::ObjectsToCostmap()
-: NUMBER_OF_POINTS(4),
-  NUMBER_OF_DIMENSIONS(2),
-  OBJECTS_COSTMAP_LAYER_("objects_costmap"),
-  BLURRED_OBJECTS_COSTMAP_LAYER_("blurred_objects_costmap")
+ObjectsToCostmap::ObjectsToCostmap() : NUMBER_OF_POINTS(4), NUMBER_OF_DIMENSIONS(2)
 {
 }
 
@@ -145,25 +144,103 @@ grid_map::Polygon ObjectsToCostmap::makePolygonFromObjectConvexHull(
 }
 
 void ObjectsToCostmap::setCostInPolygon(
-  const grid_map::Polygon & polygon, const std::string & gridmap_layer_name, const float score,
-  grid_map::GridMap & objects_costmap)
+  const grid_map::Polygon & polygon, const float score, const grid_map::GridMap & gridmap,
+  grid_map::Matrix & objects_costmap)
 {
-  for (grid_map::PolygonIterator itr(objects_costmap, polygon); !itr.isPastEnd(); ++itr) {
-    const float current_score = objects_costmap.at(gridmap_layer_name, *itr);
-    if (score > current_score) {
-      objects_costmap.at(gridmap_layer_name, *itr) = score;
+  const auto & vertices = polygon.getVertices();
+  if (vertices.size() < 3) {
+    return;
+  }
+
+  // position of the edge of the cell (0, 0)
+  const double resolution = gridmap.getResolution();
+  const double top_x = gridmap.getPosition().x() + gridmap.getLength().x() / 2.0;
+  const double top_y = gridmap.getPosition().y() + gridmap.getLength().y() / 2.0;
+  // range of the indices of the cells whose center is in [min, max]
+  const auto to_index_range =
+    [&](const double top, const double min, const double max, const int size) {
+      const double begin = std::ceil((top - max) / resolution - 0.5);
+      const double end = std::floor((top - min) / resolution - 0.5);
+      return std::make_pair(
+        static_cast<int>(std::max(begin, 0.0)),
+        static_cast<int>(std::min(end, static_cast<double>(size - 1))));
+    };
+
+  double min_x = vertices.front().x();
+  double max_x = vertices.front().x();
+  for (const auto & vertex : vertices) {
+    min_x = std::min(min_x, vertex.x());
+    max_x = std::max(max_x, vertex.x());
+  }
+
+  const auto [row_begin, row_end] =
+    to_index_range(top_x, min_x, max_x, static_cast<int>(objects_costmap.rows()));
+  for (int row = row_begin; row <= row_end; ++row) {
+    // fill the cells between the pairs of the crossings of the edges with the row
+    const double x = top_x - (row + 0.5) * resolution;
+    crossing_ys_.clear();
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      const auto & a = vertices[i];
+      const auto & b = vertices[(i + 1) % vertices.size()];
+      if ((a.x() <= x) != (b.x() <= x)) {
+        crossing_ys_.push_back(a.y() + (x - a.x()) * (b.y() - a.y()) / (b.x() - a.x()));
+      }
+    }
+    std::sort(crossing_ys_.begin(), crossing_ys_.end());
+    for (size_t i = 0; i + 1 < crossing_ys_.size(); i += 2) {
+      const auto [col_begin, col_end] = to_index_range(
+        top_y, crossing_ys_[i], crossing_ys_[i + 1], static_cast<int>(objects_costmap.cols()));
+      for (int col = col_begin; col <= col_end; ++col) {
+        objects_costmap(row, col) = std::max(objects_costmap(row, col), score);
+      }
     }
   }
 }
 
-grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
+void ObjectsToCostmap::applyMeanFilter(
+  const int size_of_expansion_kernel, grid_map::Matrix & costmap)
+{
+  if (size_of_expansion_kernel % 2 == 0) {
+    throw std::runtime_error("size_of_expansion_kernel must be odd.");
+  }
+
+  // The cells are updated in place in the column-major order, so the window of a cell contains
+  // the blurred values of the previous cells as with grid_map::SlidingWindowIterator.
+  const int margin = (size_of_expansion_kernel - 1) / 2;
+  const int rows = static_cast<int>(costmap.rows());
+  const int cols = static_cast<int>(costmap.cols());
+  column_sums_.resize(cols);
+  for (int col = 0; col < cols; ++col) {
+    const int col_begin = std::max(col - margin, 0);
+    const int col_end = std::min(col + margin, cols - 1);
+    for (int c = col_begin; c <= col_end; ++c) {
+      column_sums_[c] = costmap.col(c).head(std::min(margin + 1, rows)).cast<double>().sum();
+    }
+    for (int row = 0; row < rows; ++row) {
+      if (row > 0 && row + margin < rows) {
+        for (int c = col_begin; c <= col_end; ++c) column_sums_[c] += costmap(row + margin, c);
+      }
+      if (row - margin - 1 >= 0) {
+        for (int c = col_begin; c <= col_end; ++c) column_sums_[c] -= costmap(row - margin - 1, c);
+      }
+      double sum = 0.0;
+      for (int c = col_begin; c <= col_end; ++c) sum += column_sums_[c];
+      const int row_num = std::min(row + margin, rows - 1) - std::max(row - margin, 0) + 1;
+      const auto mean = static_cast<float>(sum / (row_num * (col_end - col_begin + 1)));
+      column_sums_[col] += mean - costmap(row, col);
+      costmap(row, col) = mean;
+    }
+  }
+}
+
+const grid_map::Matrix & ObjectsToCostmap::makeCostmapFromObjects(
   const grid_map::GridMap & costmap, const double expand_polygon_size,
   const double size_of_expansion_kernel,
   const autoware_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects)
 {
-  grid_map::GridMap objects_costmap = costmap;
-  objects_costmap.add(OBJECTS_COSTMAP_LAYER_, 0);
-  objects_costmap.add(BLURRED_OBJECTS_COSTMAP_LAYER_, 0);
+  // no reallocation happens as long as the size of the gridmap is unchanged
+  const auto & size = costmap.getSize();
+  objects_costmap_.setZero(size.x(), size.y());
 
   for (const auto & object : in_objects->objects) {
     grid_map::Polygon polygon;
@@ -179,23 +256,15 @@ grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
       object.classification.begin(), object.classification.end(),
       [](const auto & c1, const auto & c2) { return c1.probability < c2.probability; });
     const double highest_probability = static_cast<double>(highest_probability_label.probability);
-    setCostInPolygon(polygon, OBJECTS_COSTMAP_LAYER_, highest_probability, objects_costmap);
-    setCostInPolygon(polygon, BLURRED_OBJECTS_COSTMAP_LAYER_, highest_probability, objects_costmap);
+    setCostInPolygon(polygon, highest_probability, costmap, objects_costmap_);
   }
 
   // Applying mean filter to expanded gridmap
-  const grid_map::SlidingWindowIterator::EdgeHandling edge_handling =
-    grid_map::SlidingWindowIterator::EdgeHandling::CROP;
-  for (grid_map::SlidingWindowIterator iterator(
-         objects_costmap, BLURRED_OBJECTS_COSTMAP_LAYER_, edge_handling, size_of_expansion_kernel);
-       !iterator.isPastEnd(); ++iterator) {
-    objects_costmap.at(BLURRED_OBJECTS_COSTMAP_LAYER_, *iterator) =
-      iterator.getData().meanOfFinites();  // Blurring.
-  }
+  blurred_objects_costmap_ = objects_costmap_;
+  applyMeanFilter(static_cast<int>(size_of_expansion_kernel), blurred_objects_costmap_);
 
-  objects_costmap[OBJECTS_COSTMAP_LAYER_] = objects_costmap[OBJECTS_COSTMAP_LAYER_].cwiseMax(
-    objects_costmap[BLURRED_OBJECTS_COSTMAP_LAYER_]);
+  objects_costmap_ = objects_costmap_.cwiseMax(blurred_objects_costmap_);
 
-  return objects_costmap[OBJECTS_COSTMAP_LAYER_];
+  return objects_costmap_;
 }
 }  // namespace autoware::costmap_generator
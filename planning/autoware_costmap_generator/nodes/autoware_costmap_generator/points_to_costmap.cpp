@@ -44,19 +44,28 @@
 
 #include "autoware_costmap_generator/points_to_costmap.hpp"
 
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
 #include <string>
 #include <vector>
 
 namespace autoware::costmap_generator
 {
 
-void PointsToCostmap::initGridmapParam(const grid_map::GridMap & gridmap)
+void PointsToCostmap::initGridmapParam(
+  const grid_map::GridMap & gridmap, const std::string & gridmap_layer_name,
+  const double grid_min_value)
 {
   grid_length_x_ = gridmap.getLength().x();
   grid_length_y_ = gridmap.getLength().y();
   grid_resolution_ = gridmap.getResolution();
   grid_position_x_ = gridmap.getPosition().x();
   grid_position_y_ = gridmap.getPosition().y();
+
+  // no reallocation happens as long as the size of the gridmap is unchanged
+  const auto & layer = gridmap[gridmap_layer_name];
+  costmap_.resize(layer.rows(), layer.cols());
+  costmap_.setConstant(grid_min_value);
 }
 
 bool PointsToCostmap::isValidInd(const grid_map::Index & grid_ind)
@@ -72,15 +81,15 @@ bool PointsToCostmap::isValidInd(const grid_map::Index & grid_ind)
   return is_valid;
 }
 
-grid_map::Index PointsToCostmap::fetchGridIndexFromPoint(const pcl::PointXYZ & point)
+grid_map::Index PointsToCostmap::fetchGridIndexFromPoint(const double x, const double y)
 {
   // calculate out_grid_map position
   const double origin_x_offset = grid_length_x_ / 2.0 - grid_position_x_;
   const double origin_y_offset = grid_length_y_ / 2.0 - grid_position_y_;
   // coordinate conversion for making index. Set bottom left to the origin of coordinate (0, 0) in
   // gridmap area
-  double mapped_x = (grid_length_x_ - origin_x_offset - point.x) / grid_resolution_;
-  double mapped_y = (grid_length_y_ - origin_y_offset - point.y) / grid_resolution_;
+  double mapped_x = (grid_length_x_ - origin_x_offset - x) / grid_resolution_;
+  double mapped_y = (grid_length_y_ - origin_y_offset - y) / grid_resolution_;
 
   int mapped_x_ind = std::ceil(mapped_x);
   int mapped_y_ind = std::ceil(mapped_y);
@@ -88,60 +97,49 @@ grid_map::Index PointsToCostmap::fetchGridIndexFromPoint(const pcl::PointXYZ & p
   return index;
 }
 
-std::vector<std::vector<std::vector<double>>> PointsToCostmap::assignPoints2GridCell(
-  const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points)
+void PointsToCostmap::setCostFromPoint(
+  const Eigen::Vector3f & point, const double maximum_height_thres,
+  const double minimum_height_thres, const double grid_max_value)
 {
-  double y_cell_size = std::ceil(grid_length_y_ * (1 / grid_resolution_));
-  double x_cell_size = std::ceil(grid_length_x_ * (1 / grid_resolution_));
-  std::vector<double> z_vec;
-  std::vector<std::vector<double>> vec_y_z(y_cell_size, z_vec);
-  std::vector<std::vector<std::vector<double>>> vec_x_y_z(x_cell_size, vec_y_z);
-
-  for (const auto & point : in_sensor_points) {
-    grid_map::Index grid_ind = fetchGridIndexFromPoint(point);
-    if (isValidInd(grid_ind)) {
-      vec_x_y_z[grid_ind.x()][grid_ind.y()].push_back(point.z);
-    }
+  if (point.z() > maximum_height_thres || point.z() < minimum_height_thres) {
+    return;
+  }
+  const grid_map::Index grid_ind = fetchGridIndexFromPoint(point.x(), point.y());
+  if (isValidInd(grid_ind)) {
+    costmap_(grid_ind.x(), grid_ind.y()) = grid_max_value;
   }
-  return vec_x_y_z;
 }
 
-grid_map::Matrix PointsToCostmap::calculateCostmap(
+const grid_map::Matrix & PointsToCostmap::makeCostmapFromPoints(
   const double maximum_height_thres, const double minimum_lidar_height_thres,
   const double grid_min_value, const double grid_max_value, const grid_map::GridMap & gridmap,
-  const std::string & gridmap_layer_name,
-  const std::vector<std::vector<std::vector<double>>> grid_vec)
+  const std::string & gridmap_layer_name, const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points)
 {
-  grid_map::Matrix gridmap_data = gridmap[gridmap_layer_name];
-  for (size_t x_ind = 0; x_ind < grid_vec.size(); x_ind++) {
-    for (size_t y_ind = 0; y_ind < grid_vec[0].size(); y_ind++) {
-      if (grid_vec[x_ind][y_ind].size() == 0) {
-        gridmap_data(x_ind, y_ind) = grid_min_value;
-        continue;
-      }
-      for (const auto & z : grid_vec[x_ind][y_ind]) {
-        if (z > maximum_height_thres || z < minimum_lidar_height_thres) {
-          continue;
-        }
-        gridmap_data(x_ind, y_ind) = grid_max_value;
-        break;
-      }
-    }
+  initGridmapParam(gridmap, gridmap_layer_name, grid_min_value);
+  for (const auto & point : in_sensor_points) {
+    setCostFromPoint(
+      point.getVector3fMap(), maximum_height_thres, minimum_lidar_height_thres, grid_max_value);
   }
-  return gridmap_data;
+  return costmap_;
 }
 
-grid_map::Matrix PointsToCostmap::makeCostmapFromPoints(
+const grid_map::Matrix & PointsToCostmap::makeCostmapFromPoints(
   const double maximum_height_thres, const double minimum_lidar_height_thres,
   const double grid_min_value, const double grid_max_value, const grid_map::GridMap & gridmap,
-  const std::string & gridmap_layer_name, const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points)
+  const std::string & gridmap_layer_name, const sensor_msgs::msg::PointCloud2 & in_sensor_points,
+  const Eigen::Affine3f & transform)
 {
-  initGridmapParam(gridmap);
-  std::vector<std::vector<std::vector<double>>> grid_vec = assignPoints2GridCell(in_sensor_points);
-  grid_map::Matrix costmap = calculateCostmap(
-    maximum_height_thres, minimum_lidar_height_thres, grid_min_value, grid_max_value, gridmap,
-    gridmap_layer_name, grid_vec);
-  return costmap;
+  initGridmapParam(gridmap, gridmap_layer_name, grid_min_value);
+  // the points are transformed one by one instead of copying the whole pointcloud
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(in_sensor_points, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(in_sensor_points, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(in_sensor_points, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    setCostFromPoint(
+      transform * Eigen::Vector3f(*iter_x, *iter_y, *iter_z), maximum_height_thres,
+      minimum_lidar_height_thres, grid_max_value);
+  }
+  return costmap_;
 }
 
 }  // namespace autoware::costmap_generator
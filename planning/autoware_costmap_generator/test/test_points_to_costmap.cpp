@@ -219,4 +219,40 @@ TEST_F(PointsToCostmapTest, TestMakeCostmapFromPoints_invalidPoints_outOfGrid)
 
   EXPECT_EQ(nonempty_grid_cell_num, 0);
 }
+
+TEST_F(PointsToCostmapTest, TestMakeCostmapFromPoints_pointCloud2)
+{
+  // construct the same pointcloud as validPoints in sensor frame, which is 1m below the map frame
+  pointcloud in_sensor_points;
+  in_sensor_points.push_back(pcl::PointXYZ(0.7, 1, 0));
+  in_sensor_points.push_back(pcl::PointXYZ(1.1, 1, 3));
+  in_sensor_points.push_back(pcl::PointXYZ(1.4, 2, 1.7));
+  in_sensor_points.push_back(pcl::PointXYZ(1.4, 2, 4.5));  // out of the height thresholds
+  sensor_msgs::msg::PointCloud2 in_sensor_points_msg;
+  pcl::toROSMsg(in_sensor_points, in_sensor_points_msg);
+  const Eigen::Affine3f transform(Eigen::Translation3f(0.0, 0.0, 1.0));
+
+  grid_map::GridMap gridmap = construct_gridmap();
+
+  PointsToCostmap point2costmap;
+  const double maximum_height_thres = 5.0;
+  const double minimum_lidar_height_thres = 0.0;
+  const double grid_min_value = 0.0;
+  const double grid_max_value = 1.0;
+  const std::string gridmap_layer_name = "points";
+  grid_map::Matrix costmap_data = point2costmap.makeCostmapFromPoints(
+    maximum_height_thres, minimum_lidar_height_thres, grid_min_value, grid_max_value, gridmap,
+    gridmap_layer_name, in_sensor_points_msg, transform);
+
+  int nonempty_grid_cell_num = 0;
+  for (int i = 0; i < costmap_data.rows(); i++) {
+    for (int j = 0; j < costmap_data.cols(); j++) {
+      if (costmap_data(i, j) == grid_max_value) {
+        nonempty_grid_cell_num += 1;
+      }
+    }
+  }
+
+  EXPECT_EQ(nonempty_grid_cell_num, 3);
+}
 }  // namespace autoware::costmap_generator
@@ -25,6 +25,7 @@
 #include <tf2/utils.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <vector>
 
@@ -154,6 +155,17 @@ struct EDTData
   double angle;
 };
 
+// vehicle footprint cells packed in bits, for a discretized angle
+struct FootprintMask
+{
+  int min_x;          // x offset of the first column from the base index [cell]
+  int min_y;          // y offset of the first row from the base index [cell]
+  int height;         // number of rows
+  int words_per_row;  // number of 64 bit words in a row
+  // bit j of the row i is set if the cell (min_x + j, min_y + i) is covered by the footprint
+  std::vector<uint64_t> rows;
+};
+
 class AbstractPlanningAlgorithm
 {
 public:
@@ -191,7 +203,9 @@ protected:
   void computeCollisionIndexes(
     int theta_index, std::vector<IndexXY> & indexes,
     std::vector<IndexXY> & vertex_indexes_2d) const;
+  void computeCollisionTables();
   bool detectBoundaryExit(const IndexXYT & base_index) const;
+  bool hasObstacleInFootprint(const IndexXYT & base_index) const;
   bool detectCollision(const IndexXYT & base_index) const;
   bool detectCollision(const geometry_msgs::msg::Pose & base_pose) const;
 
@@ -279,9 +293,24 @@ protected:
   // vehicle vertex indexes cache
   std::vector<std::vector<IndexXY>> vertex_indexes_table_;
 
+  // collision indexes packed in bits
+  std::vector<FootprintMask> footprint_mask_table_;
+
+  // offset of the cell at the footprint center from the base index
+  std::vector<IndexXY> footprint_center_table_;
+
+  // an obstacle closer to the footprint center than the inner radius always collides, and an
+  // obstacle farther than the outer radius never does, taking the grid discretization into account
+  double footprint_inner_radius_;
+  double footprint_outer_radius_;
+
   // is_obstacle's table
   std::vector<bool> is_obstacle_table_;
 
+  // is_obstacle's table packed in bits, with a padding word at the end of each row
+  std::vector<uint64_t> obstacle_bitmap_;
+  int obstacle_bitmap_words_per_row_;
+
   // Euclidean distance transform map (distance & angle info to nearest obstacle cell)
   std::vector<EDTData> edt_map_;
 
@@ -290,7 +319,10 @@ protected:
   geometry_msgs::msg::Pose goal_pose_;
 
   // Is collision table initalized
-  bool is_collision_table_initialized;
+  bool is_collision_table_initialized{false};
+
+  // grid resolution which the collision tables are computed for
+  double collision_table_resolution_;
 
   // result path
   PlannerWaypoints waypoints_;
@@ -26,6 +26,7 @@
 #include <boost/optional/optional.hpp>
 
 #include <cmath>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <queue>
@@ -86,9 +87,16 @@ struct AstarNode
   }
 };
 
+// entry of the open list. The total cost is copied so that the heap does not touch the nodes
+struct OpenNode
+{
+  double fc;
+  AstarNode * node;
+};
+
 struct NodeComparison
 {
-  bool operator()(const AstarNode * lhs, const AstarNode * rhs) const { return lhs->fc > rhs->fc; }
+  bool operator()(const OpenNode & lhs, const OpenNode & rhs) const { return lhs.fc > rhs.fc; }
 };
 
 class AstarSearch : public AbstractPlanningAlgorithm
@@ -124,13 +132,19 @@ public:
 
   const PlannerWaypoints & getWaypoints() const { return waypoints_; }
 
+  // number of nodes expanded in the last search
+  size_t getExpandedNodeCount() const { return expanded_node_count_; }
+
   inline int getKey(const IndexXYT & index)
   {
     return indexToId(index) * planner_common_param_.theta_size + index.theta;
   }
 
 private:
+  void setTraversableTable();
   void setCollisionFreeDistanceMap();
+  AstarNode * findNode(const int key);
+  AstarNode * addNode(const int key);
   bool search();
   void expandNodes(AstarNode & current_node, const bool is_back = false);
   void resetData();
@@ -152,10 +166,20 @@ private:
   AstarParam astar_param_;
 
   // hybrid astar variables
-  std::vector<AstarNode> graph_;
+  // pool of the nodes visited in the current search. std::deque keeps the node addresses stable
+  std::deque<AstarNode> graph_;
+  // index of the node in graph_ for each key, -1 if the node has not been visited
+  std::vector<int> node_ids_;
+
+  // cells whose center the vehicle can pass through, updated in setMap
+  std::vector<bool> is_traversable_table_;
+  // obstacle-aware 2D distance to the goal cell, recomputed only when the map or goal cell changes
   std::vector<double> col_free_distance_map_;
+  int col_free_distance_map_goal_id_;
+
+  std::priority_queue<OpenNode, std::vector<OpenNode>, NodeComparison> openlist_;
 
-  std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison> openlist_;
+  size_t expanded_node_count_;
 
   // goal node, which may helpful in testing and debugging
   AstarNode * goal_node_;
@@ -191,6 +215,9 @@ private:
 
   // cost free obstacle distance
   static constexpr double cost_free_obs_dist = 1.0;
+
+  // number of node expansions between the time limit checks
+  static constexpr size_t time_check_interval = 64;
 };
 }  // namespace autoware::freespace_planning_algorithms
 
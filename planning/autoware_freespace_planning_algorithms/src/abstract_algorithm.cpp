@@ -19,7 +19,10 @@
 #include <autoware/universe_utils/geometry/geometry.hpp>
 #include <autoware/universe_utils/math/normalization.hpp>
 
+#include <algorithm>
+#include <future>
 #include <limits>
+#include <thread>
 #include <vector>
 
 namespace autoware::freespace_planning_algorithms
@@ -109,27 +112,31 @@ void AbstractPlanningAlgorithm::setMap(const nav_msgs::msg::OccupancyGrid & cost
   costmap_ = costmap;
 
   const uint32_t nb_of_cells = costmap_.data.size();
+  const uint32_t width = costmap_.info.width;
   // Initialize status
   std::vector<bool> is_obstacle_table;
   is_obstacle_table.resize(nb_of_cells);
+  obstacle_bitmap_words_per_row_ = width / 64 + 2;
+  obstacle_bitmap_.assign(obstacle_bitmap_words_per_row_ * costmap_.info.height, 0);
   for (uint32_t i = 0; i < nb_of_cells; ++i) {
     const int cost = costmap_.data[i];
     if (cost < 0 || planner_common_param_.obstacle_threshold <= cost) {
       is_obstacle_table[i] = true;
+      const uint32_t x = i % width;
+      obstacle_bitmap_[(i / width) * obstacle_bitmap_words_per_row_ + x / 64] |= 1ULL << (x % 64);
     }
   }
   is_obstacle_table_ = is_obstacle_table;
 
   computeEDTMap();
 
-  // construct collision indexes table
-  if (is_collision_table_initialized == false) {
-    for (int i = 0; i < planner_common_param_.theta_size; i++) {
-      std::vector<IndexXY> indexes_2d, vertex_indexes_2d;
-      computeCollisionIndexes(i, indexes_2d, vertex_indexes_2d);
-      coll_indexes_table_.push_back(indexes_2d);
-      vertex_indexes_table_.push_back(vertex_indexes_2d);
-    }
+  // construct collision indexes table. The table only depends on the vehicle shape and the grid
+  // resolution, so it is reused while the resolution is unchanged
+  if (
+    is_collision_table_initialized == false ||
+    collision_table_resolution_ != costmap_.info.resolution) {
+    computeCollisionTables();
+    collision_table_resolution_ = costmap_.info.resolution;
     is_collision_table_initialized = true;
   }
 
@@ -291,6 +298,71 @@ void AbstractPlanningAlgorithm::computeCollisionIndexes(
   addIndex2d(back, left, vertex_indexes_2d);
 }
 
+void AbstractPlanningAlgorithm::computeCollisionTables()
+{
+  const int theta_size = planner_common_param_.theta_size;
+  const double resolution = costmap_.info.resolution;
+  coll_indexes_table_.assign(theta_size, {});
+  vertex_indexes_table_.assign(theta_size, {});
+  footprint_mask_table_.assign(theta_size, {});
+  footprint_center_table_.assign(theta_size, {});
+
+  const double center_offset =
+    0.5 * collision_vehicle_shape_.length - collision_vehicle_shape_.base2back;
+  const auto computeTables = [&](const int theta_begin, const int theta_end) {
+    for (int i = theta_begin; i < theta_end; ++i) {
+      auto & indexes_2d = coll_indexes_table_[i];
+      computeCollisionIndexes(i, indexes_2d, vertex_indexes_table_[i]);
+
+      // pack the collision indexes in bits
+      auto & mask = footprint_mask_table_[i];
+      int max_x = std::numeric_limits<int>::lowest();
+      int max_y = std::numeric_limits<int>::lowest();
+      mask.min_x = std::numeric_limits<int>::max();
+      mask.min_y = std::numeric_limits<int>::max();
+      for (const auto & index : indexes_2d) {
+        mask.min_x = std::min(mask.min_x, index.x);
+        mask.min_y = std::min(mask.min_y, index.y);
+        max_x = std::max(max_x, index.x);
+        max_y = std::max(max_y, index.y);
+      }
+      mask.height = max_y - mask.min_y + 1;
+      mask.words_per_row = (max_x - mask.min_x) / 64 + 1;
+      mask.rows.assign(mask.height * mask.words_per_row, 0);
+      for (const auto & index : indexes_2d) {
+        const int x = index.x - mask.min_x;
+        const int y = index.y - mask.min_y;
+        mask.rows[y * mask.words_per_row + x / 64] |= 1ULL << (x % 64);
+      }
+
+      const double theta = i * 2.0 * M_PI / theta_size;
+      footprint_center_table_[i] = IndexXY{
+        static_cast<int>(std::round(center_offset * std::cos(theta) / resolution)),
+        static_cast<int>(std::round(center_offset * std::sin(theta) / resolution))};
+    }
+  };
+
+  // the tables of each angle are independent, so they are computed in parallel
+  const int thread_num =
+    std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, theta_size);
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < thread_num; ++i) {
+    futures.push_back(std::async(
+      std::launch::async, computeTables, theta_size * i / thread_num,
+      theta_size * (i + 1) / thread_num));
+  }
+  for (auto & future : futures) {
+    future.get();
+  }
+
+  // the footprint center and the footprint cells are off by at most half a cell diagonal from the
+  // exact positions because of the discretization
+  const double half_width = 0.5 * collision_vehicle_shape_.width;
+  const double half_diagonal = std::hypot(0.5 * collision_vehicle_shape_.length, half_width);
+  footprint_inner_radius_ = half_width - 0.5 * std::sqrt(2.0) * resolution;
+  footprint_outer_radius_ = half_diagonal + std::sqrt(2.0) * resolution;
+}
+
 bool AbstractPlanningAlgorithm::detectBoundaryExit(const IndexXYT & base_index) const
 {
   if (isWithinMargin(base_index)) return false;
@@ -329,18 +401,34 @@ bool AbstractPlanningAlgorithm::detectCollision(const IndexXYT & base_index) con
   if (obstacle_edt > collision_vehicle_shape_.max_dimension) return false;
   if (obstacle_edt < collision_vehicle_shape_.min_dimension) return true;
 
-  const auto & coll_indexes_2d = coll_indexes_table_[base_index.theta];
-  for (const auto & coll_index_2d : coll_indexes_2d) {
-    IndexXY coll_index{coll_index_2d.x, coll_index_2d.y};
-    // must slide to current base position
-    coll_index.x += base_index.x;
-    coll_index.y += base_index.y;
+  // same check with the circles around the footprint center, which are tighter
+  const auto & center_offset = footprint_center_table_[base_index.theta];
+  const IndexXY center_index{base_index.x + center_offset.x, base_index.y + center_offset.y};
+  const double center_obstacle_edt = getObstacleEDT(center_index).distance;
+  if (center_obstacle_edt > footprint_outer_radius_) return false;
+  if (center_obstacle_edt < footprint_inner_radius_) return true;
 
-    if (isObs(coll_index)) {
-      return true;
+  return hasObstacleInFootprint(base_index);
+}
+
+bool AbstractPlanningAlgorithm::hasObstacleInFootprint(const IndexXYT & base_index) const
+{
+  // NOTE: the footprint is within the map since detectBoundaryExit is already done
+  const auto & mask = footprint_mask_table_[base_index.theta];
+  const int begin_x = base_index.x + mask.min_x;
+  for (int row = 0; row < mask.height; ++row) {
+    const int y = base_index.y + mask.min_y + row;
+    const uint64_t * obstacle_row = &obstacle_bitmap_[y * obstacle_bitmap_words_per_row_];
+    const uint64_t * mask_row = &mask.rows[row * mask.words_per_row];
+    for (int word = 0; word < mask.words_per_row; ++word) {
+      // extract the 64 obstacle bits from begin_x + 64 * word
+      const int x = begin_x + 64 * word;
+      const int shift = x % 64;
+      uint64_t obstacle_bits = obstacle_row[x / 64] >> shift;
+      if (shift != 0) obstacle_bits |= obstacle_row[x / 64 + 1] << (64 - shift);
+      if (obstacle_bits & mask_row[word]) return true;
     }
   }
-
   return false;
 }
 
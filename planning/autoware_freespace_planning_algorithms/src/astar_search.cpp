@@ -32,6 +32,8 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <utility>
 #include <vector>
 
 namespace autoware::freespace_planning_algorithms
@@ -74,6 +76,8 @@ AstarSearch::AstarSearch(
   const AstarParam & astar_param)
 : AbstractPlanningAlgorithm(planner_common_param, collision_vehicle_shape),
   astar_param_(astar_param),
+  col_free_distance_map_goal_id_(-1),
+  expanded_node_count_(0),
   goal_node_(nullptr),
   use_reeds_shepp_(true)
 {
@@ -103,20 +107,39 @@ void AstarSearch::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
   min_expansion_dist_ = std::max(astar_param_.expansion_distance, 1.5 * costmap_.info.resolution);
   max_expansion_dist_ = std::max(
     collision_vehicle_shape_.base_length * base_length_max_expansion_factor_, min_expansion_dist_);
+
+  setTraversableTable();
+  // the distance map depends on the obstacles, so it has to be recomputed for the new map
+  col_free_distance_map_goal_id_ = -1;
 }
 
 void AstarSearch::resetData()
 {
   // clearing openlist is necessary because otherwise remaining elements of openlist
   // point to deleted node.
-  openlist_ = std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison>();
+  openlist_ = std::priority_queue<OpenNode, std::vector<OpenNode>, NodeComparison>();
   const int nb_of_grid_nodes = costmap_.info.width * costmap_.info.height;
   const int total_astar_node_count = nb_of_grid_nodes * planner_common_param_.theta_size;
-  graph_.assign(total_astar_node_count, AstarNode{});
-  col_free_distance_map_.assign(nb_of_grid_nodes, std::numeric_limits<double>::max());
+  // only the visited nodes are allocated in graph_, so the per-search initialization is limited to
+  // the node index table
+  graph_.clear();
+  node_ids_.assign(total_astar_node_count, -1);
+  expanded_node_count_ = 0;
   shifted_goal_pose_ = {};
 }
 
+AstarNode * AstarSearch::findNode(const int key)
+{
+  const int id = node_ids_[key];
+  return id < 0 ? nullptr : &graph_[id];
+}
+
+AstarNode * AstarSearch::addNode(const int key)
+{
+  node_ids_[key] = static_cast<int>(graph_.size());
+  return &graph_.emplace_back();
+}
+
 bool AstarSearch::makePlan(const Pose & start_pose, const Pose & goal_pose)
 {
   resetData();
@@ -193,52 +216,75 @@ bool AstarSearch::makePlan(
   return true;
 }
 
+void AstarSearch::setTraversableTable()
+{
+  const int nb_of_grid_nodes = costmap_.info.width * costmap_.info.height;
+  const double min_obstacle_distance = 0.5 * collision_vehicle_shape_.width;
+  is_traversable_table_.assign(nb_of_grid_nodes, false);
+  for (int id = 0; id < nb_of_grid_nodes; ++id) {
+    is_traversable_table_[id] =
+      !is_obstacle_table_[id] && edt_map_[id].distance >= min_obstacle_distance;
+  }
+}
+
 void AstarSearch::setCollisionFreeDistanceMap()
 {
-  using Entry = std::pair<IndexXY, double>;
+  const auto goal_index = pose2index(costmap_, goal_pose_, planner_common_param_.theta_size);
+  const int goal_id = indexToId(goal_index);
+  // the distance map only depends on the map and the goal cell, so it is reused when the same goal
+  // is planned again on the same map
+  if (goal_id == col_free_distance_map_goal_id_) return;
+
+  using Entry = std::pair<double, int>;
   struct CompareEntry
   {
-    bool operator()(const Entry & a, const Entry & b) const { return a.second > b.second; }
+    bool operator()(const Entry & a, const Entry & b) const { return a.first > b.first; }
   };
   std::priority_queue<Entry, std::vector<Entry>, CompareEntry> heap;
+  const int width = costmap_.info.width;
+  const int height = costmap_.info.height;
+  col_free_distance_map_.assign(width * height, std::numeric_limits<double>::max());
   std::vector<bool> closed(col_free_distance_map_.size(), false);
-  auto goal_index = pose2index(costmap_, goal_pose_, planner_common_param_.theta_size);
-  col_free_distance_map_[indexToId(goal_index)] = 0.0;
-  heap.push({IndexXY{goal_index.x, goal_index.y}, 0.0});
+  col_free_distance_map_[goal_id] = 0.0;
+  heap.push({0.0, goal_id});
 
-  Entry current;
-  std::array<int, 3> offsets = {1, 0, -1};
+  const double resolution = costmap_.info.resolution;
+  const double diagonal_resolution = std::sqrt(2.0) * resolution;
+  const std::array<int, 3> offsets = {1, 0, -1};
   while (!heap.empty()) {
-    current = heap.top();
+    const auto [current_dist, id] = heap.top();
     heap.pop();
-    const int id = indexToId(current.first);
     if (closed[id]) continue;
     closed[id] = true;
 
-    const auto & index = current.first;
+    const int index_x = id % width;
+    const int index_y = id / width;
     for (const auto & offset_x : offsets) {
-      const int x = index.x + offset_x;
+      const int x = index_x + offset_x;
+      if (x < 0 || width <= x) continue;
       for (const auto & offset_y : offsets) {
-        const int y = index.y + offset_y;
-        const IndexXY n_index{x, y};
-        const double offset = std::abs(offset_x) + std::abs(offset_y);
-        if (isOutOfRange(n_index) || isObs(n_index) || offset < 1) continue;
-        if (getObstacleEDT(n_index).distance < 0.5 * collision_vehicle_shape_.width) continue;
-        const int n_id = indexToId(n_index);
-        const double dist = current.second + (sqrt(offset) * costmap_.info.resolution);
-        if (closed[n_id] || col_free_distance_map_[n_id] < dist) continue;
+        const int y = index_y + offset_y;
+        if (y < 0 || height <= y || (offset_x == 0 && offset_y == 0)) continue;
+        const int n_id = y * width + x;
+        if (closed[n_id] || !is_traversable_table_[n_id]) continue;
+        const bool is_diagonal = offset_x != 0 && offset_y != 0;
+        const double dist = current_dist + (is_diagonal ? diagonal_resolution : resolution);
+        if (col_free_distance_map_[n_id] < dist) continue;
         col_free_distance_map_[n_id] = dist;
-        heap.push({n_index, dist});
+        heap.push({dist, n_id});
       }
     }
   }
+  col_free_distance_map_goal_id_ = goal_id;
 }
 
 void AstarSearch::setStartNode(const double cost_offset)
 {
   const auto index = pose2index(costmap_, start_pose_, planner_common_param_.theta_size);
   // Set start node
-  AstarNode * start_node = &graph_[getKey(index)];
+  const int key = getKey(index);
+  AstarNode * start_node = findNode(key);
+  if (start_node == nullptr) start_node = addNode(key);
   const double initial_cost = estimateCost(start_pose_, index) + cost_offset;
   start_node->set(start_pose_, 0.0, initial_cost, 0, false);
   start_node->dir_distance = 0.0;
@@ -248,7 +294,7 @@ void AstarSearch::setStartNode(const double cost_offset)
   start_node->parent = nullptr;
 
   // Push start node to openlist
-  openlist_.push(start_node);
+  openlist_.push({start_node->fc, start_node});
 }
 
 double AstarSearch::estimateCost(const Pose & pose, const IndexXYT & index) const
@@ -264,22 +310,27 @@ double AstarSearch::estimateCost(const Pose & pose, const IndexXYT & index) cons
 
 bool AstarSearch::search()
 {
-  const rclcpp::Time begin = rclcpp::Clock(RCL_ROS_TIME).now();
+  rclcpp::Clock clock(RCL_ROS_TIME);
+  const rclcpp::Time begin = clock.now();
+  size_t pop_count = 0;
 
   // Start A* search
   while (!openlist_.empty()) {
-    // Check time and terminate if the search reaches the time limit
-    const rclcpp::Time now = rclcpp::Clock(RCL_ROS_TIME).now();
-    const double msec = (now - begin).seconds() * 1000.0;
-    if (msec > planner_common_param_.time_limit) {
-      return false;
+    // Check time and terminate if the search reaches the time limit. Reading the clock is not
+    // negligible compared to a node expansion, so it is read once in time_check_interval pops
+    if (pop_count++ % time_check_interval == 0) {
+      const double msec = (clock.now() - begin).seconds() * 1000.0;
+      if (msec > planner_common_param_.time_limit) {
+        return false;
+      }
     }
 
     // Expand minimum cost node
-    AstarNode * current_node = openlist_.top();
+    AstarNode * current_node = openlist_.top().node;
     openlist_.pop();
     if (current_node->status == NodeStatus::Closed) continue;
     current_node->status = NodeStatus::Closed;
+    ++expanded_node_count_;
 
     if (isGoal(*current_node)) {
       goal_node_ = current_node;
@@ -316,8 +367,10 @@ void AstarSearch::expandNodes(AstarNode & current_node, const bool is_back)
 
     if (isOutOfRange(next_index) || isObs(next_index)) continue;
 
-    AstarNode * next_node = &graph_[getKey(next_index)];
-    if (next_node->status == NodeStatus::Closed || detectCollision(next_index)) continue;
+    const int next_key = getKey(next_index);
+    AstarNode * next_node = findNode(next_key);
+    if (next_node != nullptr && next_node->status == NodeStatus::Closed) continue;
+    if (detectCollision(next_index)) continue;
 
     const auto obs_edt = getObstacleEDT(next_index);
     const bool is_direction_switch =
@@ -335,7 +388,8 @@ void AstarSearch::expandNodes(AstarNode & current_node, const bool is_back)
 
     double total_cost = move_cost + estimateCost(next_pose, next_index);
     // Compare cost
-    if (next_node->status == NodeStatus::None || next_node->fc > total_cost) {
+    if (next_node == nullptr || next_node->fc > total_cost) {
+      if (next_node == nullptr) next_node = addNode(next_key);
       next_node->status = NodeStatus::Open;
       next_node->set(next_pose, move_cost, total_cost, steering_index, is_back);
       next_node->dir_distance =
@@ -343,7 +397,7 @@ void AstarSearch::expandNodes(AstarNode & current_node, const bool is_back)
       next_node->dist_to_goal = calcDistance2d(next_pose, goal_pose_);
       next_node->dist_to_obs = obs_edt.distance;
       next_node->parent = &current_node;
-      openlist_.push(next_node);
+      openlist_.push({total_cost, next_node});
       continue;
     }
   }
@@ -29,7 +29,9 @@
 #include <algorithm>
 #include <array>
 #include <fstream>
+#include <random>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -201,14 +203,8 @@ fpa::PlannerCommonParam get_default_planner_params()
     obstacle_threshold};
 }
 
-std::unique_ptr<fpa::AbstractPlanningAlgorithm> configure_astar(bool use_multi)
+fpa::AstarParam get_default_astar_params()
 {
-  auto planner_common_param = get_default_planner_params();
-  if (use_multi) {
-    planner_common_param.turning_steps = 3;
-  }
-
-  // configure astar param
   const std::string search_method = "forward";
   const bool only_behind_solutions = false;
   const bool use_back = true;
@@ -219,7 +215,7 @@ std::unique_ptr<fpa::AbstractPlanningAlgorithm> configure_astar(bool use_multi)
   const double smoothness_weight = 0.5;
   const double obstacle_distance_weight = 1.7;
   const double goal_lat_distance_weight = 1.0;
-  const auto astar_param = fpa::AstarParam{
+  return fpa::AstarParam{
     search_method,
     only_behind_solutions,
     use_back,
@@ -230,6 +226,17 @@ std::unique_ptr<fpa::AbstractPlanningAlgorithm> configure_astar(bool use_multi)
     smoothness_weight,
     obstacle_distance_weight,
     goal_lat_distance_weight};
+}
+
+std::unique_ptr<fpa::AbstractPlanningAlgorithm> configure_astar(bool use_multi)
+{
+  auto planner_common_param = get_default_planner_params();
+  if (use_multi) {
+    planner_common_param.turning_steps = 3;
+  }
+
+  // configure astar param
+  const auto astar_param = get_default_astar_params();
 
   auto algo = std::make_unique<fpa::AstarSearch>(planner_common_param, vehicle_shape, astar_param);
   return algo;
@@ -381,6 +388,40 @@ TEST(AstarSearchTestSuite, MultiCurvature)
   EXPECT_TRUE(test_algorithm(AlgorithmType::ASTAR_MULTI));
 }
 
+// measure the planning time and the number of expanded nodes in the parking scenarios above
+void benchmark_astar(bool use_multi)
+{
+  auto algo = configure_astar(use_multi);
+  const auto * astar = dynamic_cast<fpa::AstarSearch *>(algo.get());
+  const auto costmap_msg = construct_cost_map(150, 150, 0.2, 10);
+
+  constexpr size_t N_trial = 10;
+  rclcpp::Clock clock{RCL_SYSTEM_TIME};
+  for (size_t i = 0; i < goal_poses.size(); ++i) {
+    double time_sum = 0.0;
+    size_t expanded_node_count = 0;
+    for (size_t j = 0; j < N_trial; ++j) {
+      algo->setMap(costmap_msg);
+      const rclcpp::Time begin = clock.now();
+      ASSERT_TRUE(algo->makePlan(create_pose_msg(start_pose), create_pose_msg(goal_poses.at(i))));
+      time_sum += (clock.now() - begin).seconds() * 1000.0;
+      expanded_node_count = astar->getExpandedNodeCount();
+    }
+    std::cout << "case" << i << " : " << time_sum / N_trial << "[msec]"
+              << ", expanded nodes : " << expanded_node_count << std::endl;
+  }
+}
+
+TEST(AstarSearchTestSuite, DISABLED_BenchmarkSingleCurvature)
+{
+  benchmark_astar(true);
+}
+
+TEST(AstarSearchTestSuite, DISABLED_BenchmarkMultiCurvature)
+{
+  benchmark_astar(false);
+}
+
 TEST(RRTStarTestSuite, Fastest)
 {
   EXPECT_TRUE(test_algorithm(AlgorithmType::RRTSTAR_FASTEST));
@@ -396,6 +437,108 @@ TEST(RRTStarTestSuite, InformedUpdate)
   EXPECT_TRUE(test_algorithm(AlgorithmType::RRTSTAR_INFORMED_UPDATE));
 }
 
+// exposes the collision check and keeps the check which walks all the footprint cells one by one
+class CollisionCheckTester : public fpa::AstarSearch
+{
+public:
+  using fpa::AstarSearch::AstarSearch;
+  using fpa::AstarSearch::detectBoundaryExit;
+  using fpa::AstarSearch::detectCollision;
+  using fpa::AstarSearch::hasObstacleInFootprint;
+
+  bool detectCollisionWithCellWalk(const fpa::IndexXYT & base_index) const
+  {
+    if (detectBoundaryExit(base_index)) return true;
+
+    const double obstacle_edt = getObstacleEDT(base_index).distance;
+    if (obstacle_edt > collision_vehicle_shape_.max_dimension) return false;
+    if (obstacle_edt < collision_vehicle_shape_.min_dimension) return true;
+
+    return hasObstacleInFootprintWithCellWalk(base_index);
+  }
+
+  bool hasObstacleInFootprintWithCellWalk(const fpa::IndexXYT & base_index) const
+  {
+    for (const auto & coll_index_2d : coll_indexes_table_[base_index.theta]) {
+      const fpa::IndexXY coll_index{coll_index_2d.x + base_index.x, coll_index_2d.y + base_index.y};
+      if (isObs(coll_index)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int getNbOfMarginCells() const { return nb_of_margin_cells_; }
+};
+
+nav_msgs::msg::OccupancyGrid construct_random_cost_map(
+  const size_t width, const size_t height, const double resolution, const double obstacle_ratio,
+  std::mt19937 & engine)
+{
+  nav_msgs::msg::OccupancyGrid costmap_msg{};
+  costmap_msg.info.width = width;
+  costmap_msg.info.height = height;
+  costmap_msg.info.resolution = resolution;
+  costmap_msg.info.origin.orientation.w = 1.0;
+
+  // unknown cells (-1) are also obstacles
+  std::uniform_real_distribution<double> ratio_dist(0.0, 1.0);
+  for (size_t i = 0; i < width * height; ++i) {
+    const double r = ratio_dist(engine);
+    costmap_msg.data.push_back(
+      r < 0.5 * obstacle_ratio ? 100 : (r < obstacle_ratio ? -1 : (r < 0.5 ? 50 : 0)));
+  }
+  return costmap_msg;
+}
+
+TEST(AbstractAlgorithmTestSuite, CollisionCheckSameAsCellWalk)
+{
+  auto planner_common_param = get_default_planner_params();
+  planner_common_param.theta_size = 72;
+  CollisionCheckTester tester(planner_common_param, vehicle_shape, get_default_astar_params());
+
+  std::mt19937 engine(0);
+  // the widths are not multiples of 64 to check the bits across the words of the bitmap
+  for (const auto & [width, height, resolution] :
+       std::vector<std::tuple<size_t, size_t, double>>{
+         {150, 150, 0.2}, {97, 130, 0.3}, {230, 70, 0.1}, {150, 150, 0.2}}) {
+    size_t check_num = 0;
+    size_t collision_num = 0;
+    for (const double obstacle_ratio : {0.001, 0.01, 0.05}) {
+      tester.setMap(construct_random_cost_map(width, height, resolution, obstacle_ratio, engine));
+
+      // include the poses near the boundary, where the footprint may exit the map
+      const int margin = tester.getNbOfMarginCells();
+      std::uniform_int_distribution<int> x_dist(margin / 2, static_cast<int>(width) - margin / 2);
+      std::uniform_int_distribution<int> y_dist(margin / 2, static_cast<int>(height) - margin / 2);
+      for (int i = 0; i < 300; ++i) {
+        const int x = x_dist(engine);
+        const int y = y_dist(engine);
+        for (int theta = 0; theta < planner_common_param.theta_size; ++theta) {
+          const fpa::IndexXYT index{x, y, theta};
+          const bool is_colliding = tester.detectCollisionWithCellWalk(index);
+          ASSERT_EQ(tester.detectCollision(index), is_colliding)
+            << "map: " << width << "x" << height << ", resolution: " << resolution
+            << ", index: (" << x << ", " << y << ", " << theta << ")";
+          ++check_num;
+          collision_num += is_colliding ? 1 : 0;
+          // the packed footprint is also the same without the shortcuts with the distance
+          if (!tester.detectBoundaryExit(index)) {
+            ASSERT_EQ(
+              tester.hasObstacleInFootprint(index),
+              tester.hasObstacleInFootprintWithCellWalk(index))
+              << "map: " << width << "x" << height << ", resolution: " << resolution
+              << ", index: (" << x << ", " << y << ", " << theta << ")";
+          }
+        }
+      }
+    }
+    // both of the results are checked
+    EXPECT_GT(collision_num, 0u);
+    EXPECT_LT(collision_num, check_num);
+  }
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -213,6 +213,7 @@ private:
     double pointcloud_voxel_grid_y;
     double pointcloud_voxel_grid_z;
     double pointcloud_cluster_tolerance;
+    double pointcloud_corridor_grid_resolution;
     int pointcloud_min_cluster_size;
     int pointcloud_max_cluster_size;
     // hysteresis for stop and cruise
@@ -21,6 +21,7 @@
 
 #include <rclcpp/rclcpp.hpp>
 
+#include <cstdint>
 #include <limits>
 #include <optional>
 #include <string>
@@ -38,6 +39,35 @@ PoseWithStamp getCurrentObjectPose(
 
 std::vector<StopObstacle> getClosestStopObstacles(const std::vector<StopObstacle> & stop_obstacles);
 
+/**
+ * @brief occupancy grid of the area swept along the trajectory, built once per planning cycle.
+ * A cell is occupied when any part of it is within half_width of a trajectory segment after
+ * start_idx, so that points outside the corridor are rejected with one cell lookup.
+ * The cell size is enlarged from the given resolution if the grid would have more than
+ * max_cell_num cells, which only makes the corridor coarser.
+ */
+class TrajectoryCorridorGrid
+{
+public:
+  static constexpr int64_t max_cell_num = 1 << 22;
+
+  TrajectoryCorridorGrid(
+    const std::vector<TrajectoryPoint> & traj_points, const size_t start_idx,
+    const double half_width, const double resolution);
+
+  bool isInside(const double x, const double y) const;
+
+  double getResolution() const { return resolution_; }
+
+private:
+  double min_x_{0.0};
+  double min_y_{0.0};
+  double resolution_;
+  int64_t width_{0};
+  int64_t height_{0};
+  std::vector<uint8_t> cells_;
+};
+
 template <class T>
 size_t getIndexWithLongitudinalOffset(
   const T & points, const double longitudinal_offset, std::optional<size_t> start_idx)
@@ -16,6 +16,7 @@
 
 #include "autoware/motion_utils/resample/resample.hpp"
 #include "autoware/motion_utils/trajectory/conversion.hpp"
+#include "autoware/motion_utils/trajectory/trajectory_index.hpp"
 #include "autoware/obstacle_cruise_planner/polygon_utils.hpp"
 #include "autoware/obstacle_cruise_planner/utils.hpp"
 #include "autoware/universe_utils/geometry/boost_polygon_utils.hpp"
@@ -31,6 +32,7 @@
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/segmentation/extract_clusters.h>
 #include <pcl_conversions/pcl_conversions.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #include <algorithm>
 #include <chrono>
@@ -257,6 +259,8 @@ ObstacleCruisePlannerNode::BehaviorDeterminationParam::BehaviorDeterminationPara
     node.declare_parameter<double>("behavior_determination.pointcloud_voxel_grid_z");
   pointcloud_cluster_tolerance =
     node.declare_parameter<double>("behavior_determination.pointcloud_cluster_tolerance");
+  pointcloud_corridor_grid_resolution =
+    node.declare_parameter<double>("behavior_determination.pointcloud_corridor_grid_resolution");
   pointcloud_min_cluster_size =
     node.declare_parameter<int>("behavior_determination.pointcloud_min_cluster_size");
   pointcloud_max_cluster_size =
@@ -331,6 +335,9 @@ void ObstacleCruisePlannerNode::BehaviorDeterminationParam::onParam(
   autoware::universe_utils::updateParam<double>(
     parameters, "behavior_determination.pointcloud_cluster_tolerance",
     pointcloud_cluster_tolerance);
+  autoware::universe_utils::updateParam<double>(
+    parameters, "behavior_determination.pointcloud_corridor_grid_resolution",
+    pointcloud_corridor_grid_resolution);
   autoware::universe_utils::updateParam<int>(
     parameters, "behavior_determination.pointcloud_min_cluster_size", pointcloud_min_cluster_size);
   autoware::universe_utils::updateParam<int>(
@@ -824,37 +831,52 @@ std::vector<Obstacle> ObstacleCruisePlannerNode::convertToObstacles(
   }
 
   if (!pointcloud.data.empty() && transform_stamped) {
-    // 1. transform pointcloud
-    PointCloud::Ptr pointcloud_ptr(new PointCloud);
-    pcl::fromROSMsg(pointcloud, *pointcloud_ptr);
-    const Eigen::Matrix4f transform =
-      tf2::transformToEigen(transform_stamped.value().transform).matrix().cast<float>();
-    pcl::transformPointCloud(*pointcloud_ptr, *pointcloud_ptr, transform);
+    const auto max_lat_margin =
+      std::max(p.max_lat_margin_for_stop_against_unknown, p.max_lat_margin_for_slow_down);
+    const size_t ego_idx = ego_nearest_param_.findIndex(traj_points, odometry.pose.pose);
+
+    // 1. transform pointcloud and extract the points in the trajectory corridor.
+    // The points are read from the message directly so that the points outside the corridor are
+    // neither copied nor clustered.
+    const obstacle_cruise_utils::TrajectoryCorridorGrid corridor_grid(
+      traj_points, ego_idx, vehicle_info_.vehicle_width_m + max_lat_margin,
+      p.pointcloud_corridor_grid_resolution);
+    const Eigen::Isometry3f transform =
+      tf2::transformToEigen(transform_stamped.value().transform).cast<float>();
+    PointCloud::Ptr corridor_points_ptr(new PointCloud);
+    for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(pointcloud, "x"),
+         iter_y(pointcloud, "y"), iter_z(pointcloud, "z");
+         iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+      const Eigen::Vector3f point = transform * Eigen::Vector3f(*iter_x, *iter_y, *iter_z);
+      if (corridor_grid.isInside(point.x(), point.y())) {
+        corridor_points_ptr->push_back(pcl::PointXYZ(point.x(), point.y(), point.z()));
+      }
+    }
 
     // 2. downsample & cluster pointcloud
     PointCloud::Ptr filtered_points_ptr(new PointCloud);
     pcl::VoxelGrid<pcl::PointXYZ> filter;
-    filter.setInputCloud(pointcloud_ptr);
+    filter.setInputCloud(corridor_points_ptr);
     filter.setLeafSize(
       p.pointcloud_voxel_grid_x, p.pointcloud_voxel_grid_y, p.pointcloud_voxel_grid_z);
     filter.filter(*filtered_points_ptr);
 
-    pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-    tree->setInputCloud(filtered_points_ptr);
     std::vector<pcl::PointIndices> clusters;
-    pcl::EuclideanClusterExtraction<pcl::PointXYZ> ec;
-    ec.setClusterTolerance(p.pointcloud_cluster_tolerance);
-    ec.setMinClusterSize(p.pointcloud_min_cluster_size);
-    ec.setMaxClusterSize(p.pointcloud_max_cluster_size);
-    ec.setSearchMethod(tree);
-    ec.setInputCloud(filtered_points_ptr);
-    ec.extract(clusters);
-
-    const auto max_lat_margin =
-      std::max(p.max_lat_margin_for_stop_against_unknown, p.max_lat_margin_for_slow_down);
-    const size_t ego_idx = ego_nearest_param_.findIndex(traj_points, odometry.pose.pose);
+    if (!filtered_points_ptr->empty()) {
+      pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
+      tree->setInputCloud(filtered_points_ptr);
+      pcl::EuclideanClusterExtraction<pcl::PointXYZ> ec;
+      ec.setClusterTolerance(p.pointcloud_cluster_tolerance);
+      ec.setMinClusterSize(p.pointcloud_min_cluster_size);
+      ec.setMaxClusterSize(p.pointcloud_max_cluster_size);
+      ec.setSearchMethod(tree);
+      ec.setInputCloud(filtered_points_ptr);
+      ec.extract(clusters);
+    }
 
     // 3. convert clusters to obstacles
+    const autoware::motion_utils::TrajectoryIndex traj_index(traj_points);
+    size_t nearest_idx_hint = ego_idx;
     for (const auto & cluster_indices : clusters) {
       double ego_to_stop_collision_distance = std::numeric_limits<double>::max();
       double ego_to_slow_down_front_collision_distance = std::numeric_limits<double>::max();
@@ -868,13 +890,18 @@ std::vector<Obstacle> ObstacleCruisePlannerNode::convertToObstacles(
       for (const auto & index : cluster_indices.indices) {
         const auto obstacle_point = toGeomPoint(filtered_points_ptr->points[index]);
         const auto current_lat_dist_from_obstacle_to_traj =
-          autoware::motion_utils::calcLateralOffset(traj_points, obstacle_point);
+          traj_index.calcLateralOffset(obstacle_point, nearest_idx_hint);
         const auto min_lat_dist_to_traj_poly =
           std::abs(current_lat_dist_from_obstacle_to_traj) - vehicle_info_.vehicle_width_m;
 
         if (min_lat_dist_to_traj_poly < max_lat_margin) {
-          const auto current_ego_to_obstacle_distance =
-            calcDistanceToFrontVehicle(traj_points, ego_idx, obstacle_point);
+          // same as calcDistanceToFrontVehicle without scanning the whole trajectory
+          nearest_idx_hint = traj_index.findNearestIndex(obstacle_point, nearest_idx_hint);
+          const auto current_ego_to_obstacle_distance = std::invoke([&]() -> std::optional<double> {
+            const double dist = traj_index.calcSignedArcLength(ego_idx, nearest_idx_hint);
+            if (dist < 0.0) return std::nullopt;
+            return dist;
+          });
           if (current_ego_to_obstacle_distance) {
             ego_to_obstacle_distance =
               std::min(ego_to_obstacle_distance, *current_ego_to_obstacle_distance);
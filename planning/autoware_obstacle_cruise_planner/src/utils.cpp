@@ -17,6 +17,9 @@
 #include "autoware/universe_utils/ros/marker_helper.hpp"
 #include "object_recognition_utils/predicted_path_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace obstacle_cruise_utils
 {
 namespace
@@ -112,4 +115,92 @@ std::vector<StopObstacle> getClosestStopObstacles(const std::vector<StopObstacle
   }
   return candidates;
 }
+
+TrajectoryCorridorGrid::TrajectoryCorridorGrid(
+  const std::vector<TrajectoryPoint> & traj_points, const size_t start_idx,
+  const double half_width, const double resolution)
+: resolution_(resolution)
+{
+  if (traj_points.size() <= start_idx + 1 || !(resolution > 0.0)) {
+    return;
+  }
+
+  double traj_min_x = std::numeric_limits<double>::max();
+  double traj_min_y = std::numeric_limits<double>::max();
+  double traj_max_x = std::numeric_limits<double>::lowest();
+  double traj_max_y = std::numeric_limits<double>::lowest();
+  for (size_t i = start_idx; i < traj_points.size(); ++i) {
+    const auto & p = traj_points.at(i).pose.position;
+    traj_min_x = std::min(traj_min_x, p.x);
+    traj_min_y = std::min(traj_min_y, p.y);
+    traj_max_x = std::max(traj_max_x, p.x);
+    traj_max_y = std::max(traj_max_y, p.y);
+  }
+
+  // a cell is occupied if its center is within the margin, which covers the whole cell
+  const auto calc_margin = [&]() { return half_width + resolution_ * std::sqrt(0.5); };
+  const auto calc_cell_num = [&](const double min_v, const double max_v) {
+    return std::ceil((max_v - min_v + 2.0 * calc_margin()) / resolution_);
+  };
+  // the number of cells is bounded even with a long trajectory or a small resolution
+  while (calc_cell_num(traj_min_x, traj_max_x) * calc_cell_num(traj_min_y, traj_max_y) >
+         static_cast<double>(max_cell_num)) {
+    resolution_ *= 2.0;
+  }
+  const double margin = calc_margin();
+
+  min_x_ = traj_min_x - margin;
+  min_y_ = traj_min_y - margin;
+  width_ = static_cast<int64_t>(calc_cell_num(traj_min_x, traj_max_x));
+  height_ = static_cast<int64_t>(calc_cell_num(traj_min_y, traj_max_y));
+  cells_.assign(static_cast<size_t>(width_ * height_), 0);
+
+  for (size_t i = start_idx; i + 1 < traj_points.size(); ++i) {
+    const auto & front = traj_points.at(i).pose.position;
+    const auto & back = traj_points.at(i + 1).pose.position;
+    const double seg_x = back.x - front.x;
+    const double seg_y = back.y - front.y;
+    const double seg_squared_length = seg_x * seg_x + seg_y * seg_y;
+
+    const auto to_cell = [&](const double v, const double min_v, const int64_t size) {
+      const auto idx = static_cast<int64_t>(std::floor((v - min_v) / resolution_));
+      return std::clamp<int64_t>(idx, 0, size - 1);
+    };
+    const int64_t min_ix = to_cell(std::min(front.x, back.x) - margin, min_x_, width_);
+    const int64_t max_ix = to_cell(std::max(front.x, back.x) + margin, min_x_, width_);
+    const int64_t min_iy = to_cell(std::min(front.y, back.y) - margin, min_y_, height_);
+    const int64_t max_iy = to_cell(std::max(front.y, back.y) + margin, min_y_, height_);
+
+    for (int64_t iy = min_iy; iy <= max_iy; ++iy) {
+      for (int64_t ix = min_ix; ix <= max_ix; ++ix) {
+        auto & cell = cells_.at(static_cast<size_t>(iy * width_ + ix));
+        if (cell) {
+          continue;
+        }
+        const double x = min_x_ + (static_cast<double>(ix) + 0.5) * resolution_ - front.x;
+        const double y = min_y_ + (static_cast<double>(iy) + 0.5) * resolution_ - front.y;
+        const double ratio =
+          seg_squared_length < 1e-6
+            ? 0.0
+            : std::clamp((x * seg_x + y * seg_y) / seg_squared_length, 0.0, 1.0);
+        if (std::hypot(x - ratio * seg_x, y - ratio * seg_y) <= margin) {
+          cell = 1;
+        }
+      }
+    }
+  }
+}
+
+bool TrajectoryCorridorGrid::isInside(const double x, const double y) const
+{
+  if (cells_.empty() || !std::isfinite(x) || !std::isfinite(y)) {
+    return false;
+  }
+  const auto ix = static_cast<int64_t>(std::floor((x - min_x_) / resolution_));
+  const auto iy = static_cast<int64_t>(std::floor((y - min_y_) / resolution_));
+  if (ix < 0 || width_ <= ix || iy < 0 || height_ <= iy) {
+    return false;
+  }
+  return cells_[static_cast<size_t>(iy * width_ + ix)] != 0;
+}
 }  // namespace obstacle_cruise_utils
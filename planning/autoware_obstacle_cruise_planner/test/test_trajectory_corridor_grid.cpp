@@ -0,0 +1,188 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/obstacle_cruise_planner/utils.hpp"
+#include "autoware/universe_utils/geometry/boost_polygon_utils.hpp"
+
+#include <boost/geometry/algorithms/append.hpp>
+#include <boost/geometry/algorithms/convex_hull.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using autoware::universe_utils::Point2d;
+using autoware::universe_utils::Polygon2d;
+using obstacle_cruise_utils::TrajectoryCorridorGrid;
+
+namespace
+{
+// trajectory along an arc of the given radius
+std::vector<TrajectoryPoint> createCurvedTrajectory(
+  const double radius, const double interval, const size_t size)
+{
+  std::vector<TrajectoryPoint> traj_points;
+  for (size_t i = 0; i < size; ++i) {
+    const double theta = interval * static_cast<double>(i) / radius;
+    TrajectoryPoint p;
+    p.pose.position.x = radius * std::sin(theta);
+    p.pose.position.y = radius * (1.0 - std::cos(theta));
+    p.pose.orientation = autoware::universe_utils::createQuaternionFromYaw(theta);
+    p.longitudinal_velocity_mps = 10.0;
+    traj_points.push_back(p);
+  }
+  return traj_points;
+}
+
+// footprints swept between the consecutive trajectory points as createOneStepPolygons of the node
+// does, with the lateral margin of half_width and without the longitudinal offsets
+std::vector<Polygon2d> createOneStepPolygons(
+  const std::vector<TrajectoryPoint> & traj_points, const size_t start_idx,
+  const double half_width)
+{
+  std::vector<Polygon2d> output_polygons;
+  for (size_t i = start_idx; i + 1 < traj_points.size(); ++i) {
+    Polygon2d step_polys;
+    for (const size_t idx : {i, i + 1}) {
+      boost::geometry::append(
+        step_polys,
+        autoware::universe_utils::toFootprint(traj_points.at(idx).pose, 0.0, 0.0, 2.0 * half_width)
+          .outer());
+    }
+    Polygon2d hull_polygon;
+    boost::geometry::convex_hull(step_polys, hull_polygon);
+    boost::geometry::correct(hull_polygon);
+    output_polygons.push_back(hull_polygon);
+  }
+  return output_polygons;
+}
+
+// min_x, min_y, max_x, max_y
+std::array<double, 4> calcBoundingBox(const std::vector<TrajectoryPoint> & traj_points)
+{
+  std::array<double, 4> bbox{
+    std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+  for (const auto & traj_point : traj_points) {
+    const auto & p = traj_point.pose.position;
+    bbox[0] = std::min(bbox[0], p.x);
+    bbox[1] = std::min(bbox[1], p.y);
+    bbox[2] = std::max(bbox[2], p.x);
+    bbox[3] = std::max(bbox[3], p.y);
+  }
+  return bbox;
+}
+
+double calcDistanceToTrajectory(
+  const std::vector<TrajectoryPoint> & traj_points, const size_t start_idx, const double x,
+  const double y)
+{
+  double min_dist = std::numeric_limits<double>::max();
+  for (size_t i = start_idx; i + 1 < traj_points.size(); ++i) {
+    const auto & front = traj_points.at(i).pose.position;
+    const auto & back = traj_points.at(i + 1).pose.position;
+    const double seg_x = back.x - front.x;
+    const double seg_y = back.y - front.y;
+    const double ratio = std::clamp(
+      ((x - front.x) * seg_x + (y - front.y) * seg_y) / (seg_x * seg_x + seg_y * seg_y), 0.0, 1.0);
+    min_dist =
+      std::min(min_dist, std::hypot(x - front.x - ratio * seg_x, y - front.y - ratio * seg_y));
+  }
+  return min_dist;
+}
+
+// check that the points in the footprints are inside the corridor, and the points farther than a
+// cell diagonal from the footprints are outside
+void expectConsistentWithFootprints(
+  const std::vector<TrajectoryPoint> & traj_points, const size_t start_idx,
+  const double half_width, const TrajectoryCorridorGrid & corridor_grid, const size_t point_num)
+{
+  const auto footprints = createOneStepPolygons(traj_points, start_idx, half_width);
+  const double max_dist_inside = half_width + std::sqrt(2.0) * corridor_grid.getResolution();
+
+  const auto [min_x, min_y, max_x, max_y] = calcBoundingBox(traj_points);
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist_x(min_x - 10.0, max_x + 10.0);
+  std::uniform_real_distribution<double> dist_y(min_y - 10.0, max_y + 10.0);
+  size_t inside_footprint_num = 0;
+  size_t far_num = 0;
+  for (size_t i = 0; i < point_num; ++i) {
+    const double x = dist_x(engine);
+    const double y = dist_y(engine);
+    const bool is_inside_footprint =
+      std::any_of(footprints.begin(), footprints.end(), [&](const auto & footprint) {
+        return boost::geometry::covered_by(Point2d(x, y), footprint);
+      });
+    if (is_inside_footprint) {
+      ++inside_footprint_num;
+      EXPECT_TRUE(corridor_grid.isInside(x, y)) << "point: " << x << ", " << y;
+    }
+    if (calcDistanceToTrajectory(traj_points, start_idx, x, y) > max_dist_inside) {
+      ++far_num;
+      EXPECT_FALSE(corridor_grid.isInside(x, y)) << "point: " << x << ", " << y;
+    }
+  }
+  EXPECT_GT(inside_footprint_num, 0u);
+  EXPECT_GT(far_num, 0u);
+}
+}  // namespace
+
+TEST(TrajectoryCorridorGrid, SameAsOneStepPolygons)
+{
+  const auto traj_points = createCurvedTrajectory(25.0, 1.0, 60);
+  const size_t start_idx = 10;
+  const double half_width = 2.8;
+  const double resolution = 0.5;
+
+  const TrajectoryCorridorGrid corridor_grid(traj_points, start_idx, half_width, resolution);
+  EXPECT_DOUBLE_EQ(corridor_grid.getResolution(), resolution);
+  expectConsistentWithFootprints(traj_points, start_idx, half_width, corridor_grid, 20000);
+
+  // the points behind start_idx are outside
+  const auto & behind_point = traj_points.front().pose.position;
+  EXPECT_FALSE(corridor_grid.isInside(behind_point.x, behind_point.y));
+}
+
+TEST(TrajectoryCorridorGrid, CellNumIsBoundedWithSmallResolution)
+{
+  const auto traj_points = createCurvedTrajectory(100.0, 1.0, 300);
+  const size_t start_idx = 0;
+  const double half_width = 2.8;
+  const double resolution = 0.001;
+
+  const TrajectoryCorridorGrid corridor_grid(traj_points, start_idx, half_width, resolution);
+  const double cell_size = corridor_grid.getResolution();
+  EXPECT_GT(cell_size, resolution);
+  const auto [min_x, min_y, max_x, max_y] = calcBoundingBox(traj_points);
+  const double margin = 2.0 * (half_width + cell_size * std::sqrt(0.5));
+  const double width = std::ceil((max_x - min_x + margin) / cell_size);
+  const double height = std::ceil((max_y - min_y + margin) / cell_size);
+  EXPECT_LE(width * height, static_cast<double>(TrajectoryCorridorGrid::max_cell_num));
+  expectConsistentWithFootprints(traj_points, start_idx, half_width, corridor_grid, 5000);
+}
+
+TEST(TrajectoryCorridorGrid, EmptyWithoutSegment)
+{
+  const auto traj_points = createCurvedTrajectory(25.0, 1.0, 5);
+  const TrajectoryCorridorGrid corridor_grid(traj_points, 4, 2.8, 0.5);
+  const auto & p = traj_points.back().pose.position;
+  EXPECT_FALSE(corridor_grid.isInside(p.x, p.y));
+}
@@ -61,6 +61,7 @@ private:
     // option
     bool enable_warm_start;
     bool enable_optimization_validation;
+    bool enable_windowed_smoothing;
 
     // common
     double delta_arc_length;
@@ -76,6 +77,10 @@ private:
     double smooth_weight;
     double lat_error_weight;
 
+    // windowed smoothing
+    int num_points_per_window;
+    int num_overlap_points;
+
     // qp
     QPParam qp_param;
 
@@ -109,7 +114,9 @@ private:
   rclcpp::Publisher<Trajectory>::SharedPtr debug_eb_traj_pub_;
   rclcpp::Publisher<Trajectory>::SharedPtr debug_eb_fixed_traj_pub_;
 
-  std::unique_ptr<autoware::common::osqp::OSQPInterface> osqp_solver_ptr_;
+  // solver for each window of the optimized points
+  std::vector<std::unique_ptr<autoware::common::osqp::OSQPInterface>> osqp_solver_ptrs_;
+  std::vector<std::pair<size_t, size_t>> prev_windows_;
   std::shared_ptr<std::vector<TrajectoryPoint>> prev_eb_traj_points_ptr_{nullptr};
 
   std::vector<TrajectoryPoint> insertFixedPoint(
@@ -118,11 +125,19 @@ private:
   std::tuple<std::vector<TrajectoryPoint>, size_t> getPaddedTrajectoryPoints(
     const std::vector<TrajectoryPoint> & traj_points) const;
 
+  std::vector<std::pair<size_t, size_t>> calcWindows() const;
+
   void updateConstraint(
     const std::vector<TrajectoryPoint> & traj_points, const bool is_goal_contained,
-    const int pad_start_idx);
+    const int pad_start_idx, const std::vector<std::pair<size_t, size_t>> & windows);
+
+  void updateWindowConstraint(
+    const std::vector<TrajectoryPoint> & traj_points, const std::vector<double> & lower_bound,
+    const std::vector<double> & upper_bound, const std::pair<size_t, size_t> & window,
+    std::unique_ptr<autoware::common::osqp::OSQPInterface> & osqp_solver_ptr) const;
 
-  std::optional<std::vector<double>> calcSmoothedTrajectory();
+  std::optional<std::vector<double>> calcSmoothedTrajectory(
+    const std::vector<std::pair<size_t, size_t>> & windows);
 
   std::optional<std::vector<TrajectoryPoint>> convertOptimizedPointsToTrajectory(
     const std::vector<double> & optimized_points, const std::vector<TrajectoryPoint> & traj_points,
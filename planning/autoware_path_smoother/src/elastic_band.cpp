@@ -26,7 +26,10 @@
 
 #include <algorithm>
 #include <chrono>
+#include <future>
 #include <limits>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -75,6 +78,55 @@ std::vector<double> toStdVector(const Eigen::VectorXd & eigen_vec)
   return {eigen_vec.data(), eigen_vec.data() + eigen_vec.rows()};
 }
 
+// call func(i) for i in [0, size) on separate threads
+template <typename Func>
+void runInParallel(const size_t size, const Func & func)
+{
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < size; ++i) {
+    futures.push_back(std::async(std::launch::async, func, i));
+  }
+  if (0 < size) {
+    func(0);
+  }
+  for (auto & future : futures) {
+    future.get();
+  }
+}
+
+// blend the optimized points of the windows with weights fading in and out at the window edges
+std::vector<double> blendWindowResults(
+  const std::vector<std::pair<size_t, size_t>> & windows,
+  const std::vector<std::vector<double>> & window_results, const size_t num_points,
+  const size_t num_overlap_points)
+{
+  const auto calc_weight = [&](const size_t dist_from_edge) {
+    const double ratio = std::min(
+      static_cast<double>(dist_from_edge + 1) / static_cast<double>(num_overlap_points + 1), 1.0);
+    return ratio * ratio * (3.0 - 2.0 * ratio);
+  };
+
+  std::vector<double> weighted_sum(num_points, 0.0);
+  std::vector<double> weight_sum(num_points, 0.0);
+  for (size_t w = 0; w < windows.size(); ++w) {
+    const auto [begin, end] = windows.at(w);
+    for (size_t i = begin; i < end; ++i) {
+      // NOTE: The front of the first window and the back of the last window are not blended.
+      const double front_weight = w == 0 ? 1.0 : calc_weight(i - begin);
+      const double back_weight = w + 1 == windows.size() ? 1.0 : calc_weight(end - 1 - i);
+      const double weight = std::min(front_weight, back_weight);
+      weighted_sum.at(i) += weight * window_results.at(w).at(i - begin);
+      weight_sum.at(i) += weight;
+    }
+  }
+
+  std::vector<double> blended_points(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    blended_points.at(i) = weighted_sum.at(i) / weight_sum.at(i);
+  }
+  return blended_points;
+}
+
 std_msgs::msg::Header createHeader(const rclcpp::Time & now)
 {
   std_msgs::msg::Header header;
@@ -92,6 +144,8 @@ EBPathSmoother::EBParam::EBParam(rclcpp::Node * node)
     enable_warm_start = node->declare_parameter<bool>("elastic_band.option.enable_warm_start");
     enable_optimization_validation =
       node->declare_parameter<bool>("elastic_band.option.enable_optimization_validation");
+    enable_windowed_smoothing =
+      node->declare_parameter<bool>("elastic_band.option.enable_windowed_smoothing");
   }
 
   {  // common
@@ -113,6 +167,13 @@ EBPathSmoother::EBParam::EBParam(rclcpp::Node * node)
     lat_error_weight = node->declare_parameter<double>("elastic_band.weight.lat_error_weight");
   }
 
+  {  // windowed smoothing
+    num_points_per_window =
+      node->declare_parameter<int>("elastic_band.windowed_smoothing.num_points_per_window");
+    num_overlap_points =
+      node->declare_parameter<int>("elastic_band.windowed_smoothing.num_overlap_points");
+  }
+
   {  // qp
     qp_param.max_iteration = node->declare_parameter<int>("elastic_band.qp.max_iteration");
     qp_param.eps_abs = node->declare_parameter<double>("elastic_band.qp.eps_abs");
@@ -132,6 +193,8 @@ void EBPathSmoother::EBParam::onParam(const std::vector<rclcpp::Parameter> & par
     updateParam<bool>(
       parameters, "elastic_band.option.enable_optimization_validation",
       enable_optimization_validation);
+    updateParam<bool>(
+      parameters, "elastic_band.option.enable_windowed_smoothing", enable_windowed_smoothing);
   }
 
   {  // common
@@ -153,6 +216,13 @@ void EBPathSmoother::EBParam::onParam(const std::vector<rclcpp::Parameter> & par
     updateParam<double>(parameters, "elastic_band.weight.lat_error_weight", lat_error_weight);
   }
 
+  {  // windowed smoothing
+    updateParam<int>(
+      parameters, "elastic_band.windowed_smoothing.num_points_per_window", num_points_per_window);
+    updateParam<int>(
+      parameters, "elastic_band.windowed_smoothing.num_overlap_points", num_overlap_points);
+  }
+
   {  // qp
     updateParam<int>(parameters, "elastic_band.qp.max_iteration", qp_param.max_iteration);
     updateParam<double>(parameters, "elastic_band.qp.eps_abs", qp_param.eps_abs);
@@ -241,10 +311,11 @@ std::vector<TrajectoryPoint> EBPathSmoother::smoothTrajectory(
   const auto [padded_traj_points, pad_start_idx] = getPaddedTrajectoryPoints(resampled_traj_points);
 
   // 5. update constraint for elastic band's QP
-  updateConstraint(padded_traj_points, is_goal_contained, pad_start_idx);
+  const auto windows = calcWindows();
+  updateConstraint(padded_traj_points, is_goal_contained, pad_start_idx, windows);
 
   // 6. get optimization result
-  const auto optimized_points = calcSmoothedTrajectory();
+  const auto optimized_points = calcSmoothedTrajectory(windows);
   if (!optimized_points) {
     RCLCPP_INFO_EXPRESSION(
       logger_, enable_debug_info_, "return std::nullopt since smoothing failed");
@@ -307,9 +378,32 @@ std::tuple<std::vector<TrajectoryPoint>, size_t> EBPathSmoother::getPaddedTrajec
   return {padded_traj_points, pad_start_idx};
 }
 
+std::vector<std::pair<size_t, size_t>> EBPathSmoother::calcWindows() const
+{
+  const auto & p = eb_param_;
+  const auto num_points = static_cast<size_t>(p.num_points);
+
+  // NOTE: All the points are optimized by one QP when the windows cannot overlap each other.
+  if (
+    !p.enable_windowed_smoothing || p.num_overlap_points < 1 ||
+    p.num_points_per_window <= p.num_overlap_points || p.num_points <= p.num_points_per_window) {
+    return {{0, num_points}};
+  }
+
+  const auto window_size = static_cast<size_t>(p.num_points_per_window);
+  const auto window_stride = window_size - static_cast<size_t>(p.num_overlap_points);
+  std::vector<std::pair<size_t, size_t>> windows;
+  for (size_t begin = 0; begin + window_size < num_points; begin += window_stride) {
+    windows.emplace_back(begin, begin + window_size);
+  }
+  // NOTE: The last window is aligned to the back so that all the windows have the same size.
+  windows.emplace_back(num_points - window_size, num_points);
+  return windows;
+}
+
 void EBPathSmoother::updateConstraint(
   const std::vector<TrajectoryPoint> & traj_points, const bool is_goal_contained,
-  const int pad_start_idx)
+  const int pad_start_idx, const std::vector<std::pair<size_t, size_t>> & windows)
 {
   time_keeper_ptr_->tic(__func__);
 
@@ -317,7 +411,6 @@ void EBPathSmoother::updateConstraint(
 
   std::vector<TrajectoryPoint> debug_fixed_traj_points;  // for debug
 
-  const Eigen::MatrixXd A = Eigen::MatrixXd::Identity(p.num_points, p.num_points);
   std::vector<double> upper_bound(p.num_points, 0.0);
   std::vector<double> lower_bound(p.num_points, 0.0);
   for (size_t i = 0; i < static_cast<size_t>(p.num_points); ++i) {
@@ -349,75 +442,123 @@ void EBPathSmoother::updateConstraint(
     }
   }
 
-  Eigen::VectorXd x_mat(2 * p.num_points);
+  // NOTE: The solvers cannot be warm-started when the windows are changed.
+  if (windows != prev_windows_) {
+    osqp_solver_ptrs_.clear();
+    osqp_solver_ptrs_.resize(windows.size());
+    prev_windows_ = windows;
+  }
+
+  // update QP of each window
+  runInParallel(windows.size(), [&](const size_t i) {
+    updateWindowConstraint(
+      traj_points, lower_bound, upper_bound, windows.at(i), osqp_solver_ptrs_.at(i));
+  });
+
+  // publish fixed trajectory
+  const auto eb_fixed_traj = autoware::motion_utils::convertToTrajectory(
+    debug_fixed_traj_points, createHeader(clock_.now()));
+  debug_eb_fixed_traj_pub_->publish(eb_fixed_traj);
+
+  time_keeper_ptr_->toc(__func__, "        ");
+}
+
+void EBPathSmoother::updateWindowConstraint(
+  const std::vector<TrajectoryPoint> & traj_points, const std::vector<double> & lower_bound,
+  const std::vector<double> & upper_bound, const std::pair<size_t, size_t> & window,
+  std::unique_ptr<autoware::common::osqp::OSQPInterface> & osqp_solver_ptr) const
+{
+  const auto & p = eb_param_;
+  const auto [begin, end] = window;
+  const auto num_points = static_cast<int>(end - begin);
+
+  const Eigen::MatrixXd A = Eigen::MatrixXd::Identity(num_points, num_points);
+  const std::vector<double> window_lower_bound(
+    std::next(lower_bound.begin(), begin), std::next(lower_bound.begin(), end));
+  const std::vector<double> window_upper_bound(
+    std::next(upper_bound.begin(), begin), std::next(upper_bound.begin(), end));
+
+  Eigen::VectorXd x_mat(2 * num_points);
   std::vector<Eigen::Triplet<double>> theta_triplet_vec;
-  for (size_t i = 0; i < static_cast<size_t>(p.num_points); ++i) {
-    x_mat(i) = traj_points.at(i).pose.position.x;
-    x_mat(i + p.num_points) = traj_points.at(i).pose.position.y;
+  for (int i = 0; i < num_points; ++i) {
+    const auto & pose = traj_points.at(begin + i).pose;
+    x_mat(i) = pose.position.x;
+    x_mat(i + num_points) = pose.position.y;
 
-    const double yaw = tf2::getYaw(traj_points.at(i).pose.orientation);
+    const double yaw = tf2::getYaw(pose.orientation);
     theta_triplet_vec.push_back(Eigen::Triplet<double>(i, i, -std::sin(yaw)));
-    theta_triplet_vec.push_back(Eigen::Triplet<double>(i, i + p.num_points, std::cos(yaw)));
+    theta_triplet_vec.push_back(Eigen::Triplet<double>(i, i + num_points, std::cos(yaw)));
   }
-  Eigen::SparseMatrix<double> sparse_theta_mat(p.num_points, 2 * p.num_points);
+  Eigen::SparseMatrix<double> sparse_theta_mat(num_points, 2 * num_points);
   sparse_theta_mat.setFromTriplets(theta_triplet_vec.begin(), theta_triplet_vec.end());
 
   // calculate P
-  const Eigen::SparseMatrix<double> raw_P_for_smooth = p.smooth_weight * makePMatrix(p.num_points);
+  const Eigen::SparseMatrix<double> raw_P_for_smooth = p.smooth_weight * makePMatrix(num_points);
   const Eigen::MatrixXd theta_P_mat = sparse_theta_mat * raw_P_for_smooth;
   const Eigen::MatrixXd P_for_smooth = theta_P_mat * sparse_theta_mat.transpose();
   const Eigen::MatrixXd P_for_lat_error =
-    p.lat_error_weight * Eigen::MatrixXd::Identity(p.num_points, p.num_points);
+    p.lat_error_weight * Eigen::MatrixXd::Identity(num_points, num_points);
   const Eigen::MatrixXd P = P_for_smooth + P_for_lat_error;
 
   // calculate q
   const Eigen::VectorXd raw_q_for_smooth = theta_P_mat * x_mat;
   const auto q = toStdVector(raw_q_for_smooth);
 
-  if (p.enable_warm_start && osqp_solver_ptr_) {
-    osqp_solver_ptr_->updateP(P);
-    osqp_solver_ptr_->updateQ(q);
-    osqp_solver_ptr_->updateA(A);
-    osqp_solver_ptr_->updateBounds(lower_bound, upper_bound);
-    osqp_solver_ptr_->updateEpsRel(p.qp_param.eps_rel);
+  if (p.enable_warm_start && osqp_solver_ptr) {
+    osqp_solver_ptr->updateP(P);
+    osqp_solver_ptr->updateQ(q);
+    osqp_solver_ptr->updateA(A);
+    osqp_solver_ptr->updateBounds(window_lower_bound, window_upper_bound);
+    osqp_solver_ptr->updateEpsRel(p.qp_param.eps_rel);
   } else {
-    osqp_solver_ptr_ = std::make_unique<autoware::common::osqp::OSQPInterface>(
-      P, A, q, lower_bound, upper_bound, p.qp_param.eps_abs);
-    osqp_solver_ptr_->updateEpsRel(p.qp_param.eps_rel);
-    osqp_solver_ptr_->updateEpsAbs(p.qp_param.eps_abs);
-    osqp_solver_ptr_->updateMaxIter(p.qp_param.max_iteration);
+    osqp_solver_ptr = std::make_unique<autoware::common::osqp::OSQPInterface>(
+      P, A, q, window_lower_bound, window_upper_bound, p.qp_param.eps_abs);
+    osqp_solver_ptr->updateEpsRel(p.qp_param.eps_rel);
+    osqp_solver_ptr->updateEpsAbs(p.qp_param.eps_abs);
+    osqp_solver_ptr->updateMaxIter(p.qp_param.max_iteration);
   }
-
-  // publish fixed trajectory
-  const auto eb_fixed_traj = autoware::motion_utils::convertToTrajectory(
-    debug_fixed_traj_points, createHeader(clock_.now()));
-  debug_eb_fixed_traj_pub_->publish(eb_fixed_traj);
-
-  time_keeper_ptr_->toc(__func__, "        ");
 }
 
-std::optional<std::vector<double>> EBPathSmoother::calcSmoothedTrajectory()
+std::optional<std::vector<double>> EBPathSmoother::calcSmoothedTrajectory(
+  const std::vector<std::pair<size_t, size_t>> & windows)
 {
   time_keeper_ptr_->tic(__func__);
 
-  // solve QP
-  const auto result = osqp_solver_ptr_->optimize();
-  const auto optimized_points = std::get<0>(result);
+  // solve QP of each window
+  std::vector<std::tuple<std::vector<double>, std::vector<double>, int64_t, int64_t, int64_t>>
+    results(windows.size());
+  runInParallel(
+    windows.size(), [&](const size_t i) { results.at(i) = osqp_solver_ptrs_.at(i)->optimize(); });
 
-  const auto status = std::get<3>(result);
+  std::vector<std::vector<double>> window_results;
+  for (size_t i = 0; i < windows.size(); ++i) {
+    const auto & optimized_points = std::get<0>(results.at(i));
 
-  // check status
-  if (status != 1) {
-    osqp_solver_ptr_->logUnsolvedStatus("[EB]");
-    return std::nullopt;
+    const auto status = std::get<3>(results.at(i));
+
+    // check status
+    if (status != 1) {
+      osqp_solver_ptrs_.at(i)->logUnsolvedStatus("[EB]");
+      return std::nullopt;
+    }
+    const auto has_nan = std::any_of(
+      optimized_points.begin(), optimized_points.end(), [](const auto v) { return std::isnan(v); });
+    if (has_nan) {
+      RCLCPP_WARN(logger_, "optimization failed: result contains NaN values");
+      return std::nullopt;
+    }
+    window_results.push_back(optimized_points);
   }
-  const auto has_nan = std::any_of(
-    optimized_points.begin(), optimized_points.end(), [](const auto v) { return std::isnan(v); });
-  if (has_nan) {
-    RCLCPP_WARN(logger_, "optimization failed: result contains NaN values");
-    return std::nullopt;
+
+  if (window_results.size() == 1) {
+    time_keeper_ptr_->toc(__func__, "        ");
+    return window_results.front();
   }
 
+  // blend the results in the overlaps of the windows
+  const auto optimized_points = blendWindowResults(
+    windows, window_results, eb_param_.num_points, eb_param_.num_overlap_points);
+
   time_keeper_ptr_->toc(__func__, "        ");
   return optimized_points;
 }
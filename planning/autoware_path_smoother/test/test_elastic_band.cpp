@@ -0,0 +1,200 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+#include "autoware/path_smoother/elastic_band.hpp"
+#include "autoware/universe_utils/geometry/geometry.hpp"
+#include "autoware/universe_utils/math/normalization.hpp"
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+using autoware::path_smoother::CommonParam;
+using autoware::path_smoother::EBPathSmoother;
+using autoware::path_smoother::EgoNearestParam;
+using autoware::path_smoother::TimeKeeper;
+using autoware::path_smoother::TrajectoryPoint;
+
+// wavy path with a zigzag noise whose points are 1.0 [m] away from each other along x
+std::vector<TrajectoryPoint> generateNoisyTrajectoryPoints(const size_t num_points)
+{
+  std::vector<TrajectoryPoint> traj_points(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const double x = static_cast<double>(i);
+    traj_points.at(i).pose.position.x = x;
+    traj_points.at(i).pose.position.y = 2.0 * std::sin(x / 20.0) + (i % 2 == 0 ? 0.05 : -0.05);
+    traj_points.at(i).longitudinal_velocity_mps = 10.0;
+  }
+  autoware::motion_utils::insertOrientation(traj_points, true);
+  return traj_points;
+}
+
+std::shared_ptr<rclcpp::Node> createNode()
+{
+  const auto path_smoother_dir =
+    ament_index_cpp::get_package_share_directory("autoware_path_smoother");
+  auto node_options = rclcpp::NodeOptions{};
+  node_options.arguments(
+    {"--ros-args", "--params-file",
+     path_smoother_dir + "/config/elastic_band_smoother.param.yaml"});
+  return std::make_shared<rclcpp::Node>("test_elastic_band", node_options);
+}
+
+std::vector<rclcpp::Parameter> createParameters(
+  const int num_points, const bool enable_windowed_smoothing)
+{
+  return {
+    rclcpp::Parameter("elastic_band.common.num_points", num_points),
+    rclcpp::Parameter("elastic_band.option.enable_windowed_smoothing", enable_windowed_smoothing)};
+}
+
+// heading change [rad] at each inner point, calculated from the positions
+std::vector<double> calcHeadingChanges(const std::vector<TrajectoryPoint> & traj_points)
+{
+  using autoware::universe_utils::calcAzimuthAngle;
+  using autoware::universe_utils::getPoint;
+
+  std::vector<double> heading_changes;
+  for (size_t i = 1; i + 1 < traj_points.size(); ++i) {
+    const double prev_heading =
+      calcAzimuthAngle(getPoint(traj_points.at(i - 1)), getPoint(traj_points.at(i)));
+    const double next_heading =
+      calcAzimuthAngle(getPoint(traj_points.at(i)), getPoint(traj_points.at(i + 1)));
+    heading_changes.push_back(
+      std::abs(autoware::universe_utils::normalizeRadian(next_heading - prev_heading)));
+  }
+  return heading_changes;
+}
+
+// curvature [1/m] of the circle passing through each three consecutive points
+std::vector<double> calcCurvatures(const std::vector<TrajectoryPoint> & traj_points)
+{
+  using autoware::universe_utils::calcDistance2d;
+
+  std::vector<double> curvatures;
+  for (size_t i = 1; i + 1 < traj_points.size(); ++i) {
+    const auto & p0 = traj_points.at(i - 1).pose.position;
+    const auto & p1 = traj_points.at(i).pose.position;
+    const auto & p2 = traj_points.at(i + 1).pose.position;
+    const double cross = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+    curvatures.push_back(
+      2.0 * std::abs(cross) /
+      (calcDistance2d(p0, p1) * calcDistance2d(p1, p2) * calcDistance2d(p0, p2)));
+  }
+  return curvatures;
+}
+}  // namespace
+
+TEST(ElasticBand, windowedSmoothing)
+{
+  rclcpp::init(0, nullptr);
+  {
+    const auto node = createNode();
+    const auto common_param = CommonParam(node.get());
+    EBPathSmoother smoother(
+      node.get(), false, EgoNearestParam(node.get()), common_param,
+      std::make_shared<TimeKeeper>());
+    const double delta_arc_length =
+      node->get_parameter("elastic_band.common.delta_arc_length").as_double();
+
+    const auto traj_points = generateNoisyTrajectoryPoints(300);
+    const auto & ego_pose = traj_points.front().pose;
+
+    smoother.onParam(createParameters(200, false));
+    const auto single_traj_points = smoother.smoothTrajectory(traj_points, ego_pose);
+
+    smoother.resetPreviousData();
+    smoother.onParam(createParameters(200, true));
+    const auto windowed_traj_points = smoother.smoothTrajectory(traj_points, ego_pose);
+
+    ASSERT_EQ(windowed_traj_points.size(), single_traj_points.size());
+    ASSERT_GT(windowed_traj_points.size(), 2u);
+
+    // NOTE: The noise of the input changes the heading by about 0.2 [rad] at every point, so a gap
+    //       or a kink between the windows in the overlaps fails the following checks.
+    // position continuity: the intervals of the points do not change by the blending
+    for (size_t i = 0; i + 1 < windowed_traj_points.size(); ++i) {
+      const double windowed_interval = autoware::universe_utils::calcDistance2d(
+        windowed_traj_points.at(i), windowed_traj_points.at(i + 1));
+      const double single_interval = autoware::universe_utils::calcDistance2d(
+        single_traj_points.at(i), single_traj_points.at(i + 1));
+      EXPECT_NEAR(windowed_interval, single_interval, 0.02 * delta_arc_length) << "index: " << i;
+    }
+
+    // heading continuity and bounded curvature: the windowed result is as smooth as the single QP
+    constexpr double heading_change_margin = 0.01;
+    constexpr double curvature_margin = 0.01;
+    const auto single_heading_changes = calcHeadingChanges(single_traj_points);
+    const auto windowed_heading_changes = calcHeadingChanges(windowed_traj_points);
+    const double max_single_heading_change =
+      *std::max_element(single_heading_changes.begin(), single_heading_changes.end());
+    for (size_t i = 0; i < windowed_heading_changes.size(); ++i) {
+      EXPECT_LE(windowed_heading_changes.at(i), max_single_heading_change + heading_change_margin)
+        << "index: " << i + 1;
+    }
+    const auto single_curvatures = calcCurvatures(single_traj_points);
+    const auto windowed_curvatures = calcCurvatures(windowed_traj_points);
+    const double max_single_curvature =
+      *std::max_element(single_curvatures.begin(), single_curvatures.end());
+    for (size_t i = 0; i < windowed_curvatures.size(); ++i) {
+      EXPECT_LE(windowed_curvatures.at(i), max_single_curvature + curvature_margin)
+        << "index: " << i + 1;
+    }
+  }
+  rclcpp::shutdown();
+}
+
+TEST(ElasticBand, DISABLED_benchmarkWindowedSmoothing)
+{
+  rclcpp::init(0, nullptr);
+  {
+    const auto node = createNode();
+    EBPathSmoother smoother(
+      node.get(), false, EgoNearestParam(node.get()), CommonParam(node.get()),
+      std::make_shared<TimeKeeper>());
+
+    const auto traj_points = generateNoisyTrajectoryPoints(1000);
+    const auto & ego_pose = traj_points.front().pose;
+
+    constexpr size_t iteration_num = 20;
+    std::cout << "num_points, single QP [ms], windowed [ms]" << std::endl;
+    for (const int num_points : {100, 200, 400, 800}) {
+      std::vector<double> times;
+      for (const bool enable_windowed_smoothing : {false, true}) {
+        smoother.onParam(createParameters(num_points, enable_windowed_smoothing));
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iteration_num; ++i) {
+          smoother.resetPreviousData();
+          smoother.smoothTrajectory(traj_points, ego_pose);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        times.push_back(
+          std::chrono::duration<double, std::milli>(end - start).count() / iteration_num);
+      }
+      std::cout << num_points << ", " << times.at(0) << ", " << times.at(1) << std::endl;
+    }
+  }
+  rclcpp::shutdown();
+}
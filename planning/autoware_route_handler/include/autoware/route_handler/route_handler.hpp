@@ -15,6 +15,7 @@
 #ifndef AUTOWARE__ROUTE_HANDLER__ROUTE_HANDLER_HPP_
 #define AUTOWARE__ROUTE_HANDLER__ROUTE_HANDLER_HPP_
 
+#include <autoware/universe_utils/system/lru_cache.hpp>
 #include <rclcpp/logger.hpp>
 
 #include <autoware_map_msgs/msg/lanelet_map_bin.hpp>
@@ -31,8 +32,13 @@
 #include <lanelet2_traffic_rules/TrafficRules.h>
 
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace autoware::route_handler
@@ -68,6 +74,12 @@ using Waypoints = std::vector<PiecewiseWaypoints>;
 class RouteHandler
 {
 public:
+  struct CacheStatistics
+  {
+    size_t hit_count{0};
+    size_t miss_count{0};
+  };
+
   RouteHandler() = default;
   explicit RouteHandler(const LaneletMapBin & map_msg);
 
@@ -326,7 +338,55 @@ public:
    */
   lanelet::ConstLanelets getShoulderLaneletsAtPose(const Pose & pose) const;
 
+  /**
+   * @brief Calculate the arc length along the route from the start of the first route section to
+   * the projection of the pose on the given route lanelet. The arc length of each route section is
+   * measured on its preferred lanelet and precomputed when the route is set, so only the given
+   * lanelet is traversed.
+   * @param lanelet route lanelet on which the pose is projected
+   * @param pose pose to project
+   * @return arc length on the route, or std::nullopt if the lanelet is not in the route message
+   */
+  std::optional<double> getArcLengthOnRoute(
+    const lanelet::ConstLanelet & lanelet, const Pose & pose) const;
+
+  /**
+   * @brief Get hit/miss counts of the memoized route queries (lanelet sequences, closest route
+   * lanelet and left/right lanelets) since the map or the route was last set.
+   */
+  CacheStatistics getCacheStatistics() const;
+
 private:
+  // Memoized results of the queries which only depend on the map and the route. A new instance is
+  // created whenever the map or the route lanelets change, so copies of the handler share it only
+  // while they hold the same route.
+  struct RouteCache
+  {
+    using SequenceKey = std::tuple<lanelet::Id, double, double, bool>;
+    using AdjacentKey = std::tuple<lanelet::Id, bool, bool>;
+    using PoseKey = std::tuple<double, double, double, double, double, double, double>;
+    static constexpr size_t capacity{256};
+
+    std::mutex mutex;
+    autoware::universe_utils::LRUCache<SequenceKey, lanelet::ConstLanelets, std::map> sequence{
+      capacity};
+    autoware::universe_utils::LRUCache<SequenceKey, lanelet::ConstLanelets, std::map>
+      sequence_after{capacity};
+    autoware::universe_utils::LRUCache<SequenceKey, lanelet::ConstLanelets, std::map>
+      sequence_up_to{capacity};
+    autoware::universe_utils::LRUCache<PoseKey, std::optional<lanelet::ConstLanelet>, std::map>
+      closest_lanelet{capacity};
+    autoware::universe_utils::LRUCache<AdjacentKey, std::optional<lanelet::ConstLanelet>, std::map>
+      left_lanelet{capacity};
+    autoware::universe_utils::LRUCache<AdjacentKey, std::optional<lanelet::ConstLanelet>, std::map>
+      right_lanelet{capacity};
+    CacheStatistics statistics;
+
+    // immutable after construction
+    std::unordered_set<lanelet::Id> route_lanelet_ids;
+    std::unordered_map<lanelet::Id, double> route_section_start_arc_lengths;
+  };
+
   // MUST
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
@@ -347,10 +407,15 @@ private:
   Pose original_start_pose_;
   Pose original_goal_pose_;
 
+  std::shared_ptr<RouteCache> cache_{std::make_shared<RouteCache>()};
+
   // non-const methods
   void setLaneletsFromRouteMsg();
+  void resetCache(const bool is_route_msg_applied);
 
   // const methods
+  bool isInRouteLanelets(const lanelet::ConstLanelet & lanelet) const;
+
   // for routing
   lanelet::ConstLanelets getMainLanelets(const lanelet::ConstLanelets & path_lanelets) const;
 
@@ -364,6 +429,21 @@ private:
     const lanelet::ConstLanelet & lanelet,
     const double min_length = std::numeric_limits<double>::max(),
     const bool only_route_lanes = true) const;
+  lanelet::ConstLanelets calcLaneletSequenceUpTo(
+    const lanelet::ConstLanelet & lanelet, const double min_length,
+    const bool only_route_lanes) const;
+  lanelet::ConstLanelets calcLaneletSequenceAfter(
+    const lanelet::ConstLanelet & lanelet, const double min_length,
+    const bool only_route_lanes) const;
+  lanelet::ConstLanelets calcLaneletSequence(
+    const lanelet::ConstLanelet & lanelet, const double backward_distance,
+    const double forward_distance, const bool only_route_lanes) const;
+  std::optional<lanelet::ConstLanelet> calcRightLanelet(
+    const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
+    const bool get_shoulder_lane) const;
+  std::optional<lanelet::ConstLanelet> calcLeftLanelet(
+    const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
+    const bool get_shoulder_lane) const;
   std::optional<lanelet::ConstLanelet> getFollowingShoulderLanelet(
     const lanelet::ConstLanelet & lanelet) const;
   lanelet::ConstLanelets getShoulderLaneletSequenceAfter(
@@ -174,6 +174,31 @@ lanelet::ArcCoordinates calcArcCoordinates(
     to2D(lanelet.centerline()),
     to2D(lanelet::utils::conversion::toLaneletPoint(point)).basicPoint());
 }
+
+/**
+ * @brief return the memoized value of the key, or compute and memoize it.
+ * The lock is not held while computing since the computation may call other memoized queries.
+ */
+template <class Cache, class LRU, class Key, class Compute>
+auto memoize(
+  Cache & cache, LRU & lru, const Key & key, const Compute & compute, const bool use_cache = true)
+{
+  if (!use_cache) {
+    return compute();
+  }
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (auto value = lru.get(key)) {
+      ++cache.statistics.hit_count;
+      return *value;
+    }
+    ++cache.statistics.miss_count;
+  }
+  const auto value = compute();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  lru.put(key, value);
+  return value;
+}
 }  // namespace
 
 RouteHandler::RouteHandler(const LaneletMapBin & map_msg)
@@ -215,6 +240,7 @@ void RouteHandler::setMap(const LaneletMapBin & map_msg)
   is_handler_ready_ = false;
 
   setLaneletsFromRouteMsg();
+  resetCache(true);
 }
 
 bool RouteHandler::isRouteLooped(const RouteSections & route_sections)
@@ -242,6 +268,7 @@ void RouteHandler::setRoute(const LaneletRoute & route_msg)
     route_ptr_ = std::make_shared<LaneletRoute>(route_msg);
     is_handler_ready_ = false;
     setLaneletsFromRouteMsg();
+    resetCache(true);
   } else {
     RCLCPP_ERROR(
       logger_,
@@ -352,6 +379,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
     route_lanelets_.push_back(lanelet_map_ptr_->laneletLayer.get(id));
   }
   is_handler_ready_ = true;
+  resetCache(false);
 }
 
 void RouteHandler::clearRoute()
@@ -362,6 +390,58 @@ void RouteHandler::clearRoute()
   goal_lanelets_.clear();
   route_ptr_ = nullptr;
   is_handler_ready_ = false;
+  resetCache(false);
+}
+
+void RouteHandler::resetCache(const bool is_route_msg_applied)
+{
+  auto cache = std::make_shared<RouteCache>();
+
+  cache->route_lanelet_ids.reserve(route_lanelets_.size());
+  for (const auto & llt : route_lanelets_) {
+    cache->route_lanelet_ids.insert(llt.id());
+  }
+
+  // arc length at the start of each route section, measured along the preferred lanelets.
+  // the route message does not correspond to the route lanelets set by setRouteLanelets()
+  if (is_route_msg_applied && route_ptr_ && is_handler_ready_) {
+    double section_start_arc_length = 0.0;
+    for (const auto & route_section : route_ptr_->segments) {
+      for (const auto & primitive : route_section.primitives) {
+        cache->route_section_start_arc_lengths.emplace(primitive.id, section_start_arc_length);
+      }
+      const auto & preferred_lanelet =
+        lanelet_map_ptr_->laneletLayer.get(route_section.preferred_primitive.id);
+      section_start_arc_length += static_cast<double>(
+        boost::geometry::length(preferred_lanelet.centerline2d().basicLineString()));
+    }
+  }
+
+  cache_ = cache;
+}
+
+bool RouteHandler::isInRouteLanelets(const lanelet::ConstLanelet & lanelet) const
+{
+  // equivalent to exists(route_lanelets_, lanelet) since route lanelets are never inverted
+  return !lanelet.inverted() && cache_->route_lanelet_ids.count(lanelet.id()) > 0;
+}
+
+std::optional<double> RouteHandler::getArcLengthOnRoute(
+  const lanelet::ConstLanelet & lanelet, const Pose & pose) const
+{
+  const auto & start_arc_lengths = cache_->route_section_start_arc_lengths;
+  const auto itr = start_arc_lengths.find(lanelet.id());
+  if (itr == start_arc_lengths.end()) {
+    return std::nullopt;
+  }
+  return itr->second + lanelet::utils::getArcCoordinates({lanelet}, pose).length;
+}
+
+RouteHandler::CacheStatistics RouteHandler::getCacheStatistics() const
+{
+  const auto cache = cache_;
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  return cache->statistics;
 }
 
 void RouteHandler::setLaneletsFromRouteMsg()
@@ -560,9 +640,20 @@ lanelet::ConstLanelets RouteHandler::getLaneChangeableNeighbors(
 
 lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
   const lanelet::ConstLanelet & lanelet, const double min_length, const bool only_route_lanes) const
+{
+  const auto cache = cache_;
+  const auto key = std::make_tuple(lanelet.id(), min_length, 0.0, only_route_lanes);
+  return memoize(
+    *cache, cache->sequence_after, key,
+    [&]() { return calcLaneletSequenceAfter(lanelet, min_length, only_route_lanes); },
+    !lanelet.inverted());
+}
+
+lanelet::ConstLanelets RouteHandler::calcLaneletSequenceAfter(
+  const lanelet::ConstLanelet & lanelet, const double min_length, const bool only_route_lanes) const
 {
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (only_route_lanes && !exists(route_lanelets_, lanelet)) {
+  if (only_route_lanes && !isInRouteLanelets(lanelet)) {
     return lanelet_sequence_forward;
   }
 
@@ -595,9 +686,20 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
 
 lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
   const lanelet::ConstLanelet & lanelet, const double min_length, const bool only_route_lanes) const
+{
+  const auto cache = cache_;
+  const auto key = std::make_tuple(lanelet.id(), min_length, 0.0, only_route_lanes);
+  return memoize(
+    *cache, cache->sequence_up_to, key,
+    [&]() { return calcLaneletSequenceUpTo(lanelet, min_length, only_route_lanes); },
+    !lanelet.inverted());
+}
+
+lanelet::ConstLanelets RouteHandler::calcLaneletSequenceUpTo(
+  const lanelet::ConstLanelet & lanelet, const double min_length, const bool only_route_lanes) const
 {
   lanelet::ConstLanelets lanelet_sequence_backward;
-  if (only_route_lanes && !exists(route_lanelets_, lanelet)) {
+  if (only_route_lanes && !isInRouteLanelets(lanelet)) {
     return lanelet_sequence_backward;
   }
 
@@ -654,6 +756,21 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
 lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   const lanelet::ConstLanelet & lanelet, const double backward_distance,
   const double forward_distance, const bool only_route_lanes) const
+{
+  const auto cache = cache_;
+  const auto key =
+    std::make_tuple(lanelet.id(), backward_distance, forward_distance, only_route_lanes);
+  return memoize(
+    *cache, cache->sequence, key,
+    [&]() {
+      return calcLaneletSequence(lanelet, backward_distance, forward_distance, only_route_lanes);
+    },
+    !lanelet.inverted());
+}
+
+lanelet::ConstLanelets RouteHandler::calcLaneletSequence(
+  const lanelet::ConstLanelet & lanelet, const double backward_distance,
+  const double forward_distance, const bool only_route_lanes) const
 {
   Pose current_pose{};
   current_pose.orientation.w = 1;
@@ -662,7 +779,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   }
 
   lanelet::ConstLanelets lanelet_sequence;
-  if (only_route_lanes && !exists(route_lanelets_, lanelet)) {
+  if (only_route_lanes && !isInRouteLanelets(lanelet)) {
     return lanelet_sequence;
   }
 
@@ -705,7 +822,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   const lanelet::ConstLanelet & lanelet, const Pose & current_pose, const double backward_distance,
   const double forward_distance, const bool only_route_lanes) const
 {
-  if (only_route_lanes && !exists(route_lanelets_, lanelet)) {
+  if (only_route_lanes && !isInRouteLanelets(lanelet)) {
     return {};
   }
 
@@ -905,7 +1022,23 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequence(
 bool RouteHandler::getClosestLaneletWithinRoute(
   const Pose & search_pose, lanelet::ConstLanelet * closest_lanelet) const
 {
-  return lanelet::utils::query::getClosestLanelet(route_lanelets_, search_pose, closest_lanelet);
+  const auto cache = cache_;
+  const auto & p = search_pose.position;
+  const auto & q = search_pose.orientation;
+  const auto key = std::make_tuple(p.x, p.y, p.z, q.x, q.y, q.z, q.w);
+  const auto result = memoize(
+    *cache, cache->closest_lanelet, key, [&]() -> std::optional<lanelet::ConstLanelet> {
+      lanelet::ConstLanelet closest;
+      if (!lanelet::utils::query::getClosestLanelet(route_lanelets_, search_pose, &closest)) {
+        return std::nullopt;
+      }
+      return closest;
+    });
+  if (!result) {
+    return false;
+  }
+  *closest_lanelet = *result;
+  return true;
 }
 
 bool RouteHandler::getClosestPreferredLaneletWithinRoute(
@@ -959,7 +1092,7 @@ bool RouteHandler::getNextLaneletsWithinRoute(
   const auto following_lanelets = routing_graph_ptr_->following(lanelet);
   next_lanelets->clear();
   for (const auto & llt : following_lanelets) {
-    if (start_lane_id != llt.id() && exists(route_lanelets_, llt)) {
+    if (start_lane_id != llt.id() && isInRouteLanelets(llt)) {
       next_lanelets->push_back(llt);
     }
   }
@@ -991,7 +1124,7 @@ bool RouteHandler::getPreviousLaneletsWithinRoute(
   const auto candidate_lanelets = routing_graph_ptr_->previous(lanelet);
   prev_lanelets->clear();
   for (const auto & llt : candidate_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (isInRouteLanelets(llt)) {
       prev_lanelets->push_back(llt);
     }
   }
@@ -1007,6 +1140,18 @@ lanelet::ConstLanelets RouteHandler::getPreviousLanelets(
 std::optional<lanelet::ConstLanelet> RouteHandler::getRightLanelet(
   const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
   const bool get_shoulder_lane) const
+{
+  const auto cache = cache_;
+  const auto key = std::make_tuple(lanelet.id(), enable_same_root, get_shoulder_lane);
+  return memoize(
+    *cache, cache->right_lanelet, key,
+    [&]() { return calcRightLanelet(lanelet, enable_same_root, get_shoulder_lane); },
+    !lanelet.inverted());
+}
+
+std::optional<lanelet::ConstLanelet> RouteHandler::calcRightLanelet(
+  const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
+  const bool get_shoulder_lane) const
 {
   // right road lanelet of shoulder lanelet
   if (isShoulderLanelet(lanelet)) {
@@ -1073,6 +1218,18 @@ std::optional<lanelet::ConstLanelet> RouteHandler::getRightLanelet(
 std::optional<lanelet::ConstLanelet> RouteHandler::getLeftLanelet(
   const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
   const bool get_shoulder_lane) const
+{
+  const auto cache = cache_;
+  const auto key = std::make_tuple(lanelet.id(), enable_same_root, get_shoulder_lane);
+  return memoize(
+    *cache, cache->left_lanelet, key,
+    [&]() { return calcLeftLanelet(lanelet, enable_same_root, get_shoulder_lane); },
+    !lanelet.inverted());
+}
+
+std::optional<lanelet::ConstLanelet> RouteHandler::calcLeftLanelet(
+  const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
+  const bool get_shoulder_lane) const
 {
   // left road lanelet of shoulder lanelet
   if (isShoulderLanelet(lanelet)) {
@@ -1844,7 +2001,7 @@ lanelet::ConstLanelets RouteHandler::getNeighborsWithinRoute(
     lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, lanelet);
   lanelet::ConstLanelets neighbors_within_route;
   for (const auto & llt : neighbor_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (isInRouteLanelets(llt)) {
       neighbors_within_route.push_back(llt);
     }
   }
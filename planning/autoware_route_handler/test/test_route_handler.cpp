@@ -314,4 +314,48 @@ TEST_F(TestRouteHandler, testGetShoulderLaneletsAtPose)
   shoulder_lanelets = route_handler_->getShoulderLaneletsAtPose(pose);
   ASSERT_TRUE(shoulder_lanelets.empty());
 }
+
+TEST_F(TestRouteHandler, checkCachedLaneletSequence)
+{
+  const auto lanelet = route_handler_->getLaneletsFromId(4775);
+  const auto initial_statistics = route_handler_->getCacheStatistics();
+
+  const auto lanelet_sequence = route_handler_->getLaneletSequence(lanelet);
+  const auto statistics_after_first_query = route_handler_->getCacheStatistics();
+  EXPECT_GT(statistics_after_first_query.miss_count, initial_statistics.miss_count);
+
+  const auto cached_lanelet_sequence = route_handler_->getLaneletSequence(lanelet);
+  const auto statistics_after_second_query = route_handler_->getCacheStatistics();
+  EXPECT_EQ(statistics_after_second_query.hit_count, statistics_after_first_query.hit_count + 1);
+  EXPECT_EQ(statistics_after_second_query.miss_count, statistics_after_first_query.miss_count);
+  ASSERT_EQ(cached_lanelet_sequence.size(), lanelet_sequence.size());
+  for (size_t i = 0; i < lanelet_sequence.size(); ++i) {
+    EXPECT_EQ(cached_lanelet_sequence.at(i).id(), lanelet_sequence.at(i).id());
+  }
+
+  // the cache is discarded when the route is set
+  set_test_route(lane_change_right_test_route_filename);
+  const auto statistics_after_set_route = route_handler_->getCacheStatistics();
+  EXPECT_EQ(statistics_after_set_route.hit_count, 0ul);
+  EXPECT_EQ(statistics_after_set_route.miss_count, 0ul);
+}
+
+TEST_F(TestRouteHandler, getArcLengthOnRoute)
+{
+  const auto pose_before = autoware::test_utils::createPose(-0.5, 1.75, 0.0, 0.0, 0.0, 0.0);
+  const auto pose_after = autoware::test_utils::createPose(0.5, 1.75, 0.0, 0.0, 0.0, 0.0);
+
+  const auto arc_length_before =
+    route_handler_->getArcLengthOnRoute(route_handler_->getLaneletsFromId(4775), pose_before);
+  const auto arc_length_after =
+    route_handler_->getArcLengthOnRoute(route_handler_->getLaneletsFromId(4424), pose_after);
+  ASSERT_TRUE(arc_length_before.has_value());
+  ASSERT_TRUE(arc_length_after.has_value());
+  EXPECT_GT(arc_length_after.value(), arc_length_before.value());
+
+  route_handler_->clearRoute();
+  const auto arc_length_without_route =
+    route_handler_->getArcLengthOnRoute(route_handler_->getLaneletsFromId(4775), pose_before);
+  EXPECT_FALSE(arc_length_without_route.has_value());
+}
 }  // namespace autoware::route_handler::test
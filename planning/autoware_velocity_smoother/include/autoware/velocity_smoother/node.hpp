@@ -272,12 +272,15 @@ private:
   rclcpp::Publisher<Trajectory>::SharedPtr pub_backward_filtered_trajectory_;
   rclcpp::Publisher<Trajectory>::SharedPtr pub_merged_filtered_trajectory_;
   rclcpp::Publisher<Float32Stamped>::SharedPtr pub_closest_merged_velocity_;
+  rclcpp::Publisher<Float64Stamped>::SharedPtr pub_qp_iteration_num_;
+  rclcpp::Publisher<Float64Stamped>::SharedPtr pub_qp_solve_time_;
 
   // helper functions
   size_t findNearestIndexFromEgo(const TrajectoryPoints & points) const;
   bool isReverse(const TrajectoryPoints & points) const;
   void flipVelocity(TrajectoryPoints & points) const;
   void publishStopWatchTime();
+  void publishSolverStatistics() const;
 
   std::unique_ptr<autoware::universe_utils::LoggerLevelConfigure> logger_configure_;
   std::unique_ptr<autoware::universe_utils::PublishedTimePublisher> published_time_publisher_;
@@ -19,13 +19,14 @@
 #include "autoware/universe_utils/geometry/geometry.hpp"
 #include "autoware/universe_utils/system/time_keeper.hpp"
 #include "autoware/velocity_smoother/smoother/smoother_base.hpp"
-#include "qp_interface/qp_interface.hpp"
+#include "qp_interface/proxqp_interface.hpp"
 
 #include "autoware_planning_msgs/msg/trajectory_point.hpp"
 
 #include "boost/optional.hpp"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace autoware::velocity_smoother
@@ -40,6 +41,17 @@ public:
     double over_a_weight;
     double over_j_weight;
     double jerk_filter_ds;
+    bool enable_warm_start;  // reuse the previous solution and the QP workspace
+    double skip_optimization_vel_tolerance;  // ego velocity change to skip the QP [m/s]
+    double skip_optimization_acc_tolerance;  // ego acceleration change to skip the QP [m/ss]
+  };
+
+  struct SolverStatistics
+  {
+    int iteration_num{0};
+    double solve_time_ms{0.0};
+    bool is_warm_started{false};
+    bool is_skipped{false};
   };
 
   explicit JerkFilteredSmoother(
@@ -57,10 +69,31 @@ public:
 
   void setParam(const Param & param);
   Param getParam() const;
+  SolverStatistics getSolverStatistics() const { return solver_statistics_; }
+
+protected:
+  // initial guess of the QP variables from the previous solution shifted to the current start point
+  std::vector<double> calcShiftedInitialGuess(
+    const TrajectoryPoints & opt_resampled_trajectory, const size_t N) const;
 
 private:
+  // previous optimization result used for the warm start and the skip of the optimization
+  struct PreviousSolution
+  {
+    size_t input_hash{0};
+    double v0{0.0};
+    double a0{0.0};
+    TrajectoryPoints output;
+    std::vector<TrajectoryPoints> debug_trajectories;
+    std::vector<double> arclength;
+    std::vector<double> velocity_squared;
+    std::vector<double> acceleration;
+  };
+
   Param smoother_param_;
-  std::shared_ptr<autoware::common::QPInterface> qp_interface_;
+  std::shared_ptr<autoware::common::ProxQPInterface> qp_interface_;
+  std::optional<PreviousSolution> prev_solution_{std::nullopt};
+  SolverStatistics solver_statistics_;
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("jerk_filtered_smoother")};
 
   TrajectoryPoints forwardJerkFilter(
@@ -72,6 +105,7 @@ private:
   TrajectoryPoints mergeFilteredTrajectory(
     const double v0, const double a0, const double a_min, const double j_min,
     const TrajectoryPoints & forward_filtered, const TrajectoryPoints & backward_filtered) const;
+  bool canSkipOptimization(const size_t input_hash, const double v0, const double a0) const;
 };
 }  // namespace autoware::velocity_smoother
 
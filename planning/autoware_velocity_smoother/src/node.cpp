@@ -117,6 +117,10 @@ void VelocitySmootherNode::setupSmoother(const double wheelbase)
         create_publisher<Trajectory>("~/debug/merged_filtered_trajectory", 1);
       pub_closest_merged_velocity_ =
         create_publisher<Float32Stamped>("~/closest_merged_velocity", 1);
+      pub_qp_iteration_num_ =
+        create_publisher<Float64Stamped>("~/debug/jerk_filtered/qp_iteration_num", 1);
+      pub_qp_solve_time_ =
+        create_publisher<Float64Stamped>("~/debug/jerk_filtered/qp_solve_time_ms", 1);
       break;
     }
     case AlgorithmType::L2: {
@@ -219,6 +223,9 @@ rcl_interfaces::msg::SetParametersResult VelocitySmootherNode::onParameter(
       update_param("over_a_weight", p.over_a_weight);
       update_param("over_j_weight", p.over_j_weight);
       update_param("jerk_filter_ds", p.jerk_filter_ds);
+      update_param_bool("enable_warm_start", p.enable_warm_start);
+      update_param("skip_optimization_vel_tolerance", p.skip_optimization_vel_tolerance);
+      update_param("skip_optimization_acc_tolerance", p.skip_optimization_acc_tolerance);
       std::dynamic_pointer_cast<JerkFilteredSmoother>(smoother_)->setParam(p);
       break;
     }
@@ -633,6 +640,7 @@ bool VelocitySmootherNode::smoothVelocity(
         publish_debug_trajs_)) {
     RCLCPP_WARN(get_logger(), "Fail to solve optimization.");
   }
+  publishSolverStatistics();
 
   // Set 0 velocity after input-stop-point
   overwriteStopPoint(clipped, traj_smoothed);
@@ -1095,6 +1103,27 @@ void VelocitySmootherNode::publishStopWatchTime()
   debug_calculation_time_->publish(calculation_time_data);
 }
 
+void VelocitySmootherNode::publishSolverStatistics() const
+{
+  const auto jerk_filtered_smoother = std::dynamic_pointer_cast<JerkFilteredSmoother>(smoother_);
+  if (!jerk_filtered_smoother) {
+    return;
+  }
+
+  const auto statistics = jerk_filtered_smoother->getSolverStatistics();
+  const auto stamp = this->now();
+
+  Float64Stamped iteration_num_data{};
+  iteration_num_data.stamp = stamp;
+  iteration_num_data.data = static_cast<double>(statistics.iteration_num);
+  pub_qp_iteration_num_->publish(iteration_num_data);
+
+  Float64Stamped solve_time_data{};
+  solve_time_data.stamp = stamp;
+  solve_time_data.data = statistics.solve_time_ms;
+  pub_qp_solve_time_->publish(solve_time_data);
+}
+
 TrajectoryPoint VelocitySmootherNode::calcProjectedTrajectoryPoint(
   const TrajectoryPoints & trajectory, const Pose & pose) const
 {
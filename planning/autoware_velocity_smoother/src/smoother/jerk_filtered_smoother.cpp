@@ -15,13 +15,15 @@
 #include "autoware/velocity_smoother/smoother/jerk_filtered_smoother.hpp"
 
 #include "autoware/velocity_smoother/trajectory_utils.hpp"
-#include "qp_interface/proxqp_interface.hpp"
+#include "interpolation/interpolation_utils.hpp"
+#include "interpolation/linear_interpolation.hpp"
 
 #include <Eigen/Core>
 
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <numeric>
 #include <vector>
@@ -30,6 +32,25 @@
 
 namespace autoware::velocity_smoother
 {
+namespace
+{
+size_t calcTrajectoryHash(const TrajectoryPoints & points)
+{
+  size_t seed = points.size();
+  const auto hash_combine = [&seed](const double value) {
+    seed ^= std::hash<double>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  };
+  for (const auto & p : points) {
+    hash_combine(p.pose.position.x);
+    hash_combine(p.pose.position.y);
+    hash_combine(p.pose.orientation.z);
+    hash_combine(p.pose.orientation.w);
+    hash_combine(p.longitudinal_velocity_mps);
+  }
+  return seed;
+}
+}  // namespace
+
 JerkFilteredSmoother::JerkFilteredSmoother(
   rclcpp::Node & node, const std::shared_ptr<autoware::universe_utils::TimeKeeper> time_keeper)
 : SmootherBase(node, time_keeper)
@@ -40,14 +61,25 @@ JerkFilteredSmoother::JerkFilteredSmoother(
   p.over_a_weight = node.declare_parameter<double>("over_a_weight");
   p.over_j_weight = node.declare_parameter<double>("over_j_weight");
   p.jerk_filter_ds = node.declare_parameter<double>("jerk_filter_ds");
-
-  qp_interface_ =
-    std::make_shared<autoware::common::ProxQPInterface>(false, 20000, 1.0e-8, 1.0e-6, false);
+  p.enable_warm_start = node.declare_parameter<bool>("enable_warm_start");
+  p.skip_optimization_vel_tolerance =
+    node.declare_parameter<double>("skip_optimization_vel_tolerance");
+  p.skip_optimization_acc_tolerance =
+    node.declare_parameter<double>("skip_optimization_acc_tolerance");
+
+  qp_interface_ = std::make_shared<autoware::common::ProxQPInterface>(
+    p.enable_warm_start, 20000, 1.0e-8, 1.0e-6, false);
 }
 
 void JerkFilteredSmoother::setParam(const Param & smoother_param)
 {
+  if (smoother_param.enable_warm_start != smoother_param_.enable_warm_start) {
+    qp_interface_ = std::make_shared<autoware::common::ProxQPInterface>(
+      smoother_param.enable_warm_start, 20000, 1.0e-8, 1.0e-6, false);
+  }
   smoother_param_ = smoother_param;
+  // NOTE: the weights may have changed, so the previous solution cannot be reused as it is.
+  prev_solution_ = std::nullopt;
 }
 
 JerkFilteredSmoother::Param JerkFilteredSmoother::getParam() const
@@ -62,9 +94,11 @@ bool JerkFilteredSmoother::apply(
   autoware::universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
 
   output = input;
+  solver_statistics_ = SolverStatistics{};
 
   if (input.empty()) {
     RCLCPP_WARN(logger_, "Input TrajectoryPoints to the jerk filtered optimization is empty.");
+    prev_solution_ = std::nullopt;
     return false;
   }
 
@@ -79,6 +113,17 @@ bool JerkFilteredSmoother::apply(
     return true;
   }
 
+  // skip the optimization when neither the input trajectory nor the ego state has changed.
+  const size_t input_hash = calcTrajectoryHash(input);
+  if (canSkipOptimization(input_hash, v0, a0)) {
+    output = prev_solution_->output;
+    if (publish_debug_trajs) {
+      debug_trajectories = prev_solution_->debug_trajectories;
+    }
+    solver_statistics_.is_skipped = true;
+    return true;
+  }
+
   const auto ts = std::chrono::system_clock::now();
 
   const double a_max = base_param_.max_accel;
@@ -145,6 +190,7 @@ bool JerkFilteredSmoother::apply(
 
   if (!zero_vel_id) {
     RCLCPP_WARN(logger_, "opt_resampled_trajectory must have stop point.");
+    prev_solution_ = std::nullopt;
     return false;
   }
 
@@ -302,12 +348,26 @@ bool JerkFilteredSmoother::apply(
   }
   time_keeper_->end_track("initOptimization");
 
+  // warm start with the previous solution shifted to the current start point
+  if (smoother_param_.enable_warm_start && prev_solution_) {
+    qp_interface_->setPrimalInitialGuess(calcShiftedInitialGuess(opt_resampled_trajectory, N));
+    solver_statistics_.is_warm_started = true;
+  }
+
   // execute optimization
   time_keeper_->start_track("optimize");
+  const auto ts_optimize = std::chrono::system_clock::now();
   const auto optval = qp_interface_->optimize(P, A, q, lower_bound, upper_bound);
+  solver_statistics_.solve_time_ms =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now() - ts_optimize)
+      .count() *
+    1.0e-6;
+  solver_statistics_.iteration_num = qp_interface_->getIterationNumber();
   time_keeper_->end_track("optimize");
   if (!qp_interface_->isSolved()) {
     RCLCPP_WARN(logger_, "optimization failed : %s", qp_interface_->getStatus().c_str());
+    prev_solution_ = std::nullopt;
     return false;
   }
 
@@ -315,13 +375,16 @@ bool JerkFilteredSmoother::apply(
     std::any_of(optval.begin(), optval.end(), [](const auto v) { return std::isnan(v); });
   if (has_nan) {
     RCLCPP_WARN(logger_, "optimization failed: result contains NaN values");
+    prev_solution_ = std::nullopt;
     return false;
   }
 
   const auto tf1 = std::chrono::system_clock::now();
   const double dt_ms1 =
     std::chrono::duration_cast<std::chrono::nanoseconds>(tf1 - ts).count() * 1.0e-6;
-  RCLCPP_DEBUG(logger_, "optimization time = %f [ms]", dt_ms1);
+  RCLCPP_DEBUG(
+    logger_, "optimization time = %f [ms], iteration = %d, warm start = %d", dt_ms1,
+    solver_statistics_.iteration_num, solver_statistics_.is_warm_started);
 
   // get velocity & acceleration
   for (size_t i = 0; i < N; ++i) {
@@ -334,6 +397,23 @@ bool JerkFilteredSmoother::apply(
     output.at(i).acceleration_mps2 = a_stop_decel;
   }
 
+  // keep the result for the warm start and the skip of the next optimization
+  {
+    PreviousSolution prev_solution;
+    prev_solution.input_hash = input_hash;
+    prev_solution.v0 = v0;
+    prev_solution.a0 = a0;
+    prev_solution.output = output;
+    if (publish_debug_trajs) {
+      prev_solution.debug_trajectories = debug_trajectories;
+    }
+    prev_solution.arclength = trajectory_utils::calcArclengthArray(output);
+    prev_solution.arclength.resize(N);
+    prev_solution.velocity_squared.assign(optval.begin() + IDX_B0, optval.begin() + IDX_B0 + N);
+    prev_solution.acceleration.assign(optval.begin() + IDX_A0, optval.begin() + IDX_A0 + N);
+    prev_solution_ = std::move(prev_solution);
+  }
+
   if (VERBOSE_TRAJECTORY_VELOCITY) {
     const auto s_output = trajectory_utils::calcArclengthArray(output);
 
@@ -478,6 +558,50 @@ TrajectoryPoints JerkFilteredSmoother::mergeFilteredTrajectory(
   return merged;
 }
 
+bool JerkFilteredSmoother::canSkipOptimization(
+  const size_t input_hash, const double v0, const double a0) const
+{
+  if (!smoother_param_.enable_warm_start || !prev_solution_) {
+    return false;
+  }
+  return prev_solution_->input_hash == input_hash &&
+         std::abs(prev_solution_->v0 - v0) < smoother_param_.skip_optimization_vel_tolerance &&
+         std::abs(prev_solution_->a0 - a0) < smoother_param_.skip_optimization_acc_tolerance;
+}
+
+std::vector<double> JerkFilteredSmoother::calcShiftedInitialGuess(
+  const TrajectoryPoints & opt_resampled_trajectory, const size_t N) const
+{
+  autoware::universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
+
+  // x = [b, a, delta, sigma, gamma]. The slack variables are initialized with zero.
+  std::vector<double> initial_guess(5 * N, 0.0);
+
+  const auto & prev = *prev_solution_;
+  if (prev.arclength.size() < 2 || !interpolation_utils::isIncreasing(prev.arclength)) {
+    return initial_guess;
+  }
+
+  // arc length of the current start point on the previous solution
+  const double offset = autoware::motion_utils::calcSignedArcLength(
+    prev.output, prev.output.front().pose.position,
+    opt_resampled_trajectory.front().pose.position);
+
+  const auto arclength = trajectory_utils::calcArclengthArray(opt_resampled_trajectory);
+  std::vector<double> query_keys(N);
+  for (size_t i = 0; i < N; ++i) {
+    query_keys.at(i) =
+      std::clamp(arclength.at(i) + offset, prev.arclength.front(), prev.arclength.back());
+  }
+
+  const auto b = interpolation::lerp(prev.arclength, prev.velocity_squared, query_keys);
+  const auto a = interpolation::lerp(prev.arclength, prev.acceleration, query_keys);
+  std::copy(b.begin(), b.end(), initial_guess.begin());
+  std::copy(a.begin(), a.end(), initial_guess.begin() + N);
+
+  return initial_guess;
+}
+
 TrajectoryPoints JerkFilteredSmoother::resampleTrajectory(
   const TrajectoryPoints & input, [[maybe_unused]] const double v0,
   const geometry_msgs::msg::Pose & current_pose, const double nearest_dist_threshold,
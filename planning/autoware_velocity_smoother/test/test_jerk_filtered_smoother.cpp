@@ -0,0 +1,218 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/velocity_smoother/smoother/jerk_filtered_smoother.hpp"
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using autoware::velocity_smoother::JerkFilteredSmoother;
+using autoware::velocity_smoother::TrajectoryPoints;
+using autoware_planning_msgs::msg::TrajectoryPoint;
+
+namespace
+{
+// the solver stops at the residual of 1e-8, which leaves a much smaller difference than this
+constexpr double solution_tolerance = 1.0e-3;
+
+// exposes the initial guess of the warm start
+class JerkFilteredSmootherWithInitialGuess : public JerkFilteredSmoother
+{
+public:
+  using JerkFilteredSmoother::calcShiftedInitialGuess;
+  using JerkFilteredSmoother::JerkFilteredSmoother;
+};
+
+std::shared_ptr<rclcpp::Node> createNode(const std::string & name, const bool enable_warm_start)
+{
+  const auto velocity_smoother_dir =
+    ament_index_cpp::get_package_share_directory("autoware_velocity_smoother");
+  auto node_options = rclcpp::NodeOptions{};
+  node_options.append_parameter_override("enable_warm_start", enable_warm_start);
+  node_options.arguments(
+    {"--ros-args", "--params-file",
+     velocity_smoother_dir + "/config/default_velocity_smoother.param.yaml", "--params-file",
+     velocity_smoother_dir + "/config/default_common.param.yaml", "--params-file",
+     velocity_smoother_dir + "/config/JerkFiltered.param.yaml"});
+  return std::make_shared<rclcpp::Node>(name, node_options);
+}
+
+// straight trajectory which stops only at the last point
+TrajectoryPoints genStraightTrajectory(const size_t size, const double velocity)
+{
+  TrajectoryPoints tps;
+  TrajectoryPoint p;
+  p.pose.orientation.w = 1.0;
+  p.longitudinal_velocity_mps = velocity;
+  for (size_t i = 0; i < size; ++i) {
+    p.pose.position.x = static_cast<double>(i);
+    tps.push_back(p);
+  }
+  tps.back().longitudinal_velocity_mps = 0.0;
+  return tps;
+}
+
+void expectSameTrajectory(
+  const TrajectoryPoints & actual, const TrajectoryPoints & expected, const double tolerance)
+{
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(
+      actual.at(i).longitudinal_velocity_mps, expected.at(i).longitudinal_velocity_mps, tolerance)
+      << "i = " << i;
+    EXPECT_NEAR(actual.at(i).acceleration_mps2, expected.at(i).acceleration_mps2, tolerance)
+      << "i = " << i;
+  }
+}
+}  // namespace
+
+class TestJerkFilteredSmoother : public ::testing::Test
+{
+protected:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+  void TearDown() override { rclcpp::shutdown(); }
+
+  std::shared_ptr<autoware::universe_utils::TimeKeeper> time_keeper_{
+    std::make_shared<autoware::universe_utils::TimeKeeper>()};
+  std::vector<TrajectoryPoints> debug_trajectories_;
+};
+
+TEST_F(TestJerkFilteredSmoother, SkipOptimizationWithSameInput)
+{
+  const auto node = createNode("test_jerk_filtered_smoother", true);
+  JerkFilteredSmoother smoother(*node, time_keeper_);
+  const auto input = genStraightTrajectory(100, 10.0);
+
+  TrajectoryPoints first_output;
+  ASSERT_TRUE(smoother.apply(5.0, 0.0, input, first_output, debug_trajectories_, false));
+  EXPECT_FALSE(smoother.getSolverStatistics().is_skipped);
+  EXPECT_FALSE(smoother.getSolverStatistics().is_warm_started);
+
+  TrajectoryPoints second_output;
+  ASSERT_TRUE(smoother.apply(5.0, 0.0, input, second_output, debug_trajectories_, false));
+  EXPECT_TRUE(smoother.getSolverStatistics().is_skipped);
+  EXPECT_EQ(second_output, first_output);
+}
+
+TEST_F(TestJerkFilteredSmoother, SolveAgainWithChangedVelocity)
+{
+  const auto node = createNode("test_jerk_filtered_smoother", true);
+  JerkFilteredSmoother smoother(*node, time_keeper_);
+  const auto input = genStraightTrajectory(100, 10.0);
+  const double v0 = 5.0;
+  const double dv = 10.0 * smoother.getParam().skip_optimization_vel_tolerance;
+
+  TrajectoryPoints output;
+  ASSERT_TRUE(smoother.apply(v0, 0.0, input, output, debug_trajectories_, false));
+  ASSERT_TRUE(smoother.apply(v0 + dv, 0.0, input, output, debug_trajectories_, false));
+  EXPECT_FALSE(smoother.getSolverStatistics().is_skipped);
+  EXPECT_TRUE(smoother.getSolverStatistics().is_warm_started);
+  EXPECT_NEAR(output.front().longitudinal_velocity_mps, v0 + dv, solution_tolerance);
+}
+
+TEST_F(TestJerkFilteredSmoother, SetParamClearsPreviousSolution)
+{
+  const auto node = createNode("test_jerk_filtered_smoother", true);
+  JerkFilteredSmoother smoother(*node, time_keeper_);
+  const auto input = genStraightTrajectory(100, 10.0);
+
+  TrajectoryPoints output;
+  ASSERT_TRUE(smoother.apply(5.0, 0.0, input, output, debug_trajectories_, false));
+  smoother.setParam(smoother.getParam());
+  ASSERT_TRUE(smoother.apply(5.0, 0.0, input, output, debug_trajectories_, false));
+  EXPECT_FALSE(smoother.getSolverStatistics().is_skipped);
+  EXPECT_FALSE(smoother.getSolverStatistics().is_warm_started);
+}
+
+TEST_F(TestJerkFilteredSmoother, NoSkipWithoutWarmStart)
+{
+  const auto node = createNode("test_jerk_filtered_smoother", false);
+  JerkFilteredSmoother smoother(*node, time_keeper_);
+  const auto input = genStraightTrajectory(100, 10.0);
+
+  TrajectoryPoints output;
+  ASSERT_TRUE(smoother.apply(5.0, 0.0, input, output, debug_trajectories_, false));
+  ASSERT_TRUE(smoother.apply(5.0, 0.0, input, output, debug_trajectories_, false));
+  EXPECT_FALSE(smoother.getSolverStatistics().is_skipped);
+  EXPECT_FALSE(smoother.getSolverStatistics().is_warm_started);
+}
+
+TEST_F(TestJerkFilteredSmoother, ShiftedInitialGuess)
+{
+  const auto node = createNode("test_jerk_filtered_smoother", true);
+  JerkFilteredSmootherWithInitialGuess smoother(*node, time_keeper_);
+  const auto input = genStraightTrajectory(100, 10.0);
+
+  TrajectoryPoints prev_output;
+  ASSERT_TRUE(smoother.apply(5.0, 0.0, input, prev_output, debug_trajectories_, false));
+  // NOTE: only the last point of the input stops, so that all the points of the previous output are
+  // the variables of the previous solution.
+
+  // the current start point is on a point of the previous solution
+  for (const size_t start_idx : {size_t{0}, size_t{1}, size_t{5}, prev_output.size() / 2}) {
+    const TrajectoryPoints resampled(prev_output.begin() + start_idx, prev_output.end());
+    const size_t N = resampled.size();
+    const auto initial_guess = smoother.calcShiftedInitialGuess(resampled, N);
+
+    ASSERT_EQ(initial_guess.size(), 5 * N);
+    for (size_t i = 0; i < N; ++i) {
+      const auto & prev_point = prev_output.at(start_idx + i);
+      // the output velocity is the square root of the clipped velocity squared
+      EXPECT_NEAR(
+        std::sqrt(std::max(initial_guess.at(i), 0.0)), prev_point.longitudinal_velocity_mps, 1e-6)
+        << "start_idx = " << start_idx << ", i = " << i;
+      EXPECT_NEAR(initial_guess.at(N + i), prev_point.acceleration_mps2, 1e-6)
+        << "start_idx = " << start_idx << ", i = " << i;
+    }
+    // the slack variables are zero
+    EXPECT_TRUE(std::all_of(
+      initial_guess.begin() + 2 * N, initial_guess.end(), [](const auto v) { return v == 0.0; }));
+  }
+}
+
+TEST_F(TestJerkFilteredSmoother, WarmStartSameResultAsColdStart)
+{
+  const auto warm_node = createNode("test_jerk_filtered_smoother_warm", true);
+  const auto cold_node = createNode("test_jerk_filtered_smoother_cold", false);
+  JerkFilteredSmoother warm_smoother(*warm_node, time_keeper_);
+  JerkFilteredSmoother cold_smoother(*cold_node, time_keeper_);
+
+  const auto input = genStraightTrajectory(100, 10.0);
+  TrajectoryPoints warm_output;
+  TrajectoryPoints cold_output;
+  ASSERT_TRUE(warm_smoother.apply(5.0, 0.0, input, warm_output, debug_trajectories_, false));
+
+  // the ego moves forward and accelerates
+  auto shifted_input = genStraightTrajectory(100, 10.0);
+  for (auto & p : shifted_input) {
+    p.pose.position.x += 0.5;
+  }
+  for (const auto & [v0, a0] : {std::make_pair(5.5, 0.3), std::make_pair(6.0, 0.5)}) {
+    ASSERT_TRUE(
+      warm_smoother.apply(v0, a0, shifted_input, warm_output, debug_trajectories_, false));
+    ASSERT_TRUE(warm_smoother.getSolverStatistics().is_warm_started);
+    ASSERT_TRUE(
+      cold_smoother.apply(v0, a0, shifted_input, cold_output, debug_trajectories_, false));
+    expectSameTrajectory(warm_output, cold_output, solution_tolerance);
+  }
+}
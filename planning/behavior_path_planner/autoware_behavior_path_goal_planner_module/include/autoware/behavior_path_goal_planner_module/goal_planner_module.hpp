@@ -428,6 +428,8 @@ private:
   private:
     void initializeOccupancyGridMap(
       const PlannerData & planner_data, const GoalPlannerParameters & parameters);
+    // occupancy grid which occupancy_grid_map is built from
+    OccupancyGrid::ConstSharedPtr occupancy_grid_of_map{nullptr};
   };
   std::optional<GoalPlannerData> gp_planner_data_{std::nullopt};
   std::mutex gp_planner_data_mutex_;
@@ -647,6 +649,14 @@ private:
   void onTimer();
   void onFreespaceParkingTimer();
 
+  // plan the paths for the pairs of planner index and goal candidate with `thread_num` threads and
+  // return the successful ones in the order of the pairs
+  std::vector<PullOverPath> planPullOverPathCandidates(
+    const std::vector<std::pair<size_t, GoalCandidate>> & planner_and_goal_pairs,
+    const std::shared_ptr<const PlannerData> & planner_data,
+    const BehaviorModuleOutput & previous_module_output,
+    const lanelet::ConstLanelets & current_lanes, const int thread_num);
+
   // steering factor
   void updateSteeringFactor(
     const std::array<Pose, 2> & pose, const std::array<double, 2> distance, const uint16_t type);
@@ -19,6 +19,8 @@
 #include "autoware/behavior_path_planner_common/utils/occupancy_grid_based_collision_detector/occupancy_grid_based_collision_detector.hpp"
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace autoware::behavior_path_planner
@@ -56,19 +58,45 @@ private:
   void createAreaPolygons(
     std::vector<Pose> original_search_poses,
     const std::shared_ptr<const PlannerData> & planner_data);
-  bool checkCollision(
-    const Pose & pose, const PredictedObjects & objects,
+  bool checkCollision(const Pose & pose, const PredictedObjects & objects) const;
+  bool checkOccupancyGridCollision(
+    const Pose & pose,
     const std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map) const;
   bool checkCollisionWithLongitudinalDistance(
     const Pose & ego_pose, const PredictedObjects & objects,
     const std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map,
     const std::shared_ptr<const PlannerData> & planner_data) const;
+  bool checkCollisionWithLongitudinalDistance(
+    const Pose & ego_pose, const PredictedObjects & objects,
+    const std::shared_ptr<const PlannerData> & planner_data) const;
+  bool checkOccupancyGridCollisionWithLongitudinalDistance(
+    const Pose & ego_pose,
+    const std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map) const;
   BasicPolygons2d getNoParkingAreaPolygons(const lanelet::ConstLanelets & lanes) const;
   BasicPolygons2d getNoStoppingAreaPolygons(const lanelet::ConstLanelets & lanes) const;
   bool isInAreas(const LinearRing2d & footprint, const BasicPolygons2d & areas) const;
 
+  // results of the occupancy grid collision checks of a goal candidate, which depend only on the
+  // goal pose and the occupancy grid
+  struct OccupancyGridCollision
+  {
+    Pose goal_pose{};
+    bool is_footprint_colliding{false};
+    bool is_longitudinal_margin_colliding{false};
+  };
+  OccupancyGridCollision getOccupancyGridCollision(
+    const GoalCandidate & goal_candidate,
+    const std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map) const;
+
   LinearRing2d vehicle_footprint_{};
   bool left_side_parking_{true};
+
+  // The occupancy grid collision checks of the goal candidates are cached across the cycles. The
+  // collision detector is re-created for every new occupancy grid, so the cache is cleared when
+  // the detector changes.
+  mutable std::mutex occupancy_grid_collision_cache_mutex_;
+  mutable std::weak_ptr<OccupancyGridBasedCollisionDetector> cached_occupancy_grid_map_{};
+  mutable std::unordered_map<size_t, OccupancyGridCollision> occupancy_grid_collision_cache_{};
 };
 }  // namespace autoware::behavior_path_planner
 
@@ -45,6 +45,10 @@ public:
   std::optional<PullOverPath> plan(
     const std::shared_ptr<const PlannerData> planner_data,
     const BehaviorModuleOutput & previous_module_output, const Pose & goal_pose) override;
+  std::shared_ptr<PullOverPlannerBase> clone() const override
+  {
+    return std::make_shared<GeometricPullOver>(*this);
+  }
 
   std::vector<PullOverPath> generatePullOverPaths(
     const lanelet::ConstLanelets & road_lanes, const lanelet::ConstLanelets & shoulder_lanes,
@@ -189,6 +189,12 @@ public:
     const std::shared_ptr<const PlannerData> planner_data,
     const BehaviorModuleOutput & previous_module_output, const Pose & goal_pose) = 0;
 
+  /**
+   * @brief create a copy of this planner so that candidate paths can be planned concurrently
+   * @return copy of this planner, or nullptr if the planner can not be copied
+   */
+  virtual std::shared_ptr<PullOverPlannerBase> clone() const { return nullptr; }
+
 protected:
   const autoware::vehicle_info_utils::VehicleInfo vehicle_info_;
   const LinearRing2d vehicle_footprint_;
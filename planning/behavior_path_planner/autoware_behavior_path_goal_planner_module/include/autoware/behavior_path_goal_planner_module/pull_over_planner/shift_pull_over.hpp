@@ -38,6 +38,10 @@ public:
   std::optional<PullOverPath> plan(
     const std::shared_ptr<const PlannerData> planner_data,
     const BehaviorModuleOutput & previous_module_output, const Pose & goal_pose) override;
+  std::shared_ptr<PullOverPlannerBase> clone() const override
+  {
+    return std::make_shared<ShiftPullOver>(*this);
+  }
 
 protected:
   PathWithLaneId generateReferencePath(
@@ -30,9 +30,12 @@
 
 #include <lanelet2_core/Forward.h>
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace autoware::behavior_path_planner::goal_planner_utils
@@ -137,6 +140,23 @@ std::string makePathPriorityDebugMessage(
   const std::map<size_t, double> & path_id_to_rough_margin_map,
   const std::function<bool(const PullOverPath &)> & isSoftMargin,
   const std::function<bool(const PullOverPath &)> & isHighCurvature);
+
+/**
+ * @brief plan the pull over paths for the pairs of planner index and goal candidate with
+ * `thread_num` threads. The planners are not thread-safe, so the other threads than the calling
+ * one use their clones, and all the pairs are planned by the calling thread if the planners can
+ * not be cloned.
+ * @param on_best_path_found called once from the calling thread as soon as the pairs up to the
+ * first successful one are all planned, with the results and the number of the planned pairs.
+ * @return paths of the pairs in the same order, std::nullopt for the failed ones
+ */
+std::vector<std::optional<PullOverPath>> planPullOverPaths(
+  const std::vector<std::shared_ptr<PullOverPlannerBase>> & pull_over_planners,
+  const std::vector<std::pair<size_t, GoalCandidate>> & planner_and_goal_pairs,
+  const std::shared_ptr<const PlannerData> & planner_data,
+  const BehaviorModuleOutput & previous_module_output, const int thread_num,
+  const std::function<void(const std::vector<std::optional<PullOverPath>> &, const size_t)> &
+    on_best_path_found = nullptr);
 }  // namespace autoware::behavior_path_planner::goal_planner_utils
 
 #endif  // AUTOWARE__BEHAVIOR_PATH_GOAL_PLANNER_MODULE__UTIL_HPP_
@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -301,32 +302,6 @@ void GoalPlannerModule::onTimer()
     local_planner_data, parameters.backward_goal_search_length,
     parameters.forward_goal_search_length,
     /*forward_only_in_route*/ false);
-  std::vector<PullOverPath> path_candidates{};
-  std::optional<Pose> closest_start_pose{};
-  double min_start_arc_length = std::numeric_limits<double>::max();
-  const auto planCandidatePaths = [&](
-                                    const std::shared_ptr<PullOverPlannerBase> & planner,
-                                    const GoalCandidate & goal_candidate) {
-    auto pull_over_path =
-      planner->plan(local_planner_data, previous_module_output, goal_candidate.goal_pose);
-    if (pull_over_path && pull_over_path->getParkingPath().points.size() >= 3) {
-      pull_over_path->goal_id = goal_candidate.id;
-      pull_over_path->id = path_candidates.size();
-
-      // calculate absolute maximum curvature of parking path(start pose to end pose) for path
-      // priority
-      path_candidates.push_back(*pull_over_path);
-      // calculate closest pull over start pose for stop path
-      const double start_arc_length =
-        lanelet::utils::getArcCoordinates(current_lanes, pull_over_path->start_pose).length;
-      if (start_arc_length < min_start_arc_length) {
-        min_start_arc_length = start_arc_length;
-        // closest start pose is stop point when not finding safe path
-        closest_start_pose = pull_over_path->start_pose;
-      }
-    }
-  };
-
   // todo: currently non centerline input path is supported only by shift pull over
   const bool is_center_line_input_path = goal_planner_utils::isReferencePath(
     previous_module_output.reference_path, previous_module_output.path, 0.1);
@@ -334,25 +309,29 @@ void GoalPlannerModule::onTimer()
     getLogger(), "the input path of pull over planner is center line: %d",
     is_center_line_input_path);
 
-  // plan candidate paths and set them to the member variable
+  // list the pairs of planner and goal candidate in the order of priority
+  std::vector<std::pair<size_t, GoalCandidate>> planner_and_goal_pairs{};
+  const auto isPlannable = [&](const size_t planner_idx) {
+    // todo: temporary skip NON SHIFT planner when input path is not center line
+    return is_center_line_input_path ||
+           pull_over_planners_.at(planner_idx)->getPlannerType() == PullOverPlannerType::SHIFT;
+  };
   if (parameters.path_priority == "efficient_path") {
-    for (const auto & planner : pull_over_planners_) {
-      // todo: temporary skip NON SHIFT planner when input path is not center line
-      if (!is_center_line_input_path && planner->getPlannerType() != PullOverPlannerType::SHIFT) {
+    for (size_t planner_idx = 0; planner_idx < pull_over_planners_.size(); ++planner_idx) {
+      if (!isPlannable(planner_idx)) {
         continue;
       }
       for (const auto & goal_candidate : goal_candidates) {
-        planCandidatePaths(planner, goal_candidate);
+        planner_and_goal_pairs.emplace_back(planner_idx, goal_candidate);
       }
     }
   } else if (parameters.path_priority == "close_goal") {
     for (const auto & goal_candidate : goal_candidates) {
-      for (const auto & planner : pull_over_planners_) {
-        // todo: temporary skip NON SHIFT planner when input path is not center line
-        if (!is_center_line_input_path && planner->getPlannerType() != PullOverPlannerType::SHIFT) {
+      for (size_t planner_idx = 0; planner_idx < pull_over_planners_.size(); ++planner_idx) {
+        if (!isPlannable(planner_idx)) {
           continue;
         }
-        planCandidatePaths(planner, goal_candidate);
+        planner_and_goal_pairs.emplace_back(planner_idx, goal_candidate);
       }
     }
   } else {
@@ -362,14 +341,64 @@ void GoalPlannerModule::onTimer()
     throw std::domain_error("[pull_over] invalid path_priority");
   }
 
-  // set member variables
-  thread_safe_data_.set_pull_over_path_candidates(path_candidates);
-  thread_safe_data_.set_closest_start_pose(closest_start_pose);
+  // plan candidate paths and set them to the member variable
+  const auto path_candidates = planPullOverPathCandidates(
+    planner_and_goal_pairs, local_planner_data, previous_module_output, current_lanes,
+    parameters.path_generation_thread_num);
   RCLCPP_INFO(getLogger(), "generated %lu pull over path candidates", path_candidates.size());
 
   thread_safe_data_.set_last_previous_module_output(previous_module_output);
 }
 
+std::vector<PullOverPath> GoalPlannerModule::planPullOverPathCandidates(
+  const std::vector<std::pair<size_t, GoalCandidate>> & planner_and_goal_pairs,
+  const std::shared_ptr<const PlannerData> & planner_data,
+  const BehaviorModuleOutput & previous_module_output, const lanelet::ConstLanelets & current_lanes,
+  const int thread_num)
+{
+  // collect the paths planned for the first `planned_num` pairs in the order of priority and set
+  // them to the member variables
+  const auto setPathCandidates = [&](
+                                   const std::vector<std::optional<PullOverPath>> & planned_paths,
+                                   const size_t planned_num) {
+    std::vector<PullOverPath> path_candidates{};
+    std::optional<Pose> closest_start_pose{};
+    double min_start_arc_length = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < planned_num; ++i) {
+      if (!planned_paths.at(i)) {
+        continue;
+      }
+      auto pull_over_path = *planned_paths.at(i);
+      pull_over_path.id = path_candidates.size();
+      // calculate closest pull over start pose for stop path
+      const double start_arc_length =
+        lanelet::utils::getArcCoordinates(current_lanes, pull_over_path.start_pose).length;
+      if (start_arc_length < min_start_arc_length) {
+        min_start_arc_length = start_arc_length;
+        // closest start pose is stop point when not finding safe path
+        closest_start_pose = pull_over_path.start_pose;
+      }
+      path_candidates.push_back(pull_over_path);
+    }
+    thread_safe_data_.set_pull_over_path_candidates(path_candidates);
+    thread_safe_data_.set_closest_start_pose(closest_start_pose);
+    return path_candidates;
+  };
+
+  // When there is no candidate yet, the main thread can not do anything until the candidates are
+  // set. So the candidates are set as soon as the best-priority path is found.
+  std::function<void(const std::vector<std::optional<PullOverPath>> &, const size_t)>
+    on_best_path_found{nullptr};
+  if (thread_safe_data_.get_pull_over_path_candidates().empty()) {
+    on_best_path_found = setPathCandidates;
+  }
+  const auto planned_paths = goal_planner_utils::planPullOverPaths(
+    pull_over_planners_, planner_and_goal_pairs, planner_data, previous_module_output, thread_num,
+    on_best_path_found);
+
+  return setPathCandidates(planned_paths, planned_paths.size());
+}
+
 void GoalPlannerModule::onFreespaceParkingTimer()
 {
   const ScopedFlag flag(is_freespace_parking_cb_running_);
@@ -2767,7 +2796,16 @@ void GoalPlannerModule::GoalPlannerData::update(
   planner_data.route_handler = std::make_shared<RouteHandler>(*(planner_data_.route_handler));
   current_status = current_status_;
   previous_module_output = previous_module_output_;
-  occupancy_grid_map->setMap(*(planner_data.occupancy_grid));
+  // setMap builds the collision index tables of the whole grid, so the collision detector is
+  // rebuilt only when a new occupancy grid is given. It is re-created instead of being updated in
+  // place because the previous one may still be used by onTimer/onFreespaceParkingTimer
+  if (planner_data.occupancy_grid != occupancy_grid_of_map) {
+    auto new_occupancy_grid_map = std::make_shared<OccupancyGridBasedCollisionDetector>();
+    new_occupancy_grid_map->setParam(occupancy_grid_map->getParam());
+    new_occupancy_grid_map->setMap(*(planner_data.occupancy_grid));
+    occupancy_grid_map = new_occupancy_grid_map;
+    occupancy_grid_of_map = planner_data.occupancy_grid;
+  }
   // to create a deepcopy of GoalPlanner(not GoalPlannerBase), goal_searcher_ is not enough, so
   // recreate it here
   goal_searcher = std::make_shared<GoalSearcher>(parameters, vehicle_footprint);
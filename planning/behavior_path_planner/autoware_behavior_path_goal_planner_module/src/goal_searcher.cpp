@@ -295,9 +295,13 @@ void GoalSearcher::update(
   // update is_safe
   for (auto & goal_candidate : goal_candidates) {
     const Pose goal_pose = goal_candidate.goal_pose;
+    const auto occupancy_grid_collision =
+      getOccupancyGridCollision(goal_candidate, occupancy_grid_map);
 
     // check collision with footprint
-    if (checkCollision(goal_pose, pull_over_lane_stop_objects, occupancy_grid_map)) {
+    if (
+      occupancy_grid_collision.is_footprint_colliding ||
+      checkCollision(goal_pose, pull_over_lane_stop_objects)) {
       goal_candidate.is_safe = false;
       continue;
     }
@@ -307,8 +311,9 @@ void GoalSearcher::update(
     const auto target_objects = goal_planner_utils::filterObjectsByLateralDistance(
       goal_pose, planner_data->parameters.vehicle_width, pull_over_lane_stop_objects,
       parameters_.object_recognition_collision_check_hard_margins.back(), filter_inside);
-    if (checkCollisionWithLongitudinalDistance(
-          goal_pose, target_objects, occupancy_grid_map, planner_data)) {
+    if (
+      occupancy_grid_collision.is_longitudinal_margin_colliding ||
+      checkCollisionWithLongitudinalDistance(goal_pose, target_objects, planner_data)) {
       goal_candidate.is_safe = false;
       continue;
     }
@@ -358,8 +363,20 @@ bool GoalSearcher::isSafeGoalWithMarginScaleFactor(
   return true;
 }
 
-bool GoalSearcher::checkCollision(
-  const Pose & pose, const PredictedObjects & objects,
+bool GoalSearcher::checkCollision(const Pose & pose, const PredictedObjects & objects) const
+{
+  if (parameters_.use_object_recognition) {
+    if (utils::checkCollisionBetweenFootprintAndObjects(
+          vehicle_footprint_, pose, objects,
+          parameters_.object_recognition_collision_check_hard_margins.back())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool GoalSearcher::checkOccupancyGridCollision(
+  const Pose & pose,
   const std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map) const
 {
   if (parameters_.use_occupancy_grid_for_goal_search) {
@@ -371,21 +388,36 @@ bool GoalSearcher::checkCollision(
       return true;
     }
   }
+  return false;
+}
 
+bool GoalSearcher::checkCollisionWithLongitudinalDistance(
+  const Pose & ego_pose, const PredictedObjects & objects,
+  const std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map,
+  const std::shared_ptr<const PlannerData> & planner_data) const
+{
+  return checkOccupancyGridCollisionWithLongitudinalDistance(ego_pose, occupancy_grid_map) ||
+         checkCollisionWithLongitudinalDistance(ego_pose, objects, planner_data);
+}
+
+bool GoalSearcher::checkCollisionWithLongitudinalDistance(
+  const Pose & ego_pose, const PredictedObjects & objects,
+  const std::shared_ptr<const PlannerData> & planner_data) const
+{
   if (parameters_.use_object_recognition) {
-    if (utils::checkCollisionBetweenFootprintAndObjects(
-          vehicle_footprint_, pose, objects,
-          parameters_.object_recognition_collision_check_hard_margins.back())) {
+    if (
+      utils::calcLongitudinalDistanceFromEgoToObjects(
+        ego_pose, planner_data->parameters.base_link2front, planner_data->parameters.base_link2rear,
+        objects) < parameters_.longitudinal_margin) {
       return true;
     }
   }
   return false;
 }
 
-bool GoalSearcher::checkCollisionWithLongitudinalDistance(
-  const Pose & ego_pose, const PredictedObjects & objects,
-  const std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map,
-  const std::shared_ptr<const PlannerData> & planner_data) const
+bool GoalSearcher::checkOccupancyGridCollisionWithLongitudinalDistance(
+  const Pose & ego_pose,
+  const std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map) const
 {
   if (
     parameters_.use_occupancy_grid_for_goal_search &&
@@ -416,16 +448,35 @@ bool GoalSearcher::checkCollisionWithLongitudinalDistance(
       return true;
     }
   }
+  return false;
+}
 
-  if (parameters_.use_object_recognition) {
-    if (
-      utils::calcLongitudinalDistanceFromEgoToObjects(
-        ego_pose, planner_data->parameters.base_link2front, planner_data->parameters.base_link2rear,
-        objects) < parameters_.longitudinal_margin) {
-      return true;
-    }
+GoalSearcher::OccupancyGridCollision GoalSearcher::getOccupancyGridCollision(
+  const GoalCandidate & goal_candidate,
+  const std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map) const
+{
+  std::lock_guard<std::mutex> lock(occupancy_grid_collision_cache_mutex_);
+  if (cached_occupancy_grid_map_.lock() != occupancy_grid_map) {
+    occupancy_grid_collision_cache_.clear();
+    cached_occupancy_grid_map_ = occupancy_grid_map;
   }
-  return false;
+
+  // the goal candidates are re-created with the same ids when the goal is changed
+  const auto & goal_pose = goal_candidate.goal_pose;
+  const auto cached = occupancy_grid_collision_cache_.find(goal_candidate.id);
+  if (
+    cached != occupancy_grid_collision_cache_.end() &&
+    cached->second.goal_pose.position == goal_pose.position &&
+    cached->second.goal_pose.orientation == goal_pose.orientation) {
+    return cached->second;
+  }
+
+  OccupancyGridCollision collision{};
+  collision.goal_pose = goal_pose;
+  collision.is_footprint_colliding = checkOccupancyGridCollision(goal_pose, occupancy_grid_map);
+  collision.is_longitudinal_margin_colliding =
+    checkOccupancyGridCollisionWithLongitudinalDistance(goal_pose, occupancy_grid_map);
+  return occupancy_grid_collision_cache_[goal_candidate.id] = collision;
 }
 
 void GoalSearcher::createAreaPolygons(
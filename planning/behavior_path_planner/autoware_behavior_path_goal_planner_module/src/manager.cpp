@@ -134,6 +134,7 @@ GoalPlannerParameters GoalPlannerModuleManager::initGoalPlannerParameters(
     p.path_priority = node->declare_parameter<std::string>(ns + "path_priority");
     p.efficient_path_order =
       node->declare_parameter<std::vector<std::string>>(ns + "efficient_path_order");
+    p.path_generation_thread_num = node->declare_parameter<int>(ns + "path_generation_thread_num");
     p.lane_departure_check_expansion_margin =
       node->declare_parameter<double>(ns + "lane_departure_check_expansion_margin");
   }
@@ -513,6 +514,7 @@ void GoalPlannerModuleManager::updateModuleParams(
     updateParam<std::string>(parameters, ns + "path_priority", p->path_priority);
     updateParam<std::vector<std::string>>(
       parameters, ns + "efficient_path_order", p->efficient_path_order);
+    updateParam<int>(parameters, ns + "path_generation_thread_num", p->path_generation_thread_num);
   }
 
   // shift parking
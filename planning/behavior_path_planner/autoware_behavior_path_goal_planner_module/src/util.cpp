@@ -32,6 +32,8 @@
 #include <tf2_ros/transform_listener.h>
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -493,4 +495,79 @@ std::string makePathPriorityDebugMessage(
   return ss.str();
 }
 
+std::vector<std::optional<PullOverPath>> planPullOverPaths(
+  const std::vector<std::shared_ptr<PullOverPlannerBase>> & pull_over_planners,
+  const std::vector<std::pair<size_t, GoalCandidate>> & planner_and_goal_pairs,
+  const std::shared_ptr<const PlannerData> & planner_data,
+  const BehaviorModuleOutput & previous_module_output, const int thread_num,
+  const std::function<void(const std::vector<std::optional<PullOverPath>> &, const size_t)> &
+    on_best_path_found)
+{
+  const size_t task_num = planner_and_goal_pairs.size();
+
+  // each result is written only by the thread which planned it, and is read after its done flag is
+  // set, so the results do not need a lock
+  std::vector<std::optional<PullOverPath>> results(task_num);
+  std::vector<std::atomic<bool>> is_done(task_num);
+  for (auto & flag : is_done) {
+    flag.store(false);
+  }
+  std::atomic<size_t> next_task_idx{0};
+
+  const auto plan = [&](
+                      const std::vector<std::shared_ptr<PullOverPlannerBase>> & planners,
+                      const auto & on_planned) {
+    for (size_t i = next_task_idx++; i < task_num; i = next_task_idx++) {
+      const auto & [planner_idx, goal_candidate] = planner_and_goal_pairs.at(i);
+      auto pull_over_path = planners.at(planner_idx)->plan(
+        planner_data, previous_module_output, goal_candidate.goal_pose);
+      if (pull_over_path && pull_over_path->getParkingPath().points.size() >= 3) {
+        pull_over_path->goal_id = goal_candidate.id;
+        results.at(i) = std::move(pull_over_path);
+      }
+      is_done.at(i).store(true, std::memory_order_release);
+      on_planned();
+    }
+  };
+
+  // the best path is found when all the pairs with higher priority are done and one of them
+  // succeeded
+  bool is_best_path_found = !on_best_path_found;
+  size_t done_num = 0;
+  const auto streamBestPath = [&]() {
+    while (!is_best_path_found && done_num < task_num &&
+           is_done.at(done_num).load(std::memory_order_acquire)) {
+      if (results.at(done_num)) {
+        on_best_path_found(results, done_num + 1);
+        is_best_path_found = true;
+      }
+      ++done_num;
+    }
+  };
+
+  std::vector<std::future<void>> workers{};
+  const size_t worker_num = std::min(task_num, static_cast<size_t>(std::max(thread_num, 1)));
+  for (size_t i = 1; i < worker_num; ++i) {
+    std::vector<std::shared_ptr<PullOverPlannerBase>> planners{};
+    for (const auto & planner : pull_over_planners) {
+      planners.push_back(planner->clone());
+    }
+    if (std::any_of(planners.begin(), planners.end(), [](const auto & p) { return !p; })) {
+      break;
+    }
+    workers.push_back(std::async(std::launch::async, [&plan, planners]() {
+      plan(planners, []() {});
+    }));
+  }
+
+  // this thread also plans and streams the best path while the workers are running
+  plan(pull_over_planners, streamBestPath);
+  for (auto & worker : workers) {
+    worker.get();
+  }
+  streamBestPath();
+
+  return results;
+}
+
 }  // namespace autoware::behavior_path_planner::goal_planner_utils
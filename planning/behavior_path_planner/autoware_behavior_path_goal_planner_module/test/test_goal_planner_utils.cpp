@@ -0,0 +1,237 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/behavior_path_goal_planner_module/util.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using autoware::behavior_path_planner::BehaviorModuleOutput;
+using autoware::behavior_path_planner::GoalCandidate;
+using autoware::behavior_path_planner::GoalPlannerParameters;
+using autoware::behavior_path_planner::PlannerData;
+using autoware::behavior_path_planner::PullOverPath;
+using autoware::behavior_path_planner::PullOverPlannerBase;
+using autoware::behavior_path_planner::PullOverPlannerType;
+using autoware::behavior_path_planner::goal_planner_utils::planPullOverPaths;
+
+namespace
+{
+// Planner which fails for some goals and takes a different time for each goal, and records whether
+// it is used from more than one thread.
+class FakePullOverPlanner : public PullOverPlannerBase
+{
+public:
+  FakePullOverPlanner(
+    rclcpp::Node & node, const PullOverPlannerType type, const bool is_cloneable,
+    const std::shared_ptr<std::atomic<bool>> & is_shared)
+  : PullOverPlannerBase{node, GoalPlannerParameters{}},
+    type_{type},
+    is_cloneable_{is_cloneable},
+    is_shared_{is_shared}
+  {
+  }
+
+  PullOverPlannerType getPlannerType() const override { return type_; }
+
+  std::optional<PullOverPath> plan(
+    [[maybe_unused]] const std::shared_ptr<const PlannerData> planner_data,
+    [[maybe_unused]] const BehaviorModuleOutput & previous_module_output,
+    const Pose & goal_pose) override
+  {
+    const auto thread_id = std::this_thread::get_id();
+    if (thread_id_ && *thread_id_ != thread_id) {
+      is_shared_->store(true);
+    }
+    thread_id_ = thread_id;
+
+    const int goal_idx = static_cast<int>(goal_pose.position.x);
+    std::this_thread::sleep_for(std::chrono::microseconds((goal_idx * 37) % 500));
+    if (goal_idx % 3 == static_cast<int>(type_)) {
+      return std::nullopt;
+    }
+
+    PathWithLaneId path{};
+    for (int i = 0; i < 3; ++i) {
+      tier4_planning_msgs::msg::PathPointWithLaneId point{};
+      point.point.pose = goal_pose;
+      point.point.pose.position.x += i;
+      point.point.pose.position.y = static_cast<double>(type_);
+      path.points.push_back(point);
+    }
+    PullOverPath pull_over_path{};
+    pull_over_path.type = type_;
+    pull_over_path.setPaths({path}, path.points.front().point.pose, path.points.back().point.pose);
+    return pull_over_path;
+  }
+
+  std::shared_ptr<PullOverPlannerBase> clone() const override
+  {
+    if (!is_cloneable_) {
+      return nullptr;
+    }
+    auto planner = std::make_shared<FakePullOverPlanner>(*this);
+    planner->thread_id_ = std::nullopt;
+    return planner;
+  }
+
+private:
+  PullOverPlannerType type_;
+  bool is_cloneable_;
+  std::shared_ptr<std::atomic<bool>> is_shared_;
+  std::optional<std::thread::id> thread_id_{std::nullopt};
+};
+
+std::shared_ptr<rclcpp::Node> createNode()
+{
+  rclcpp::NodeOptions node_options;
+  node_options.parameter_overrides(
+    {{"wheel_radius", 0.39},
+     {"wheel_width", 0.42},
+     {"wheel_base", 2.74},
+     {"wheel_tread", 1.63},
+     {"front_overhang", 1.0},
+     {"rear_overhang", 1.03},
+     {"left_overhang", 0.1},
+     {"right_overhang", 0.1},
+     {"vehicle_height", 2.5},
+     {"max_steer_angle", 0.7}});
+  return std::make_shared<rclcpp::Node>("test_goal_planner_utils", node_options);
+}
+
+std::vector<std::pair<size_t, GoalCandidate>> createPlannerAndGoalPairs(
+  const size_t planner_num, const size_t goal_num)
+{
+  std::vector<std::pair<size_t, GoalCandidate>> pairs{};
+  for (size_t planner_idx = 0; planner_idx < planner_num; ++planner_idx) {
+    for (size_t goal_idx = 1; goal_idx <= goal_num; ++goal_idx) {
+      GoalCandidate goal_candidate{};
+      goal_candidate.goal_pose.position.x = static_cast<double>(goal_idx);
+      goal_candidate.goal_pose.orientation.w = 1.0;
+      goal_candidate.id = goal_idx;
+      pairs.emplace_back(planner_idx, goal_candidate);
+    }
+  }
+  return pairs;
+}
+
+void expectSamePaths(const std::optional<PullOverPath> & a, const std::optional<PullOverPath> & b)
+{
+  ASSERT_EQ(a.has_value(), b.has_value());
+  if (!a) {
+    return;
+  }
+  EXPECT_EQ(a->type, b->type);
+  EXPECT_EQ(a->goal_id, b->goal_id);
+  EXPECT_EQ(a->start_pose, b->start_pose);
+  EXPECT_EQ(a->end_pose, b->end_pose);
+  EXPECT_EQ(a->getParkingPath().points, b->getParkingPath().points);
+}
+}  // namespace
+
+class PlanPullOverPathsTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+    node_ = createNode();
+  }
+
+  void TearDown() override
+  {
+    node_.reset();
+    rclcpp::shutdown();
+  }
+
+  std::vector<std::shared_ptr<PullOverPlannerBase>> createPlanners(const bool is_cloneable)
+  {
+    return {
+      std::make_shared<FakePullOverPlanner>(
+        *node_, PullOverPlannerType::SHIFT, is_cloneable, is_shared_),
+      std::make_shared<FakePullOverPlanner>(
+        *node_, PullOverPlannerType::ARC_FORWARD, is_cloneable, is_shared_)};
+  }
+
+  std::shared_ptr<rclcpp::Node> node_;
+  std::shared_ptr<std::atomic<bool>> is_shared_{std::make_shared<std::atomic<bool>>(false)};
+};
+
+TEST_F(PlanPullOverPathsTest, ParallelResultsEqualSerialResults)
+{
+  const auto pairs = createPlannerAndGoalPairs(2, 30);
+
+  const auto serial_results =
+    planPullOverPaths(createPlanners(true), pairs, nullptr, BehaviorModuleOutput{}, 1);
+  const auto parallel_results =
+    planPullOverPaths(createPlanners(true), pairs, nullptr, BehaviorModuleOutput{}, 4);
+
+  ASSERT_EQ(serial_results.size(), pairs.size());
+  ASSERT_EQ(parallel_results.size(), pairs.size());
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    expectSamePaths(parallel_results.at(i), serial_results.at(i));
+  }
+  EXPECT_FALSE(is_shared_->load());
+}
+
+TEST_F(PlanPullOverPathsTest, BestPathIsStreamedInPriorityOrder)
+{
+  const auto pairs = createPlannerAndGoalPairs(2, 30);
+  const auto serial_results =
+    planPullOverPaths(createPlanners(true), pairs, nullptr, BehaviorModuleOutput{}, 1);
+  size_t best_idx = 0;
+  while (!serial_results.at(best_idx)) {
+    ++best_idx;
+  }
+
+  size_t call_num = 0;
+  std::vector<std::optional<PullOverPath>> streamed_results{};
+  const auto on_best_path_found = [&](const auto & results, const size_t planned_num) {
+    ++call_num;
+    streamed_results.assign(results.begin(), results.begin() + planned_num);
+  };
+  planPullOverPaths(
+    createPlanners(true), pairs, nullptr, BehaviorModuleOutput{}, 4, on_best_path_found);
+
+  EXPECT_EQ(call_num, 1u);
+  ASSERT_EQ(streamed_results.size(), best_idx + 1);
+  for (size_t i = 0; i < streamed_results.size(); ++i) {
+    expectSamePaths(streamed_results.at(i), serial_results.at(i));
+  }
+}
+
+TEST_F(PlanPullOverPathsTest, PlanOnCallingThreadWithoutClone)
+{
+  const auto pairs = createPlannerAndGoalPairs(2, 10);
+
+  const auto serial_results =
+    planPullOverPaths(createPlanners(true), pairs, nullptr, BehaviorModuleOutput{}, 1);
+  const auto results =
+    planPullOverPaths(createPlanners(false), pairs, nullptr, BehaviorModuleOutput{}, 4);
+
+  ASSERT_EQ(results.size(), pairs.size());
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    expectSamePaths(results.at(i), serial_results.at(i));
+  }
+  EXPECT_FALSE(is_shared_->load());
+}
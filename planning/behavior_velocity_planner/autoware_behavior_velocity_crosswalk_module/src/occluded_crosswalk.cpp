@@ -19,7 +19,10 @@
 #include <autoware_grid_map_utils/polygon_iterator.hpp>
 #include <grid_map_ros/GridMapRosConverter.hpp>
 
+#include <opencv2/imgproc.hpp>
+
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace autoware::behavior_velocity_planner
@@ -136,13 +139,82 @@ void clear_occlusions_behind_objects(
   }
 }
 
+bool may_be_occluded(
+  const OccupancyGridAnalysis & occupancy_grid_analysis,
+  const std::vector<lanelet::BasicPolygon2d> & detection_areas, const int min_nb_of_cells,
+  const autoware::behavior_velocity_planner::CrosswalkModule::PlannerParam & params)
+{
+  const auto & occupancy_grid = *occupancy_grid_analysis.getOccupancyGrid();
+  // cells without information are unknown for is_occluded but occupied for the analysis
+  if (std::find(occupancy_grid.data.begin(), occupancy_grid.data.end(), -1) !=
+      occupancy_grid.data.end()) {
+    return true;
+  }
+  const int width = static_cast<int>(occupancy_grid.info.width);
+  const int height = static_cast<int>(occupancy_grid.info.height);
+  const double resolution = occupancy_grid.info.resolution;
+  const auto & origin = occupancy_grid.info.origin.position;
+
+  // bounding box of the detection areas in the image with a margin of 1 pixel for the rounding
+  int min_col = std::numeric_limits<int>::max();
+  int min_row = std::numeric_limits<int>::max();
+  int max_col = std::numeric_limits<int>::lowest();
+  int max_row = std::numeric_limits<int>::lowest();
+  for (const auto & detection_area : detection_areas) {
+    for (const auto & p : detection_area) {
+      const int col = static_cast<int>(std::floor((p.x() - origin.x) / resolution));
+      const int row = height - 1 - static_cast<int>(std::floor((p.y() - origin.y) / resolution));
+      min_col = std::min(min_col, col - 1);
+      min_row = std::min(min_row, row - 1);
+      max_col = std::max(max_col, col + 1);
+      max_row = std::max(max_row, row + 1);
+    }
+  }
+  const cv::Rect areas_rect =
+    cv::Rect(min_col, min_row, max_col - min_col + 1, max_row - min_row + 1) &
+    cv::Rect(0, 0, width, height);
+  if (areas_rect.empty()) {
+    return false;
+  }
+
+  const auto & components = occupancy_grid_analysis.getUnknownConnectedComponents(
+    params.occlusion_free_space_max, params.occlusion_occupied_min);
+  for (int label = 1; label < components.num; ++label) {
+    const cv::Rect component_rect(
+      components.stats.at<int>(label, cv::CC_STAT_LEFT),
+      components.stats.at<int>(label, cv::CC_STAT_TOP),
+      components.stats.at<int>(label, cv::CC_STAT_WIDTH),
+      components.stats.at<int>(label, cv::CC_STAT_HEIGHT));
+    const bool is_large_enough =
+      component_rect.width >= min_nb_of_cells && component_rect.height >= min_nb_of_cells;
+    const bool is_on_edge = component_rect.x == 0 || component_rect.y == 0 ||
+                            component_rect.br().x == width || component_rect.br().y == height;
+    if ((is_large_enough || is_on_edge) && !(component_rect & areas_rect).empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool is_crosswalk_occluded(
   const lanelet::ConstLanelet & crosswalk_lanelet,
-  const nav_msgs::msg::OccupancyGrid & occupancy_grid,
+  const OccupancyGridAnalysis & occupancy_grid_analysis,
   const geometry_msgs::msg::Point & path_intersection, const double detection_range,
   const std::vector<autoware_perception_msgs::msg::PredictedObject> & dynamic_objects,
   const autoware::behavior_velocity_planner::CrosswalkModule::PlannerParam & params)
 {
+  const auto & occupancy_grid = *occupancy_grid_analysis.getOccupancyGrid();
+  const auto min_nb_of_cells =
+    std::ceil(params.occlusion_min_size / occupancy_grid.info.resolution);
+  const auto detection_areas = calculate_detection_areas(
+    crosswalk_lanelet, {path_intersection.x, path_intersection.y}, detection_range);
+  // NOTE: clearing the cells behind the objects only reduces the occlusions, so the raw occupancy
+  // grid without any occlusion skips the costly conversion to the grid map
+  if (!may_be_occluded(
+        occupancy_grid_analysis, detection_areas, static_cast<int>(min_nb_of_cells), params)) {
+    return false;
+  }
+
   grid_map::GridMap grid_map;
   grid_map::GridMapRosConverter::fromOccupancyGrid(occupancy_grid, "layer", grid_map);
 
@@ -152,9 +224,7 @@ bool is_crosswalk_occluded(
       params.occlusion_extra_objects_size);
     clear_occlusions_behind_objects(grid_map, objects);
   }
-  const auto min_nb_of_cells = std::ceil(params.occlusion_min_size / grid_map.getResolution());
-  for (const auto & detection_area : calculate_detection_areas(
-         crosswalk_lanelet, {path_intersection.x, path_intersection.y}, detection_range)) {
+  for (const auto & detection_area : detection_areas) {
     grid_map::Polygon poly;
     for (const auto & p : detection_area) poly.addVertex(grid_map::Position(p.x(), p.y()));
     for (autoware::grid_map_utils::PolygonIterator iter(grid_map, poly); !iter.isPastEnd(); ++iter)
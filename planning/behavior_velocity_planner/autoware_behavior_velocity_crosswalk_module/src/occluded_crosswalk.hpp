@@ -17,6 +17,7 @@
 
 #include "scene_crosswalk.hpp"
 
+#include <autoware/behavior_velocity_planner_common/utilization/occupancy_grid_analysis.hpp>
 #include <grid_map_core/GridMap.hpp>
 #include <rclcpp/time.hpp>
 
@@ -49,9 +50,22 @@ bool is_occluded(
 lanelet::BasicPoint2d interpolate_point(
   const lanelet::BasicSegment2d & segment, const double extra_distance);
 
+/// @brief quickly check if the given areas may contain an occlusion
+/// @details an occlusion needs a connected component of unknown cells which either contains a
+/// square of min_nb_of_cells or touches the edge of the grid, and overlaps with the areas
+/// @param [in] occupancy_grid_analysis analysis of the occupancy grid shared by the modules
+/// @param [in] detection_areas areas where occlusions are searched
+/// @param [in] min_nb_of_cells minimum number of occluded cells needed to detect an occlusion
+/// @param [in] params parameters
+/// @return false if there is no occlusion in the areas, true if there may be one
+bool may_be_occluded(
+  const OccupancyGridAnalysis & occupancy_grid_analysis,
+  const std::vector<lanelet::BasicPolygon2d> & detection_areas, const int min_nb_of_cells,
+  const autoware::behavior_velocity_planner::CrosswalkModule::PlannerParam & params);
+
 /// @brief check if the crosswalk is occluded
 /// @param crosswalk_lanelet lanelet of the crosswalk
-/// @param occupancy_grid occupancy grid with the occlusion information
+/// @param occupancy_grid_analysis analysis of the occupancy grid with the occlusion information
 /// @param path_intersection intersection between the crosswalk and the ego path
 /// @param detection_range range away from the crosswalk until occlusions are considered
 /// @param dynamic_objects dynamic objects
@@ -59,7 +73,7 @@ lanelet::BasicPoint2d interpolate_point(
 /// @return true if the crosswalk is occluded
 bool is_crosswalk_occluded(
   const lanelet::ConstLanelet & crosswalk_lanelet,
-  const nav_msgs::msg::OccupancyGrid & occupancy_grid,
+  const OccupancyGridAnalysis & occupancy_grid_analysis,
   const geometry_msgs::msg::Point & path_intersection, const double detection_range,
   const std::vector<autoware_perception_msgs::msg::PredictedObject> & dynamic_objects,
   const autoware::behavior_velocity_planner::CrosswalkModule::PlannerParam & params);
@@ -878,10 +878,11 @@ void CrosswalkModule::applySlowDownByOcclusion(
         planner_data_->current_velocity->twist.linear.x);
     const auto is_ego_on_the_crosswalk =
       dist_ego_to_crosswalk <= planner_data_->vehicle_info_.max_longitudinal_offset_m;
-    if (!is_ego_on_the_crosswalk) {
+    const auto occupancy_grid_analysis = planner_data_->getOccupancyGridAnalysis();
+    if (!is_ego_on_the_crosswalk && occupancy_grid_analysis) {
       if (is_crosswalk_occluded(
-            crosswalk_, *planner_data_->occupancy_grid, first_path_point_on_crosswalk,
-            detection_range, objects_ptr->objects, planner_param_)) {
+            crosswalk_, *occupancy_grid_analysis, first_path_point_on_crosswalk, detection_range,
+            objects_ptr->objects, planner_param_)) {
         if (!current_initial_occlusion_time_) current_initial_occlusion_time_ = now;
         if (cmp_with_time_buffer(current_initial_occlusion_time_, std::greater_equal<double>{}))
           most_recent_occlusion_time_ = now;
@@ -21,10 +21,12 @@
 #include "intersection_stoplines.hpp"
 #include "object_manager.hpp"
 #include "result.hpp"
+#include "util.hpp"
 
 #include <autoware/behavior_velocity_planner_common/scene_module_interface.hpp>
 #include <autoware/behavior_velocity_planner_common/utilization/state_machine.hpp>
 #include <autoware/motion_utils/marker/virtual_wall_marker_creator.hpp>
+#include <opencv2/core.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <tier4_debug_msgs/msg/float64_multi_array_stamped.hpp>
@@ -383,6 +385,10 @@ private:
 
   //! save the time when ego observed green traffic light before entering the intersection
   std::optional<rclcpp::Time> initial_green_light_observed_time_{std::nullopt};
+
+  //! cache of the rasterized occlusion attention area, which is built at the first occlusion
+  //! detection and rebuilt only if the cells of the occupancy grid are not aligned with it
+  mutable std::optional<util::OcclusionAttentionRaster> occlusion_attention_raster_{std::nullopt};
   /** @}*/
 
 private:
@@ -702,6 +708,19 @@ private:
    * intersection_lanelets.first_attention_area(), occlusion_attention_divisions_
    */
   OcclusionType detectOcclusion(const InterpolatedPathInfo & interpolated_path_info) const;
+
+  /**
+   * @brief get the occlusion attention area rasterized on the lattice of the occupancy grid
+   * @attention this function has access to value() of intersection_lanelets_
+   */
+  const util::OcclusionAttentionRaster & getOcclusionAttentionRaster(
+    const double resolution, const double origin_x, const double origin_y) const;
+
+  //! scratch buffers of detectOcclusion, which are reused to avoid the allocation every cycle
+  mutable cv::Mat occlusion_attention_mask_;
+  mutable cv::Mat occlusion_unknown_mask_raw_;
+  mutable cv::Mat occlusion_unknown_mask_;
+  mutable cv::Mat occlusion_mask_;
   /** @} */
 
 private:
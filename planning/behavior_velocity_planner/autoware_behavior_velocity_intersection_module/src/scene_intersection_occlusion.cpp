@@ -23,7 +23,10 @@
 
 #include <lanelet2_core/geometry/Polygon.h>
 
+#include <algorithm>
+#include <limits>
 #include <tuple>
+#include <vector>
 
 namespace autoware::behavior_velocity_planner
 {
@@ -102,8 +105,6 @@ IntersectionModule::OcclusionType IntersectionModule::detectOcclusion(
   const InterpolatedPathInfo & interpolated_path_info) const
 {
   const auto & intersection_lanelets = intersection_lanelets_.value();
-  const auto & adjacent_lanelets = intersection_lanelets.adjacent();
-  const auto & attention_areas = intersection_lanelets.occlusion_attention_area();
   const auto first_attention_area = intersection_lanelets.first_attention_area().value();
   const auto & lane_divisions = occlusion_attention_divisions_.value();
 
@@ -181,56 +182,64 @@ IntersectionModule::OcclusionType IntersectionModule::detectOcclusion(
   // attention: 255
   // non-attention: 0
   // NOTE: interesting area is set to 255 for later masking
-  cv::Mat attention_mask(width, height, CV_8UC1, cv::Scalar(0));
-  std::vector<std::vector<cv::Point>> attention_area_cv_polygons;
-  for (const auto & attention_area : attention_areas) {
-    const auto area2d = lanelet::utils::to2D(attention_area);
-    findCommonCvPolygons(area2d, attention_area_cv_polygons);
-  }
-  for (const auto & poly : attention_area_cv_polygons) {
-    cv::fillPoly(attention_mask, poly, cv::Scalar(255), cv::LINE_AA);
-  }
-  // (1.1)
-  // reset adjacent_lanelets area to 0 on attention_mask
-  std::vector<std::vector<cv::Point>> adjacent_lane_cv_polygons;
-  for (const auto & adjacent_lanelet : adjacent_lanelets) {
-    const auto area2d = adjacent_lanelet.polygon2d().basicPolygon();
-    findCommonCvPolygons(area2d, adjacent_lane_cv_polygons);
-  }
-  for (const auto & poly : adjacent_lane_cv_polygons) {
-    cv::fillPoly(attention_mask, poly, cv::Scalar(0), cv::LINE_AA);
+  // NOTE: the attention area and the adjacent lanes are static, so they are rasterized in the map
+  // frame only once and the part overlapping with the current grid is copied. The following steps
+  // are limited to the bounding box of that part(attention_roi)
+  const auto & attention_raster = getOcclusionAttentionRaster(resolution, origin.x, origin.y);
+  auto & attention_mask = occlusion_attention_mask_;
+  const auto attention_roi_opt = util::copyOcclusionAttentionRaster(
+    attention_raster, origin.x, origin.y, width, height, attention_mask);
+  if (!attention_roi_opt) {
+    return NotOccluded{std::numeric_limits<double>::infinity()};
   }
+  const auto & attention_roi = attention_roi_opt.value();
+  const cv::Rect grid_rect(0, 0, width, height);
 
   // (2) prepare unknown mask
   // In OpenCV the pixel at (X=x, Y=y) (with left-upper origin) is accessed by img[y, x]
   // unknown: 255
   // not-unknown: 0
-  cv::Mat unknown_mask_raw(width, height, CV_8UC1, cv::Scalar(0));
-  cv::Mat unknown_mask(width, height, CV_8UC1, cv::Scalar(0));
-  for (int x = 0; x < width; x++) {
-    for (int y = 0; y < height; y++) {
-      const int idx = y * width + x;
-      const unsigned char intensity = occ_grid.data.at(idx);
+  // NOTE: the cells within the kernel size around attention_roi are also needed for morphologyEx
+  const int morph_size = static_cast<int>(planner_param_.occlusion.denoise_kernel / resolution);
+  const cv::Rect unknown_roi =
+    cv::Rect(
+      attention_roi.x - morph_size, attention_roi.y - morph_size,
+      attention_roi.width + 2 * morph_size, attention_roi.height + 2 * morph_size) &
+    grid_rect;
+  auto & unknown_mask_raw = occlusion_unknown_mask_raw_;
+  auto & unknown_mask = occlusion_unknown_mask_;
+  unknown_mask_raw.create(height, width, CV_8UC1);
+  unknown_mask_raw.setTo(cv::Scalar(0));
+  unknown_mask.create(height, width, CV_8UC1);
+  unknown_mask.setTo(cv::Scalar(0));
+  for (int row = unknown_roi.y; row < unknown_roi.y + unknown_roi.height; row++) {
+    const int y = height - 1 - row;
+    auto * unknown_mask_raw_row = unknown_mask_raw.ptr<unsigned char>(row);
+    for (int x = unknown_roi.x; x < unknown_roi.x + unknown_roi.width; x++) {
+      const unsigned char intensity = occ_grid.data.at(y * width + x);
       if (
         planner_param_.occlusion.free_space_max <= intensity &&
         intensity < planner_param_.occlusion.occupied_min) {
-        unknown_mask_raw.at<unsigned char>(height - 1 - y, x) = 255;
+        unknown_mask_raw_row[x] = 255;
       }
     }
   }
   // (2.1) apply morphologyEx
-  const int morph_size = static_cast<int>(planner_param_.occlusion.denoise_kernel / resolution);
+  cv::Mat unknown_mask_roi = unknown_mask(unknown_roi);
   cv::morphologyEx(
-    unknown_mask_raw, unknown_mask, cv::MORPH_OPEN,
+    unknown_mask_raw(unknown_roi), unknown_mask_roi, cv::MORPH_OPEN,
     cv::getStructuringElement(cv::MORPH_RECT, cv::Size(morph_size, morph_size)));
 
   // (3) occlusion mask
   static constexpr unsigned char OCCLUDED = 255;
   static constexpr unsigned char BLOCKED = 127;
-  cv::Mat occlusion_mask(width, height, CV_8UC1, cv::Scalar(0));
-  cv::bitwise_and(attention_mask, unknown_mask, occlusion_mask);
+  auto & occlusion_mask = occlusion_mask_;
+  occlusion_mask.create(height, width, CV_8UC1);
+  occlusion_mask.setTo(cv::Scalar(0));
+  cv::Mat occlusion_mask_roi = occlusion_mask(attention_roi);
+  cv::bitwise_and(attention_mask(attention_roi), unknown_mask(attention_roi), occlusion_mask_roi);
   // re-use attention_mask
-  attention_mask = cv::Mat(width, height, CV_8UC1, cv::Scalar(0));
+  attention_mask.setTo(cv::Scalar(0));
   // (3.1) draw all cells on attention_mask behind blocking vehicles as not occluded
   const auto & blocking_attention_objects = object_info_manager_.parkedObjects();
   for (const auto & blocking_attention_object_info : blocking_attention_objects) {
@@ -268,7 +277,14 @@ IntersectionModule::OcclusionType IntersectionModule::detectOcclusion(
   const double possible_object_bbox_y = possible_object_bbox.at(1) / resolution;
   const double possible_object_area = possible_object_bbox_x * possible_object_bbox_y;
   std::vector<std::vector<cv::Point>> contours;
-  cv::findContours(occlusion_mask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
+  // NOTE: findContours regards the pixels on the image border as 0, so the roi is expanded by 1
+  const cv::Rect contour_roi =
+    cv::Rect(
+      attention_roi.x - 1, attention_roi.y - 1, attention_roi.width + 2, attention_roi.height + 2) &
+    grid_rect;
+  cv::findContours(
+    occlusion_mask(contour_roi), contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE,
+    contour_roi.tl());
   std::vector<std::vector<cv::Point>> valid_contours;
   for (const auto & contour : contours) {
     if (contour.size() <= 2) {
@@ -304,7 +320,7 @@ IntersectionModule::OcclusionType IntersectionModule::detectOcclusion(
     debug_data_.occlusion_polygons.push_back(polygon_msg);
   }
   // (4.1) re-draw occluded cells using valid_contours
-  occlusion_mask = cv::Mat(width, height, CV_8UC1, cv::Scalar(0));
+  occlusion_mask.setTo(cv::Scalar(0));
   for (const auto & valid_contour : valid_contours) {
     // NOTE: drawContour does not work well
     cv::fillPoly(occlusion_mask, valid_contour, cv::Scalar(OCCLUDED), cv::LINE_AA);
@@ -447,4 +463,35 @@ IntersectionModule::OcclusionType IntersectionModule::detectOcclusion(
   debug_data_.static_occlusion = true;
   return StaticallyOccluded{min_dist};
 }
+
+const util::OcclusionAttentionRaster & IntersectionModule::getOcclusionAttentionRaster(
+  const double resolution, const double origin_x, const double origin_y) const
+{
+  if (
+    occlusion_attention_raster_ &&
+    util::isAlignedWithOcclusionAttentionRaster(
+      occlusion_attention_raster_.value(), resolution, origin_x, origin_y)) {
+    return occlusion_attention_raster_.value();
+  }
+
+  const auto & intersection_lanelets = intersection_lanelets_.value();
+  std::vector<lanelet::BasicPolygon2d> attention_areas;
+  for (const auto & attention_area : intersection_lanelets.occlusion_attention_area()) {
+    lanelet::BasicPolygon2d attention_area2d;
+    for (const auto & p : attention_area) {
+      attention_area2d.emplace_back(p.x(), p.y());
+    }
+    attention_areas.push_back(attention_area2d);
+  }
+  std::vector<lanelet::BasicPolygon2d> adjacent_areas;
+  for (const auto & adjacent_lanelet : intersection_lanelets.adjacent()) {
+    adjacent_areas.push_back(adjacent_lanelet.polygon2d().basicPolygon());
+  }
+
+  // NOTE: the raster is built on the lattice of the current grid, so the cells of the following
+  // grids are aligned with it as long as their origins move by multiples of the resolution
+  occlusion_attention_raster_ = util::rasterizeOcclusionAttentionArea(
+    attention_areas, adjacent_areas, resolution, origin_x, origin_y);
+  return occlusion_attention_raster_.value();
+}
 }  // namespace autoware::behavior_velocity_planner
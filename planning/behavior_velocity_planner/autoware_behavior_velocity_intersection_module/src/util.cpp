@@ -21,6 +21,7 @@
 #include <autoware/behavior_velocity_planner_common/utilization/util.hpp>
 #include <autoware/motion_utils/trajectory/trajectory.hpp>
 #include <autoware_lanelet2_extension/utility/utilities.hpp>
+#include <opencv2/imgproc.hpp>
 
 #include <boost/geometry/algorithms/correct.hpp>
 #include <boost/geometry/algorithms/intersects.hpp>
@@ -414,4 +415,105 @@ std::vector<lanelet::CompoundPolygon3d> getPolygon3dFromLanelets(
   return polys;
 }
 
+OcclusionAttentionRaster rasterizeOcclusionAttentionArea(
+  const std::vector<lanelet::BasicPolygon2d> & attention_areas,
+  const std::vector<lanelet::BasicPolygon2d> & adjacent_areas, const double resolution,
+  const double lattice_origin_x, const double lattice_origin_y)
+{
+  OcclusionAttentionRaster raster;
+  raster.resolution = resolution;
+
+  double min_x = std::numeric_limits<double>::max();
+  double min_y = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  for (const auto & attention_area : attention_areas) {
+    for (const auto & p : attention_area) {
+      min_x = std::min(min_x, p.x());
+      min_y = std::min(min_y, p.y());
+      max_x = std::max(max_x, p.x());
+      max_y = std::max(max_y, p.y());
+    }
+  }
+  if (min_x > max_x || min_y > max_y) {
+    raster.mask = cv::Mat(0, 0, CV_8UC1);
+    return raster;
+  }
+
+  // the indices are counted on the lattice and shifted so that a margin of 2 cells is left around
+  // the attention area for the anti-aliased edges
+  const auto toLatticeIndex = [&](const double x, const double lattice_origin) {
+    return static_cast<int>(std::floor((x - lattice_origin) / resolution));
+  };
+  const int min_idx_x = toLatticeIndex(min_x, lattice_origin_x) - 2;
+  const int min_idx_y = toLatticeIndex(min_y, lattice_origin_y) - 2;
+  const int cols = toLatticeIndex(max_x, lattice_origin_x) - min_idx_x + 3;
+  const int rows = toLatticeIndex(max_y, lattice_origin_y) - min_idx_y + 3;
+  raster.origin_x = lattice_origin_x + min_idx_x * resolution;
+  raster.origin_y = lattice_origin_y + min_idx_y * resolution;
+  raster.mask = cv::Mat(rows, cols, CV_8UC1, cv::Scalar(0));
+
+  const auto toCvPolygon = [&](const lanelet::BasicPolygon2d & area) {
+    std::vector<cv::Point> cv_polygon;
+    for (const auto & p : area) {
+      const int idx_x = toLatticeIndex(p.x(), lattice_origin_x) - min_idx_x;
+      const int idx_y = toLatticeIndex(p.y(), lattice_origin_y) - min_idx_y;
+      cv_polygon.emplace_back(idx_x, rows - 1 - idx_y);
+    }
+    return cv_polygon;
+  };
+  for (const auto & attention_area : attention_areas) {
+    cv::fillPoly(raster.mask, toCvPolygon(attention_area), cv::Scalar(255), cv::LINE_AA);
+  }
+  // reset adjacent_lanelets area to 0
+  for (const auto & adjacent_area : adjacent_areas) {
+    cv::fillPoly(raster.mask, toCvPolygon(adjacent_area), cv::Scalar(0), cv::LINE_AA);
+  }
+  return raster;
+}
+
+bool isAlignedWithOcclusionAttentionRaster(
+  const OcclusionAttentionRaster & raster, const double resolution, const double origin_x,
+  const double origin_y)
+{
+  if (raster.resolution != resolution) {
+    return false;
+  }
+  // allow the rounding error of the origin which is accumulated in the map frame
+  static constexpr double tolerance = 1e-3;
+  const double offset_x = (origin_x - raster.origin_x) / resolution;
+  const double offset_y = (origin_y - raster.origin_y) / resolution;
+  return std::abs(offset_x - std::round(offset_x)) < tolerance &&
+         std::abs(offset_y - std::round(offset_y)) < tolerance;
+}
+
+std::optional<cv::Rect> copyOcclusionAttentionRaster(
+  const OcclusionAttentionRaster & raster, const double origin_x, const double origin_y,
+  const int width, const int height, cv::Mat & mask)
+{
+  mask.create(height, width, CV_8UC1);
+  mask.setTo(cv::Scalar(0));
+
+  const double resolution = raster.resolution;
+  const int raster_offset_x =
+    static_cast<int>(std::round((origin_x - raster.origin_x) / resolution));
+  const int raster_offset_y =
+    static_cast<int>(std::round((origin_y - raster.origin_y) / resolution));
+  const int roi_begin_idx_x = std::clamp(-raster_offset_x, 0, width);
+  const int roi_end_idx_x = std::clamp(raster.mask.cols - raster_offset_x, 0, width);
+  const int roi_begin_idx_y = std::clamp(-raster_offset_y, 0, height);
+  const int roi_end_idx_y = std::clamp(raster.mask.rows - raster_offset_y, 0, height);
+  if (roi_begin_idx_x >= roi_end_idx_x || roi_begin_idx_y >= roi_end_idx_y) {
+    return std::nullopt;
+  }
+  const cv::Rect mask_roi(
+    roi_begin_idx_x, height - roi_end_idx_y, roi_end_idx_x - roi_begin_idx_x,
+    roi_end_idx_y - roi_begin_idx_y);
+  const cv::Rect raster_roi(
+    roi_begin_idx_x + raster_offset_x, raster.mask.rows - roi_end_idx_y - raster_offset_y,
+    mask_roi.width, mask_roi.height);
+  raster.mask(raster_roi).copyTo(mask(mask_roi));
+  return mask_roi;
+}
+
 }  // namespace autoware::behavior_velocity_planner::util
@@ -18,6 +18,7 @@
 #include "interpolated_path_info.hpp"
 
 #include <autoware/universe_utils/geometry/boost_geometry.hpp>
+#include <opencv2/core.hpp>
 #include <rclcpp/logger.hpp>
 
 #include <autoware_perception_msgs/msg/predicted_object_kinematics.hpp>
@@ -149,6 +150,45 @@ getFirstPointInsidePolygonsByFootprint(
 std::vector<lanelet::CompoundPolygon3d> getPolygon3dFromLanelets(
   const lanelet::ConstLanelets & ll_vec);
 
+/**
+ * @brief occlusion attention area excluding the adjacent lanes rasterized in the map frame
+ */
+struct OcclusionAttentionRaster
+{
+  double resolution{0.0};
+  double origin_x{0.0};  //!< map coordinate of the left bottom corner
+  double origin_y{0.0};  //!< map coordinate of the left bottom corner
+  cv::Mat mask;          //!< attention: 255, non-attention: 0. the first row is the top
+};
+
+/**
+ * @brief rasterize the attention areas excluding the adjacent areas. The cells are on the lattice
+ * of the given resolution which passes through (lattice_origin_x, lattice_origin_y), so that the
+ * raster is aligned with the cells of an occupancy grid whose origin is on the same lattice
+ */
+OcclusionAttentionRaster rasterizeOcclusionAttentionArea(
+  const std::vector<lanelet::BasicPolygon2d> & attention_areas,
+  const std::vector<lanelet::BasicPolygon2d> & adjacent_areas, const double resolution,
+  const double lattice_origin_x, const double lattice_origin_y);
+
+/**
+ * @brief check if the cells of the occupancy grid whose origin is (origin_x, origin_y) are aligned
+ * with the cells of the raster
+ */
+bool isAlignedWithOcclusionAttentionRaster(
+  const OcclusionAttentionRaster & raster, const double resolution, const double origin_x,
+  const double origin_y);
+
+/**
+ * @brief copy the part of the raster overlapping with the occupancy grid to mask, which is resized
+ * to the size of the grid and is 0 outside of that part
+ * @return the bounding box of the copied part in mask, or nullopt if the raster does not overlap
+ * with the grid
+ */
+std::optional<cv::Rect> copyOcclusionAttentionRaster(
+  const OcclusionAttentionRaster & raster, const double origin_x, const double origin_y,
+  const int width, const int height, cv::Mat & mask);
+
 }  // namespace autoware::behavior_velocity_planner::util
 
 #endif  // UTIL_HPP_
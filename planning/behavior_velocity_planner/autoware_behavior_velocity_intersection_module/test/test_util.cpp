@@ -17,8 +17,14 @@
 
 #include <autoware/route_handler/route_handler.hpp>
 #include <autoware_test_utils/autoware_test_utils.hpp>
+#include <opencv2/imgproc.hpp>
 
 #include <gtest/gtest.h>
+#include <lanelet2_core/primitives/Polygon.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
 
 TEST(TestUtil, retrievePathsBackward)
 {
@@ -88,6 +94,95 @@ TEST(TestUtil, retrievePathsBackward)
   }
 }
 
+TEST(TestUtil, copyOcclusionAttentionRasterSameAsFillPolyOnGrid)
+{
+  using autoware::behavior_velocity_planner::util::copyOcclusionAttentionRaster;
+  using autoware::behavior_velocity_planner::util::isAlignedWithOcclusionAttentionRaster;
+  using autoware::behavior_velocity_planner::util::rasterizeOcclusionAttentionArea;
+  using lanelet::BasicPoint2d;
+
+  // concave attention area and a triangle, and an adjacent lane crossing them
+  const std::vector<lanelet::BasicPolygon2d> attention_areas{
+    lanelet::BasicPolygon2d{
+      BasicPoint2d(97.0, -58.0), BasicPoint2d(131.3, -55.2), BasicPoint2d(138.7, -31.9),
+      BasicPoint2d(118.2, -41.4), BasicPoint2d(101.6, -22.3)},
+    lanelet::BasicPolygon2d{
+      BasicPoint2d(120.4, -28.8), BasicPoint2d(143.1, -26.6), BasicPoint2d(129.9, -12.5)}};
+  const std::vector<lanelet::BasicPolygon2d> adjacent_areas{lanelet::BasicPolygon2d{
+    BasicPoint2d(104.2, -61.3), BasicPoint2d(110.8, -60.9), BasicPoint2d(127.6, -9.7),
+    BasicPoint2d(121.1, -10.2)}};
+
+  // the lattice of the occupancy grid does not pass through the origin of the map
+  const double resolution = 0.5;
+  const double lattice_origin_x = 100.13;
+  const double lattice_origin_y = -40.37;
+  const auto raster = rasterizeOcclusionAttentionArea(
+    attention_areas, adjacent_areas, resolution, lattice_origin_x, lattice_origin_y);
+
+  // direct rasterization of the areas on the grid. The canvas is extended so that fillPoly does
+  // not clip the edges, which changes the anti-aliasing next to the border of the image
+  const auto fillPolyOnGrid =
+    [&](const double origin_x, const double origin_y, const int width, const int height) {
+      constexpr int margin = 200;
+      cv::Mat canvas(height + 2 * margin, width + 2 * margin, CV_8UC1, cv::Scalar(0));
+      const auto toCvPolygon = [&](const lanelet::BasicPolygon2d & area) {
+        std::vector<cv::Point> cv_polygon;
+        for (const auto & p : area) {
+          const int idx_x = static_cast<int>(std::floor((p.x() - origin_x) / resolution));
+          const int idx_y = static_cast<int>(std::floor((p.y() - origin_y) / resolution));
+          cv_polygon.emplace_back(idx_x + margin, height - 1 - idx_y + margin);
+        }
+        return cv_polygon;
+      };
+      for (const auto & attention_area : attention_areas) {
+        cv::fillPoly(canvas, toCvPolygon(attention_area), cv::Scalar(255), cv::LINE_AA);
+      }
+      for (const auto & adjacent_area : adjacent_areas) {
+        cv::fillPoly(canvas, toCvPolygon(adjacent_area), cv::Scalar(0), cv::LINE_AA);
+      }
+      return cv::Mat(canvas(cv::Rect(margin, margin, width, height)));
+    };
+
+  std::mt19937 engine(0);
+  std::uniform_int_distribution<int> shift_dist(-150, 60);
+  const int width = 120;
+  const int height = 100;
+  size_t overlapped_num = 0;
+  for (size_t i = 0; i < 50; ++i) {
+    // the grid moves with the ego by multiples of the resolution
+    const double origin_x = lattice_origin_x + shift_dist(engine) * resolution;
+    const double origin_y = lattice_origin_y + shift_dist(engine) * resolution;
+    ASSERT_TRUE(isAlignedWithOcclusionAttentionRaster(raster, resolution, origin_x, origin_y));
+
+    cv::Mat mask;
+    const auto roi = copyOcclusionAttentionRaster(raster, origin_x, origin_y, width, height, mask);
+    const auto expected = fillPolyOnGrid(origin_x, origin_y, width, height);
+    ASSERT_EQ(mask.rows, height);
+    ASSERT_EQ(mask.cols, width);
+    EXPECT_EQ(cv::countNonZero(mask != expected), 0) << "origin: " << origin_x << ", " << origin_y;
+    if (!roi) {
+      EXPECT_EQ(cv::countNonZero(expected), 0);
+      continue;
+    }
+    ++overlapped_num;
+    // the attention area is within the roi
+    cv::Mat expected_outside_roi = expected.clone();
+    expected_outside_roi(roi.value()).setTo(cv::Scalar(0));
+    EXPECT_EQ(cv::countNonZero(expected_outside_roi), 0);
+  }
+  EXPECT_GT(overlapped_num, 0u);
+
+  // the raster is not reused for the grid whose cells are shifted from the lattice
+  EXPECT_TRUE(isAlignedWithOcclusionAttentionRaster(
+    raster, resolution, lattice_origin_x + 3 * resolution + 1e-6, lattice_origin_y));
+  EXPECT_FALSE(isAlignedWithOcclusionAttentionRaster(
+    raster, resolution, lattice_origin_x + 0.5 * resolution, lattice_origin_y));
+  EXPECT_FALSE(isAlignedWithOcclusionAttentionRaster(
+    raster, resolution, lattice_origin_x, lattice_origin_y - 0.1));
+  EXPECT_FALSE(
+    isAlignedWithOcclusionAttentionRaster(raster, 0.25, lattice_origin_x, lattice_origin_y));
+}
+
 /*
   TOOD(Mamoru Sobue): instantiating intersection_module and PlannerData is a messy
 class TestWithMap : public ::testing::Test
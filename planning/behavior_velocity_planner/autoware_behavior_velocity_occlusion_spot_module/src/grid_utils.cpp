@@ -305,42 +305,37 @@ void imageToOccupancyGrid(const cv::Mat & cv_image, nav_msgs::msg::OccupancyGrid
   }
 }
 void toQuantizedImage(
-  const nav_msgs::msg::OccupancyGrid & occupancy_grid, cv::Mat * border_image,
+  const OccupancyGridAnalysis & occupancy_grid_analysis, cv::Mat * border_image,
   cv::Mat * occlusion_image, const GridParam & param)
 {
-  const int width = border_image->cols;
-  const int height = border_image->rows;
-  for (int x = width - 1; x >= 0; x--) {
-    for (int y = height - 1; y >= 0; y--) {
-      const int idx = (height - 1 - y) + (width - 1 - x) * height;
-      unsigned char intensity = occupancy_grid.data.at(idx);
-      if (intensity <= param.free_space_max) {
-        continue;
-      } else if (intensity < param.occupied_min) {
-        intensity = grid_utils::occlusion_cost_value::UNKNOWN_IMAGE;
-        occlusion_image->at<unsigned char>(y, x) = intensity;
-      } else {
-        intensity = grid_utils::occlusion_cost_value::OCCUPIED_IMAGE;
-        border_image->at<unsigned char>(y, x) = intensity;
-      }
-    }
-  }
+  // NOTE: the image here is the north-up quantized image rotated by 90 degrees counterclockwise,
+  // that is the pixel at (y, x) is the cell at (width - 1 - y, height - 1 - x) of the grid
+  cv::Mat quantized_image;
+  cv::rotate(
+    occupancy_grid_analysis.getQuantizedImage(param.free_space_max + 1, param.occupied_min - 1),
+    quantized_image, cv::ROTATE_90_COUNTERCLOCKWISE);
+  border_image->setTo(
+    cv::Scalar(grid_utils::occlusion_cost_value::OCCUPIED_IMAGE),
+    quantized_image == OccupancyGridAnalysis::OCCUPIED);
+  occlusion_image->setTo(
+    cv::Scalar(grid_utils::occlusion_cost_value::UNKNOWN_IMAGE),
+    quantized_image == OccupancyGridAnalysis::UNKNOWN);
 }
 
 void denoiseOccupancyGridCV(
-  const OccupancyGrid::ConstSharedPtr occupancy_grid_ptr,
+  const OccupancyGridAnalysis & occupancy_grid_analysis,
   const Polygons2d & stuck_vehicle_foot_prints, const Polygons2d & moving_vehicle_foot_prints,
   grid_map::GridMap & grid_map, const GridParam & param, const bool is_show_debug_window,
   const int num_iter, const bool use_object_footprints, const bool use_object_ray_casts)
 {
-  OccupancyGrid occupancy_grid = *occupancy_grid_ptr;
+  OccupancyGrid occupancy_grid = *occupancy_grid_analysis.getOccupancyGrid();
   cv::Mat border_image(
     occupancy_grid.info.width, occupancy_grid.info.height, CV_8UC1,
     cv::Scalar(grid_utils::occlusion_cost_value::FREE_SPACE));
   cv::Mat occlusion_image(
     occupancy_grid.info.width, occupancy_grid.info.height, CV_8UC1,
     cv::Scalar(grid_utils::occlusion_cost_value::FREE_SPACE));
-  toQuantizedImage(occupancy_grid, &border_image, &occlusion_image, param);
+  toQuantizedImage(occupancy_grid_analysis, &border_image, &occlusion_image, param);
 
   //! show original occupancy grid to compare difference
   if (is_show_debug_window) {
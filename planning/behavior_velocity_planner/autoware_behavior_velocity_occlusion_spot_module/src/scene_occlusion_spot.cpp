@@ -152,7 +152,8 @@ bool OcclusionSpotModule::modifyPathVelocity(
   DEBUG_PRINT(show_time, "filter obj[ms]: ", stop_watch_.toc("processing_time", true));
   if (param_.detection_method == utils::DETECTION_METHOD::OCCUPANCY_GRID) {
     const auto & occ_grid_ptr = planner_data_->occupancy_grid;
-    if (!occ_grid_ptr) return true;  // no data
+    const auto occupancy_grid_analysis = planner_data_->getOccupancyGridAnalysis();
+    if (!occ_grid_ptr || !occupancy_grid_analysis) return true;  // no data
     grid_map::GridMap grid_map;
     Polygons2d stuck_vehicle_foot_prints;
     Polygons2d moving_vehicle_foot_prints;
@@ -164,8 +165,8 @@ bool OcclusionSpotModule::modifyPathVelocity(
     const int num_iter = static_cast<int>(
       (param_.detection_area.min_occlusion_spot_size / occ_grid_ptr->info.resolution) - 1);
     grid_utils::denoiseOccupancyGridCV(
-      occ_grid_ptr, stuck_vehicle_foot_prints, moving_vehicle_foot_prints, grid_map, param_.grid,
-      param_.is_show_cv_window, num_iter, param_.use_object_info,
+      *occupancy_grid_analysis, stuck_vehicle_foot_prints, moving_vehicle_foot_prints, grid_map,
+      param_.grid, param_.is_show_cv_window, num_iter, param_.use_object_info,
       param_.use_moving_object_ray_cast);
     DEBUG_PRINT(show_time, "grid [ms]: ", stop_watch_.toc("processing_time", true));
     // Note: Don't consider offset from path start to ego here
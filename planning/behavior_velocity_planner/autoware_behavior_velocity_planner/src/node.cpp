@@ -288,6 +288,7 @@ bool BehaviorVelocityPlannerNode::processData(rclcpp::Clock clock)
   is_ready &= getData(planner_data_.current_acceleration, sub_acceleration_, "acceleration");
   is_ready &= getData(planner_data_.predicted_objects, sub_predicted_objects_, "predicted_objects");
   is_ready &= getData(planner_data_.occupancy_grid, sub_occupancy_grid_, "occupancy_grid");
+  planner_data_.occupancy_grid_analysis = planner_data_.getOccupancyGridAnalysis();
 
   const auto odometry = sub_vehicle_odometry_.takeData();
   if (odometry) {
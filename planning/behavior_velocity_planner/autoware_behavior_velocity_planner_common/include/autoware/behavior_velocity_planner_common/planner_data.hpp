@@ -48,6 +48,7 @@
 namespace autoware::behavior_velocity_planner
 {
 class BehaviorVelocityPlannerNode;
+class OccupancyGridAnalysis;
 struct PlannerData
 {
   explicit PlannerData(rclcpp::Node & node)
@@ -70,6 +71,9 @@ struct PlannerData
   pcl::PointCloud<pcl::PointXYZ>::ConstPtr no_ground_pointcloud;
   // occupancy grid
   nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid;
+  // image analysis of occupancy_grid shared by the modules. recreated when occupancy_grid changes
+  // NOTE: the modules should use getOccupancyGridAnalysis()
+  std::shared_ptr<const OccupancyGridAnalysis> occupancy_grid_analysis;
 
   // nearest search
   double ego_nearest_dist_threshold;
@@ -147,6 +151,15 @@ struct PlannerData
     }
     return std::make_optional<TrafficSignalStamped>(traffic_light_id_map.at(id));
   }
+
+  /**
+   *@fn
+   *@brief get the image analysis of occupancy_grid. occupancy_grid_analysis is returned if it is
+   *made from the current occupancy_grid, otherwise a new one is created
+   *@return nullptr if occupancy_grid is not available
+   *@note include occupancy_grid_analysis.hpp to use the result
+   */
+  std::shared_ptr<const OccupancyGridAnalysis> getOccupancyGridAnalysis() const;
 };
 }  // namespace autoware::behavior_velocity_planner
 
@@ -0,0 +1,98 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__BEHAVIOR_VELOCITY_PLANNER_COMMON__UTILIZATION__OCCUPANCY_GRID_ANALYSIS_HPP_
+#define AUTOWARE__BEHAVIOR_VELOCITY_PLANNER_COMMON__UTILIZATION__OCCUPANCY_GRID_ANALYSIS_HPP_
+
+#include <opencv2/core.hpp>
+
+#include <nav_msgs/msg/occupancy_grid.hpp>
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+namespace autoware::behavior_velocity_planner
+{
+/**
+ * @brief image analysis of an occupancy grid shared by the scene modules.
+ * Each result is computed at the first request and reused for the same arguments, so the
+ * modules processing the same occupancy grid message do not repeat the same computation.
+ * @note the cell values are read as unsigned char, so the unknown value(-1) of the occupancy grid
+ * is regarded as 255. A cell whose value is in [unknown_min, unknown_max] is unknown, and a cell
+ * whose value is larger than unknown_max is occupied.
+ * @note the images are north-up: the pixel at (row, col) is the grid cell (x = col,
+ * y = height - 1 - row)
+ */
+class OccupancyGridAnalysis
+{
+public:
+  static constexpr unsigned char FREE_SPACE = 0;
+  static constexpr unsigned char UNKNOWN = 127;
+  static constexpr unsigned char OCCUPIED = 255;
+
+  struct ConnectedComponents
+  {
+    int num{0};         //!< number of labels including the background label 0
+    cv::Mat labels;     //!< CV_32SC1 label image
+    cv::Mat stats;      //!< CV_32SC1 statistics of cv::connectedComponentsWithStats
+    cv::Mat centroids;  //!< CV_64FC1 centroids of cv::connectedComponentsWithStats
+  };
+
+  explicit OccupancyGridAnalysis(nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid);
+
+  const nav_msgs::msg::OccupancyGrid::ConstSharedPtr & getOccupancyGrid() const
+  {
+    return occupancy_grid_;
+  }
+
+  /**
+   * @brief get the image whose pixels are FREE_SPACE, UNKNOWN or OCCUPIED
+   */
+  const cv::Mat & getQuantizedImage(const int unknown_min, const int unknown_max) const;
+
+  /**
+   * @brief get the mask whose unknown pixels are 255 and others are 0
+   * @param denoise_kernel_size size of the kernel of the morphological opening to remove small
+   * unknown areas. The opening is not applied if it is smaller than 2
+   */
+  const cv::Mat & getUnknownMask(
+    const int unknown_min, const int unknown_max, const int denoise_kernel_size = 0) const;
+
+  /**
+   * @brief get the distance [m] from each unknown pixel to the nearest pixel which is not unknown
+   * in CV_32FC1. The distance of the pixels which are not unknown is 0
+   */
+  const cv::Mat & getUnknownDistanceTransform(
+    const int unknown_min, const int unknown_max, const int denoise_kernel_size = 0) const;
+
+  /**
+   * @brief get the 8-connected components of the unknown mask
+   */
+  const ConnectedComponents & getUnknownConnectedComponents(
+    const int unknown_min, const int unknown_max, const int denoise_kernel_size = 0) const;
+
+private:
+  const nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid_;
+
+  mutable std::recursive_mutex mutex_;
+  mutable std::map<std::pair<int, int>, cv::Mat> quantized_images_;
+  mutable std::map<std::tuple<int, int, int>, cv::Mat> unknown_masks_;
+  mutable std::map<std::tuple<int, int, int>, cv::Mat> unknown_distance_transforms_;
+  mutable std::map<std::tuple<int, int, int>, ConnectedComponents> unknown_connected_components_;
+};
+}  // namespace autoware::behavior_velocity_planner
+
+#endif  // AUTOWARE__BEHAVIOR_VELOCITY_PLANNER_COMMON__UTILIZATION__OCCUPANCY_GRID_ANALYSIS_HPP_
@@ -0,0 +1,125 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/behavior_velocity_planner_common/planner_data.hpp>
+#include <autoware/behavior_velocity_planner_common/utilization/occupancy_grid_analysis.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <memory>
+#include <utility>
+
+namespace autoware::behavior_velocity_planner
+{
+OccupancyGridAnalysis::OccupancyGridAnalysis(
+  nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid)
+: occupancy_grid_(std::move(occupancy_grid))
+{
+}
+
+const cv::Mat & OccupancyGridAnalysis::getQuantizedImage(
+  const int unknown_min, const int unknown_max) const
+{
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  const auto key = std::make_pair(unknown_min, unknown_max);
+  if (const auto it = quantized_images_.find(key); it != quantized_images_.end()) {
+    return it->second;
+  }
+
+  const int width = occupancy_grid_->info.width;
+  const int height = occupancy_grid_->info.height;
+  cv::Mat image(height, width, CV_8UC1);
+  for (int y = 0; y < height; ++y) {
+    const auto * grid_row = &occupancy_grid_->data[y * width];
+    auto * image_row = image.ptr<unsigned char>(height - 1 - y);
+    for (int x = 0; x < width; ++x) {
+      const auto intensity = static_cast<unsigned char>(grid_row[x]);
+      if (intensity < unknown_min) {
+        image_row[x] = FREE_SPACE;
+      } else if (intensity <= unknown_max) {
+        image_row[x] = UNKNOWN;
+      } else {
+        image_row[x] = OCCUPIED;
+      }
+    }
+  }
+  return quantized_images_.emplace(key, image).first->second;
+}
+
+const cv::Mat & OccupancyGridAnalysis::getUnknownMask(
+  const int unknown_min, const int unknown_max, const int denoise_kernel_size) const
+{
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  const auto key = std::make_tuple(unknown_min, unknown_max, denoise_kernel_size);
+  if (const auto it = unknown_masks_.find(key); it != unknown_masks_.end()) {
+    return it->second;
+  }
+
+  cv::Mat unknown_mask;
+  cv::compare(getQuantizedImage(unknown_min, unknown_max), UNKNOWN, unknown_mask, cv::CMP_EQ);
+  if (denoise_kernel_size > 1) {
+    cv::morphologyEx(
+      unknown_mask, unknown_mask, cv::MORPH_OPEN,
+      cv::getStructuringElement(
+        cv::MORPH_RECT, cv::Size(denoise_kernel_size, denoise_kernel_size)));
+  }
+  return unknown_masks_.emplace(key, unknown_mask).first->second;
+}
+
+const cv::Mat & OccupancyGridAnalysis::getUnknownDistanceTransform(
+  const int unknown_min, const int unknown_max, const int denoise_kernel_size) const
+{
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  const auto key = std::make_tuple(unknown_min, unknown_max, denoise_kernel_size);
+  if (const auto it = unknown_distance_transforms_.find(key);
+      it != unknown_distance_transforms_.end()) {
+    return it->second;
+  }
+
+  cv::Mat distance;
+  cv::distanceTransform(
+    getUnknownMask(unknown_min, unknown_max, denoise_kernel_size), distance, cv::DIST_L2,
+    cv::DIST_MASK_PRECISE, CV_32F);
+  distance *= occupancy_grid_->info.resolution;
+  return unknown_distance_transforms_.emplace(key, distance).first->second;
+}
+
+const OccupancyGridAnalysis::ConnectedComponents &
+OccupancyGridAnalysis::getUnknownConnectedComponents(
+  const int unknown_min, const int unknown_max, const int denoise_kernel_size) const
+{
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  const auto key = std::make_tuple(unknown_min, unknown_max, denoise_kernel_size);
+  if (const auto it = unknown_connected_components_.find(key);
+      it != unknown_connected_components_.end()) {
+    return it->second;
+  }
+
+  ConnectedComponents components;
+  components.num = cv::connectedComponentsWithStats(
+    getUnknownMask(unknown_min, unknown_max, denoise_kernel_size), components.labels,
+    components.stats, components.centroids, 8, CV_32S);
+  return unknown_connected_components_.emplace(key, components).first->second;
+}
+
+std::shared_ptr<const OccupancyGridAnalysis> PlannerData::getOccupancyGridAnalysis() const
+{
+  if (!occupancy_grid) {
+    return nullptr;
+  }
+  if (occupancy_grid_analysis && occupancy_grid_analysis->getOccupancyGrid() == occupancy_grid) {
+    return occupancy_grid_analysis;
+  }
+  return std::make_shared<const OccupancyGridAnalysis>(occupancy_grid);
+}
+}  // namespace autoware::behavior_velocity_planner
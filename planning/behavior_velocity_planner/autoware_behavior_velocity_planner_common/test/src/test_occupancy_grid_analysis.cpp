@@ -0,0 +1,92 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/behavior_velocity_planner_common/utilization/occupancy_grid_analysis.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace
+{
+using autoware::behavior_velocity_planner::OccupancyGridAnalysis;
+
+// 6x4 grid with free cells(0), a 3x2 unknown area(50), an occupied cell(100) and a no information
+// cell(-1)
+nav_msgs::msg::OccupancyGrid::ConstSharedPtr generateOccupancyGrid()
+{
+  auto grid = std::make_shared<nav_msgs::msg::OccupancyGrid>();
+  grid->info.width = 6;
+  grid->info.height = 4;
+  grid->info.resolution = 0.5;
+  grid->data.assign(grid->info.width * grid->info.height, 0);
+  for (int y = 1; y <= 2; ++y) {
+    for (int x = 1; x <= 3; ++x) {
+      grid->data[y * grid->info.width + x] = 50;
+    }
+  }
+  grid->data[0 * grid->info.width + 5] = 100;
+  grid->data[3 * grid->info.width + 0] = -1;
+  return grid;
+}
+}  // namespace
+
+TEST(OccupancyGridAnalysis, quantizedImage)
+{
+  const OccupancyGridAnalysis analysis(generateOccupancyGrid());
+  const auto & image = analysis.getQuantizedImage(10, 90);
+  ASSERT_EQ(image.rows, 4);
+  ASSERT_EQ(image.cols, 6);
+  // north-up: the cell at (x, y) is at (row = height - 1 - y, col = x)
+  EXPECT_EQ(image.at<unsigned char>(3, 0), OccupancyGridAnalysis::FREE_SPACE);
+  EXPECT_EQ(image.at<unsigned char>(2, 1), OccupancyGridAnalysis::UNKNOWN);
+  EXPECT_EQ(image.at<unsigned char>(1, 3), OccupancyGridAnalysis::UNKNOWN);
+  EXPECT_EQ(image.at<unsigned char>(3, 5), OccupancyGridAnalysis::OCCUPIED);
+  // no information is regarded as 255
+  EXPECT_EQ(image.at<unsigned char>(0, 0), OccupancyGridAnalysis::OCCUPIED);
+  EXPECT_EQ(
+    analysis.getQuantizedImage(0, 255).at<unsigned char>(0, 0), OccupancyGridAnalysis::UNKNOWN);
+
+  // the result is cached
+  EXPECT_EQ(&image, &analysis.getQuantizedImage(10, 90));
+}
+
+TEST(OccupancyGridAnalysis, unknownMask)
+{
+  const OccupancyGridAnalysis analysis(generateOccupancyGrid());
+  EXPECT_EQ(cv::countNonZero(analysis.getUnknownMask(10, 90)), 6);
+  // the 3x2 unknown area is removed by the opening with 3x3 kernel
+  EXPECT_EQ(cv::countNonZero(analysis.getUnknownMask(10, 90, 3)), 0);
+  EXPECT_EQ(cv::countNonZero(analysis.getUnknownMask(10, 90, 2)), 6);
+}
+
+TEST(OccupancyGridAnalysis, unknownDistanceTransform)
+{
+  const OccupancyGridAnalysis analysis(generateOccupancyGrid());
+  const auto & distance = analysis.getUnknownDistanceTransform(10, 90);
+  EXPECT_FLOAT_EQ(distance.at<float>(3, 0), 0.0);
+  EXPECT_FLOAT_EQ(distance.at<float>(2, 2), 0.5);
+}
+
+TEST(OccupancyGridAnalysis, unknownConnectedComponents)
+{
+  const OccupancyGridAnalysis analysis(generateOccupancyGrid());
+  const auto & components = analysis.getUnknownConnectedComponents(10, 90);
+  ASSERT_EQ(components.num, 2);
+  EXPECT_EQ(components.stats.at<int>(1, cv::CC_STAT_LEFT), 1);
+  EXPECT_EQ(components.stats.at<int>(1, cv::CC_STAT_TOP), 1);
+  EXPECT_EQ(components.stats.at<int>(1, cv::CC_STAT_WIDTH), 3);
+  EXPECT_EQ(components.stats.at<int>(1, cv::CC_STAT_HEIGHT), 2);
+  EXPECT_EQ(components.stats.at<int>(1, cv::CC_STAT_AREA), 6);
+}
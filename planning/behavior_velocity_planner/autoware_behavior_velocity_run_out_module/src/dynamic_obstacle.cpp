@@ -14,21 +14,19 @@
 
 #include "dynamic_obstacle.hpp"
 
+#include "lateral_nearest_point_extractor.hpp"
+
 #include <autoware/motion_utils/trajectory/trajectory.hpp>
 #include <autoware/universe_utils/geometry/geometry.hpp>
 #include <autoware/universe_utils/geometry/pose_deviation.hpp>
 #include <autoware/universe_utils/math/unit_conversion.hpp>
 #include <autoware/universe_utils/ros/uuid_helper.hpp>
-#include <autoware/universe_utils/transform/transforms.hpp>
-
-#include <boost/geometry/algorithms/covered_by.hpp>
-#include <boost/geometry/algorithms/envelope.hpp>
-
-#include <pcl/filters/voxel_grid.h>
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <string>
+#include <vector>
 
 namespace autoware::behavior_velocity_planner
 {
@@ -67,180 +65,6 @@ std::vector<geometry_msgs::msg::Pose> createPredictedPath(
   return path_points;
 }
 
-pcl::PointCloud<pcl::PointXYZ> applyVoxelGridFilter(
-  const pcl::PointCloud<pcl::PointXYZ> & input_points)
-{
-  auto no_height_points = input_points;
-  for (auto & p : no_height_points) {
-    p.z = 0.0;
-  }
-
-  pcl::VoxelGrid<pcl::PointXYZ> filter;
-  filter.setInputCloud(pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(no_height_points));
-  filter.setLeafSize(0.05f, 0.05f, 100000.0f);
-
-  pcl::PointCloud<pcl::PointXYZ> output_points;
-  filter.filter(output_points);
-  output_points.header = input_points.header;
-
-  return output_points;
-}
-
-pcl::PointCloud<pcl::PointXYZ> applyVoxelGridFilter(
-  const sensor_msgs::msg::PointCloud2 & input_points)
-{
-  if (input_points.data.empty()) {
-    return pcl::PointCloud<pcl::PointXYZ>();
-  }
-
-  pcl::PointCloud<pcl::PointXYZ> input_points_pcl;
-  pcl::fromROSMsg(input_points, input_points_pcl);
-
-  auto no_height_points = input_points_pcl;
-  for (auto & p : no_height_points) {
-    p.z = 0.0;
-  }
-
-  pcl::VoxelGrid<pcl::PointXYZ> filter;
-  filter.setInputCloud(pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(no_height_points));
-  filter.setLeafSize(0.05f, 0.05f, 100000.0f);
-
-  pcl::PointCloud<pcl::PointXYZ> output_points;
-  filter.filter(output_points);
-
-  return output_points;
-}
-
-bool isAheadOf(
-  const geometry_msgs::msg::Point & target_point, const geometry_msgs::msg::Pose & base_pose)
-{
-  const auto longitudinal_deviation =
-    autoware::universe_utils::calcLongitudinalDeviation(base_pose, target_point);
-  const bool is_ahead = longitudinal_deviation > 0;
-  return is_ahead;
-}
-
-pcl::PointCloud<pcl::PointXYZ> extractObstaclePointsWithinPolygon(
-  const pcl::PointCloud<pcl::PointXYZ> & input_points, const Polygons2d & polys)
-{
-  namespace bg = boost::geometry;
-
-  if (polys.empty()) {
-    RCLCPP_WARN_STREAM(
-      rclcpp::get_logger("run_out"), "detection area polygon is empty. return empty points.");
-
-    const pcl::PointCloud<pcl::PointXYZ> empty_points;
-    return empty_points;
-  }
-
-  pcl::PointCloud<pcl::PointXYZ> output_points;
-  output_points.header = input_points.header;
-  for (const auto & poly : polys) {
-    const auto bounding_box = bg::return_envelope<autoware::universe_utils::Box2d>(poly);
-    for (const auto & p : input_points) {
-      Point2d point(p.x, p.y);
-
-      // filter with bounding box to reduce calculation time
-      if (!bg::covered_by(point, bounding_box)) {
-        continue;
-      }
-
-      if (!bg::covered_by(point, poly)) {
-        continue;
-      }
-
-      output_points.push_back(p);
-    }
-  }
-
-  return output_points;
-}
-
-// group points with its nearest segment of path points
-std::vector<pcl::PointCloud<pcl::PointXYZ>> groupPointsWithNearestSegmentIndex(
-  const pcl::PointCloud<pcl::PointXYZ> & input_points, const PathPointsWithLaneId & path_points)
-{
-  // assign nearest segment index to each point
-  std::vector<pcl::PointCloud<pcl::PointXYZ>> points_with_index;
-  points_with_index.resize(path_points.size());
-
-  for (const auto & p : input_points.points) {
-    const auto ros_point = autoware::universe_utils::createPoint(p.x, p.y, p.z);
-    const size_t nearest_seg_idx =
-      autoware::motion_utils::findNearestSegmentIndex(path_points, ros_point);
-
-    // if the point is ahead of end of the path, index should be path.size() - 1
-    if (
-      nearest_seg_idx == path_points.size() - 2 &&
-      isAheadOf(ros_point, path_points.back().point.pose)) {
-      points_with_index.back().push_back(p);
-      continue;
-    }
-
-    points_with_index.at(nearest_seg_idx).push_back(p);
-  }
-
-  return points_with_index;
-}
-
-// calculate lateral nearest point from base_pose
-pcl::PointXYZ calculateLateralNearestPoint(
-  const pcl::PointCloud<pcl::PointXYZ> & input_points, const geometry_msgs::msg::Pose & base_pose)
-{
-  const auto lateral_nearest_point = std::min_element(
-    input_points.points.begin(), input_points.points.end(), [&](const auto & p1, const auto & p2) {
-      const auto lateral_deviation_p1 = std::abs(autoware::universe_utils::calcLateralDeviation(
-        base_pose, autoware::universe_utils::createPoint(p1.x, p1.y, 0)));
-      const auto lateral_deviation_p2 = std::abs(autoware::universe_utils::calcLateralDeviation(
-        base_pose, autoware::universe_utils::createPoint(p2.x, p2.y, 0)));
-
-      return lateral_deviation_p1 < lateral_deviation_p2;
-    });
-
-  return *lateral_nearest_point;
-}
-
-pcl::PointCloud<pcl::PointXYZ> selectLateralNearestPoints(
-  const std::vector<pcl::PointCloud<pcl::PointXYZ>> & points_with_index,
-  const PathPointsWithLaneId & path_points)
-{
-  pcl::PointCloud<pcl::PointXYZ> lateral_nearest_points;
-  for (size_t idx = 0; idx < points_with_index.size(); idx++) {
-    if (points_with_index.at(idx).points.empty()) {
-      continue;
-    }
-
-    lateral_nearest_points.push_back(
-      calculateLateralNearestPoint(points_with_index.at(idx), path_points.at(idx).point.pose));
-  }
-
-  return lateral_nearest_points;
-}
-
-// extract lateral nearest points for nearest segment of the path
-// path is interpolated with given interval
-pcl::PointCloud<pcl::PointXYZ> extractLateralNearestPoints(
-  const pcl::PointCloud<pcl::PointXYZ> & input_points, const PathWithLaneId & path,
-  const float interval)
-{
-  // interpolate path points with given interval
-  PathWithLaneId interpolated_path;
-  if (!splineInterpolate(
-        path, interval, interpolated_path, rclcpp::get_logger("dynamic_obstacle_creator"))) {
-    return input_points;
-  }
-
-  // divide points into groups according to nearest segment index
-  const auto points_with_index =
-    groupPointsWithNearestSegmentIndex(input_points, interpolated_path.points);
-
-  // select the lateral nearest point for each group
-  const auto lateral_nearest_points =
-    selectLateralNearestPoints(points_with_index, interpolated_path.points);
-
-  return lateral_nearest_points;
-}
-
 std::optional<Eigen::Affine3f> getTransformMatrix(
   const tf2_ros::Buffer & tf_buffer, const std::string & target_frame_id,
   const std::string & source_frame_id, const builtin_interfaces::msg::Time & stamp)
@@ -257,39 +81,6 @@ std::optional<Eigen::Affine3f> getTransformMatrix(
   return transform_matrix;
 }
 
-pcl::PointCloud<pcl::PointXYZ> transformPointCloud(
-  const PointCloud2 & input_pointcloud, const Eigen::Affine3f & transform_matrix)
-{
-  if (input_pointcloud.data.empty()) {
-    return pcl::PointCloud<pcl::PointXYZ>();
-  }
-
-  pcl::PointCloud<pcl::PointXYZ> pointcloud_pcl;
-  pcl::fromROSMsg(input_pointcloud, pointcloud_pcl);
-  pcl::PointCloud<pcl::PointXYZ> pointcloud_pcl_transformed;
-  autoware::universe_utils::transformPointCloud(
-    pointcloud_pcl, pointcloud_pcl_transformed, transform_matrix);
-
-  return pointcloud_pcl_transformed;
-}
-
-PointCloud2 concatPointCloud(
-  const pcl::PointCloud<pcl::PointXYZ> & cloud1, const pcl::PointCloud<pcl::PointXYZ> & cloud2)
-{
-  // convert to ROS pointcloud to concatenate points
-  PointCloud2 cloud1_ros;
-  PointCloud2 cloud2_ros;
-  pcl::toROSMsg(cloud1, cloud1_ros);
-  pcl::toROSMsg(cloud2, cloud2_ros);
-
-  // concatenate two clouds
-  PointCloud2 concat_points;
-  pcl::concatenatePointCloud(cloud1_ros, cloud2_ros, concat_points);
-  concat_points.header = cloud1_ros.header;
-
-  return concat_points;
-}
-
 void calculateMinAndMaxVelFromCovariance(
   const geometry_msgs::msg::TwistWithCovariance & twist_with_covariance,
   const double std_dev_multiplier, run_out_utils::DynamicObstacle & dynamic_obstacle)
@@ -511,17 +302,11 @@ void DynamicObstacleCreatorForPoints::onCompareMapFilteredPointCloud(
     return;
   }
 
-  // transform and convert to pcl points for easier handling
   const auto transform_matrix =
     getTransformMatrix(tf_buffer_, "map", msg->header.frame_id, msg->header.stamp);
   if (!transform_matrix) {
     return;
   }
-  const pcl::PointCloud<pcl::PointXYZ> pc_transformed =
-    transformPointCloud(*msg, *transform_matrix);
-
-  // apply voxel grid filter to reduce calculation cost
-  const auto voxel_grid_filtered_points = applyVoxelGridFilter(pc_transformed);
 
   // these variables are written in another callback
   mutex_.lock();
@@ -529,13 +314,10 @@ void DynamicObstacleCreatorForPoints::onCompareMapFilteredPointCloud(
   const auto path = dynamic_obstacle_data_.path;
   mutex_.unlock();
 
-  // filter obstacle points within detection area polygon
-  const auto detection_area_filtered_points =
-    extractObstaclePointsWithinPolygon(voxel_grid_filtered_points, detection_area_polygon);
-
-  // filter points that have lateral nearest distance
-  const auto lateral_nearest_points =
-    extractLateralNearestPoints(detection_area_filtered_points, path, param_.points_interval);
+  // filter obstacle points within detection area polygon and that have lateral nearest distance
+  LateralNearestPointExtractor extractor(path, param_.points_interval, {detection_area_polygon});
+  extractor.addPoints(*msg, *transform_matrix, 0);
+  const auto lateral_nearest_points = extractor.getLateralNearestPoints();
 
   std::lock_guard<std::mutex> lock(mutex_);
   obstacle_points_map_filtered_ = lateral_nearest_points;
@@ -552,25 +334,12 @@ void DynamicObstacleCreatorForPoints::onSynchronizedPointCloud(
     return;
   }
 
-  // transform pointcloud and convert to pcl points for easier handling
   const auto transform_matrix = getTransformMatrix(
     tf_buffer_, "map", compare_map_filtered_points->header.frame_id,
     compare_map_filtered_points->header.stamp);
   if (!transform_matrix) {
     return;
   }
-  pcl::PointCloud<pcl::PointXYZ> compare_map_filtered_points_transformed =
-    transformPointCloud(*compare_map_filtered_points, *transform_matrix);
-  pcl::PointCloud<pcl::PointXYZ> vector_map_filtered_points_transformed =
-    transformPointCloud(*vector_map_filtered_points, *transform_matrix);
-  compare_map_filtered_points_transformed.header.frame_id = "map";
-  vector_map_filtered_points_transformed.header.frame_id = "map";
-
-  // apply voxel grid filter to reduce calculation cost
-  const auto voxel_grid_filtered_compare_map_points =
-    applyVoxelGridFilter(compare_map_filtered_points_transformed);
-  const auto voxel_grid_filtered_vector_map_points =
-    applyVoxelGridFilter(vector_map_filtered_points_transformed);
 
   // these variables are written in another callback
   mutex_.lock();
@@ -579,25 +348,19 @@ void DynamicObstacleCreatorForPoints::onSynchronizedPointCloud(
   const auto path = dynamic_obstacle_data_.path;
   mutex_.unlock();
 
-  // filter obstacle points within detection area polygon
-  const auto detection_area_filtered_compare_map_points = extractObstaclePointsWithinPolygon(
-    voxel_grid_filtered_compare_map_points, mandatory_detection_area);
-  const auto detection_area_filtered_vector_map_points =
-    extractObstaclePointsWithinPolygon(voxel_grid_filtered_vector_map_points, detection_area);
-
-  // concatenate two filtered pointclouds
-  const auto concat_points = concatPointCloud(
-    detection_area_filtered_compare_map_points, detection_area_filtered_vector_map_points);
-
-  // remove overlap points
-  const auto concat_points_no_overlap = applyVoxelGridFilter(concat_points);
-
-  // filter points that have lateral nearest distance
-  const auto lateral_nearest_points =
-    extractLateralNearestPoints(concat_points_no_overlap, path, param_.points_interval);
+  // filter obstacle points within detection area polygon and that have lateral nearest distance
+  // NOTE: the points overlapping in two pointclouds do not need to be removed since only the
+  // lateral nearest point is selected for each segment
+  LateralNearestPointExtractor extractor(
+    path, param_.points_interval, {mandatory_detection_area, detection_area});
+  extractor.addPoints(*compare_map_filtered_points, *transform_matrix, 0);
+  extractor.addPoints(*vector_map_filtered_points, *transform_matrix, 1);
+  const auto lateral_nearest_points = extractor.getLateralNearestPoints();
 
   // publish filtered pointcloud for debug
-  debug_ptr_->publishFilteredPointCloud(lateral_nearest_points, concat_points.header);
+  auto header = compare_map_filtered_points->header;
+  header.frame_id = "map";
+  debug_ptr_->publishFilteredPointCloud(lateral_nearest_points, header);
 
   std::lock_guard<std::mutex> lock(mutex_);
   obstacle_points_map_filtered_ = lateral_nearest_points;
@@ -0,0 +1,296 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lateral_nearest_point_extractor.hpp"
+
+#include <autoware/behavior_velocity_planner_common/utilization/path_utilization.hpp>
+
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <boost/geometry/algorithms/convert.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/disjoint.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+
+#include <tf2/utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace autoware::behavior_velocity_planner
+{
+using autoware::universe_utils::Box2d;
+
+namespace
+{
+// same leaf size as the voxel grid filter which was applied before the lateral nearest selection
+constexpr double fallback_voxel_size = 0.05;
+
+uint64_t createVoxelKey(const double x, const double y)
+{
+  const auto ix = static_cast<int32_t>(std::floor(x / fallback_voxel_size));
+  const auto iy = static_cast<int32_t>(std::floor(y / fallback_voxel_size));
+  return (static_cast<uint64_t>(static_cast<uint32_t>(ix)) << 32) | static_cast<uint32_t>(iy);
+}
+}  // namespace
+
+LateralNearestPointExtractor::LateralNearestPointExtractor(
+  const tier4_planning_msgs::msg::PathWithLaneId & path, const float interval,
+  std::vector<Polygons2d> areas)
+: areas_(std::move(areas))
+{
+  // interpolate path points with given interval
+  tier4_planning_msgs::msg::PathWithLaneId interpolated_path;
+  if (
+    splineInterpolate(
+      path, interval, interpolated_path, rclcpp::get_logger("dynamic_obstacle_creator")) &&
+    interpolated_path.points.size() > 1) {
+    for (const auto & p : interpolated_path.points) {
+      const auto & pose = p.point.pose;
+      const double yaw = tf2::getYaw(pose.orientation);
+      path_poses_.push_back({pose.position.x, pose.position.y, std::cos(yaw), std::sin(yaw)});
+    }
+    lateral_nearest_points_.resize(path_poses_.size());
+  }
+
+  // grid covering all the detection areas
+  double min_x = std::numeric_limits<double>::max();
+  double min_y = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  for (const auto & area : areas_) {
+    std::vector<Box2d> envelopes;
+    for (const auto & poly : area) {
+      const auto envelope = boost::geometry::return_envelope<Box2d>(poly);
+      min_x = std::min(min_x, envelope.min_corner().x());
+      min_y = std::min(min_y, envelope.min_corner().y());
+      max_x = std::max(max_x, envelope.max_corner().x());
+      max_y = std::max(max_y, envelope.max_corner().y());
+      envelopes.push_back(envelope);
+    }
+    area_envelopes_.push_back(envelopes);
+  }
+  if (min_x > max_x || min_y > max_y) {
+    return;
+  }
+  static constexpr size_t max_cell_num = 1 << 16;
+  cell_size_ = 1.0;
+  do {
+    grid_width_ = static_cast<size_t>((max_x - min_x) / cell_size_) + 1;
+    grid_height_ = static_cast<size_t>((max_y - min_y) / cell_size_) + 1;
+    cell_size_ *= 2.0;
+  } while (grid_width_ * grid_height_ > max_cell_num);
+  cell_size_ /= 2.0;
+  grid_min_x_ = min_x;
+  grid_min_y_ = min_y;
+  cells_.resize(grid_width_ * grid_height_);
+}
+
+void LateralNearestPointExtractor::addPoints(
+  const sensor_msgs::msg::PointCloud2 & points, const Eigen::Affine3f & transform_matrix,
+  const size_t area_idx)
+{
+  if (areas_.at(area_idx).empty()) {
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("run_out"), "detection area polygon is empty. return empty points.");
+    return;
+  }
+  if (points.width * points.height == 0) {
+    return;
+  }
+
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(points, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(points, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(points, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const Eigen::Vector3f p = transform_matrix * Eigen::Vector3f(*iter_x, *iter_y, *iter_z);
+    addPoint(p.x(), p.y(), area_idx);
+  }
+}
+
+pcl::PointCloud<pcl::PointXYZ> LateralNearestPointExtractor::getLateralNearestPoints() const
+{
+  // NOTE: the height is ignored as the voxel grid filter used to do
+  pcl::PointCloud<pcl::PointXYZ> output_points;
+  if (path_poses_.empty()) {
+    for (const auto key : fallback_voxel_keys_) {
+      const auto & voxel = fallback_voxels_.at(key);
+      output_points.push_back(
+        pcl::PointXYZ(voxel.sum_x / voxel.num, voxel.sum_y / voxel.num, 0.0));
+    }
+    return output_points;
+  }
+  for (const auto & p : lateral_nearest_points_) {
+    if (p.is_found) {
+      output_points.push_back(pcl::PointXYZ(p.x, p.y, 0.0));
+    }
+  }
+  return output_points;
+}
+
+const LateralNearestPointExtractor::Cell & LateralNearestPointExtractor::getCell(
+  const size_t ix, const size_t iy)
+{
+  namespace bg = boost::geometry;
+
+  auto & cell = cells_.at(iy * grid_width_ + ix);
+  if (cell.is_initialized) {
+    return cell;
+  }
+  cell.is_initialized = true;
+
+  const double cell_min_x = grid_min_x_ + ix * cell_size_;
+  const double cell_min_y = grid_min_y_ + iy * cell_size_;
+  Polygon2d cell_poly;
+  bg::convert(
+    Box2d(
+      Point2d(cell_min_x, cell_min_y), Point2d(cell_min_x + cell_size_, cell_min_y + cell_size_)),
+    cell_poly);
+  for (const auto & area : areas_) {
+    auto state = AreaState::OUTSIDE;
+    for (const auto & poly : area) {
+      if (bg::covered_by(cell_poly, poly)) {
+        state = AreaState::INSIDE;
+        break;
+      }
+      if (!bg::disjoint(cell_poly, poly)) {
+        state = AreaState::PARTIALLY_INSIDE;
+      }
+    }
+    cell.area_states.push_back(state);
+  }
+
+  // a path point farther than (the nearest distance from the center + the cell diagonal) from
+  // the center of the cell cannot be the nearest from any point in the cell
+  if (!path_poses_.empty()) {
+    const double center_x = cell_min_x + 0.5 * cell_size_;
+    const double center_y = cell_min_y + 0.5 * cell_size_;
+    std::vector<double> dists;
+    dists.reserve(path_poses_.size());
+    for (const auto & pose : path_poses_) {
+      dists.push_back(std::hypot(pose.x - center_x, pose.y - center_y));
+    }
+    const double max_dist =
+      *std::min_element(dists.begin(), dists.end()) + std::sqrt(2.0) * cell_size_;
+    for (size_t i = 0; i < dists.size(); ++i) {
+      if (dists.at(i) <= max_dist) {
+        cell.nearest_index_candidates.push_back(i);
+      }
+    }
+  }
+  return cell;
+}
+
+bool LateralNearestPointExtractor::isInArea(
+  const Cell & cell, const double x, const double y, const size_t area_idx) const
+{
+  namespace bg = boost::geometry;
+
+  const auto state = cell.area_states.at(area_idx);
+  if (state != AreaState::PARTIALLY_INSIDE) {
+    return state == AreaState::INSIDE;
+  }
+  const Point2d point(x, y);
+  const auto & area = areas_.at(area_idx);
+  const auto & envelopes = area_envelopes_.at(area_idx);
+  for (size_t i = 0; i < area.size(); ++i) {
+    // filter with bounding box to reduce calculation time
+    if (bg::covered_by(point, envelopes.at(i)) && bg::covered_by(point, area.at(i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// same as findNearestSegmentIndex, but the points ahead of the end of the path belong to the last
+// point
+size_t LateralNearestPointExtractor::findSegmentIndex(
+  const Cell & cell, const double x, const double y) const
+{
+  size_t nearest_idx = 0;
+  double min_squared_dist = std::numeric_limits<double>::max();
+  for (const auto i : cell.nearest_index_candidates) {
+    const double squared_dist =
+      std::pow(path_poses_.at(i).x - x, 2) + std::pow(path_poses_.at(i).y - y, 2);
+    if (squared_dist < min_squared_dist) {
+      min_squared_dist = squared_dist;
+      nearest_idx = i;
+    }
+  }
+
+  const size_t last_idx = path_poses_.size() - 1;
+  size_t seg_idx = nearest_idx;
+  if (nearest_idx == last_idx) {
+    seg_idx = last_idx - 1;
+  } else if (nearest_idx != 0) {
+    const auto & front = path_poses_.at(nearest_idx);
+    const auto & back = path_poses_.at(nearest_idx + 1);
+    const double signed_length =
+      (x - front.x) * (back.x - front.x) + (y - front.y) * (back.y - front.y);
+    if (signed_length <= 0.0) {
+      seg_idx = nearest_idx - 1;
+    }
+  }
+
+  // if the point is ahead of end of the path, index should be path.size() - 1
+  const auto & last_pose = path_poses_.at(last_idx);
+  if (
+    seg_idx == last_idx - 1 &&
+    (x - last_pose.x) * last_pose.cos_yaw + (y - last_pose.y) * last_pose.sin_yaw > 0.0) {
+    return last_idx;
+  }
+  return seg_idx;
+}
+
+void LateralNearestPointExtractor::addPoint(const double x, const double y, const size_t area_idx)
+{
+  if (x < grid_min_x_ || y < grid_min_y_) {
+    return;
+  }
+  const auto ix = static_cast<size_t>((x - grid_min_x_) / cell_size_);
+  const auto iy = static_cast<size_t>((y - grid_min_y_) / cell_size_);
+  if (ix >= grid_width_ || iy >= grid_height_) {
+    return;
+  }
+  const auto & cell = getCell(ix, iy);
+  if (!isInArea(cell, x, y, area_idx)) {
+    return;
+  }
+
+  // without the path, the points are de-duplicated with a voxel grid as before, which also removes
+  // the overlap between the clouds of the different areas
+  if (path_poses_.empty()) {
+    const auto key = createVoxelKey(x, y);
+    auto & voxel = fallback_voxels_[key];
+    if (voxel.num == 0) {
+      fallback_voxel_keys_.push_back(key);
+    }
+    voxel.sum_x += x;
+    voxel.sum_y += y;
+    ++voxel.num;
+    return;
+  }
+
+  const size_t idx = findSegmentIndex(cell, x, y);
+  const auto & base_pose = path_poses_.at(idx);
+  const double lateral_deviation =
+    std::abs((y - base_pose.y) * base_pose.cos_yaw - (x - base_pose.x) * base_pose.sin_yaw);
+  auto & lateral_nearest_point = lateral_nearest_points_.at(idx);
+  if (lateral_deviation < lateral_nearest_point.lateral_deviation) {
+    lateral_nearest_point = {true, x, y, lateral_deviation};
+  }
+}
+}  // namespace autoware::behavior_velocity_planner
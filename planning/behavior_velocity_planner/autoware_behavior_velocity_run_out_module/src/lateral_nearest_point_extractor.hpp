@@ -0,0 +1,112 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATERAL_NEAREST_POINT_EXTRACTOR_HPP_
+#define LATERAL_NEAREST_POINT_EXTRACTOR_HPP_
+
+#include "utils.hpp"
+
+#include <Eigen/Geometry>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <tier4_planning_msgs/msg/path_with_lane_id.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace autoware::behavior_velocity_planner
+{
+/**
+ * @brief extract the lateral nearest obstacle point for each segment of the interpolated path.
+ * The points are read from PointCloud2 in place and transformed one by one. A grid over the
+ * detection areas caches for each cell whether it is inside the areas and which path points can be
+ * the nearest, so that each point is processed in almost constant time without the intermediate
+ * pointclouds and the voxel grid filter.
+ */
+class LateralNearestPointExtractor
+{
+public:
+  LateralNearestPointExtractor(
+    const tier4_planning_msgs::msg::PathWithLaneId & path, const float interval,
+    std::vector<Polygons2d> areas);
+
+  void addPoints(
+    const sensor_msgs::msg::PointCloud2 & points, const Eigen::Affine3f & transform_matrix,
+    const size_t area_idx);
+
+  pcl::PointCloud<pcl::PointXYZ> getLateralNearestPoints() const;
+
+private:
+  enum class AreaState : uint8_t { OUTSIDE, INSIDE, PARTIALLY_INSIDE };
+
+  struct PathPose
+  {
+    double x;
+    double y;
+    double cos_yaw;
+    double sin_yaw;
+  };
+
+  struct LateralNearestPoint
+  {
+    bool is_found{false};
+    double x{0.0};
+    double y{0.0};
+    double lateral_deviation{std::numeric_limits<double>::max()};
+  };
+
+  struct Cell
+  {
+    bool is_initialized{false};
+    std::vector<AreaState> area_states;
+    // path point indices which can be the nearest from a point in the cell, in ascending order
+    std::vector<size_t> nearest_index_candidates;
+  };
+
+  // sum of the points in a voxel of the fallback output
+  struct Voxel
+  {
+    double sum_x{0.0};
+    double sum_y{0.0};
+    size_t num{0};
+  };
+
+  const Cell & getCell(const size_t ix, const size_t iy);
+  bool isInArea(const Cell & cell, const double x, const double y, const size_t area_idx) const;
+  size_t findSegmentIndex(const Cell & cell, const double x, const double y) const;
+  void addPoint(const double x, const double y, const size_t area_idx);
+
+  std::vector<Polygons2d> areas_;
+  std::vector<std::vector<autoware::universe_utils::Box2d>> area_envelopes_;
+  std::vector<PathPose> path_poses_;
+  std::vector<LateralNearestPoint> lateral_nearest_points_;
+  // points within the areas, which are output as voxel centroids when the path is not available
+  std::unordered_map<uint64_t, Voxel> fallback_voxels_;
+  std::vector<uint64_t> fallback_voxel_keys_;
+
+  double grid_min_x_{0.0};
+  double grid_min_y_{0.0};
+  double cell_size_{1.0};
+  size_t grid_width_{0};
+  size_t grid_height_{0};
+  std::vector<Cell> cells_;
+};
+}  // namespace autoware::behavior_velocity_planner
+
+#endif  // LATERAL_NEAREST_POINT_EXTRACTOR_HPP_
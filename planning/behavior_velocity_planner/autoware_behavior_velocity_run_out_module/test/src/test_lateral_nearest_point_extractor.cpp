@@ -0,0 +1,244 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lateral_nearest_point_extractor.hpp"
+
+#include <autoware/behavior_velocity_planner_common/utilization/path_utilization.hpp>
+#include <autoware/motion_utils/trajectory/trajectory.hpp>
+#include <autoware/universe_utils/geometry/geometry.hpp>
+#include <autoware/universe_utils/geometry/pose_deviation.hpp>
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+
+#include <gtest/gtest.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using autoware::behavior_velocity_planner::LateralNearestPointExtractor;
+using autoware::behavior_velocity_planner::Point2d;
+using autoware::behavior_velocity_planner::Polygon2d;
+using autoware::behavior_velocity_planner::Polygons2d;
+using tier4_planning_msgs::msg::PathPointWithLaneId;
+using tier4_planning_msgs::msg::PathWithLaneId;
+
+namespace
+{
+constexpr float points_interval = 1.0f;
+
+// path along an arc of 30 m radius
+PathWithLaneId createCurvedPath()
+{
+  PathWithLaneId path;
+  constexpr double radius = 30.0;
+  for (int i = 0; i < 20; ++i) {
+    const double theta = 0.06 * i;
+    PathPointWithLaneId p;
+    p.point.pose.position.x = radius * std::sin(theta);
+    p.point.pose.position.y = radius * (1.0 - std::cos(theta));
+    p.point.pose.orientation = autoware::universe_utils::createQuaternionFromYaw(theta);
+    p.point.longitudinal_velocity_mps = 10.0;
+    path.points.push_back(p);
+  }
+  return path;
+}
+
+Polygon2d createPolygon(const std::vector<Point2d> & points)
+{
+  Polygon2d poly;
+  for (const auto & p : points) {
+    poly.outer().push_back(p);
+  }
+  poly.outer().push_back(points.front());
+  boost::geometry::correct(poly);
+  return poly;
+}
+
+pcl::PointCloud<pcl::PointXYZ> createRandomPoints(const size_t num, const unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> dist_x(-10.0f, 45.0f);
+  std::uniform_real_distribution<float> dist_y(-10.0f, 25.0f);
+  std::uniform_real_distribution<float> dist_z(-1.0f, 2.0f);
+  pcl::PointCloud<pcl::PointXYZ> points;
+  for (size_t i = 0; i < num; ++i) {
+    points.push_back(pcl::PointXYZ(dist_x(engine), dist_y(engine), dist_z(engine)));
+  }
+  return points;
+}
+
+sensor_msgs::msg::PointCloud2 toMsg(const pcl::PointCloud<pcl::PointXYZ> & points)
+{
+  sensor_msgs::msg::PointCloud2 msg;
+  pcl::toROSMsg(points, msg);
+  return msg;
+}
+
+pcl::PointCloud<pcl::PointXYZ> transformPoints(
+  const pcl::PointCloud<pcl::PointXYZ> & points, const Eigen::Affine3f & transform_matrix)
+{
+  pcl::PointCloud<pcl::PointXYZ> output;
+  for (const auto & p : points) {
+    const Eigen::Vector3f q = transform_matrix * Eigen::Vector3f(p.x, p.y, p.z);
+    output.push_back(pcl::PointXYZ(q.x(), q.y(), q.z()));
+  }
+  return output;
+}
+
+// the pipeline used before LateralNearestPointExtractor: polygon filter -> grouping with the
+// nearest segment -> selection of the lateral nearest point of each group
+pcl::PointCloud<pcl::PointXYZ> extractLateralNearestPointsReference(
+  const std::vector<std::pair<pcl::PointCloud<pcl::PointXYZ>, Polygons2d>> & points_and_areas,
+  const PathWithLaneId & path)
+{
+  namespace bg = boost::geometry;
+  using autoware::universe_utils::createPoint;
+
+  pcl::PointCloud<pcl::PointXYZ> area_points;
+  for (const auto & [points, area] : points_and_areas) {
+    for (const auto & p : points) {
+      for (const auto & poly : area) {
+        if (bg::covered_by(Point2d(p.x, p.y), poly)) {
+          area_points.push_back(p);
+          break;
+        }
+      }
+    }
+  }
+
+  PathWithLaneId interpolated_path;
+  EXPECT_TRUE(autoware::behavior_velocity_planner::splineInterpolate(
+    path, points_interval, interpolated_path, rclcpp::get_logger("test")));
+  const auto & path_points = interpolated_path.points;
+
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> points_with_index(path_points.size());
+  for (const auto & p : area_points) {
+    const auto point = createPoint(p.x, p.y, p.z);
+    const size_t seg_idx = autoware::motion_utils::findNearestSegmentIndex(path_points, point);
+    if (
+      seg_idx == path_points.size() - 2 &&
+      autoware::universe_utils::calcLongitudinalDeviation(
+        path_points.back().point.pose, point) > 0) {
+      points_with_index.back().push_back(p);
+      continue;
+    }
+    points_with_index.at(seg_idx).push_back(p);
+  }
+
+  pcl::PointCloud<pcl::PointXYZ> output;
+  for (size_t i = 0; i < points_with_index.size(); ++i) {
+    const auto & base_pose = path_points.at(i).point.pose;
+    const auto & group = points_with_index.at(i);
+    if (group.empty()) {
+      continue;
+    }
+    const auto nearest = std::min_element(
+      group.begin(), group.end(), [&](const auto & p1, const auto & p2) {
+        return std::abs(autoware::universe_utils::calcLateralDeviation(
+                 base_pose, createPoint(p1.x, p1.y, 0.0))) <
+               std::abs(autoware::universe_utils::calcLateralDeviation(
+                 base_pose, createPoint(p2.x, p2.y, 0.0)));
+      });
+    output.push_back(*nearest);
+  }
+  return output;
+}
+}  // namespace
+
+TEST(LateralNearestPointExtractor, SameResultAsPolygonSegmentLateralNearestPipeline)
+{
+  const auto path = createCurvedPath();
+  // two overlapping areas with a concave one, which are partially covered by the grid cells
+  const Polygons2d area1{
+    createPolygon({{-5.0, -6.0}, {20.0, -4.0}, {22.0, 8.0}, {5.0, 3.0}, {-5.0, 5.0}})};
+  const Polygons2d area2{
+    createPolygon({{10.0, -2.0}, {40.0, 8.0}, {35.0, 22.0}, {12.0, 9.0}}),
+    createPolygon({{-8.0, 4.0}, {2.0, 4.0}, {2.0, 12.0}, {-8.0, 12.0}})};
+
+  Eigen::Affine3f transform_matrix = Eigen::Affine3f::Identity();
+  transform_matrix.translate(Eigen::Vector3f(1.5f, -0.5f, 0.3f));
+  transform_matrix.rotate(Eigen::AngleAxisf(0.1f, Eigen::Vector3f::UnitZ()));
+
+  for (unsigned int seed = 0; seed < 10; ++seed) {
+    const auto points1 = createRandomPoints(3000, seed);
+    const auto points2 = createRandomPoints(3000, seed + 100);
+
+    LateralNearestPointExtractor extractor(path, points_interval, {area1, area2});
+    extractor.addPoints(toMsg(points1), transform_matrix, 0);
+    extractor.addPoints(toMsg(points2), transform_matrix, 1);
+    const auto result = extractor.getLateralNearestPoints();
+
+    const auto expected = extractLateralNearestPointsReference(
+      {{transformPoints(points1, transform_matrix), area1},
+       {transformPoints(points2, transform_matrix), area2}},
+      path);
+
+    ASSERT_EQ(result.size(), expected.size()) << "seed: " << seed;
+    for (size_t i = 0; i < result.size(); ++i) {
+      EXPECT_FLOAT_EQ(result.at(i).x, expected.at(i).x) << "seed: " << seed << ", index: " << i;
+      EXPECT_FLOAT_EQ(result.at(i).y, expected.at(i).y) << "seed: " << seed << ", index: " << i;
+      EXPECT_FLOAT_EQ(result.at(i).z, 0.0f);
+    }
+  }
+}
+
+TEST(LateralNearestPointExtractor, FallbackPointsAreDeduplicatedWithVoxelGrid)
+{
+  // the path cannot be interpolated with a single point
+  PathWithLaneId path;
+  path.points.push_back(createCurvedPath().points.front());
+  const Polygons2d area{createPolygon({{0.0, 0.0}, {10.0, 0.0}, {10.0, 10.0}, {0.0, 10.0}})};
+
+  pcl::PointCloud<pcl::PointXYZ> points;
+  points.push_back(pcl::PointXYZ(1.01f, 1.01f, 0.5f));
+  points.push_back(pcl::PointXYZ(1.03f, 1.03f, 1.5f));
+  points.push_back(pcl::PointXYZ(1.07f, 1.01f, 0.0f));
+  points.push_back(pcl::PointXYZ(20.0f, 1.0f, 0.0f));
+
+  // the same points in the other cloud only add to the same voxels
+  LateralNearestPointExtractor extractor(path, points_interval, {area, area});
+  extractor.addPoints(toMsg(points), Eigen::Affine3f::Identity(), 0);
+  extractor.addPoints(toMsg(points), Eigen::Affine3f::Identity(), 1);
+  const auto result = extractor.getLateralNearestPoints();
+
+  // centroid of each 5 cm voxel within the area
+  std::map<std::pair<int, int>, std::vector<Eigen::Vector2d>> voxels;
+  for (const auto & p : points) {
+    if (!boost::geometry::covered_by(Point2d(p.x, p.y), area.front())) {
+      continue;
+    }
+    voxels[{static_cast<int>(std::floor(p.x / 0.05)), static_cast<int>(std::floor(p.y / 0.05))}]
+      .emplace_back(p.x, p.y);
+  }
+
+  ASSERT_EQ(result.size(), 2u);
+  ASSERT_EQ(voxels.size(), 2u);
+  auto voxel_itr = voxels.begin();
+  for (const auto & p : result) {
+    Eigen::Vector2d centroid = Eigen::Vector2d::Zero();
+    for (const auto & voxel_point : voxel_itr->second) {
+      centroid += voxel_point / static_cast<double>(voxel_itr->second.size());
+    }
+    EXPECT_NEAR(p.x, centroid.x(), 1e-5);
+    EXPECT_NEAR(p.y, centroid.y(), 1e-5);
+    EXPECT_FLOAT_EQ(p.z, 0.0f);
+    ++voxel_itr;
+  }
+}
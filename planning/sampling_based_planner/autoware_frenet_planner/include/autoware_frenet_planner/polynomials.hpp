@@ -15,6 +15,8 @@
 #ifndef AUTOWARE_FRENET_PLANNER__POLYNOMIALS_HPP_
 #define AUTOWARE_FRENET_PLANNER__POLYNOMIALS_HPP_
 
+#include <Eigen/Core>
+
 namespace autoware::frenet_planner
 {
 class Polynomial
@@ -49,6 +51,15 @@ public:
   [[nodiscard]] double acceleration(const double t) const;
   /// @brief Get the jerk at the given time
   [[nodiscard]] double jerk(const double t) const;
+
+  /// @brief Get the positions at the given times, evaluated with vectorized operations
+  [[nodiscard]] Eigen::ArrayXd positions(const Eigen::Ref<const Eigen::ArrayXd> & t) const;
+  /// @brief Get the velocities at the given times, evaluated with vectorized operations
+  [[nodiscard]] Eigen::ArrayXd velocities(const Eigen::Ref<const Eigen::ArrayXd> & t) const;
+  /// @brief Get the accelerations at the given times, evaluated with vectorized operations
+  [[nodiscard]] Eigen::ArrayXd accelerations(const Eigen::Ref<const Eigen::ArrayXd> & t) const;
+  /// @brief Get the jerks at the given times, evaluated with vectorized operations
+  [[nodiscard]] Eigen::ArrayXd jerks(const Eigen::Ref<const Eigen::ArrayXd> & t) const;
 };
 }  // namespace autoware::frenet_planner
 
@@ -18,6 +18,7 @@
 #include <autoware_frenet_planner/conversions.hpp>
 #include <autoware_frenet_planner/polynomials.hpp>
 #include <autoware_frenet_planner/structures.hpp>
+#include <autoware_sampler_common/constraints/parallel_for.hpp>
 #include <autoware_sampler_common/structures.hpp>
 #include <autoware_sampler_common/transform/spline_transform.hpp>
 #include <eigen3/Eigen/Eigen>
@@ -30,17 +31,104 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 namespace autoware::frenet_planner
 {
+namespace
+{
+using autoware::sampler_common::Point2d;
+using autoware::sampler_common::constraints::parallelFor;
+
+/// @brief offsets from the initial arc length or time sampled with the given resolution
+std::vector<double> sampleOffsets(const double start, const double end, const double resolution)
+{
+  std::vector<double> offsets;
+  for (double offset = start; offset <= end; offset += resolution) {
+    offsets.push_back(offset);
+  }
+  return offsets;
+}
+
+/// @brief points of the reference and their left unit vectors at the arc lengths shared by all
+/// the candidate paths
+/// @details the reference spline is evaluated once per arc length instead of once per point of
+/// each candidate
+class ReferenceCache
+{
+public:
+  ReferenceCache(
+    const autoware::sampler_common::transform::Spline2D & reference, const double initial_s,
+    const std::vector<double> & offsets)
+  {
+    points_.reserve(offsets.size());
+    lefts_.reserve(offsets.size());
+    for (const auto offset : offsets) {
+      const auto s = initial_s + offset;
+      const auto heading = reference.yaw(s);
+      points_.push_back(reference.cartesian(s));
+      lefts_.emplace_back(std::cos(heading + M_PI_2), std::sin(heading + M_PI_2));
+    }
+  }
+
+  /// @brief same as Spline2D::cartesian({initial_s + offsets[i], d}), within rounding
+  [[nodiscard]] Point2d cartesian(const size_t i, const double d) const
+  {
+    return {points_[i].x() + d * lefts_[i].x(), points_[i].y() + d * lefts_[i].y()};
+  }
+
+private:
+  std::vector<Point2d> points_;
+  std::vector<Point2d> lefts_;
+};
+
+/// @brief calculate the yaws, lengths, poses, and curvatures from the cartesian points of the path
+void calculateYawsAndCurvatures(Path & path)
+{
+  path.yaws.reserve(path.points.size());
+  path.lengths.reserve(path.points.size());
+  path.curvatures.reserve(path.points.size());
+  path.poses.reserve(path.points.size());
+  // TODO(Maxime CLEMENT): more precise calculations are proposed in Appendix I of the paper:
+  // Optimal path Generation for Dynamic Street Scenarios in a Frenet Frame (Werling2010)
+  // Calculate cartesian yaw and interval values
+  path.lengths.push_back(0.0);
+  for (auto it = path.points.begin(); it != std::prev(path.points.end()); ++it) {
+    const auto dx = std::next(it)->x() - it->x();
+    const auto dy = std::next(it)->y() - it->y();
+    const auto yaw = std::atan2(dy, dx);
+    path.yaws.push_back(yaw);
+    path.lengths.push_back(path.lengths.back() + std::hypot(dx, dy));
+
+    geometry_msgs::msg::Pose pose;
+    pose.position.x = it->x();
+    pose.position.y = it->y();
+    pose.position.z = 0.0;
+    pose.orientation = autoware::universe_utils::createQuaternionFromRPY(0.0, 0.0, yaw);
+    path.poses.push_back(pose);
+  }
+  path.yaws.push_back(path.yaws.back());
+  path.poses.push_back(path.poses.back());
+
+  // Calculate curvatures
+  for (size_t i = 1; i < path.yaws.size(); ++i) {
+    const auto dyaw =
+      autoware::common::helper_functions::wrap_angle(path.yaws[i] - path.yaws[i - 1]);
+    path.curvatures.push_back(dyaw / (path.lengths[i] - path.lengths[i - 1]));
+  }
+  path.curvatures.push_back(path.curvatures.back());
+}
+}  // namespace
+
 std::vector<Trajectory> generateTrajectories(
   const autoware::sampler_common::transform::Spline2D & reference_spline,
   const FrenetState & initial_state, const SamplingParameters & sampling_parameters)
 {
-  std::vector<Trajectory> trajectories;
-  trajectories.reserve(sampling_parameters.parameters.size());
-  for (const auto & parameter : sampling_parameters.parameters) {
-    auto trajectory = generateCandidate(
+  std::vector<Trajectory> trajectories(sampling_parameters.parameters.size());
+  parallelFor(trajectories.size(), [&](const size_t i) {
+    const auto & parameter = sampling_parameters.parameters[i];
+    auto & trajectory = trajectories[i];
+    trajectory = generateCandidate(
       initial_state, parameter.target_state, parameter.target_duration,
       sampling_parameters.resolution);
     trajectory.sampling_parameter = parameter;
@@ -48,8 +136,7 @@ std::vector<Trajectory> generateTrajectories(
     std::stringstream ss;
     ss << parameter;
     trajectory.tag = ss.str();
-    trajectories.push_back(trajectory);
-  }
+  });
   return trajectories;
 }
 
@@ -57,18 +144,18 @@ std::vector<Trajectory> generateLowVelocityTrajectories(
   const autoware::sampler_common::transform::Spline2D & reference_spline,
   const FrenetState & initial_state, const SamplingParameters & sampling_parameters)
 {
-  std::vector<Trajectory> trajectories;
-  trajectories.reserve(sampling_parameters.parameters.size());
-  for (const auto & parameter : sampling_parameters.parameters) {
-    auto trajectory = generateLowVelocityCandidate(
+  std::vector<Trajectory> trajectories(sampling_parameters.parameters.size());
+  parallelFor(trajectories.size(), [&](const size_t i) {
+    const auto & parameter = sampling_parameters.parameters[i];
+    auto & trajectory = trajectories[i];
+    trajectory = generateLowVelocityCandidate(
       initial_state, parameter.target_state, parameter.target_duration,
       sampling_parameters.resolution);
     calculateCartesian(reference_spline, trajectory);
     std::stringstream ss;
     ss << parameter;
     trajectory.tag = ss.str();
-    trajectories.push_back(trajectory);
-  }
+  });
   return trajectories;
 }
 
@@ -76,14 +163,30 @@ std::vector<Path> generatePaths(
   const autoware::sampler_common::transform::Spline2D & reference_spline,
   const FrenetState & initial_state, const SamplingParameters & sampling_parameters)
 {
-  std::vector<Path> candidates;
-  candidates.reserve(sampling_parameters.parameters.size());
-  for (const auto parameter : sampling_parameters.parameters) {
-    auto candidate =
-      generateCandidate(initial_state, parameter.target_state, sampling_parameters.resolution);
-    calculateCartesian(reference_spline, candidate);
-    candidates.push_back(candidate);
+  // all the candidates are sampled at the same arc lengths, so the reference is evaluated once
+  double max_delta_s = 0.0;
+  for (const auto & parameter : sampling_parameters.parameters) {
+    max_delta_s =
+      std::max(max_delta_s, parameter.target_state.position.s - initial_state.position.s);
   }
+  const ReferenceCache reference_cache(
+    reference_spline, initial_state.position.s,
+    sampleOffsets(sampling_parameters.resolution, max_delta_s, sampling_parameters.resolution));
+
+  std::vector<Path> candidates(sampling_parameters.parameters.size());
+  parallelFor(candidates.size(), [&](const size_t i) {
+    auto & candidate = candidates[i];
+    candidate = generateCandidate(
+      initial_state, sampling_parameters.parameters[i].target_state,
+      sampling_parameters.resolution);
+    if (!candidate.frenet_points.empty()) {
+      candidate.points.reserve(candidate.frenet_points.size());
+      for (size_t j = 0; j < candidate.frenet_points.size(); ++j) {
+        candidate.points.push_back(reference_cache.cartesian(j, candidate.frenet_points[j].d));
+      }
+      calculateYawsAndCurvatures(candidate);
+    }
+  });
   return candidates;
 }
 
@@ -100,10 +203,13 @@ Trajectory generateCandidate(
     initial_state.position.d, initial_state.lateral_velocity, initial_state.lateral_acceleration,
     target_state.position.d, target_state.lateral_velocity, target_state.lateral_acceleration,
     duration);
-  for (double t = 0.0; t <= duration; t += time_resolution) {
-    trajectory.times.push_back(t);
-    trajectory.frenet_points.emplace_back(
-      trajectory.longitudinal_polynomial->position(t), trajectory.lateral_polynomial->position(t));
+  trajectory.times = sampleOffsets(0.0, duration, time_resolution);
+  const Eigen::Map<const Eigen::ArrayXd> times(trajectory.times.data(), trajectory.times.size());
+  const Eigen::ArrayXd ss = trajectory.longitudinal_polynomial->positions(times);
+  const Eigen::ArrayXd ds = trajectory.lateral_polynomial->positions(times);
+  trajectory.frenet_points.reserve(trajectory.times.size());
+  for (Eigen::Index i = 0; i < times.size(); ++i) {
+    trajectory.frenet_points.emplace_back(ss[i], ds[i]);
   }
   return trajectory;
 }
@@ -122,12 +228,14 @@ Trajectory generateLowVelocityCandidate(
     initial_state.position.d, initial_state.lateral_velocity, initial_state.lateral_acceleration,
     target_state.position.d, target_state.lateral_velocity, target_state.lateral_acceleration,
     delta_s);
-  for (double t = 0.0; t <= duration; t += time_resolution) {
-    trajectory.times.push_back(t);
-    const auto s = trajectory.longitudinal_polynomial->position(t);
-    const auto ds = s - initial_state.position.s;
-    const auto d = trajectory.lateral_polynomial->position(ds);
-    trajectory.frenet_points.emplace_back(s, d);
+  trajectory.times = sampleOffsets(0.0, duration, time_resolution);
+  const Eigen::Map<const Eigen::ArrayXd> times(trajectory.times.data(), trajectory.times.size());
+  const Eigen::ArrayXd ss = trajectory.longitudinal_polynomial->positions(times);
+  const Eigen::ArrayXd ds =
+    trajectory.lateral_polynomial->positions(ss - initial_state.position.s);
+  trajectory.frenet_points.reserve(trajectory.times.size());
+  for (Eigen::Index i = 0; i < times.size(); ++i) {
+    trajectory.frenet_points.emplace_back(ss[i], ds[i]);
   }
   return trajectory;
 }
@@ -141,9 +249,12 @@ Path generateCandidate(
     initial_state.position.d, initial_state.lateral_velocity, initial_state.lateral_acceleration,
     target_state.position.d, target_state.lateral_velocity, target_state.lateral_acceleration,
     delta_s);
-  for (double s = s_resolution; s <= delta_s; s += s_resolution) {
-    path.frenet_points.emplace_back(
-      initial_state.position.s + s, path.lateral_polynomial->position(s));
+  const auto offsets = sampleOffsets(s_resolution, delta_s, s_resolution);
+  const Eigen::ArrayXd ds = path.lateral_polynomial->positions(
+    Eigen::Map<const Eigen::ArrayXd>(offsets.data(), offsets.size()));
+  path.frenet_points.reserve(offsets.size());
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    path.frenet_points.emplace_back(initial_state.position.s + offsets[i], ds[i]);
   }
   return path;
 }
@@ -153,42 +264,11 @@ void calculateCartesian(
 {
   if (!path.frenet_points.empty()) {
     path.points.reserve(path.frenet_points.size());
-    path.yaws.reserve(path.frenet_points.size());
-    path.lengths.reserve(path.frenet_points.size());
-    path.curvatures.reserve(path.frenet_points.size());
-    path.poses.reserve(path.frenet_points.size());
     // Calculate cartesian positions
     for (const auto & fp : path.frenet_points) {
       path.points.push_back(reference.cartesian(fp));
     }
-    // TODO(Maxime CLEMENT): more precise calculations are proposed in Appendix I of the paper:
-    // Optimal path Generation for Dynamic Street Scenarios in a Frenet Frame (Werling2010)
-    // Calculate cartesian yaw and interval values
-    path.lengths.push_back(0.0);
-    for (auto it = path.points.begin(); it != std::prev(path.points.end()); ++it) {
-      const auto dx = std::next(it)->x() - it->x();
-      const auto dy = std::next(it)->y() - it->y();
-      const auto yaw = std::atan2(dy, dx);
-      path.yaws.push_back(yaw);
-      path.lengths.push_back(path.lengths.back() + std::hypot(dx, dy));
-
-      geometry_msgs::msg::Pose pose;
-      pose.position.x = it->x();
-      pose.position.y = it->y();
-      pose.position.z = 0.0;
-      pose.orientation = autoware::universe_utils::createQuaternionFromRPY(0.0, 0.0, yaw);
-      path.poses.push_back(pose);
-    }
-    path.yaws.push_back(path.yaws.back());
-    path.poses.push_back(path.poses.back());
-
-    // Calculate curvatures
-    for (size_t i = 1; i < path.yaws.size(); ++i) {
-      const auto dyaw =
-        autoware::common::helper_functions::wrap_angle(path.yaws[i] - path.yaws[i - 1]);
-      path.curvatures.push_back(dyaw / (path.lengths[i] - path.lengths[i - 1]));
-    }
-    path.curvatures.push_back(path.curvatures.back());
+    calculateYawsAndCurvatures(path);
   }
 }
 void calculateCartesian(
@@ -216,24 +296,25 @@ void calculateCartesian(
     const auto last_curvature = trajectory.curvatures.empty() ? 0.0 : trajectory.curvatures.back();
     trajectory.curvatures.push_back(last_curvature);
     // Calculate velocities, accelerations, jerk
-    for (size_t i = 0; i < trajectory.times.size(); ++i) {
-      const auto time = trajectory.times[i];
-      const auto s_vel = trajectory.longitudinal_polynomial->velocity(time);
-      const auto s_acc = trajectory.longitudinal_polynomial->acceleration(time);
-      const auto d_vel = trajectory.lateral_polynomial->velocity(time);
-      const auto d_acc = trajectory.lateral_polynomial->acceleration(time);
+    const Eigen::Map<const Eigen::ArrayXd> times(trajectory.times.data(), trajectory.times.size());
+    const Eigen::ArrayXd s_vels = trajectory.longitudinal_polynomial->velocities(times);
+    const Eigen::ArrayXd s_accs = trajectory.longitudinal_polynomial->accelerations(times);
+    const Eigen::ArrayXd d_vels = trajectory.lateral_polynomial->velocities(times);
+    const Eigen::ArrayXd d_accs = trajectory.lateral_polynomial->accelerations(times);
+    const Eigen::ArrayXd jerks = trajectory.longitudinal_polynomial->jerks(times) +
+                                 trajectory.lateral_polynomial->jerks(times);
+    for (Eigen::Index i = 0; i < times.size(); ++i) {
       Eigen::Rotation2D rotation(d_yaws[i]);
-      Eigen::Vector2d vel_vector{s_vel, d_vel};
-      Eigen::Vector2d acc_vector{s_acc, d_acc};
+      Eigen::Vector2d vel_vector{s_vels[i], d_vels[i]};
+      Eigen::Vector2d acc_vector{s_accs[i], d_accs[i]};
       const auto vel = rotation * vel_vector;
       const auto acc = rotation * acc_vector;
       trajectory.longitudinal_velocities.push_back(vel.x());
       trajectory.lateral_velocities.push_back(vel.y());
       trajectory.longitudinal_accelerations.push_back(acc.x());
       trajectory.lateral_accelerations.push_back(acc.y());
-      trajectory.jerks.push_back(
-        trajectory.longitudinal_polynomial->jerk(time) + trajectory.lateral_polynomial->jerk(time));
     }
+    trajectory.jerks.assign(jerks.data(), jerks.data() + jerks.size());
     if (trajectory.longitudinal_accelerations.empty()) {
       trajectory.longitudinal_accelerations.push_back(0.0);
       trajectory.lateral_accelerations.push_back(0.0);
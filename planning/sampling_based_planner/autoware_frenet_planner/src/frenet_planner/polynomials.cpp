@@ -72,4 +72,36 @@ double Polynomial::jerk(const double t) const
   const double t2 = t * t;
   return 60 * a_ * t2 + 24 * b_ * t + 6 * c_;
 }
+
+// the batch evaluations use the same operations as the scalar ones. The results are equal within
+// rounding as the compiler may contract the operations differently (e.g., fused multiply-adds).
+Eigen::ArrayXd Polynomial::positions(const Eigen::Ref<const Eigen::ArrayXd> & t) const
+{
+  const Eigen::ArrayXd t2 = t * t;
+  const Eigen::ArrayXd t3 = t2 * t;
+  const Eigen::ArrayXd t4 = t3 * t;
+  const Eigen::ArrayXd t5 = t4 * t;
+  return a_ * t5 + b_ * t4 + c_ * t3 + d_ * t2 + e_ * t + f_;
+}
+
+Eigen::ArrayXd Polynomial::velocities(const Eigen::Ref<const Eigen::ArrayXd> & t) const
+{
+  const Eigen::ArrayXd t2 = t * t;
+  const Eigen::ArrayXd t3 = t2 * t;
+  const Eigen::ArrayXd t4 = t3 * t;
+  return 5 * a_ * t4 + 4 * b_ * t3 + 3 * c_ * t2 + 2 * d_ * t + e_;
+}
+
+Eigen::ArrayXd Polynomial::accelerations(const Eigen::Ref<const Eigen::ArrayXd> & t) const
+{
+  const Eigen::ArrayXd t2 = t * t;
+  const Eigen::ArrayXd t3 = t2 * t;
+  return 20 * a_ * t3 + 12 * b_ * t2 + 6 * c_ * t + 2 * d_;
+}
+
+Eigen::ArrayXd Polynomial::jerks(const Eigen::Ref<const Eigen::ArrayXd> & t) const
+{
+  const Eigen::ArrayXd t2 = t * t;
+  return 60 * a_ * t2 + 24 * b_ * t + 6 * c_;
+}
 }  // namespace autoware::frenet_planner
@@ -0,0 +1,140 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware_frenet_planner/frenet_planner.hpp>
+#include <autoware_frenet_planner/polynomials.hpp>
+#include <autoware_sampler_common/transform/spline_transform.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using autoware::frenet_planner::Polynomial;
+
+namespace
+{
+// the batch and scalar evaluations may round differently (e.g., with fused multiply-adds)
+constexpr auto TOL = 1E-9;
+
+double relativeTolerance(const double expected)
+{
+  return TOL * std::max(1.0, std::abs(expected));
+}
+
+autoware::sampler_common::transform::Spline2D createWindingReference()
+{
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (auto i = 0; i < 50; ++i) {
+    xs.push_back(2.0 * i);
+    ys.push_back(5.0 * std::sin(0.1 * i));
+  }
+  return {xs, ys};
+}
+}  // namespace
+
+TEST(Polynomial, batchEvaluationsEqualScalarEvaluations)
+{
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> state_distribution(-10.0, 10.0);
+  std::uniform_real_distribution<double> length_distribution(0.5, 50.0);
+  std::uniform_int_distribution<int> size_distribution(1, 200);
+  for (auto iter = 0; iter < 100; ++iter) {
+    const auto length = length_distribution(gen);
+    const Polynomial polynomial(
+      state_distribution(gen), state_distribution(gen), state_distribution(gen),
+      state_distribution(gen), state_distribution(gen), state_distribution(gen), length);
+    // random times including the negative ones and the ones beyond the parameter length
+    std::uniform_real_distribution<double> time_distribution(-1.0, length + 1.0);
+    Eigen::ArrayXd times(size_distribution(gen));
+    for (Eigen::Index i = 0; i < times.size(); ++i) {
+      times[i] = time_distribution(gen);
+    }
+
+    const Eigen::ArrayXd positions = polynomial.positions(times);
+    const Eigen::ArrayXd velocities = polynomial.velocities(times);
+    const Eigen::ArrayXd accelerations = polynomial.accelerations(times);
+    const Eigen::ArrayXd jerks = polynomial.jerks(times);
+    ASSERT_EQ(positions.size(), times.size());
+    ASSERT_EQ(velocities.size(), times.size());
+    ASSERT_EQ(accelerations.size(), times.size());
+    ASSERT_EQ(jerks.size(), times.size());
+    for (Eigen::Index i = 0; i < times.size(); ++i) {
+      const auto t = times[i];
+      const auto position = polynomial.position(t);
+      const auto velocity = polynomial.velocity(t);
+      const auto acceleration = polynomial.acceleration(t);
+      const auto jerk = polynomial.jerk(t);
+      EXPECT_NEAR(positions[i], position, relativeTolerance(position)) << "t = " << t;
+      EXPECT_NEAR(velocities[i], velocity, relativeTolerance(velocity)) << "t = " << t;
+      EXPECT_NEAR(accelerations[i], acceleration, relativeTolerance(acceleration)) << "t = " << t;
+      EXPECT_NEAR(jerks[i], jerk, relativeTolerance(jerk)) << "t = " << t;
+    }
+  }
+}
+
+TEST(FrenetPlanner, generatePathsEqualPerPointConversion)
+{
+  using autoware::frenet_planner::FrenetState;
+  using autoware::frenet_planner::Path;
+  using autoware::frenet_planner::SamplingParameter;
+  using autoware::frenet_planner::SamplingParameters;
+
+  const auto reference = createWindingReference();
+  FrenetState initial_state;
+  initial_state.position = {3.0, 0.5};
+  initial_state.lateral_velocity = 0.1;
+  initial_state.lateral_acceleration = -0.05;
+
+  // the candidates have different lengths so that they share only a part of the arc lengths
+  SamplingParameters sampling_parameters;
+  sampling_parameters.resolution = 0.5;
+  for (const auto target_length : {5.0, 12.3, 30.0}) {
+    for (const auto target_d : {-2.0, 0.0, 1.5}) {
+      SamplingParameter parameter;
+      parameter.target_state.position = {initial_state.position.s + target_length, target_d};
+      sampling_parameters.parameters.push_back(parameter);
+    }
+  }
+
+  const auto paths =
+    autoware::frenet_planner::generatePaths(reference, initial_state, sampling_parameters);
+  ASSERT_EQ(paths.size(), sampling_parameters.parameters.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const auto & path = paths[i];
+    // the candidate converted point by point with the reference spline
+    Path expected = autoware::frenet_planner::generateCandidate(
+      initial_state, sampling_parameters.parameters[i].target_state,
+      sampling_parameters.resolution);
+    autoware::frenet_planner::calculateCartesian(reference, expected);
+
+    ASSERT_FALSE(path.points.empty());
+    ASSERT_EQ(path.frenet_points.size(), expected.frenet_points.size());
+    ASSERT_EQ(path.points.size(), expected.points.size());
+    ASSERT_EQ(path.yaws.size(), expected.yaws.size());
+    ASSERT_EQ(path.curvatures.size(), expected.curvatures.size());
+    for (size_t j = 0; j < path.points.size(); ++j) {
+      const auto & fp = path.frenet_points[j];
+      const auto ds = fp.s - initial_state.position.s;
+      EXPECT_NEAR(fp.d, path.lateral_polynomial->position(ds), TOL);
+      EXPECT_NEAR(path.points[j].x(), expected.points[j].x(), TOL);
+      EXPECT_NEAR(path.points[j].y(), expected.points[j].y(), TOL);
+      EXPECT_NEAR(path.yaws[j], expected.yaws[j], TOL);
+      EXPECT_NEAR(path.curvatures[j], expected.curvatures[j], 1E-6);
+    }
+  }
+}
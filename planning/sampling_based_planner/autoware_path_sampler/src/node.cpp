@@ -475,13 +475,10 @@ autoware::sampler_common::Path PathSampler::generatePath(const PlannerData & pla
     generateCandidatesFromPreviousPath(planner_data, path_spline);
   candidate_paths.insert(
     candidate_paths.end(), candidates_from_prev_path.begin(), candidates_from_prev_path.end());
-  debug_data_.footprints.clear();
-  for (auto & path : candidate_paths) {
-    const auto footprint =
-      autoware::sampler_common::constraints::checkHardConstraints(path, params_.constraints);
-    debug_data_.footprints.push_back(footprint);
-    autoware::sampler_common::constraints::calculateCost(path, params_.constraints, path_spline);
-  }
+  debug_data_.footprints = autoware::sampler_common::constraints::checkHardConstraints(
+    candidate_paths, params_.constraints);
+  autoware::sampler_common::constraints::calculateCost(
+    candidate_paths, params_.constraints, path_spline);
   const auto best_path_idx = [](const auto & paths) {
     auto min_cost = std::numeric_limits<double>::max();
     size_t best_path_idx = 0;
@@ -0,0 +1,65 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_SAMPLER_COMMON__CONSTRAINTS__CONSTRAINT_GRID_HPP_
+#define AUTOWARE_SAMPLER_COMMON__CONSTRAINTS__CONSTRAINT_GRID_HPP_
+
+#include "autoware_sampler_common/structures.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace autoware::sampler_common::constraints
+{
+/// @brief raster of the drivable area and of the obstacles shared by the checks of many points
+/// @details each cell stores whether it is inside, outside, or on the boundary of the drivable area
+/// and whether it may be within the minimum distance from an obstacle. The exact geometric checks
+/// are only done for the points in the cells on the boundary or near an obstacle, so the results
+/// are the same as boost::geometry::covered_by and boost::geometry::distance.
+class ConstraintGrid
+{
+public:
+  /// @brief build the grid
+  /// @param [in] constraints constraints with the drivable area and the obstacles
+  /// @param [in] area area covered by the grid. The points outside are checked exactly
+  /// @param [in] resolution [m] size of the cells. Increased if the grid has too many cells
+  ConstraintGrid(
+    const Constraints & constraints, const autoware::universe_utils::Box2d & area,
+    const double resolution);
+
+  /// @brief return true if the point is covered by the drivable polygons
+  [[nodiscard]] bool isInsideDrivableArea(const Point2d & p) const;
+  /// @brief return true if the point is within the minimum distance from an obstacle
+  [[nodiscard]] bool isColliding(const Point2d & p) const;
+
+private:
+  enum class CellState : uint8_t { OUTSIDE, INSIDE, BOUNDARY };
+
+  [[nodiscard]] bool getCellIndex(const Point2d & p, size_t & index) const;
+  void markBoundary(const Point2d & from, const Point2d & to);
+
+  const Constraints & constraints_;
+  double origin_x_;
+  double origin_y_;
+  double resolution_;
+  size_t width_;
+  size_t height_;
+  std::vector<CellState> drivable_area_cells_;
+  std::vector<bool> near_obstacle_cells_;
+  // envelopes of the obstacles expanded by the minimum distance
+  std::vector<autoware::universe_utils::Box2d> obstacle_envelopes_;
+};
+}  // namespace autoware::sampler_common::constraints
+
+#endif  // AUTOWARE_SAMPLER_COMMON__CONSTRAINTS__CONSTRAINT_GRID_HPP_
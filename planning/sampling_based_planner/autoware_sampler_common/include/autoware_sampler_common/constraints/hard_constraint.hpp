@@ -22,6 +22,16 @@ namespace autoware::sampler_common::constraints
 {
 /// @brief Check if the path satisfies the hard constraints
 MultiPoint2d checkHardConstraints(Path & path, const Constraints & constraints);
+/// @brief check the hard constraints of all the given paths at once
+/// @details the drivable area and the obstacles are rasterized once for all the paths (see
+/// ConstraintGrid) and the paths are checked in parallel. The results are the same as checking
+/// each path with checkHardConstraints(Path &, const Constraints &)
+/// @param [inout] paths paths whose constraint_results are updated
+/// @param [in] constraints constraints
+/// @param [in] grid_resolution [m] resolution of the raster
+/// @return footprint of each path
+std::vector<MultiPoint2d> checkHardConstraints(
+  std::vector<Path> & paths, const Constraints & constraints, const double grid_resolution = 0.5);
 bool has_collision(
   const MultiPoint2d & footprint, const MultiPolygon2d & obstacles,
   const double min_distance = 0.0);
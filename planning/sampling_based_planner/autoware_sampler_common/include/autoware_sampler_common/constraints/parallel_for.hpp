@@ -0,0 +1,53 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_SAMPLER_COMMON__CONSTRAINTS__PARALLEL_FOR_HPP_
+#define AUTOWARE_SAMPLER_COMMON__CONSTRAINTS__PARALLEL_FOR_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace autoware::sampler_common::constraints
+{
+/// @brief call func(i) for i in [0, size) on the available hardware threads
+/// @details the indices are distributed dynamically by chunks since the cost per index varies
+template <typename Func>
+void parallelFor(const size_t size, const Func & func)
+{
+  constexpr size_t chunk_size = 16;
+  const size_t thread_num = std::min<size_t>(
+    std::max(1U, std::thread::hardware_concurrency()), (size + chunk_size - 1) / chunk_size);
+  if (thread_num <= 1) {
+    for (size_t i = 0; i < size; ++i) func(i);
+    return;
+  }
+  std::atomic<size_t> next_idx{0};
+  const auto run = [&]() {
+    for (size_t begin = next_idx.fetch_add(chunk_size); begin < size;
+         begin = next_idx.fetch_add(chunk_size)) {
+      const size_t end = std::min(begin + chunk_size, size);
+      for (size_t i = begin; i < end; ++i) func(i);
+    }
+  };
+  std::vector<std::future<void>> futures;
+  for (size_t t = 1; t < thread_num; ++t) futures.push_back(std::async(std::launch::async, run));
+  run();
+  for (auto & future : futures) future.get();
+}
+}  // namespace autoware::sampler_common::constraints
+
+#endif  // AUTOWARE_SAMPLER_COMMON__CONSTRAINTS__PARALLEL_FOR_HPP_
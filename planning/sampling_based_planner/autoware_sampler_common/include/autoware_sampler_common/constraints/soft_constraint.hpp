@@ -18,6 +18,8 @@
 #include "autoware_sampler_common/structures.hpp"
 #include "autoware_sampler_common/transform/spline_transform.hpp"
 
+#include <vector>
+
 namespace autoware::sampler_common::constraints
 {
 /// @brief calculate the curvature cost of the given path
@@ -30,6 +32,10 @@ void calculateLateralDeviationCost(
 /// @brief calculate the overall cost of the given path
 void calculateCost(
   Path & path, const Constraints & constraints, const transform::Spline2D & reference);
+/// @brief calculate the cost of all the given paths in parallel
+void calculateCost(
+  std::vector<Path> & paths, const Constraints & constraints,
+  const transform::Spline2D & reference);
 }  // namespace autoware::sampler_common::constraints
 
 #endif  // AUTOWARE_SAMPLER_COMMON__CONSTRAINTS__SOFT_CONSTRAINT_HPP_
@@ -32,9 +32,31 @@ class Spline
   std::vector<double> h_{};
 
 public:
+  /// @brief LU factorization of the tridiagonal system giving the coefficients of the natural
+  /// cubic splines over some base indexes
+  /// @details the factorization only depends on the base indexes, so it is reused by the splines
+  /// of different values over the same base indexes, which then only solve for their values
+  class Factorization
+  {
+    std::vector<double> h_{};
+    std::vector<double> multipliers_{};
+    std::vector<double> pivots_{};
+
+  public:
+    explicit Factorization(const std::vector<double> & base_index);
+    /// @brief solve the system for the second order coefficients of the spline in O(N)
+    [[nodiscard]] std::vector<double> solve(const std::vector<double> & base_value) const;
+    [[nodiscard]] const std::vector<double> & intervals() const { return h_; }
+  };
+
   Spline() = default;
   Spline(const std::vector<double> & base_index, const std::vector<double> & base_value);
+  Spline(const Factorization & factorization, const std::vector<double> & base_value);
   explicit Spline(const std::vector<Point2d> & points);
+  /// @brief build the splines of each values over the same base indexes with a single
+  /// factorization
+  [[nodiscard]] static std::vector<Spline> build(
+    const std::vector<double> & base_index, const std::vector<std::vector<double>> & base_values);
   bool interpolate(
     const std::vector<double> & base_index, const std::vector<double> & base_value,
     const std::vector<double> & return_index, std::vector<double> & return_value);
@@ -44,16 +66,11 @@ public:
     const double query, const std::vector<double> & base_index) const;
 
 private:
-  void generateSpline(
-    const std::vector<double> & base_index, const std::vector<double> & base_value);
+  void generateSpline(const Factorization & factorization, const std::vector<double> & base_value);
   [[nodiscard]] static bool isIncrease(const std::vector<double> & x);
   [[nodiscard]] static bool isValidInput(
     const std::vector<double> & base_index, const std::vector<double> & base_value,
     const std::vector<double> & return_index);
-  [[nodiscard]] std::vector<double> solveLinearSystem(
-    const double omega, const size_t max_iter) const;
-  [[nodiscard]] static bool isConvergeL1(
-    const std::vector<double> & r1, const std::vector<double> & r2, const double converge_range);
 };
 
 class Spline2D
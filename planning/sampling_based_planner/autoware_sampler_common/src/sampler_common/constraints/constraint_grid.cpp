@@ -0,0 +1,183 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_sampler_common/constraints/constraint_grid.hpp"
+
+#include <boost/geometry.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace autoware::sampler_common::constraints
+{
+using autoware::universe_utils::Box2d;
+
+ConstraintGrid::ConstraintGrid(
+  const Constraints & constraints, const Box2d & area, const double resolution)
+: constraints_(constraints),
+  origin_x_(area.min_corner().x()),
+  origin_y_(area.min_corner().y()),
+  resolution_(resolution)
+{
+  constexpr size_t max_cell_num = 1 << 22;
+  const auto calc_size = [&](const double length) {
+    return static_cast<size_t>(std::max(length, 0.0) / resolution_) + 1;
+  };
+  while (calc_size(area.max_corner().x() - origin_x_) *
+           calc_size(area.max_corner().y() - origin_y_) >
+         max_cell_num) {
+    resolution_ *= 2.0;
+  }
+  width_ = calc_size(area.max_corner().x() - origin_x_);
+  height_ = calc_size(area.max_corner().y() - origin_y_);
+  drivable_area_cells_.assign(width_ * height_, CellState::OUTSIDE);
+  near_obstacle_cells_.assign(width_ * height_, false);
+
+  // rings of the drivable area
+  std::vector<const LinearRing2d *> rings;
+  for (const auto & polygon : constraints_.drivable_polygons) {
+    rings.push_back(&polygon.outer());
+    for (const auto & inner : polygon.inners()) rings.push_back(&inner);
+  }
+
+  // (1) fill the cells whose center is inside the drivable area with the even-odd rule
+  std::vector<double> crossing_xs;
+  for (size_t row = 0; row < height_; ++row) {
+    const double y = origin_y_ + (static_cast<double>(row) + 0.5) * resolution_;
+    crossing_xs.clear();
+    for (const auto * ring : rings) {
+      for (size_t i = 0; i < ring->size(); ++i) {
+        const auto & a = (*ring)[i];
+        const auto & b = (*ring)[(i + 1) % ring->size()];
+        if ((a.y() <= y) != (b.y() <= y)) {
+          crossing_xs.push_back(a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y()));
+        }
+      }
+    }
+    std::sort(crossing_xs.begin(), crossing_xs.end());
+    const auto to_col = [&](const double x) {
+      const double col = std::ceil((x - origin_x_) / resolution_ - 0.5);
+      return static_cast<size_t>(std::clamp(col, 0.0, static_cast<double>(width_)));
+    };
+    for (size_t i = 0; i + 1 < crossing_xs.size(); i += 2) {
+      const auto col_begin = to_col(crossing_xs[i]);
+      const auto col_end = to_col(crossing_xs[i + 1]);
+      std::fill(
+        std::next(drivable_area_cells_.begin(), row * width_ + col_begin),
+        std::next(drivable_area_cells_.begin(), row * width_ + col_end), CellState::INSIDE);
+    }
+  }
+
+  // (2) the cells crossed by the rings contain both the inside and the outside
+  for (const auto * ring : rings) {
+    for (size_t i = 0; i < ring->size(); ++i) {
+      markBoundary((*ring)[i], (*ring)[(i + 1) % ring->size()]);
+    }
+  }
+
+  // (3) mark the cells which may be within the minimum distance from an obstacle
+  const double margin = std::max(constraints_.hard.min_dist_from_obstacles, 0.0);
+  for (const auto & obstacle : constraints_.obstacle_polygons) {
+    const auto obstacle_envelope = boost::geometry::return_envelope<Box2d>(obstacle);
+    const Box2d envelope(
+      {obstacle_envelope.min_corner().x() - margin, obstacle_envelope.min_corner().y() - margin},
+      {obstacle_envelope.max_corner().x() + margin, obstacle_envelope.max_corner().y() + margin});
+    obstacle_envelopes_.push_back(envelope);
+
+    const auto to_index = [&](const double value, const double origin, const size_t size) {
+      const double index = std::floor((value - origin) / resolution_);
+      return static_cast<size_t>(std::clamp(index, 0.0, static_cast<double>(size - 1)));
+    };
+    if (
+      envelope.max_corner().x() < origin_x_ || envelope.max_corner().y() < origin_y_ ||
+      envelope.min_corner().x() > origin_x_ + static_cast<double>(width_) * resolution_ ||
+      envelope.min_corner().y() > origin_y_ + static_cast<double>(height_) * resolution_) {
+      continue;
+    }
+    const auto col_begin = to_index(envelope.min_corner().x(), origin_x_, width_);
+    const auto col_end = to_index(envelope.max_corner().x(), origin_x_, width_);
+    const auto row_begin = to_index(envelope.min_corner().y(), origin_y_, height_);
+    const auto row_end = to_index(envelope.max_corner().y(), origin_y_, height_);
+    for (auto row = row_begin; row <= row_end; ++row) {
+      for (auto col = col_begin; col <= col_end; ++col) {
+        near_obstacle_cells_[row * width_ + col] = true;
+      }
+    }
+  }
+}
+
+bool ConstraintGrid::getCellIndex(const Point2d & p, size_t & index) const
+{
+  const double col = std::floor((p.x() - origin_x_) / resolution_);
+  const double row = std::floor((p.y() - origin_y_) / resolution_);
+  if (
+    col < 0.0 || row < 0.0 || col >= static_cast<double>(width_) ||
+    row >= static_cast<double>(height_)) {
+    return false;
+  }
+  index = static_cast<size_t>(row) * width_ + static_cast<size_t>(col);
+  return true;
+}
+
+void ConstraintGrid::markBoundary(const Point2d & from, const Point2d & to)
+{
+  // any point of the segment is within a quarter of a cell from a sampled point, so the cells
+  // around the sampled points cover all the cells crossed by the segment
+  const double length = std::hypot(to.x() - from.x(), to.y() - from.y());
+  const auto sample_num = static_cast<size_t>(std::ceil(length / (0.5 * resolution_)));
+  for (size_t i = 0; i <= sample_num; ++i) {
+    const double ratio = sample_num == 0 ? 0.0 : static_cast<double>(i) / sample_num;
+    const double x = from.x() + ratio * (to.x() - from.x());
+    const double y = from.y() + ratio * (to.y() - from.y());
+    const auto col = static_cast<int64_t>(std::floor((x - origin_x_) / resolution_));
+    const auto row = static_cast<int64_t>(std::floor((y - origin_y_) / resolution_));
+    for (auto r = row - 1; r <= row + 1; ++r) {
+      for (auto c = col - 1; c <= col + 1; ++c) {
+        if (
+          r >= 0 && c >= 0 && r < static_cast<int64_t>(height_) &&
+          c < static_cast<int64_t>(width_)) {
+          drivable_area_cells_[r * width_ + c] = CellState::BOUNDARY;
+        }
+      }
+    }
+  }
+}
+
+bool ConstraintGrid::isInsideDrivableArea(const Point2d & p) const
+{
+  size_t index = 0;
+  if (getCellIndex(p, index) && drivable_area_cells_[index] != CellState::BOUNDARY) {
+    return drivable_area_cells_[index] == CellState::INSIDE;
+  }
+  return boost::geometry::covered_by(p, constraints_.drivable_polygons);
+}
+
+bool ConstraintGrid::isColliding(const Point2d & p) const
+{
+  size_t index = 0;
+  if (getCellIndex(p, index) && !near_obstacle_cells_[index]) {
+    return false;
+  }
+  for (size_t i = 0; i < obstacle_envelopes_.size(); ++i) {
+    if (
+      boost::geometry::covered_by(p, obstacle_envelopes_[i]) &&
+      boost::geometry::distance(constraints_.obstacle_polygons[i], p) <=
+        constraints_.hard.min_dist_from_obstacles) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace autoware::sampler_common::constraints
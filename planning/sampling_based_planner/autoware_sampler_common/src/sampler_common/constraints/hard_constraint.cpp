@@ -14,11 +14,15 @@
 
 #include "autoware_sampler_common/constraints/hard_constraint.hpp"
 
+#include "autoware_sampler_common/constraints/constraint_grid.hpp"
 #include "autoware_sampler_common/constraints/footprint.hpp"
+#include "autoware_sampler_common/constraints/parallel_for.hpp"
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/algorithms/within.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace autoware::sampler_common::constraints
@@ -56,4 +60,50 @@ MultiPoint2d checkHardConstraints(Path & path, const Constraints & constraints)
   }
   return footprint;
 }
+
+std::vector<MultiPoint2d> checkHardConstraints(
+  std::vector<Path> & paths, const Constraints & constraints, const double grid_resolution)
+{
+  std::vector<MultiPoint2d> footprints(paths.size());
+  parallelFor(paths.size(), [&](const size_t i) {
+    footprints[i] = buildFootprintPoints(paths[i], constraints);
+  });
+
+  // rasterize the drivable area and the obstacles once over the area of all the footprints
+  autoware::universe_utils::Box2d area(
+    {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()},
+    {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()});
+  for (const auto & footprint : footprints) {
+    for (const auto & p : footprint) {
+      area.min_corner() = {
+        std::min(area.min_corner().x(), p.x()), std::min(area.min_corner().y(), p.y())};
+      area.max_corner() = {
+        std::max(area.max_corner().x(), p.x()), std::max(area.max_corner().y(), p.y())};
+    }
+  }
+  if (area.min_corner().x() > area.max_corner().x()) area = {{0.0, 0.0}, {0.0, 0.0}};
+  const ConstraintGrid grid(constraints, area, grid_resolution);
+
+  // NOTE: each check stops at the first point violating the constraint
+  parallelFor(paths.size(), [&](const size_t i) {
+    auto & path = paths[i];
+    const auto & footprint = footprints[i];
+    if (!footprint.empty()) {
+      if (constraints.hard.limit_footprint_inside_drivable_area)
+        path.constraint_results.inside_drivable_area =
+          std::all_of(footprint.begin(), footprint.end(), [&](const auto & p) {
+            return grid.isInsideDrivableArea(p);
+          });
+      path.constraint_results.collision_free =
+        std::none_of(footprint.begin(), footprint.end(), [&](const auto & p) {
+          return grid.isColliding(p);
+        });
+    }
+    if (!satisfyMinMax(
+          path.curvatures, constraints.hard.min_curvature, constraints.hard.max_curvature)) {
+      path.constraint_results.valid_curvature = false;
+    }
+  });
+  return footprints;
+}
 }  // namespace autoware::sampler_common::constraints
@@ -14,10 +14,12 @@
 
 #include "autoware_sampler_common/constraints/soft_constraint.hpp"
 
+#include "autoware_sampler_common/constraints/parallel_for.hpp"
 #include "autoware_sampler_common/structures.hpp"
 #include "autoware_sampler_common/transform/spline_transform.hpp"
 
 #include <numeric>
+#include <vector>
 
 namespace autoware::sampler_common::constraints
 {
@@ -51,4 +53,11 @@ void calculateCost(
   calculateLengthCost(path, constraints);
   calculateLateralDeviationCost(path, constraints, reference);
 }
+
+void calculateCost(
+  std::vector<Path> & paths, const Constraints & constraints, const transform::Spline2D & reference)
+{
+  parallelFor(
+    paths.size(), [&](const size_t i) { calculateCost(paths[i], constraints, reference); });
+}
 }  // namespace autoware::sampler_common::constraints
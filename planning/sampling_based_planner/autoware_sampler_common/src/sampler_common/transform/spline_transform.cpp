@@ -21,9 +21,53 @@
 
 namespace autoware::sampler_common::transform
 {
+Spline::Factorization::Factorization(const std::vector<double> & base_index)
+{
+  // the unknowns are c_[1] to c_[N-2] since c_[0] = c_[N-1] = 0 for natural splines. Row i of the
+  // system is h_[i-1] * c_[i-1] + 2 * (h_[i-1] + h_[i]) * c_[i] + h_[i] * c_[i+1] = rhs_i
+  const size_t N = base_index.size();
+  h_.reserve(N);
+  for (size_t i = 0; i + 1 < N; ++i) {
+    h_.push_back(base_index[i + 1] - base_index[i]);
+  }
+  // forward elimination of the diagonally dominant tridiagonal matrix (Thomas algorithm)
+  multipliers_.assign(N, 0.0);
+  pivots_.assign(N, 1.0);
+  for (size_t i = 1; i + 1 < N; ++i) {
+    pivots_[i] = 2.0 * (h_[i - 1] + h_[i]);
+    if (i > 1) {
+      multipliers_[i] = h_[i - 1] / pivots_[i - 1];
+      pivots_[i] -= multipliers_[i] * h_[i - 1];
+    }
+  }
+}
+
+std::vector<double> Spline::Factorization::solve(const std::vector<double> & base_value) const
+{
+  const size_t N = base_value.size();
+  std::vector<double> c(N, 0.0);
+  if (N < 3) {
+    return c;
+  }
+  const auto & a = base_value;
+  for (size_t i = 1; i + 1 < N; ++i) {
+    const double rhs = 3.0 / h_[i] * (a[i + 1] - a[i]) - 3.0 / h_[i - 1] * (a[i] - a[i - 1]);
+    c[i] = rhs - multipliers_[i] * c[i - 1];
+  }
+  for (size_t i = N - 2; i > 0; --i) {
+    c[i] = (c[i] - h_[i] * c[i + 1]) / pivots_[i];
+  }
+  return c;
+}
+
 Spline::Spline(const std::vector<double> & base_index, const std::vector<double> & base_value)
 {
-  generateSpline(base_index, base_value);
+  generateSpline(Factorization(base_index), base_value);
+}
+
+Spline::Spline(const Factorization & factorization, const std::vector<double> & base_value)
+{
+  generateSpline(factorization, base_value);
 }
 
 Spline::Spline(const std::vector<Point2d> & points)
@@ -36,11 +80,23 @@ Spline::Spline(const std::vector<Point2d> & points)
     xs.push_back(p.x());
     ys.push_back(p.y());
   }
-  generateSpline(xs, ys);
+  generateSpline(Factorization(xs), ys);
+}
+
+std::vector<Spline> Spline::build(
+  const std::vector<double> & base_index, const std::vector<std::vector<double>> & base_values)
+{
+  const Factorization factorization(base_index);
+  std::vector<Spline> splines;
+  splines.reserve(base_values.size());
+  for (const auto & base_value : base_values) {
+    splines.emplace_back(factorization, base_value);
+  }
+  return splines;
 }
 
 void Spline::generateSpline(
-  const std::vector<double> & base_index, const std::vector<double> & base_value)
+  const Factorization & factorization, const std::vector<double> & base_value)
 {
   const size_t N = base_value.size();
 
@@ -51,12 +107,8 @@ void Spline::generateSpline(
   h_.clear();
 
   a_ = base_value;
-
-  for (size_t i = 0; i + 1 < N; ++i) {
-    h_.push_back(base_index[i + 1] - base_index[i]);
-  }
-
-  c_ = solveLinearSystem(1.8, 100);
+  h_ = factorization.intervals();
+  c_ = factorization.solve(base_value);
 
   for (size_t i = 0; i < N - 1; i++) {
     d_.push_back((c_[i + 1] - c_[i]) / (3.0 * h_[i]));
@@ -134,46 +186,17 @@ bool Spline::isValidInput(
   return true;
 }
 
-std::vector<double> Spline::solveLinearSystem(const double omega, const size_t max_iter) const
-{
-  // solve A * ans = rhs by SOR method
-  constexpr double converge_range = 0.00001;
-  std::vector<double> ans(a_.size(), 1.0);
-  std::vector<double> ans_next(a_.size(), 0.0);
-  size_t num_iter = 0;
-
-  while (!isConvergeL1(ans, ans_next, converge_range) && num_iter <= max_iter) {
-    ans = ans_next;
-    for (size_t i = 1; i < a_.size() - 1; ++i) {
-      const double rhs = 3.0 / h_[i] * (a_[i + 1] - a_[i]) - 3.0 / h_[i - 1] * (a_[i] - a_[i - 1]);
-      ans_next[i] += omega / (2.0 * (h_[i - 1] + h_[i])) *
-                     (rhs - (h_[i - 1] * ans_next[i - 1] + 2.0 * (h_[i - 1] + h_[i]) * ans[i] +
-                             h_[i] * ans[i + 1]));
-    }
-    ++num_iter;
-  }
-
-  if (num_iter > max_iter) std::cerr << "[Spline::solveLinearSystem] unconverged!\n";
-  return ans_next;
-}
-
-bool Spline::isConvergeL1(
-  const std::vector<double> & r1, const std::vector<double> & r2, const double converge_range)
-{
-  double d = 0.0;
-  for (size_t i = 0; i < r1.size(); ++i) {
-    d += std::fabs(r1.at(i) - r2.at(i));
-  }
-  return d < converge_range;
-}
-
 /*
  * 2D Spline
  */
 
 Spline2D::Spline2D(const std::vector<double> & x, const std::vector<double> & y)
-: s_(arcLength(x, y)), x_spline_{s_, x}, y_spline_{s_, y}
+: s_(arcLength(x, y))
 {
+  // both splines are over the same arc lengths so the system is factorized only once
+  const Spline::Factorization factorization(s_);
+  x_spline_ = Spline(factorization, x);
+  y_spline_ = Spline(factorization, y);
   original_points_.reserve(x.size());
   for (size_t i = 0; i < x.size(); ++i) {
     original_points_.emplace_back(x[i], y[i]);
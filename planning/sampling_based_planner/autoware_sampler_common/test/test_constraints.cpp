@@ -0,0 +1,85 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_sampler_common/constraints/hard_constraint.hpp"
+#include "autoware_sampler_common/structures.hpp"
+
+#include <boost/geometry/algorithms/correct.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+TEST(Constraints, batchHardConstraints)
+{
+  using autoware::sampler_common::Constraints;
+  using autoware::sampler_common::Path;
+  using autoware::sampler_common::Polygon2d;
+  namespace constraints = autoware::sampler_common::constraints;
+
+  Constraints c;
+  c.hard.min_curvature = -0.1;
+  c.hard.max_curvature = 0.1;
+  c.hard.min_dist_from_obstacles = 0.5;
+  c.hard.limit_footprint_inside_drivable_area = true;
+  c.ego_footprint = {{1.0, 0.5}, {1.0, -0.5}, {-1.0, -0.5}, {-1.0, 0.5}};
+  // drivable area with a hole
+  Polygon2d drivable;
+  drivable.outer() = {{-5.0, -5.0}, {-5.0, 5.0}, {50.0, 5.0}, {50.0, -5.0}, {-5.0, -5.0}};
+  drivable.inners().push_back({{20.0, -1.0}, {22.0, -1.0}, {22.0, 1.0}, {20.0, 1.0}, {20.0, -1.0}});
+  boost::geometry::correct(drivable);
+  c.drivable_polygons = {drivable};
+  Polygon2d obstacle;
+  obstacle.outer() = {{10.0, 2.0}, {10.0, 3.0}, {11.0, 3.0}, {11.0, 2.0}, {10.0, 2.0}};
+  boost::geometry::correct(obstacle);
+  c.obstacle_polygons = {obstacle};
+
+  // straight paths with various lateral offsets and lengths
+  std::vector<Path> paths;
+  for (double d = -4.5; d <= 4.5; d += 0.37) {
+    for (double length = 5.0; length <= 40.0; length += 7.0) {
+      Path path;
+      for (double s = 0.0; s <= length; s += 0.5) {
+        path.points.emplace_back(s, d + 0.02 * s);
+        path.yaws.push_back(std::atan(0.02));
+        path.curvatures.push_back(d > 4.0 ? 0.2 : 0.0);
+      }
+      paths.push_back(path);
+    }
+  }
+
+  auto batch_paths = paths;
+  const auto footprints = constraints::checkHardConstraints(batch_paths, c);
+  ASSERT_EQ(footprints.size(), paths.size());
+  bool has_valid_path = false;
+  bool has_invalid_path = false;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const auto footprint = constraints::checkHardConstraints(paths[i], c);
+    EXPECT_EQ(footprints[i].size(), footprint.size());
+    EXPECT_EQ(
+      batch_paths[i].constraint_results.collision_free,
+      paths[i].constraint_results.collision_free);
+    EXPECT_EQ(
+      batch_paths[i].constraint_results.inside_drivable_area,
+      paths[i].constraint_results.inside_drivable_area);
+    EXPECT_EQ(
+      batch_paths[i].constraint_results.valid_curvature,
+      paths[i].constraint_results.valid_curvature);
+    has_valid_path |= paths[i].constraint_results.isValid();
+    has_invalid_path |= !paths[i].constraint_results.isValid();
+  }
+  EXPECT_TRUE(has_valid_path);
+  EXPECT_TRUE(has_invalid_path);
+}
@@ -16,9 +16,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <iostream>
 #include <random>
 #include <ratio>
+#include <utility>
+#include <vector>
 
 constexpr auto TOL = 1E-6;  // 1µm tolerance
 
@@ -109,3 +114,110 @@ TEST(splineTransform, benchFrenet)
               << "ms\n";
   }
 }
+
+namespace
+{
+// coefficients c of the natural cubic spline solved with the SOR method previously used by Spline
+std::vector<double> solveWithSOR(const std::vector<double> & xs, const std::vector<double> & ys)
+{
+  constexpr double omega = 1.8;
+  constexpr size_t max_iter = 100;
+  constexpr double converge_range = 0.00001;
+  std::vector<double> h;
+  for (size_t i = 0; i + 1 < xs.size(); ++i) h.push_back(xs[i + 1] - xs[i]);
+  std::vector<double> ans(ys.size(), 1.0);
+  std::vector<double> ans_next(ys.size(), 0.0);
+  const auto l1 = [&]() {
+    double d = 0.0;
+    for (size_t i = 0; i < ans.size(); ++i) d += std::fabs(ans[i] - ans_next[i]);
+    return d;
+  };
+  for (size_t num_iter = 0; l1() >= converge_range && num_iter <= max_iter; ++num_iter) {
+    ans = ans_next;
+    for (size_t i = 1; i < ys.size() - 1; ++i) {
+      const double rhs = 3.0 / h[i] * (ys[i + 1] - ys[i]) - 3.0 / h[i - 1] * (ys[i] - ys[i - 1]);
+      ans_next[i] += omega / (2.0 * (h[i - 1] + h[i])) *
+                     (rhs - (h[i - 1] * ans_next[i - 1] + 2.0 * (h[i - 1] + h[i]) * ans[i] +
+                             h[i] * ans[i + 1]));
+    }
+  }
+  return ans_next;
+}
+
+std::pair<std::vector<double>, std::vector<double>> generateCurve(const size_t size)
+{
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (size_t i = 0; i < size; ++i) {
+    xs.push_back(static_cast<double>(i) + 0.3 * std::sin(static_cast<double>(i)));
+    ys.push_back(std::sin(0.1 * static_cast<double>(i)) * 10.0);
+  }
+  return {xs, ys};
+}
+}  // namespace
+
+TEST(splineTransform, directSolver)
+{
+  using autoware::sampler_common::transform::Spline;
+  const auto [xs, ys] = generateCurve(50);
+  const Spline spline(xs, ys);
+  const auto sor_c = solveWithSOR(xs, ys);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    // interpolation of the base values and continuity of the 1st derivative at the knots
+    EXPECT_NEAR(spline.value(xs[i], xs), ys[i], TOL);
+    if (i > 0 && i + 1 < xs.size()) {
+      EXPECT_NEAR(spline.velocity(xs[i] - 1e-9, xs), spline.velocity(xs[i] + 1e-9, xs), 1e-6);
+    }
+    // same second derivatives as the converged SOR method
+    EXPECT_NEAR(spline.acceleration(xs[i] + 1e-12, xs) / 2.0, sor_c[i], 1e-4);
+  }
+  // natural boundary conditions
+  EXPECT_NEAR(spline.acceleration(xs.front() + 1e-12, xs), 0.0, TOL);
+
+  // the splines built with a shared factorization are the same as the ones built independently
+  std::vector<double> ys2 = ys;
+  for (auto & y : ys2) y = y * y;
+  const auto splines = Spline::build(xs, {ys, ys2});
+  const Spline spline2(xs, ys2);
+  for (double x = xs.front(); x < xs.back(); x += 0.1) {
+    EXPECT_DOUBLE_EQ(splines[0].value(x, xs), spline.value(x, xs));
+    EXPECT_DOUBLE_EQ(splines[1].value(x, xs), spline2.value(x, xs));
+  }
+}
+
+TEST(splineTransform, benchLinearSystem)
+{
+  GTEST_SKIP() << "Skipping benchmark test";
+  using autoware::sampler_common::transform::Spline;
+  for (auto size = 100; size <= 1000; size += 100) {
+    std::chrono::nanoseconds sor{0};
+    std::chrono::nanoseconds direct{0};
+    std::chrono::nanoseconds shared{0};
+    double max_error = 0.0;
+    const auto [xs, ys] = generateCurve(size);
+    constexpr auto nb_iter = 1e2;
+    for (auto iter = 0; iter < nb_iter; ++iter) {
+      auto start = std::chrono::steady_clock::now();
+      const auto sor_c = solveWithSOR(xs, ys);
+      auto end = std::chrono::steady_clock::now();
+      sor += end - start;
+      start = std::chrono::steady_clock::now();
+      const Spline::Factorization factorization(xs);
+      const auto direct_c = factorization.solve(ys);
+      end = std::chrono::steady_clock::now();
+      direct += end - start;
+      start = std::chrono::steady_clock::now();
+      const auto shared_c = factorization.solve(ys);
+      end = std::chrono::steady_clock::now();
+      shared += end - start;
+      for (size_t i = 0; i < sor_c.size(); ++i) {
+        max_error = std::max(max_error, std::abs(sor_c[i] - direct_c[i]));
+      }
+    }
+    std::cout << "size = " << size << std::endl;
+    std::cout << "\tSOR                  : " << sor.count() / nb_iter << "ns\n";
+    std::cout << "\tdirect               : " << direct.count() / nb_iter << "ns\n";
+    std::cout << "\tshared factorization : " << shared.count() / nb_iter << "ns\n";
+    std::cout << "\tmax difference of c  : " << max_error << "\n";
+  }
+}